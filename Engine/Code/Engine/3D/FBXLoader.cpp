@@ -122,9 +122,7 @@ ModelNode* FBXLoader::LoadModelNodeFromFBXNode( FbxNode* fbxnode, char const* fi
 		attribute = fbxnode->GetNodeAttributeByIndex( attributeNum );
 		if ( attribute->GetAttributeType() == FbxNodeAttribute::eMesh )
 		{
-			GeometryNode* geoNode = new GeometryNode();
-			geoNode->m_vertDataID = g_theVisualDatabase->CreateOrGetVertsFromFBX( fbxnode, filepath );
-			geoNode->m_nodeType = NodeType::Geometry;
+			GeometryNode* geoNode = new GeometryNode( g_theVisualDatabase->CreateOrGetVertsFromFBX( fbxnode, filepath ) );
 	
 			/*int materialCount = fbxnode->GetMaterialCount();
 			if ( materialCount > 0 )
@@ -150,9 +148,7 @@ ModelNode* FBXLoader::LoadModelNodeFromFBXNode( FbxNode* fbxnode, char const* fi
 
 	for ( int fbxnodeNum = 0; fbxnodeNum < fbxnode->GetChildCount(); fbxnodeNum++ )
 	{
-		ModelNode* child = LoadModelNodeFromFBXNode( fbxnode->GetChild( fbxnodeNum ), filepath );
-		child->m_parent = node;
-		node->m_children.push_back( child );
+		node->AddChild( LoadModelNodeFromFBXNode( fbxnode->GetChild( fbxnodeNum ), filepath ) );
 	}
 
 	return node;
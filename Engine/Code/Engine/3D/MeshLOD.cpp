@@ -0,0 +1,56 @@
+#include "Engine/3D/MeshLOD.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/Vec4.hpp"
+
+#include <float.h>
+
+
+//-----------------------------------------------------------------------------------------------
+static float GetLODSwitchSize( uint lodNum )
+{
+	return LOD0_MIN_SCREEN_SIZE / static_cast< float >( 1u << lodNum );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Works for perspective and orthographic view projections; the xyz length of the clip y row is the
+// projection's y scale because the view part is rigid
+//
+float GetProjectedDiameterPixels( Vec3 const& worldCenter, float worldRadius, Mat44 const& viewProjection, float viewportHeightPixels )
+{
+	float const* values = viewProjection.m_values;
+	bool  isPerspective = values[ Mat44::Iw ] != 0.0f || values[ Mat44::Jw ] != 0.0f || values[ Mat44::Kw ] != 0.0f;
+
+	Vec4 clipCenter = viewProjection.TransformHomogeneous3D( Vec4( worldCenter.x, worldCenter.y, worldCenter.z, 1.0f ) );
+	if ( isPerspective && clipCenter.w <= worldRadius )
+	{
+		return FLT_MAX;
+	}
+
+	float projectionScaleY = Vec3( values[ Mat44::Iy ], values[ Mat44::Jy ], values[ Mat44::Ky ] ).GetLength();
+	float clipRadius       = worldRadius * projectionScaleY / clipCenter.w;
+	return clipRadius * viewportHeightPixels;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Biases below 1 pick coarser LODs. A switch only happens once the size clears the switch point by the hysteresis band
+//
+uint SelectMeshLOD( float projectedDiameterPixels, uint currentLOD, float lodBias /*= 1.0f*/, float hysteresis /*= LOD_HYSTERESIS*/ )
+{
+	float size = projectedDiameterPixels * lodBias;
+	uint  lod  = currentLOD < MAX_MESH_LODS ? currentLOD : MAX_MESH_LODS - 1;
+
+	while ( lod > 0 && size > GetLODSwitchSize( lod - 1 ) * ( 1.0f + hysteresis ) )
+	{
+		lod--;
+	}
+
+	while ( lod + 1 < MAX_MESH_LODS && size < GetLODSwitchSize( lod ) * ( 1.0f - hysteresis ) )
+	{
+		lod++;
+	}
+
+	return lod;
+}
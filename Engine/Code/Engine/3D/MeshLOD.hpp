@@ -0,0 +1,29 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+class Mat44;
+struct Vec3;
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr uint  MAX_MESH_LODS        = 4;
+constexpr float LOD0_MIN_SCREEN_SIZE = 256.0f;	// projected diameter in pixels below which LOD1 takes over; each further LOD halves it
+constexpr float LOD_HYSTERESIS       = 0.15f;	// fraction a size must move past a switch point before the LOD changes back
+
+
+//-----------------------------------------------------------------------------------------------
+// One level of detail inside a mesh's shared index buffer
+//
+struct MeshLOD
+{
+	uint  m_indexOffset = 0;
+	uint  m_indexCount  = 0;
+	float m_error       = 0.0f;	// simplification error relative to the mesh bounds diagonal
+};
+
+
+//-----------------------------------------------------------------------------------------------
+float GetProjectedDiameterPixels( Vec3 const& worldCenter, float worldRadius, Mat44 const& viewProjection, float viewportHeightPixels );
+uint  SelectMeshLOD( float projectedDiameterPixels, uint currentLOD, float lodBias = 1.0f, float hysteresis = LOD_HYSTERESIS );
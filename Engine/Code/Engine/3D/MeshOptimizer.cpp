@@ -0,0 +1,771 @@
+#include "Engine/3D/MeshOptimizer.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <math.h>
+#include <unordered_map>
+
+
+//-----------------------------------------------------------------------------------------------
+// FIFO post-transform cache simulation; a vertex hits while fewer than cacheSize misses happened since it was loaded
+//
+struct FIFOCacheSimulator
+{
+	std::vector<uint> m_loadTimestamps;
+	uint              m_cacheSize = 0;
+	uint              m_timestamp = 0;
+
+	FIFOCacheSimulator( size_t vertexCount, uint cacheSize )
+		: m_loadTimestamps( vertexCount, 0 )
+		, m_cacheSize( cacheSize )
+		, m_timestamp( cacheSize + 1 )
+	{
+	}
+
+	uint SimulateTriangle( uint const* triangle )
+	{
+		uint misses = 0;
+		for ( int cornerNum = 0; cornerNum < 3; cornerNum++ )
+		{
+			uint vertex = triangle[ cornerNum ];
+			if ( m_timestamp - m_loadTimestamps[ vertex ] > m_cacheSize )
+			{
+				m_loadTimestamps[ vertex ] = m_timestamp++;
+				misses++;
+			}
+		}
+		return misses;
+	}
+
+	void Flush()
+	{
+		m_timestamp += m_cacheSize + 1;
+	}
+};
+
+
+//-----------------------------------------------------------------------------------------------
+VertexCacheStats AnalyzeVertexCache( std::vector<uint> const& indices, size_t vertexCount, uint cacheSize /*= VERTEX_CACHE_STATS_SIZE*/ )
+{
+	VertexCacheStats stats;
+	size_t numTriangles = indices.size() / 3;
+	if ( numTriangles == 0 || vertexCount == 0 )
+	{
+		return stats;
+	}
+
+	FIFOCacheSimulator cache( vertexCount, cacheSize );
+	uint misses = 0;
+	for ( size_t triangleNum = 0; triangleNum < numTriangles; triangleNum++ )
+	{
+		misses += cache.SimulateTriangle( &indices[ triangleNum * 3 ] );
+	}
+
+	stats.m_acmr = static_cast< float >( misses ) / static_cast< float >( numTriangles );
+	stats.m_atvr = static_cast< float >( misses ) / static_cast< float >( vertexCount );
+	return stats;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+struct VertexBytesHash
+{
+	size_t operator()( Vertex_PCUTBN const& vertex ) const
+	{
+		// FNV-1a over the raw vertex bytes
+		unsigned char const* bytes = reinterpret_cast< unsigned char const* >( &vertex );
+		size_t hash = 14695981039346656037ull;
+		for ( size_t byteNum = 0; byteNum < sizeof( Vertex_PCUTBN ); byteNum++ )
+		{
+			hash ^= bytes[ byteNum ];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct VertexBytesEqual
+{
+	bool operator()( Vertex_PCUTBN const& vertexA, Vertex_PCUTBN const& vertexB ) const
+	{
+		return memcmp( &vertexA, &vertexB, sizeof( Vertex_PCUTBN ) ) == 0;
+	}
+};
+
+
+//-----------------------------------------------------------------------------------------------
+void BuildIndexedMesh( std::vector<Vertex_PCUTBN> const& triangleList, std::vector<Vertex_PCUTBN>& outVerts, std::vector<uint>& outIndices )
+{
+	static_assert( sizeof( Vertex_PCUTBN ) == 60, "Vertex_PCUTBN has padding; byte-wise welding would compare garbage" );
+
+	outVerts.clear();
+	outIndices.clear();
+	outIndices.reserve( triangleList.size() );
+
+	std::unordered_map<Vertex_PCUTBN, uint, VertexBytesHash, VertexBytesEqual> vertexToIndex;
+	vertexToIndex.reserve( triangleList.size() );
+
+	for ( Vertex_PCUTBN const& vertex : triangleList )
+	{
+		auto found = vertexToIndex.find( vertex );
+		if ( found != vertexToIndex.end() )
+		{
+			outIndices.push_back( found->second );
+			continue;
+		}
+
+		uint newIndex = static_cast< uint >( outVerts.size() );
+		vertexToIndex[ vertex ] = newIndex;
+		outVerts.push_back( vertex );
+		outIndices.push_back( newIndex );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Forsyth's linear-speed vertex cache optimisation scoring
+//
+static float GetForsythVertexScore( int cachePosition, uint remainingValence )
+{
+	constexpr float CACHE_DECAY_POWER   = 1.5f;
+	constexpr float LAST_TRI_SCORE      = 0.75f;
+	constexpr float VALENCE_BOOST_SCALE = 2.0f;
+	constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+	if ( remainingValence == 0 )
+	{
+		return -1.0f;
+	}
+
+	float score = 0.0f;
+	if ( cachePosition >= 0 )
+	{
+		if ( cachePosition < 3 )
+		{
+			score = LAST_TRI_SCORE;
+		}
+		else
+		{
+			float scaler = 1.0f - static_cast< float >( cachePosition - 3 ) / static_cast< float >( FORSYTH_CACHE_SIZE - 3 );
+			score = powf( scaler, CACHE_DECAY_POWER );
+		}
+	}
+
+	score += VALENCE_BOOST_SCALE * powf( static_cast< float >( remainingValence ), -VALENCE_BOOST_POWER );
+	return score;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void OptimizeVertexCache( std::vector<uint>& indices, size_t vertexCount )
+{
+	size_t numTriangles = indices.size() / 3;
+	if ( numTriangles == 0 )
+	{
+		return;
+	}
+
+	// Vertex -> triangle adjacency in CSR form
+	std::vector<uint> adjacencyOffsets( vertexCount + 1, 0 );
+	for ( uint index : indices )
+	{
+		adjacencyOffsets[ index + 1 ]++;
+	}
+	for ( size_t vertexNum = 0; vertexNum < vertexCount; vertexNum++ )
+	{
+		adjacencyOffsets[ vertexNum + 1 ] += adjacencyOffsets[ vertexNum ];
+	}
+
+	std::vector<uint> adjacentTriangles( indices.size() );
+	std::vector<uint> remainingValence( vertexCount, 0 );
+	for ( size_t triangleNum = 0; triangleNum < numTriangles; triangleNum++ )
+	{
+		for ( int cornerNum = 0; cornerNum < 3; cornerNum++ )
+		{
+			uint vertex = indices[ triangleNum * 3 + cornerNum ];
+			adjacentTriangles[ adjacencyOffsets[ vertex ] + remainingValence[ vertex ] ] = static_cast< uint >( triangleNum );
+			remainingValence[ vertex ]++;
+		}
+	}
+
+	std::vector<int>   cachePositions( vertexCount, -1 );
+	std::vector<float> vertexScores( vertexCount );
+	for ( size_t vertexNum = 0; vertexNum < vertexCount; vertexNum++ )
+	{
+		vertexScores[ vertexNum ] = GetForsythVertexScore( -1, remainingValence[ vertexNum ] );
+	}
+
+	std::vector<float> triangleScores( numTriangles );
+	std::vector<bool>  triangleEmitted( numTriangles, false );
+	for ( size_t triangleNum = 0; triangleNum < numTriangles; triangleNum++ )
+	{
+		triangleScores[ triangleNum ] = vertexScores[ indices[ triangleNum * 3 ] ] + vertexScores[ indices[ triangleNum * 3 + 1 ] ] + vertexScores[ indices[ triangleNum * 3 + 2 ] ];
+	}
+
+	std::vector<uint> optimizedIndices;
+	optimizedIndices.reserve( indices.size() );
+
+	std::vector<uint> cache;
+	std::vector<uint> nextCache;
+	cache.reserve( FORSYTH_CACHE_SIZE + 3 );
+	nextCache.reserve( FORSYTH_CACHE_SIZE + 3 );
+
+	size_t fallbackCursor = 0;
+	int    bestTriangle   = 0;
+
+	for ( size_t emittedCount = 0; emittedCount < numTriangles; emittedCount++ )
+	{
+		if ( bestTriangle < 0 )
+		{
+			// Nothing adjacent to the cache is left; continue from the next untouched triangle in input order
+			while ( triangleEmitted[ fallbackCursor ] )
+			{
+				fallbackCursor++;
+			}
+			bestTriangle = static_cast< int >( fallbackCursor );
+		}
+
+		uint const* triangle = &indices[ bestTriangle * 3 ];
+		triangleEmitted[ bestTriangle ] = true;
+
+		nextCache.clear();
+		for ( int cornerNum = 0; cornerNum < 3; cornerNum++ )
+		{
+			uint vertex = triangle[ cornerNum ];
+			optimizedIndices.push_back( vertex );
+			nextCache.push_back( vertex );
+
+			// Remove the emitted triangle from this vertex's live adjacency
+			uint* adjacencyBegin = &adjacentTriangles[ adjacencyOffsets[ vertex ] ];
+			uint  valence        = remainingValence[ vertex ];
+			for ( uint adjacentNum = 0; adjacentNum < valence; adjacentNum++ )
+			{
+				if ( adjacencyBegin[ adjacentNum ] == static_cast< uint >( bestTriangle ) )
+				{
+					adjacencyBegin[ adjacentNum ] = adjacencyBegin[ valence - 1 ];
+					break;
+				}
+			}
+			remainingValence[ vertex ]--;
+		}
+
+		for ( uint cachedVertex : cache )
+		{
+			if ( cachedVertex != triangle[ 0 ] && cachedVertex != triangle[ 1 ] && cachedVertex != triangle[ 2 ] )
+			{
+				nextCache.push_back( cachedVertex );
+			}
+		}
+		cache.swap( nextCache );
+
+		// Rescore everything that was or is in the cache and find the best adjacent triangle
+		for ( size_t cacheIndex = 0; cacheIndex < cache.size(); cacheIndex++ )
+		{
+			uint vertex = cache[ cacheIndex ];
+			int  position = cacheIndex < FORSYTH_CACHE_SIZE ? static_cast< int >( cacheIndex ) : -1;
+			cachePositions[ vertex ] = position;
+			vertexScores[ vertex ]   = GetForsythVertexScore( position, remainingValence[ vertex ] );
+		}
+
+		bestTriangle = -1;
+		float bestScore = -1.0f;
+		for ( uint vertex : cache )
+		{
+			uint const* adjacencyBegin = &adjacentTriangles[ adjacencyOffsets[ vertex ] ];
+			for ( uint adjacentNum = 0; adjacentNum < remainingValence[ vertex ]; adjacentNum++ )
+			{
+				uint   adjacentTriangle = adjacencyBegin[ adjacentNum ];
+				uint const* corners     = &indices[ adjacentTriangle * 3 ];
+				float  score            = vertexScores[ corners[ 0 ] ] + vertexScores[ corners[ 1 ] ] + vertexScores[ corners[ 2 ] ];
+				triangleScores[ adjacentTriangle ] = score;
+				if ( score > bestScore )
+				{
+					bestScore = score;
+					bestTriangle = static_cast< int >( adjacentTriangle );
+				}
+			}
+		}
+
+		if ( cache.size() > FORSYTH_CACHE_SIZE )
+		{
+			cache.resize( FORSYTH_CACHE_SIZE );
+		}
+	}
+
+	indices.swap( optimizedIndices );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// View-independent overdraw reduction ( Sander et al. ): split the cache-optimised order into clusters whose
+// ACMR stays within threshold of the whole mesh, then draw outward-facing clusters first
+//
+uint OptimizeOverdraw( std::vector<uint>& indices, std::vector<Vertex_PCUTBN> const& verts, float threshold /*= OVERDRAW_CLUSTER_THRESHOLD*/ )
+{
+	size_t numTriangles = indices.size() / 3;
+	if ( numTriangles == 0 )
+	{
+		return 0;
+	}
+
+	float meshACMR = AnalyzeVertexCache( indices, verts.size() ).m_acmr;
+
+	// Hard boundaries are triangles that miss on every corner, soft boundaries are where the running cluster ACMR is already good enough
+	std::vector<size_t> clusterStarts;
+	FIFOCacheSimulator hardCache( verts.size(), VERTEX_CACHE_STATS_SIZE );
+	FIFOCacheSimulator softCache( verts.size(), VERTEX_CACHE_STATS_SIZE );
+	uint   clusterMisses     = 0;
+	size_t clusterStart      = 0;
+	clusterStarts.push_back( 0 );
+
+	for ( size_t triangleNum = 0; triangleNum < numTriangles; triangleNum++ )
+	{
+		uint const* triangle = &indices[ triangleNum * 3 ];
+		bool isHardBoundary = hardCache.SimulateTriangle( triangle ) == 3 && triangleNum != clusterStart;
+		if ( isHardBoundary )
+		{
+			clusterStarts.push_back( triangleNum );
+			clusterStart  = triangleNum;
+			clusterMisses = 0;
+			softCache.Flush();
+		}
+
+		clusterMisses += softCache.SimulateTriangle( triangle );
+		float clusterACMR = static_cast< float >( clusterMisses ) / static_cast< float >( triangleNum - clusterStart + 1 );
+		if ( triangleNum + 1 < numTriangles && clusterACMR <= meshACMR * threshold )
+		{
+			clusterStarts.push_back( triangleNum + 1 );
+			clusterStart  = triangleNum + 1;
+			clusterMisses = 0;
+			softCache.Flush();
+		}
+	}
+	clusterStarts.push_back( numTriangles );
+
+	// Area weighted centroid / normal per cluster
+	size_t numClusters = clusterStarts.size() - 1;
+	std::vector<Vec3>  clusterCentroids( numClusters );
+	std::vector<Vec3>  clusterNormals( numClusters );
+	Vec3  meshCentroid;
+	float meshArea = 0.0f;
+
+	for ( size_t clusterNum = 0; clusterNum < numClusters; clusterNum++ )
+	{
+		Vec3  centroidSum;
+		Vec3  normalSum;
+		float areaSum = 0.0f;
+		for ( size_t triangleNum = clusterStarts[ clusterNum ]; triangleNum < clusterStarts[ clusterNum + 1 ]; triangleNum++ )
+		{
+			Vec3 const& positionA = verts[ indices[ triangleNum * 3 ] ].m_position;
+			Vec3 const& positionB = verts[ indices[ triangleNum * 3 + 1 ] ].m_position;
+			Vec3 const& positionC = verts[ indices[ triangleNum * 3 + 2 ] ].m_position;
+
+			Vec3  areaNormal = CrossProduct3D( positionB - positionA, positionC - positionA );
+			float area       = areaNormal.GetLength();
+
+			centroidSum += ( positionA + positionB + positionC ) * ( area / 3.0f );
+			normalSum   += areaNormal;
+			areaSum     += area;
+		}
+
+		clusterCentroids[ clusterNum ] = areaSum > 0.0f ? centroidSum / areaSum : verts[ indices[ clusterStarts[ clusterNum ] * 3 ] ].m_position;
+		clusterNormals[ clusterNum ]   = normalSum.GetNormalized();
+		meshCentroid += centroidSum;
+		meshArea     += areaSum;
+	}
+
+	if ( meshArea > 0.0f )
+	{
+		meshCentroid = meshCentroid / meshArea;
+	}
+
+	std::vector<float>  sortKeys( numClusters );
+	std::vector<size_t> clusterOrder( numClusters );
+	for ( size_t clusterNum = 0; clusterNum < numClusters; clusterNum++ )
+	{
+		sortKeys[ clusterNum ]     = DotProduct3D( clusterCentroids[ clusterNum ] - meshCentroid, clusterNormals[ clusterNum ] );
+		clusterOrder[ clusterNum ] = clusterNum;
+	}
+
+	std::stable_sort( clusterOrder.begin(), clusterOrder.end(), [ &sortKeys ]( size_t clusterA, size_t clusterB )
+	{
+		return sortKeys[ clusterA ] > sortKeys[ clusterB ];
+	} );
+
+	std::vector<uint> sortedIndices;
+	sortedIndices.reserve( indices.size() );
+	for ( size_t clusterNum : clusterOrder )
+	{
+		sortedIndices.insert( sortedIndices.end(), indices.begin() + clusterStarts[ clusterNum ] * 3, indices.begin() + clusterStarts[ clusterNum + 1 ] * 3 );
+	}
+
+	indices.swap( sortedIndices );
+	return static_cast< uint >( numClusters );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reorders vertices into first-use order so vertex fetch walks memory linearly
+//
+void OptimizeVertexFetch( std::vector<Vertex_PCUTBN>& verts, std::vector<uint>& indices )
+{
+	constexpr uint UNMAPPED = 0xFFFFFFFF;
+
+	std::vector<uint> remap( verts.size(), UNMAPPED );
+	std::vector<Vertex_PCUTBN> reorderedVerts;
+	reorderedVerts.reserve( verts.size() );
+
+	for ( uint& index : indices )
+	{
+		if ( remap[ index ] == UNMAPPED )
+		{
+			remap[ index ] = static_cast< uint >( reorderedVerts.size() );
+			reorderedVerts.push_back( verts[ index ] );
+		}
+		index = remap[ index ];
+	}
+
+	verts.swap( reorderedVerts );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+MeshOptimizationReport OptimizeMesh( std::vector<Vertex_PCUTBN> const& triangleList, std::vector<Vertex_PCUTBN>& outVerts, std::vector<uint>& outIndices )
+{
+	MeshOptimizationReport report;
+
+	BuildIndexedMesh( triangleList, outVerts, outIndices );
+	report.m_before = AnalyzeVertexCache( outIndices, outVerts.size() );
+
+	OptimizeVertexCache( outIndices, outVerts.size() );
+	report.m_numOverdrawClusters = OptimizeOverdraw( outIndices, outVerts );
+	OptimizeVertexFetch( outVerts, outIndices );
+
+	report.m_after                = AnalyzeVertexCache( outIndices, outVerts.size() );
+	report.m_numTriangleListVerts = static_cast< uint >( triangleList.size() );
+	report.m_numUniqueVerts       = static_cast< uint >( outVerts.size() );
+	return report;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Symmetric 4x4 plane quadric ( Garland & Heckbert ), stored as its upper triangle
+//
+struct Quadric
+{
+	double m_aa = 0.0, m_ab = 0.0, m_ac = 0.0, m_ad = 0.0;
+	double m_bb = 0.0, m_bc = 0.0, m_bd = 0.0;
+	double m_cc = 0.0, m_cd = 0.0;
+	double m_dd = 0.0;
+
+	void AddPlane( Vec3 const& normal, float distance )
+	{
+		double a = normal.x;
+		double b = normal.y;
+		double c = normal.z;
+		double d = distance;
+
+		m_aa += a * a; m_ab += a * b; m_ac += a * c; m_ad += a * d;
+		m_bb += b * b; m_bc += b * c; m_bd += b * d;
+		m_cc += c * c; m_cd += c * d;
+		m_dd += d * d;
+	}
+
+	void Add( Quadric const& other )
+	{
+		m_aa += other.m_aa; m_ab += other.m_ab; m_ac += other.m_ac; m_ad += other.m_ad;
+		m_bb += other.m_bb; m_bc += other.m_bc; m_bd += other.m_bd;
+		m_cc += other.m_cc; m_cd += other.m_cd;
+		m_dd += other.m_dd;
+	}
+
+	// Sum of squared distances from point to every accumulated plane
+	double Evaluate( Vec3 const& point ) const
+	{
+		double x = point.x;
+		double y = point.y;
+		double z = point.z;
+
+		double error = m_aa * x * x + 2.0 * m_ab * x * y + 2.0 * m_ac * x * z + 2.0 * m_ad * x
+					 + m_bb * y * y + 2.0 * m_bc * y * z + 2.0 * m_bd * y
+					 + m_cc * z * z + 2.0 * m_cd * z
+					 + m_dd;
+		return error > 0.0 ? error : 0.0;
+	}
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct PositionHash
+{
+	size_t operator()( Vec3 const& position ) const
+	{
+		uint bits[ 3 ];
+		memcpy( bits, &position, sizeof( bits ) );
+		return ( static_cast< size_t >( bits[ 0 ] ) * 73856093u ) ^ ( static_cast< size_t >( bits[ 1 ] ) * 19349663u ) ^ ( static_cast< size_t >( bits[ 2 ] ) * 83492791u );
+	}
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct PositionEqual
+{
+	bool operator()( Vec3 const& positionA, Vec3 const& positionB ) const
+	{
+		return positionA.x == positionB.x && positionA.y == positionB.y && positionA.z == positionB.z;
+	}
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct EdgeCollapse
+{
+	uint   m_from = 0;
+	uint   m_to   = 0;
+	double m_cost = 0.0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static uint64_t GetEdgeKey( uint from, uint to )
+{
+	return ( static_cast< uint64_t >( from ) << 32 ) | static_cast< uint64_t >( to );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Vertices are only ever collapsed onto another existing vertex, so LODs can share the LOD0 vertex buffer.
+// Attribute seams ( several verts at one position ) and open borders stay locked to keep UVs and silhouettes intact
+//
+float SimplifyMesh( std::vector<Vertex_PCUTBN> const& verts, std::vector<uint> const& indices, size_t targetIndexCount, float maxError, std::vector<uint>& outIndices )
+{
+	outIndices = indices;
+	if ( indices.size() <= targetIndexCount || verts.empty() )
+	{
+		return 0.0f;
+	}
+
+	size_t vertexCount = verts.size();
+
+	// Weld by position so quadrics and topology ignore attribute splits
+	std::vector<uint> positionRemap( vertexCount );
+	std::vector<uint> verticesAtPosition( vertexCount, 0 );
+	std::unordered_map<Vec3, uint, PositionHash, PositionEqual> positionToVertex;
+	positionToVertex.reserve( vertexCount );
+
+	for ( size_t vertexNum = 0; vertexNum < vertexCount; vertexNum++ )
+	{
+		auto inserted = positionToVertex.emplace( verts[ vertexNum ].m_position, static_cast< uint >( vertexNum ) );
+		positionRemap[ vertexNum ] = inserted.first->second;
+		verticesAtPosition[ inserted.first->second ]++;
+	}
+
+	AABB3 bounds( verts[ 0 ].m_position, verts[ 0 ].m_position );
+	for ( Vertex_PCUTBN const& vertex : verts )
+	{
+		bounds.StretchToIncludePoint( vertex.m_position );
+	}
+	float  boundsDiagonal = ( bounds.m_maxs - bounds.m_mins ).GetLength();
+	double maxCost        = static_cast< double >( maxError * boundsDiagonal ) * static_cast< double >( maxError * boundsDiagonal );
+
+	std::vector<bool>    isLocked( vertexCount, false );
+	std::vector<Quadric> quadrics( vertexCount );
+
+	std::unordered_map<uint64_t, uint> directedEdges;
+	directedEdges.reserve( indices.size() );
+	for ( size_t triangleNum = 0; triangleNum < indices.size() / 3; triangleNum++ )
+	{
+		uint const* triangle = &indices[ triangleNum * 3 ];
+		for ( int cornerNum = 0; cornerNum < 3; cornerNum++ )
+		{
+			directedEdges[ GetEdgeKey( positionRemap[ triangle[ cornerNum ] ], positionRemap[ triangle[ ( cornerNum + 1 ) % 3 ] ] ) ]++;
+		}
+
+		Vec3 const& positionA = verts[ triangle[ 0 ] ].m_position;
+		Vec3 const& positionB = verts[ triangle[ 1 ] ].m_position;
+		Vec3 const& positionC = verts[ triangle[ 2 ] ].m_position;
+		Vec3 normal = CrossProduct3D( positionB - positionA, positionC - positionA ).GetNormalized();
+		float distance = -DotProduct3D( normal, positionA );
+
+		for ( int cornerNum = 0; cornerNum < 3; cornerNum++ )
+		{
+			quadrics[ positionRemap[ triangle[ cornerNum ] ] ].AddPlane( normal, distance );
+		}
+	}
+
+	for ( size_t vertexNum = 0; vertexNum < vertexCount; vertexNum++ )
+	{
+		isLocked[ vertexNum ] = verticesAtPosition[ positionRemap[ vertexNum ] ] > 1;
+	}
+
+	for ( auto const& edge : directedEdges )
+	{
+		uint from = static_cast< uint >( edge.first >> 32 );
+		uint to   = static_cast< uint >( edge.first & 0xFFFFFFFF );
+		if ( directedEdges.find( GetEdgeKey( to, from ) ) == directedEdges.end() )
+		{
+			isLocked[ from ] = true;
+			isLocked[ to ]   = true;
+		}
+	}
+
+	double reachedCost = 0.0;
+	std::vector<uint>         collapseRemap( vertexCount );
+	std::vector<bool>         isTouched( vertexCount );
+	std::vector<uint>         adjacencyOffsets( vertexCount + 1 );
+	std::vector<uint>         adjacentTriangles;
+	std::vector<EdgeCollapse> collapses;
+
+	while ( outIndices.size() > targetIndexCount )
+	{
+		size_t numTriangles = outIndices.size() / 3;
+
+		// Vertex -> triangle adjacency, used by the flip test
+		std::fill( adjacencyOffsets.begin(), adjacencyOffsets.end(), 0 );
+		for ( uint index : outIndices )
+		{
+			adjacencyOffsets[ index + 1 ]++;
+		}
+		for ( size_t vertexNum = 0; vertexNum < vertexCount; vertexNum++ )
+		{
+			adjacencyOffsets[ vertexNum + 1 ] += adjacencyOffsets[ vertexNum ];
+		}
+		adjacentTriangles.resize( outIndices.size() );
+		std::vector<uint> fillCounts( vertexCount, 0 );
+		for ( size_t triangleNum = 0; triangleNum < numTriangles; triangleNum++ )
+		{
+			for ( int cornerNum = 0; cornerNum < 3; cornerNum++ )
+			{
+				uint vertex = outIndices[ triangleNum * 3 + cornerNum ];
+				adjacentTriangles[ adjacencyOffsets[ vertex ] + fillCounts[ vertex ]++ ] = static_cast< uint >( triangleNum );
+			}
+		}
+
+		collapses.clear();
+		for ( size_t triangleNum = 0; triangleNum < numTriangles; triangleNum++ )
+		{
+			for ( int cornerNum = 0; cornerNum < 3; cornerNum++ )
+			{
+				uint from = outIndices[ triangleNum * 3 + cornerNum ];
+				uint to   = outIndices[ triangleNum * 3 + ( cornerNum + 1 ) % 3 ];
+				if ( isLocked[ from ] || positionRemap[ from ] == positionRemap[ to ] )
+					continue;
+
+				Quadric combined = quadrics[ positionRemap[ from ] ];
+				combined.Add( quadrics[ positionRemap[ to ] ] );
+
+				EdgeCollapse collapse;
+				collapse.m_from = from;
+				collapse.m_to   = to;
+				collapse.m_cost = combined.Evaluate( verts[ to ].m_position );
+				if ( collapse.m_cost <= maxCost )
+				{
+					collapses.push_back( collapse );
+				}
+			}
+		}
+
+		if ( collapses.empty() )
+			break;
+
+		std::sort( collapses.begin(), collapses.end(), []( EdgeCollapse const& collapseA, EdgeCollapse const& collapseB )
+		{
+			return collapseA.m_cost < collapseB.m_cost;
+		} );
+
+		for ( size_t vertexNum = 0; vertexNum < vertexCount; vertexNum++ )
+		{
+			collapseRemap[ vertexNum ] = static_cast< uint >( vertexNum );
+		}
+		std::fill( isTouched.begin(), isTouched.end(), false );
+
+		// Each collapse removes about two triangles; stop the pass once enough are queued to hit the target
+		size_t trianglesToRemove  = ( numTriangles - targetIndexCount / 3 );
+		size_t trianglesRemoved   = 0;
+		size_t numCollapses       = 0;
+
+		for ( EdgeCollapse const& collapse : collapses )
+		{
+			if ( trianglesRemoved >= trianglesToRemove )
+				break;
+
+			if ( isTouched[ collapse.m_from ] || isTouched[ collapse.m_to ] )
+				continue;
+
+			Vec3 const& targetPosition = verts[ collapse.m_to ].m_position;
+			bool        flipsTriangle  = false;
+
+			for ( uint adjacentNum = adjacencyOffsets[ collapse.m_from ]; adjacentNum < adjacencyOffsets[ collapse.m_from + 1 ]; adjacentNum++ )
+			{
+				uint const* triangle = &outIndices[ adjacentTriangles[ adjacentNum ] * 3 ];
+				bool containsTarget = positionRemap[ triangle[ 0 ] ] == positionRemap[ collapse.m_to ] || positionRemap[ triangle[ 1 ] ] == positionRemap[ collapse.m_to ] || positionRemap[ triangle[ 2 ] ] == positionRemap[ collapse.m_to ];
+				if ( containsTarget )
+					continue;
+
+				Vec3 corners[ 3 ];
+				Vec3 movedCorners[ 3 ];
+				for ( int cornerNum = 0; cornerNum < 3; cornerNum++ )
+				{
+					corners[ cornerNum ]      = verts[ triangle[ cornerNum ] ].m_position;
+					movedCorners[ cornerNum ] = triangle[ cornerNum ] == collapse.m_from ? targetPosition : corners[ cornerNum ];
+				}
+
+				Vec3 normalBefore = CrossProduct3D( corners[ 1 ] - corners[ 0 ], corners[ 2 ] - corners[ 0 ] );
+				Vec3 normalAfter  = CrossProduct3D( movedCorners[ 1 ] - movedCorners[ 0 ], movedCorners[ 2 ] - movedCorners[ 0 ] );
+				if ( DotProduct3D( normalBefore, normalAfter ) <= 0.25f * normalBefore.GetLength() * normalAfter.GetLength() )
+				{
+					flipsTriangle = true;
+					break;
+				}
+			}
+
+			if ( flipsTriangle )
+				continue;
+
+			collapseRemap[ collapse.m_from ] = collapse.m_to;
+			quadrics[ positionRemap[ collapse.m_to ] ].Add( quadrics[ positionRemap[ collapse.m_from ] ] );
+			reachedCost = collapse.m_cost > reachedCost ? collapse.m_cost : reachedCost;
+
+			// Lock the whole one ring for the rest of this pass so queued costs stay valid
+			for ( uint adjacentNum = adjacencyOffsets[ collapse.m_from ]; adjacentNum < adjacencyOffsets[ collapse.m_from + 1 ]; adjacentNum++ )
+			{
+				uint const* triangle = &outIndices[ adjacentTriangles[ adjacentNum ] * 3 ];
+				isTouched[ triangle[ 0 ] ] = true;
+				isTouched[ triangle[ 1 ] ] = true;
+				isTouched[ triangle[ 2 ] ] = true;
+			}
+			isTouched[ collapse.m_to ] = true;
+
+			trianglesRemoved += 2;
+			numCollapses++;
+		}
+
+		if ( numCollapses == 0 )
+			break;
+
+		std::vector<uint> collapsedIndices;
+		collapsedIndices.reserve( outIndices.size() );
+		for ( size_t triangleNum = 0; triangleNum < numTriangles; triangleNum++ )
+		{
+			uint vertexA = collapseRemap[ outIndices[ triangleNum * 3 ] ];
+			uint vertexB = collapseRemap[ outIndices[ triangleNum * 3 + 1 ] ];
+			uint vertexC = collapseRemap[ outIndices[ triangleNum * 3 + 2 ] ];
+			if ( positionRemap[ vertexA ] == positionRemap[ vertexB ] || positionRemap[ vertexB ] == positionRemap[ vertexC ] || positionRemap[ vertexA ] == positionRemap[ vertexC ] )
+				continue;
+
+			collapsedIndices.push_back( vertexA );
+			collapsedIndices.push_back( vertexB );
+			collapsedIndices.push_back( vertexC );
+		}
+		outIndices.swap( collapsedIndices );
+	}
+
+	return boundsDiagonal > 0.0f ? static_cast< float >( sqrt( reachedCost ) ) / boundsDiagonal : 0.0f;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Renderer/VertexData/Vertex_PCUTBN.hpp"
+
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr uint  FORSYTH_CACHE_SIZE          = 32;		// LRU size the triangle reorder scores against
+constexpr uint  VERTEX_CACHE_STATS_SIZE     = 16;		// FIFO size used to report ACMR / ATVR
+constexpr float OVERDRAW_CLUSTER_THRESHOLD  = 1.05f;	// max ACMR growth accepted when splitting clusters for overdraw
+constexpr float SIMPLIFY_MAX_ERROR          = 0.02f;	// max quadric error per LOD as a fraction of the mesh bounds diagonal
+
+
+//-----------------------------------------------------------------------------------------------
+struct VertexCacheStats
+{
+	float m_acmr = 0.0f;	// average cache miss ratio - transformed vertices per triangle ( 0.5 - 3.0 )
+	float m_atvr = 0.0f;	// average transformed vertex ratio - transformed vertices per unique vertex ( 1.0 is ideal )
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct MeshOptimizationReport
+{
+	VertexCacheStats m_before;
+	VertexCacheStats m_after;
+	uint             m_numTriangleListVerts = 0;
+	uint             m_numUniqueVerts       = 0;
+	uint             m_numOverdrawClusters  = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+VertexCacheStats AnalyzeVertexCache( std::vector<uint> const& indices, size_t vertexCount, uint cacheSize = VERTEX_CACHE_STATS_SIZE );
+
+void BuildIndexedMesh( std::vector<Vertex_PCUTBN> const& triangleList, std::vector<Vertex_PCUTBN>& outVerts, std::vector<uint>& outIndices );
+void OptimizeVertexCache( std::vector<uint>& indices, size_t vertexCount );
+uint OptimizeOverdraw( std::vector<uint>& indices, std::vector<Vertex_PCUTBN> const& verts, float threshold = OVERDRAW_CLUSTER_THRESHOLD );
+void OptimizeVertexFetch( std::vector<Vertex_PCUTBN>& verts, std::vector<uint>& indices );
+
+// Quadric error edge collapse onto existing vertices; outIndices reference the same verts. Returns the error reached relative to the bounds diagonal
+float SimplifyMesh( std::vector<Vertex_PCUTBN> const& verts, std::vector<uint> const& indices, size_t targetIndexCount, float maxError, std::vector<uint>& outIndices );
+
+MeshOptimizationReport OptimizeMesh( std::vector<Vertex_PCUTBN> const& triangleList, std::vector<Vertex_PCUTBN>& outVerts, std::vector<uint>& outIndices );
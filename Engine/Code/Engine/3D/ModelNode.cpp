@@ -40,6 +40,14 @@ std::vector<ModelNode*> const& ModelNode::GetChildren()
 }
 
 
+//------------------------------------------------------------------------------------------------
+void ModelNode::AddChild( ModelNode* child )
+{
+	child->m_parent = this;
+	m_children.push_back( child );
+}
+
+
 //------------------------------------------------------------------------------------------------
 Mat44 ModelNode::GetLocalToParentTransform() const
 {
@@ -47,6 +55,13 @@ Mat44 ModelNode::GetLocalToParentTransform() const
 }
 
 
+//------------------------------------------------------------------------------------------------
+void ModelNode::SetLocalToParentTransform( Mat44 const& transformMat )
+{
+	m_localToParent = transformMat;
+}
+
+
 //------------------------------------------------------------------------------------------------
 ModelNode* ModelNode::GetInstance()
 {
@@ -58,9 +73,7 @@ ModelNode* ModelNode::GetInstance()
 
 	for ( uint nodeNum = 0; nodeNum < m_children.size(); nodeNum++ )
 	{
-		ModelNode* child = m_children[ nodeNum ]->GetInstance();
-		child->m_parent = node;
-		node->m_children.push_back( child );
+		node->AddChild( m_children[ nodeNum ]->GetInstance() );
 	}
 
 	return node;
@@ -81,6 +94,44 @@ void ModelNode::SetLocalToWorldTransform( Mat44 transformMat )
 }
 
 
+//------------------------------------------------------------------------------------------------
+// Only touches this hierarchy and the caller's bounds, so separate instances can update on separate threads
+//
+void ModelNode::UpdateWorldTransforms( Mat44 const& parentToWorld, AABB3& out_worldBounds, bool& out_hasBounds )
+{
+	m_localToWorld = parentToWorld;
+	m_localToWorld.Append( m_localToParent );
+
+	if ( m_nodeType == NodeType::Geometry )
+	{
+		AABB3 nodeBounds = AsGeometryNode()->GetLocalBounds().GetTransformed( m_localToWorld );
+		if ( !out_hasBounds )
+		{
+			out_worldBounds = nodeBounds;
+			out_hasBounds = true;
+		}
+		else
+		{
+			out_worldBounds.StretchToIncludePoint( nodeBounds.m_mins );
+			out_worldBounds.StretchToIncludePoint( nodeBounds.m_maxs );
+		}
+	}
+
+	for ( ModelNode* childNode : m_children )
+	{
+		childNode->UpdateWorldTransforms( m_localToWorld, out_worldBounds, out_hasBounds );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+GeometryNode::GeometryNode( uint vertDataID ) :
+	m_vertDataID( vertDataID )
+{
+	m_nodeType = NodeType::Geometry;
+}
+
+
 ////------------------------------------------------------------------------------------------------
 //Material* GeometryNode::GetMaterial() const
 //{
@@ -95,6 +146,27 @@ VertexBuffer* GeometryNode::GetVertexBuffer() const
 }
 
 
+//------------------------------------------------------------------------------------------------
+VertexBuffer* GeometryNode::GetPositionVertexBuffer() const
+{
+	return g_theVisualDatabase->m_meshData[ m_vertDataID ].m_positionVBO;
+}
+
+
+//------------------------------------------------------------------------------------------------
+VertexBuffer* GeometryNode::GetAttributeVertexBuffer() const
+{
+	return g_theVisualDatabase->m_meshData[ m_vertDataID ].m_attributeVBO;
+}
+
+
+//------------------------------------------------------------------------------------------------
+IndexBuffer* GeometryNode::GetIndexBuffer() const
+{
+	return g_theVisualDatabase->m_meshData[ m_vertDataID ].m_ibo;
+}
+
+
 //------------------------------------------------------------------------------------------------
 Vertex_PCUTBN* GeometryNode::GetVertexArray() const
 {
@@ -109,6 +181,44 @@ uint GeometryNode::GetVertexCount() const
 }
 
 
+//------------------------------------------------------------------------------------------------
+uint GeometryNode::GetIndexCount() const
+{
+	return g_theVisualDatabase->m_meshData[ m_vertDataID ].m_indexCount;
+}
+
+
+//------------------------------------------------------------------------------------------------
+uint GeometryNode::GetNumLODs() const
+{
+	return static_cast< uint >( g_theVisualDatabase->m_meshData[ m_vertDataID ].m_lods.size() );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Requests past the end of a mesh's chain fall back to its coarsest LOD
+//
+MeshLOD const& GeometryNode::GetLOD( uint lodNum ) const
+{
+	std::vector<MeshLOD> const& lods = g_theVisualDatabase->m_meshData[ m_vertDataID ].m_lods;
+	return lodNum < lods.size() ? lods[ lodNum ] : lods.back();
+}
+
+
+//------------------------------------------------------------------------------------------------
+AABB3 const& GeometryNode::GetLocalBounds() const
+{
+	return g_theVisualDatabase->m_meshData[ m_vertDataID ].m_bounds;
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool GeometryNode::HasPackedVertices() const
+{
+	return g_theVisualDatabase->m_meshData[ m_vertDataID ].m_isPacked;
+}
+
+
 //------------------------------------------------------------------------------------------------
 ModelNode* GeometryNode::GetInstance()
 {
@@ -122,9 +232,7 @@ ModelNode* GeometryNode::GetInstance()
 	
 	for ( uint nodeNum = 0; nodeNum < m_children.size(); nodeNum++ )
 	{
-		ModelNode* child = m_children[ nodeNum ]->GetInstance();
-		child->m_parent = node;
-		node->m_children.push_back( child );
+		node->AddChild( m_children[ nodeNum ]->GetInstance() );
 	}
 
 	return node;
@@ -2,6 +2,7 @@
 #include "Engine/3D/FBXLoader.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Renderer/VertexData/Vertex_PCUTBN.hpp"
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/Mat44.hpp"
 
 #include <string>
@@ -10,11 +11,13 @@
 
 //------------------------------------------------------------------------------------------------
 class GeometryNode;
+class IndexBuffer;
 class Model;
 class VertexBuffer;
 
 struct Camera;
 struct Material;
+struct MeshLOD;
 
 
 //------------------------------------------------------------------------------------------------
@@ -54,11 +57,18 @@ public:
 
 	std::vector<ModelNode*> const& GetChildren();
 
+	void                           AddChild( ModelNode* child );
+
 	Mat44                          GetLocalToParentTransform() const;
+	void                           SetLocalToParentTransform( Mat44 const& transformMat );
 					               
 	Mat44                          GetLocalToWorldTransform() const;
 	void                           SetLocalToWorldTransform( Mat44 transformMat );
 
+	// Recomputes this node's and its descendants' local to world transforms under parentToWorld and
+	// stretches out_worldBounds around every geometry node; out_hasBounds must start false
+	void                           UpdateWorldTransforms( Mat44 const& parentToWorld, AABB3& out_worldBounds, bool& out_hasBounds );
+
 public:
 	NodeType    m_nodeType = NodeType::Base;
 	std::string m_nodeName;
@@ -72,10 +82,21 @@ class GeometryNode : public ModelNode
 	friend class Model;
 
 public:
+	GeometryNode() {}
+	explicit GeometryNode( uint vertDataID );
+
 	//Material*       GetMaterial() const;
 	VertexBuffer*   GetVertexBuffer() const;
+	VertexBuffer*   GetPositionVertexBuffer() const;
+	VertexBuffer*   GetAttributeVertexBuffer() const;
+	IndexBuffer*    GetIndexBuffer() const;
 	Vertex_PCUTBN*  GetVertexArray() const;
 	uint            GetVertexCount() const;
+	uint            GetIndexCount() const;
+	uint            GetNumLODs() const;
+	MeshLOD const&  GetLOD( uint lodNum ) const;
+	AABB3 const&    GetLocalBounds() const;
+	bool            HasPackedVertices() const;
 
 protected:
 	ModelNode*      GetInstance() override;
@@ -3,10 +3,13 @@
 #include "Engine/3D/Material.hpp"
 #include "Engine/3D/Model.hpp"
 #include "Engine/3D/FBXLoader.hpp"
+#include "Engine/3D/MeshOptimizer.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/Shader.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
+#include "Engine/Renderer/VertexData/Vertex_PackedPUTBN.hpp"
 
 
 //------------------------------------------------------------------------------------------------
@@ -271,6 +274,12 @@ void VisualDatabase::Shutdown()
 	{
 		g_theRenderer->DestroyVertexBuffer( m_meshData[ meshNum ].m_vbo );
 		m_meshData[ meshNum ].m_vbo = nullptr;
+		g_theRenderer->DestroyVertexBuffer( m_meshData[ meshNum ].m_positionVBO );
+		m_meshData[ meshNum ].m_positionVBO = nullptr;
+		g_theRenderer->DestroyVertexBuffer( m_meshData[ meshNum ].m_attributeVBO );
+		m_meshData[ meshNum ].m_attributeVBO = nullptr;
+		g_theRenderer->DestroyIndexBuffer( m_meshData[ meshNum ].m_ibo );
+		m_meshData[ meshNum ].m_ibo = nullptr;
 	}
 
 	for ( int modelNum = 0; modelNum < m_modelData.m_models.size(); modelNum++ )
@@ -527,17 +536,117 @@ uint VisualDatabase::CreateOrGetVertsFromFBX( FbxNode* node, char const* filepat
 		}
 	}
 
+	MeshOptimizationReport report = OptimizeMesh( meshVerts, data.m_mesh, data.m_indices );
+	DebuggerPrintf( "Mesh %s: %u -> %u verts, %u overdraw clusters, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+					name.c_str(), report.m_numTriangleListVerts, report.m_numUniqueVerts, report.m_numOverdrawClusters,
+					report.m_before.m_acmr, report.m_after.m_acmr, report.m_before.m_atvr, report.m_after.m_atvr );
+
+	if ( !data.m_mesh.empty() )
+	{
+		data.m_bounds = AABB3( data.m_mesh[ 0 ].m_position, data.m_mesh[ 0 ].m_position );
+		for ( Vertex_PCUTBN const& vertex : data.m_mesh )
+		{
+			data.m_bounds.StretchToIncludePoint( vertex.m_position );
+		}
+	}
+
+	data.m_vertexCount = static_cast< uint >( data.m_mesh.size() );
+	data.m_indexCount  = static_cast< uint >( data.m_indices.size() );
+
+	CreateMeshLODs( data );
+
+	if ( m_config.m_usePackedVertices )
+	{
+		CreatePackedVertexStreams( data );
+	}
+	else
+	{
+		data.m_vbo = g_theRenderer->CreateDynamicVertexBuffer( sizeof( Vertex_PCUTBN ) );
+		data.m_vbo->CopyVertexData( data.m_mesh.data(), data.m_mesh.size() * sizeof( Vertex_PCUTBN ), sizeof( Vertex_PCUTBN ) );
+	}
+
+	data.m_ibo = g_theRenderer->CreateIndexBuffer();
+	data.m_ibo->CopyIndexData( data.m_indices.data(), data.m_indices.size() );
 
-	data.m_vbo = g_theRenderer->CreateDynamicVertexBuffer( sizeof( Vertex_PCUTBN ) );
-	data.m_mesh = meshVerts;
-	data.m_vbo->CopyVertexData( meshVerts.data(), meshVerts.size() * sizeof( Vertex_PCUTBN ), sizeof( Vertex_PCUTBN ) );
-	data.m_vertexCount = static_cast< uint >( meshVerts.size() );
 	m_meshData.push_back( data );
 
 	return data.m_id;
 }
 
 
+//------------------------------------------------------------------------------------------------
+// Each LOD is simplified from the previous one and shares LOD0's vertices; the chain stops early once
+// locked seams and borders keep a level from shedding a meaningful share of its triangles
+//
+void VisualDatabase::CreateMeshLODs( MeshData& data )
+{
+	MeshLOD fullDetail;
+	fullDetail.m_indexCount = data.m_indexCount;
+	data.m_lods.push_back( fullDetail );
+
+	uint numLODs = m_config.m_numMeshLODs < MAX_MESH_LODS ? m_config.m_numMeshLODs : MAX_MESH_LODS;
+	std::vector<uint> previousIndices( data.m_indices );
+
+	for ( uint lodNum = 1; lodNum < numLODs; lodNum++ )
+	{
+		size_t targetIndexCount = ( previousIndices.size() / 6 ) * 3;
+
+		std::vector<uint> lodIndices;
+		float error = SimplifyMesh( data.m_mesh, previousIndices, targetIndexCount, SIMPLIFY_MAX_ERROR, lodIndices );
+		if ( lodIndices.empty() || lodIndices.size() * 10 > previousIndices.size() * 9 )
+		{
+			break;
+		}
+
+		OptimizeVertexCache( lodIndices, data.m_mesh.size() );
+
+		MeshLOD lod;
+		lod.m_indexOffset = static_cast< uint >( data.m_indices.size() );
+		lod.m_indexCount  = static_cast< uint >( lodIndices.size() );
+		lod.m_error       = error;
+		data.m_lods.push_back( lod );
+		data.m_indices.insert( data.m_indices.end(), lodIndices.begin(), lodIndices.end() );
+
+		previousIndices.swap( lodIndices );
+	}
+
+	MeshLOD const& coarsest = data.m_lods.back();
+	DebuggerPrintf( "Mesh %s: %u LODs, %u -> %u triangles, error %.4f\n", data.m_meshName.c_str(), static_cast< uint >( data.m_lods.size() ),
+					fullDetail.m_indexCount / 3, coarsest.m_indexCount / 3, coarsest.m_error );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// The CPU copy in m_mesh stays full precision; only the GPU buffer is quantized against m_bounds
+//
+void VisualDatabase::CreatePackedVertexStreams( MeshData& data )
+{
+	std::vector<Vertex_PackedPUTBN> packedVerts;
+	packedVerts.reserve( data.m_mesh.size() );
+
+	for ( Vertex_PCUTBN const& vertex : data.m_mesh )
+	{
+		packedVerts.push_back( Vertex_PackedPUTBN::Encode( vertex, data.m_bounds ) );
+	}
+
+	std::vector<Vertex_PackedPosition> positions;
+	std::vector<Vertex_PackedUTBN>     attributes;
+	positions.reserve( packedVerts.size() );
+	attributes.reserve( packedVerts.size() );
+	for ( Vertex_PackedPUTBN const& packedVert : packedVerts )
+	{
+		positions.push_back( packedVert.m_position );
+		attributes.push_back( packedVert.m_attributes );
+	}
+
+	data.m_isPacked = true;
+	data.m_positionVBO = g_theRenderer->CreateDynamicVertexBuffer( sizeof( Vertex_PackedPosition ) );
+	data.m_positionVBO->CopyVertexData( positions.data(), positions.size() * sizeof( Vertex_PackedPosition ), sizeof( Vertex_PackedPosition ) );
+	data.m_attributeVBO = g_theRenderer->CreateDynamicVertexBuffer( sizeof( Vertex_PackedUTBN ) );
+	data.m_attributeVBO->CopyVertexData( attributes.data(), attributes.size() * sizeof( Vertex_PackedUTBN ), sizeof( Vertex_PackedUTBN ) );
+}
+
+
 //------------------------------------------------------------------------------------------------
 //Material* VisualDatabase::GetMaterialInstance( Material* material )
 //{
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Engine/3D/MeshLOD.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Renderer/VertexData/Vertex_PCUTBN.hpp"
@@ -14,6 +15,7 @@
 //-----------------------------------------------------------------------------------------------
 class Model;
 class Shader;
+class IndexBuffer;
 class Texture;
 class VertexBuffer;
 
@@ -23,7 +25,8 @@ struct Material;
 //-----------------------------------------------------------------------------------------------
 struct VisualDatabaseConfig
 {
-
+	bool m_usePackedVertices = false;	// upload meshes as Vertex_PackedPUTBN position/attribute streams; bind the *Packed shader variants to draw them
+	uint m_numMeshLODs       = MAX_MESH_LODS;	// LOD0 plus simplified levels generated per mesh at import, each targeting half the triangles of the last
 };
 
 
@@ -33,8 +36,16 @@ struct MeshData
 	uint                       m_id = 0;
 	std::string                m_meshName;
 	VertexBuffer*              m_vbo = nullptr;
-	std::vector<Vertex_PCUTBN> m_mesh;
+	VertexBuffer*              m_positionVBO  = nullptr;	// Vertex_PackedPosition stream when packed
+	VertexBuffer*              m_attributeVBO = nullptr;	// Vertex_PackedUTBN stream when packed
+	IndexBuffer*               m_ibo          = nullptr;
+	std::vector<Vertex_PCUTBN> m_mesh;						// unique verts in fetch order
+	std::vector<uint>          m_indices;					// every LOD's cache / overdraw optimised triangle list, back to back
+	std::vector<MeshLOD>       m_lods;						// m_lods[ 0 ] is the full resolution mesh
 	uint                       m_vertexCount = 0;
+	uint                       m_indexCount  = 0;			// LOD0 only
+	AABB3                      m_bounds      = AABB3( Vec3::ZERO, Vec3::ZERO );
+	bool                       m_isPacked    = false;
 };
 
 
@@ -71,6 +82,10 @@ public:
 
 	uint       CreateOrGetVertsFromFBX( FbxNode* node, char const* filepath );
 
+private:
+	void       CreateMeshLODs( MeshData& data );
+	void       CreatePackedVertexStreams( MeshData& data );
+
 
 public:
 	VisualDatabaseConfig       m_config;
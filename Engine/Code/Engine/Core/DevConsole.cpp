@@ -4,6 +4,7 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/FrameArena.hpp"
 #include "Engine/Core/Stopwatch.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Input/InputSystem.hpp"
@@ -270,7 +271,12 @@ bool DevConsole::ClearDevConsole( EventArgs& args )
 
 	if (g_theConsole != nullptr)
 	{
+		g_theConsole->m_devConsoleLock.lock();
 		g_theConsole->m_lines.clear();
+		g_theConsole->m_firstLine = 0;
+		g_theConsole->m_numLines = 0;
+		g_theConsole->m_linesVersion++;
+		g_theConsole->m_devConsoleLock.unlock();
 		return true;
 	}
 
@@ -332,12 +338,36 @@ void DevConsole::Execute(std::string const& consoleCommandText)
 //----------------------------------------------------------------------------------------------------
 void DevConsole::AddLine(Rgba8 const& color, std::string const& text)
 {
-	DevConsoleLine newLine;
 	float time = static_cast<float>(m_consoleClock->GetTotalSeconds());
-	newLine.text = Stringf("[%0.3f][%d] %s", time, m_frameNumber, text.c_str());
-	newLine.color = color;
+	std::string lineText = Stringf("[%0.3f][%d] %s", time, m_frameNumber, text.c_str());
+
 	m_devConsoleLock.lock();
-	m_lines.push_back(newLine);
+
+	int maxLines = m_config.m_maxLines;
+	int lineIndex = 0;
+	if (m_numLines < maxLines)
+	{
+		lineIndex = (m_firstLine + m_numLines) % maxLines;
+		m_numLines++;
+	}
+	else
+	{
+		lineIndex = m_firstLine;
+		m_firstLine = (m_firstLine + 1) % maxLines;
+	}
+
+	if (lineIndex >= static_cast<int>(m_lines.size()))
+	{
+		m_lines.emplace_back();
+	}
+
+	DevConsoleLine& newLine = m_lines[lineIndex];
+	newLine.text = std::move(lineText);
+	newLine.color = color;
+	newLine.layoutVerts.clear();
+	newLine.layoutDimensions = Vec2::ZERO;
+	m_linesVersion++;
+
 	m_devConsoleLock.unlock();
 }
 
@@ -355,8 +385,8 @@ void DevConsole::Render(AABB2 const& bounds, Renderer* rendererOverrride /*= nul
 		consoleRenderer = rendererOverrride; 
 	}
 
-	std::string fontFilePath = "Data/Fonts/" + m_config.m_defaultFontName;
-	BitmapFont* font = consoleRenderer->CreateOrGetBitmapFontFromFile(fontFilePath.c_str());
+	char const* fontFilePath = FrameStringf("Data/Fonts/%s", m_config.m_defaultFontName.c_str());
+	BitmapFont* font = consoleRenderer->CreateOrGetBitmapFontFromFile(fontFilePath);
 	Render_OpenFull(bounds, *consoleRenderer, *font, m_config.m_defaultFontAspect);
 }
 
@@ -440,7 +470,8 @@ void DevConsole::Render_OpenFull(AABB2 const& bounds, Renderer& renderer, Bitmap
 	Vec2 displayDimensions = bounds.GetDimensions();
 	Vec2 lineDimension = Vec2(displayDimensions.x, displayDimensions.y / m_config.m_linesOnScreen);
 
-	std::vector<Vertex_PCU> backgroundInputVerts;
+	// Everything below is rebuilt every frame, so the vertex lists come from the frame arena
+	FrameVector<Vertex_PCU> backgroundInputVerts = MakeFrameVector<Vertex_PCU>( 6 );
 	AABB2 backgroundInputBox;
 	backgroundInputBox.m_mins = bounds.m_mins;
 	backgroundInputBox.m_maxs = bounds.m_mins + Vec2( bounds.m_maxs.x - bounds.m_mins.x, lineDimension.y * 1.5f);
@@ -449,14 +480,14 @@ void DevConsole::Render_OpenFull(AABB2 const& bounds, Renderer& renderer, Bitmap
 	renderer.DrawVertexArray( static_cast<int>(backgroundInputVerts.size()), backgroundInputVerts.data() );
 
 	renderer.BindTexture( &font.GetTexture() );
-	std::vector<Vertex_PCU> inputTextVerts;
+	FrameVector<Vertex_PCU> inputTextVerts = MakeFrameVector<Vertex_PCU>( m_activeCommand.length() * 6 );
 	float lineHeight = (backgroundInputBox.m_maxs.y - backgroundInputBox.m_mins.y) * 0.75f;
 	font.AddVertsForTextInBox2D( inputTextVerts, backgroundInputBox, lineHeight, m_activeCommand, Rgba8::WHITE, fontAspect, Vec2( 0.f, 0.5f ));
 	renderer.BindTexture(&font.GetTexture());
 	renderer.DrawVertexArray( static_cast<int>(inputTextVerts.size()), inputTextVerts.data() );
 
 	AABB2 caret;
-	std::vector<Vertex_PCU> vertsForCaret;
+	FrameVector<Vertex_PCU> vertsForCaret = MakeFrameVector<Vertex_PCU>( 6 );
 	caret.m_mins = backgroundInputBox.m_mins;
 	caret.m_maxs = backgroundInputBox.m_maxs;
 	caret.m_maxs.x = caret.m_mins.x + 0.0025f * (bounds.m_maxs.x - bounds.m_mins.x);
@@ -466,38 +497,72 @@ void DevConsole::Render_OpenFull(AABB2 const& bounds, Renderer& renderer, Bitmap
 	renderer.BindTexture( nullptr );
 	renderer.DrawVertexArray( static_cast<int>(vertsForCaret.size()), vertsForCaret.data() );
 
-	std::vector<Vertex_PCU> backgroundVerts;
+	FrameVector<Vertex_PCU> backgroundVerts = MakeFrameVector<Vertex_PCU>( 6 );
 	AABB2 backgroundBox = bounds;
 	backgroundBox.m_mins.y = backgroundInputBox.m_maxs.y;
 	AddVertsForAABB2D(backgroundVerts, backgroundBox, Rgba8(125, 125, 125, 200));
 	renderer.BindTexture(nullptr);
 	renderer.DrawVertexArray(static_cast<int>(backgroundVerts.size()), backgroundVerts.data());
 
-	int numLines = static_cast<int>(m_lines.size());
+	// The line text only changes when a line is added, so its verts are kept until then
+	m_devConsoleLock.lock();
+	if (m_visibleLinesVersion != m_linesVersion || m_visibleLinesOrigin != backgroundBox.m_mins ||
+		m_visibleLineDimension != lineDimension || m_visibleLinesFontAspect != fontAspect)
+	{
+		RebuildVisibleLineVerts(backgroundBox.m_mins, lineDimension, font, fontAspect);
+	}
+	m_devConsoleLock.unlock();
 
 	renderer.BindTexture(&font.GetTexture());
+	renderer.DrawVertexArray(static_cast<int>(m_visibleLineVerts.size()), m_visibleLineVerts.data());
+}
+
 
+//----------------------------------------------------------------------------------------------------
+// Called with m_devConsoleLock held
+//
+void DevConsole::RebuildVisibleLineVerts(Vec2 const& linesOrigin, Vec2 const& lineDimension, BitmapFont& font, float fontAspect) const
+{
 	int startLine = 0;
 	
-	if (numLines > m_config.m_linesOnScreen + 3)
+	if (m_numLines > m_config.m_linesOnScreen + 3)
 	{
-		startLine = numLines - static_cast<int>(m_config.m_linesOnScreen) - 3;
+		startLine = m_numLines - static_cast<int>(m_config.m_linesOnScreen) - 3;
 	}
 
-	std::vector<Vertex_PCU> textVerts;
-	
-	for (int lineNum = startLine; lineNum < numLines; lineNum++)
+	m_visibleLineVerts.clear();
+
+	AABB2 lineBox(Vec2::ZERO, lineDimension);
+	for (int lineNum = startLine; lineNum < m_numLines; lineNum++)
 	{
-		AABB2 boxForLine;
-		boxForLine.m_mins = backgroundBox.m_mins + Vec2(0.f, lineDimension.y * (numLines - lineNum - 1));
-		boxForLine.m_maxs = boxForLine.m_mins + lineDimension;
-		
-		Rgba8 lineColor = m_lines[lineNum].color;
-		std::string lineText = m_lines[lineNum].text;
+		DevConsoleLine const& line = GetLine(lineNum);
+		if (line.layoutDimensions != lineDimension || line.layoutFontAspect != fontAspect)
+		{
+			line.layoutVerts.clear();
+			font.AddVertsForTextInBox2D(line.layoutVerts, lineBox, lineDimension.y, line.text, line.color, fontAspect, Vec2(0.f, 0.5f));
+			line.layoutDimensions = lineDimension;
+			line.layoutFontAspect = fontAspect;
+		}
 
-		font.AddVertsForTextInBox2D(textVerts, boxForLine, lineDimension.y, lineText, lineColor, fontAspect, Vec2(0.f, 0.5f));
+		Vec3 lineOffset(linesOrigin.x, linesOrigin.y + lineDimension.y * (m_numLines - lineNum - 1), 0.f);
+		for (Vertex_PCU const& vert : line.layoutVerts)
+		{
+			m_visibleLineVerts.push_back(vert);
+			m_visibleLineVerts.back().m_position += lineOffset;
+		}
 	}
-	renderer.DrawVertexArray(static_cast<int>(textVerts.size()), textVerts.data());
-	
 
+	m_visibleLinesVersion = m_linesVersion;
+	m_visibleLinesOrigin = linesOrigin;
+	m_visibleLineDimension = lineDimension;
+	m_visibleLinesFontAspect = fontAspect;
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// lineNum counts from the oldest line still kept
+//
+DevConsoleLine const& DevConsole::GetLine(int lineNum) const
+{
+	return m_lines[(m_firstLine + lineNum) % m_config.m_maxLines];
 }
@@ -3,6 +3,7 @@
 #include "Rgba8.hpp"
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Renderer/VertexData/Vertex_PCU.hpp"
 #include <vector>
 #include <mutex>
 #include "Engine/Input/InputSystem.hpp"
@@ -24,14 +25,22 @@ struct DevConsoleConfig
 	std::string  m_defaultFontName     = "System";
 	float        m_defaultFontAspect   = 0.8f;
 	float        m_linesOnScreen       = 30.5f;
+	int          m_maxLines            = 1024;		// older lines are overwritten once this many are kept
 };
 
 
 //----------------------------------------------------------------------------------------------------
+// The layout is built once in a line sized box at the origin and only translated into place after
+// that, until the console's size or font aspect changes
+//
 struct DevConsoleLine
 {
 	std::string text = "";
 	Rgba8 color = Rgba8::BLUE;
+
+	mutable std::vector<Vertex_PCU> layoutVerts;
+	mutable Vec2                    layoutDimensions;
+	mutable float                   layoutFontAspect = 0.f;
 };
 
 
@@ -79,6 +88,8 @@ public:
 
 protected:
 	void Render_OpenFull( AABB2 const& bounds, Renderer& renderer, BitmapFont& font, float fontAspect = 1.f ) const;
+	void RebuildVisibleLineVerts( Vec2 const& linesOrigin, Vec2 const& lineDimension, BitmapFont& font, float fontAspect ) const;
+	DevConsoleLine const& GetLine( int lineNum ) const;
 
 protected:
 	DevConsoleConfig             m_config;
@@ -89,9 +100,18 @@ protected:
 
 	MouseConfig                  m_mouseConfig;
 
-	std::mutex                   m_devConsoleLock;
+	mutable std::mutex           m_devConsoleLock;
+
+	std::vector<DevConsoleLine>  m_lines;						// ring buffer of up to m_config.m_maxLines
+	int                          m_firstLine = 0;				// index of the oldest line in m_lines
+	int                          m_numLines = 0;
+	unsigned int                 m_linesVersion = 0;			// bumped whenever a line is added or cleared
 
-	std::vector<DevConsoleLine>  m_lines;
+	mutable std::vector<Vertex_PCU> m_visibleLineVerts;			// reused until any of the values below change
+	mutable unsigned int         m_visibleLinesVersion = 0xFFFFFFFF;
+	mutable Vec2                 m_visibleLinesOrigin;
+	mutable Vec2                 m_visibleLineDimension;
+	mutable float                m_visibleLinesFontAspect = 0.f;
 	std::vector<std::string>     m_commandHistory;
 	std::string                  m_activeCommand;
 
@@ -11,7 +11,10 @@ typedef unsigned int uint;
 class DevConsole;
 class EventSystem;
 class FBXLoader;
+class FrameArena;
+class JobSystem;
 class Renderer;
+class RenderThread;
 class VisualDatabase;
 
 
@@ -19,8 +22,11 @@ class VisualDatabase;
 extern DevConsole*     g_theConsole;
 extern EventSystem*    g_theEventSystem;
 extern FBXLoader*      g_theFBXLoader;
+extern FrameArena*     g_theFrameArena;
+extern JobSystem*      g_theJobSystem;
 extern NamedStrings    g_gameConfigBlackboard;
 extern Renderer*       g_theRenderer;
+extern RenderThread*   g_theRenderThread;
 extern VisualDatabase* g_theVisualDatabase;
 
 
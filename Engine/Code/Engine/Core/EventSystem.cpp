@@ -3,14 +3,40 @@
 #include "Engine/Core/NamedStrings.hpp"
 #include "Engine/Core/DevConsole.hpp"
 
+#include <algorithm>
+
 
 //------------------------------------------------------------------------------------------------
 EventSystem* g_theEventSystem = nullptr;
 
 
+//------------------------------------------------------------------------------------------------
+struct QueuedEvent
+{
+	QueuedEvent* m_next = nullptr;
+	EventID      m_id   = 0;
+	EventArgs    m_args;
+};
+
+
+//------------------------------------------------------------------------------------------------
+EventEntry const* EventSubscriptionTable::FindEntry( EventID eventID ) const
+{
+	std::vector<EventEntry>::const_iterator it = std::lower_bound( m_entries.begin(), m_entries.end(), eventID,
+		[]( EventEntry const& entry, EventID id ) { return entry.m_id < id; } );
+
+	if ( it == m_entries.end() || it->m_id != eventID )
+		return nullptr;
+
+	return &( *it );
+}
+
+
 //------------------------------------------------------------------------------------------------
 EventSystem::EventSystem(EventSystemConfig const& config):
-	m_config(config)
+	m_config(config),
+	m_subscriptionTable( std::make_shared<EventSubscriptionTable const>() ),
+	m_mainThreadID( std::this_thread::get_id() )
 {
 
 }
@@ -33,14 +59,14 @@ void EventSystem::Startup()
 //------------------------------------------------------------------------------------------------
 void EventSystem::Shutdown()
 {
-
+	DispatchQueuedEvents();
 }
 
 
 //------------------------------------------------------------------------------------------------
 void EventSystem::BeginFrame()
 {
-
+	DispatchQueuedEvents();
 }
 
 
@@ -54,33 +80,68 @@ void EventSystem::EndFrame()
 //------------------------------------------------------------------------------------------------
 void EventSystem::SubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction functionPtr)
 {
-	std::vector<EventSubscription>& subscriberListForThisEvent = m_subscriptionListsByEventName[eventName];
-	
+	EventID eventID = HashEventName( eventName.c_str() );
+
+	std::lock_guard<std::mutex> writeGuard( m_subscriptionWriteLock );
+	std::shared_ptr<EventSubscriptionTable> newTable = std::make_shared<EventSubscriptionTable>( *GetSubscriptionTable() );
+
+	std::vector<EventEntry>::iterator it = std::lower_bound( newTable->m_entries.begin(), newTable->m_entries.end(), eventID,
+		[]( EventEntry const& entry, EventID id ) { return entry.m_id < id; } );
+
+	if ( it == newTable->m_entries.end() || it->m_id != eventID )
+	{
+		EventEntry newEntry;
+		newEntry.m_id   = eventID;
+		newEntry.m_name = eventName;
+		it = newTable->m_entries.insert( it, newEntry );
+	}
+	GUARANTEE_OR_DIE( it->m_name == eventName, Stringf( "Event names \"%s\" and \"%s\" hash to the same id", it->m_name.c_str(), eventName.c_str() ) );
+
 	EventSubscription newSubscription;
 	newSubscription.m_callbackFunctionPtr = functionPtr;
-	m_eventSystemLock.lock();
-	subscriberListForThisEvent.push_back(newSubscription);
-	m_eventSystemLock.unlock();
+	it->m_subscriptions.push_back( newSubscription );
+
+	std::atomic_store( &m_subscriptionTable, std::shared_ptr<EventSubscriptionTable const>( newTable ) );
 }
 
 
 //------------------------------------------------------------------------------------------------
 void EventSystem::UnsubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction functionPtr)
 {
-	m_eventSystemLock.lock();
-	std::vector<EventSubscription>& subscriberListForThisEvent = m_subscriptionListsByEventName[eventName];
-	int numSubscriptions = static_cast<int>(subscriberListForThisEvent.size());
+	EventID eventID = HashEventName( eventName.c_str() );
 	bool isUnsubscribed = false;
 
-	for (int subscriptionNum = 0; subscriptionNum < numSubscriptions; subscriptionNum++) 
 	{
-		if (subscriberListForThisEvent[subscriptionNum].m_callbackFunctionPtr == functionPtr) 
+		std::lock_guard<std::mutex> writeGuard( m_subscriptionWriteLock );
+		std::shared_ptr<EventSubscriptionTable> newTable = std::make_shared<EventSubscriptionTable>( *GetSubscriptionTable() );
+
+		for ( size_t entryNum = 0; entryNum < newTable->m_entries.size(); entryNum++ )
 		{
-			subscriberListForThisEvent.erase(subscriberListForThisEvent.begin() + subscriptionNum);
-			isUnsubscribed = true;
+			EventEntry& entry = newTable->m_entries[ entryNum ];
+			if ( entry.m_id != eventID )
+				continue;
+
+			for ( int subscriptionNum = static_cast< int >( entry.m_subscriptions.size() ) - 1; subscriptionNum >= 0; subscriptionNum-- )
+			{
+				if ( entry.m_subscriptions[ subscriptionNum ].m_callbackFunctionPtr == functionPtr )
+				{
+					entry.m_subscriptions.erase( entry.m_subscriptions.begin() + subscriptionNum );
+					isUnsubscribed = true;
+				}
+			}
+
+			if ( entry.m_subscriptions.empty() )
+			{
+				newTable->m_entries.erase( newTable->m_entries.begin() + entryNum );
+			}
+			break;
 		}
-	}	
-	m_eventSystemLock.unlock();
+
+		if ( isUnsubscribed )
+		{
+			std::atomic_store( &m_subscriptionTable, std::shared_ptr<EventSubscriptionTable const>( newTable ) );
+		}
+	}
 
 	GUARANTEE_RECOVERABLE(isUnsubscribed, "Function Pointer not in Subscription");
 }
@@ -89,72 +150,105 @@ void EventSystem::UnsubscribeEventCallbackFunction(std::string const& eventName,
 //------------------------------------------------------------------------------------------------
 void EventSystem::FireEvent(std::string const& eventName, EventArgs& args)
 {
-	m_eventSystemLock.lock();
-	std::vector<EventSubscription>& subscriberListForThisEvent = m_subscriptionListsByEventName[eventName];
-	int numSubscriptions = static_cast<int>(subscriberListForThisEvent.size());
+	EventID eventID = HashEventName( eventName.c_str() );
+	if ( !IsMainThread() )
+	{
+		QueueEvent( eventID, args );
+		return;
+	}
 
-	if (numSubscriptions == 0)
+	if ( !DispatchEvent( eventID, args ) )
 	{
 		if(g_theConsole != nullptr)
 			g_theConsole->AddLine(DevConsole::ERROR, Stringf("Invalid Command: %s",eventName.c_str()));
 	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+void EventSystem::FireEvent(std::string const& eventName)
+{
+	EventArgs args;
+	FireEvent(eventName, args);
+}
+
 
-	for (int subscriptionNum = 0; subscriptionNum < numSubscriptions; subscriptionNum++) 
+//------------------------------------------------------------------------------------------------
+void EventSystem::FireEvent( EventID eventID, EventArgs& args )
+{
+	if ( !IsMainThread() )
 	{
-		EventSubscription& subscription = subscriberListForThisEvent[subscriptionNum];
-		if (subscription.m_callbackFunctionPtr) 
-		{
-			subscription.m_numTimesTriggered++;
-			
-			bool wasConsumed = subscription.m_callbackFunctionPtr(args);
-			if (wasConsumed) 
-			{
-				break;
-			}
-		}
+		QueueEvent( eventID, args );
+		return;
 	}
-	m_eventSystemLock.unlock();
+
+	DispatchEvent( eventID, args );
 }
 
 
 //------------------------------------------------------------------------------------------------
-void EventSystem::FireEvent(std::string const& eventName)
+void EventSystem::FireEvent( EventID eventID )
 {
 	EventArgs args;
-	FireEvent(eventName, args);
+	FireEvent( eventID, args );
 }
 
 
 //------------------------------------------------------------------------------------------------
-bool EventSystem::ListValidEventsForHelp( EventArgs& args )
+// The whole queue is taken at once; pushes are newest first, so it is reversed to dispatch in order
+//
+void EventSystem::DispatchQueuedEvents()
 {
-	std::string filter = args.GetValue( "filter", "" );
-	
-	std::map<std::string, SubscriptionList>::iterator it;
+	QueuedEvent* newestEvent = m_queuedEvents.exchange( nullptr, std::memory_order_acquire );
 
-	g_theConsole->AddLine( DevConsole::INFO_MINOR, "List of Available Commands:" );
+	QueuedEvent* oldestEvent = nullptr;
+	while ( newestEvent )
+	{
+		QueuedEvent* nextEvent = newestEvent->m_next;
+		newestEvent->m_next = oldestEvent;
+		oldestEvent = newestEvent;
+		newestEvent = nextEvent;
+	}
 
-	for (it = g_theEventSystem->m_subscriptionListsByEventName.begin(); it != g_theEventSystem->m_subscriptionListsByEventName.end(); it++)
+	while ( oldestEvent )
 	{
-		if (filter == "")
-		{
-			if (it->second.size() > 0) 
-			{
-				g_theConsole->AddLine( DevConsole::INFO_MINOR, it->first );
-			}
-		}
+		QueuedEvent* queuedEvent = oldestEvent;
+		oldestEvent = oldestEvent->m_next;
+
+		DispatchEvent( queuedEvent->m_id, queuedEvent->m_args );
+		delete queuedEvent;
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+std::shared_ptr<EventSubscriptionTable const> EventSystem::GetSubscriptionTable() const
+{
+	return std::atomic_load( &m_subscriptionTable );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// The table is held for the whole dispatch, so callbacks can fire events and ( un )subscribe freely;
+// a callback unsubscribed by an earlier one in the same dispatch is still called this time
+//
+bool EventSystem::DispatchEvent( EventID eventID, EventArgs& args ) const
+{
+	std::shared_ptr<EventSubscriptionTable const> table = GetSubscriptionTable();
+	EventEntry const* entry = table->FindEntry( eventID );
+	if ( entry == nullptr || entry->m_subscriptions.empty() )
+		return false;
 
-		else
+	for ( EventSubscription const& subscription : entry->m_subscriptions )
+	{
+		if ( subscription.m_callbackFunctionPtr )
 		{
-			if (it->first.find( filter ) != std::string::npos)
+			bool wasConsumed = subscription.m_callbackFunctionPtr( args );
+			if ( wasConsumed )
 			{
-				if (it->second.size() > 0)
-				{
-					g_theConsole->AddLine( DevConsole::INFO_MINOR, it->first );
-				}
+				break;
 			}
 		}
-
 	}
 
 	return true;
@@ -162,18 +256,60 @@ bool EventSystem::ListValidEventsForHelp( EventArgs& args )
 
 
 //------------------------------------------------------------------------------------------------
-bool EventSystem::IsValidEvent( std::string eventName )
+void EventSystem::QueueEvent( EventID eventID, EventArgs const& args )
+{
+	QueuedEvent* queuedEvent = new QueuedEvent();
+	queuedEvent->m_id   = eventID;
+	queuedEvent->m_args = args;
+
+	QueuedEvent* head = m_queuedEvents.load( std::memory_order_relaxed );
+	do
+	{
+		queuedEvent->m_next = head;
+	}
+	while ( !m_queuedEvents.compare_exchange_weak( head, queuedEvent, std::memory_order_release, std::memory_order_relaxed ) );
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool EventSystem::IsMainThread() const
+{
+	return std::this_thread::get_id() == m_mainThreadID;
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool EventSystem::ListValidEventsForHelp( EventArgs& args )
 {
-	std::map<std::string, SubscriptionList>::iterator it;
-	for (it = m_subscriptionListsByEventName.begin(); it != m_subscriptionListsByEventName.end(); it++)
+	std::string filter = args.GetValue( "filter", "" );
+
+	std::shared_ptr<EventSubscriptionTable const> table = g_theEventSystem->GetSubscriptionTable();
+	std::vector<std::string> eventNames;
+	for ( EventEntry const& entry : table->m_entries )
 	{
-		if (it->first == eventName && it->second.size() > 0)
+		if ( !entry.m_subscriptions.empty() && ( filter == "" || entry.m_name.find( filter ) != std::string::npos ) )
 		{
-			return true;
+			eventNames.push_back( entry.m_name );
 		}
 	}
+	std::sort( eventNames.begin(), eventNames.end() );
+
+	g_theConsole->AddLine( DevConsole::INFO_MINOR, "List of Available Commands:" );
+
+	for ( std::string const& eventName : eventNames )
+	{
+		g_theConsole->AddLine( DevConsole::INFO_MINOR, eventName );
+	}
 
-	return false;
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool EventSystem::IsValidEvent( std::string eventName )
+{
+	EventEntry const* entry = GetSubscriptionTable()->FindEntry( HashEventName( eventName.c_str() ) );
+	return entry != nullptr && !entry->m_subscriptions.empty();
 }
 
 
@@ -215,3 +351,23 @@ void FireEvent(std::string const& eventName)
 		g_theEventSystem->FireEvent(eventName);
 	}
 }
+
+
+//------------------------------------------------------------------------------------------------
+void FireEvent( EventID eventID, EventArgs& args )
+{
+	if ( g_theEventSystem )
+	{
+		g_theEventSystem->FireEvent( eventID, args );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+void FireEvent( EventID eventID )
+{
+	if ( g_theEventSystem )
+	{
+		g_theEventSystem->FireEvent( eventID );
+	}
+}
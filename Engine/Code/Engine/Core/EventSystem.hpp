@@ -1,9 +1,13 @@
 #pragma once
 #include "Engine/Core/EngineCommon.hpp"
-#include <vector>
+#include "Engine/Core/StringUtils.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
-#include <map>
 #include <string>
+#include <thread>
+#include <vector>
 
 
 //------------------------------------------------------------------------------------------------
@@ -17,12 +21,22 @@ struct EventSystemConfig
 class NamedStrings;
 typedef NamedStrings EventArgs;
 typedef bool (*EventCallbackFunction)(EventArgs& args);
+typedef uint64_t EventID;
+
+
+//------------------------------------------------------------------------------------------------
+// Usable as a compile time constant:
+//	static constexpr EventID QUIT_EVENT = HashEventName( "Quit" );
+//
+constexpr EventID HashEventName( char const* eventName )
+{
+	return HashName( eventName );
+}
 
 
 //------------------------------------------------------------------------------------------------
 struct EventSubscription
 {
-	int m_numTimesTriggered = 0;
 	EventCallbackFunction m_callbackFunctionPtr = nullptr;
 };
 
@@ -32,7 +46,35 @@ typedef std::vector<EventSubscription> SubscriptionList;
 
 
 //------------------------------------------------------------------------------------------------
-class EventSystem 
+struct EventEntry
+{
+	EventID          m_id = 0;
+	std::string      m_name;					// kept for the console's help listing and collision checks
+	SubscriptionList m_subscriptions;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Never modified once published. Subscribing builds and publishes a changed copy, so dispatch reads
+// whichever table was current when it started without taking a lock
+//
+struct EventSubscriptionTable
+{
+	EventEntry const* FindEntry( EventID eventID ) const;
+
+	std::vector<EventEntry> m_entries;			// sorted by m_id
+};
+
+
+//------------------------------------------------------------------------------------------------
+struct QueuedEvent;
+
+
+//------------------------------------------------------------------------------------------------
+// Events fired off the main thread are pushed onto a lock free queue and dispatched, in the order
+// they were fired, from BeginFrame on the main thread
+//
+class EventSystem
 {
 
 public:
@@ -45,17 +87,28 @@ public:
 
 	void SubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction functionPtr);
 	void UnsubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction functionPtr);
-	void FireEvent(std::string const& eventName, EventArgs& args);
+	void FireEvent(std::string const& eventName, EventArgs& args);		// console path; reports names nobody subscribed to
 	void FireEvent(std::string const& eventName);
+	void FireEvent( EventID eventID, EventArgs& args );
+	void FireEvent( EventID eventID );
+	void DispatchQueuedEvents();
 
 	static bool ListValidEventsForHelp( EventArgs& args );
 
 	bool IsValidEvent( std::string eventName );
 
 protected:
-	EventSystemConfig                       m_config;
-	std::map<std::string, SubscriptionList> m_subscriptionListsByEventName;
-	std::mutex                              m_eventSystemLock;
+	std::shared_ptr<EventSubscriptionTable const> GetSubscriptionTable() const;
+	bool                                          DispatchEvent( EventID eventID, EventArgs& args ) const;	// false when nobody subscribed
+	void                                          QueueEvent( EventID eventID, EventArgs const& args );
+	bool                                          IsMainThread() const;
+
+protected:
+	EventSystemConfig                             m_config;
+	std::shared_ptr<EventSubscriptionTable const> m_subscriptionTable;			// only touched through std::atomic_load / atomic_store
+	std::mutex                                    m_subscriptionWriteLock;		// serializes subscribers; dispatch never takes it
+	std::atomic<QueuedEvent*>                     m_queuedEvents = { nullptr };	// newest first
+	std::thread::id                               m_mainThreadID;
 
 };
 
@@ -64,4 +117,6 @@ protected:
 void SubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction functionPtr);
 void UnsubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction functionPtr);
 void FireEvent(std::string const& eventName, EventArgs& args);
-void FireEvent(std::string const& eventName);
\ No newline at end of file
+void FireEvent(std::string const& eventName);
+void FireEvent( EventID eventID, EventArgs& args );
+void FireEvent( EventID eventID );
@@ -1,7 +1,19 @@
 #include "Engine/Core/FileUtils.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
 #include <fstream>
 
+#ifdef _WIN32
+#define PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 
 //-----------------------------------------------------------------------------------------------
 bool FileReadToBuffer(std::vector<uint8_t>& outBuffer, std::string const& filename)
@@ -16,19 +28,22 @@ bool FileReadToBuffer(std::vector<uint8_t>& outBuffer, std::string const& filena
 	
 	SourceTextFile.seekg(0, std::ios::end);
 
-	int sizeOfFile = static_cast<int>(SourceTextFile.tellg()) + 1;
+	size_t sizeOfFile = static_cast<size_t>(SourceTextFile.tellg());
 
 	SourceTextFile.seekg(0, std::ios::beg);
-	outBuffer.reserve(sizeOfFile);
 
-	char charFromFile;
+	// One read straight into the buffer, keeping the trailing zero FileReadToString relies on
+	size_t startOfFile = outBuffer.size();
+	outBuffer.resize(startOfFile + sizeOfFile + 1);
+	SourceTextFile.read(reinterpret_cast<char*>(outBuffer.data() + startOfFile), static_cast<std::streamsize>(sizeOfFile));
 
-	while (SourceTextFile.get(charFromFile))
+	if (static_cast<size_t>(SourceTextFile.gcount()) != sizeOfFile)
 	{
-		outBuffer.push_back(static_cast<uint8_t>(charFromFile));
+		outBuffer.resize(startOfFile);
+		return false;
 	}
 
-	outBuffer.push_back(0);
+	outBuffer[startOfFile + sizeOfFile] = 0;
 	SourceTextFile.close();
 
 	return true;
@@ -76,3 +91,142 @@ bool StringWriteToFile( std::string& outString, std::string const& filename )
 	std::vector<uint8_t> outBuffer( outString.begin(), outString.end() );
 	return BufferWriteToFile( outBuffer, filename );
 }
+
+
+//-----------------------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool MappedFile::Open( std::string const& filename )
+{
+	Close();
+
+#if defined( PLATFORM_WINDOWS )
+
+	HANDLE fileHandle = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+	if ( fileHandle == INVALID_HANDLE_VALUE )
+		return false;
+
+	LARGE_INTEGER fileSize = {};
+	if ( !GetFileSizeEx( fileHandle, &fileSize ) || fileSize.QuadPart == 0 )
+	{
+		CloseHandle( fileHandle );
+		return false;
+	}
+
+	HANDLE mappingHandle = CreateFileMappingA( fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	if ( mappingHandle == nullptr )
+	{
+		CloseHandle( fileHandle );
+		return false;
+	}
+
+	void* view = MapViewOfFile( mappingHandle, FILE_MAP_READ, 0, 0, 0 );
+	if ( view == nullptr )
+	{
+		CloseHandle( mappingHandle );
+		CloseHandle( fileHandle );
+		return false;
+	}
+
+	m_fileHandle    = fileHandle;
+	m_mappingHandle = mappingHandle;
+	m_data          = static_cast< uint8_t const* >( view );
+	m_size          = static_cast< size_t >( fileSize.QuadPart );
+
+#else
+
+	int fileDescriptor = open( filename.c_str(), O_RDONLY );
+	if ( fileDescriptor < 0 )
+		return false;
+
+	struct stat fileStatus;
+	if ( fstat( fileDescriptor, &fileStatus ) != 0 || fileStatus.st_size == 0 )
+	{
+		close( fileDescriptor );
+		return false;
+	}
+
+	// The mapping keeps the file alive on its own
+	void* view = mmap( nullptr, static_cast< size_t >( fileStatus.st_size ), PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+	close( fileDescriptor );
+	if ( view == MAP_FAILED )
+		return false;
+
+	m_data = static_cast< uint8_t const* >( view );
+	m_size = static_cast< size_t >( fileStatus.st_size );
+
+#endif
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void MappedFile::Close()
+{
+	if ( m_data == nullptr )
+		return;
+
+#if defined( PLATFORM_WINDOWS )
+
+	UnmapViewOfFile( m_data );
+	CloseHandle( static_cast< HANDLE >( m_mappingHandle ) );
+	CloseHandle( static_cast< HANDLE >( m_fileHandle ) );
+
+#else
+
+	munmap( const_cast< uint8_t* >( m_data ), m_size );
+
+#endif
+
+	m_data          = nullptr;
+	m_size          = 0;
+	m_fileHandle    = nullptr;
+	m_mappingHandle = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void ReadFileRequestJob( void* jobData )
+{
+	FileReadRequest* request = static_cast< FileReadRequest* >( jobData );
+	request->m_buffer.clear();
+	request->m_succeeded = FileReadToBuffer( request->m_buffer, request->m_filename );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void FileReadBatch( FileReadRequest* requests, int numRequests, JobCounter* counter /*= nullptr */ )
+{
+	if ( g_theJobSystem == nullptr )
+	{
+		for ( int requestNum = 0; requestNum < numRequests; requestNum++ )
+		{
+			ReadFileRequestJob( &requests[ requestNum ] );
+		}
+		return;
+	}
+
+	std::vector<JobDecl> jobDecls( numRequests );
+	for ( int requestNum = 0; requestNum < numRequests; requestNum++ )
+	{
+		jobDecls[ requestNum ].m_function = &ReadFileRequestJob;
+		jobDecls[ requestNum ].m_jobData  = &requests[ requestNum ];
+		jobDecls[ requestNum ].m_name     = "FileRead";
+	}
+
+	if ( counter != nullptr )
+	{
+		g_theJobSystem->KickJobs( jobDecls.data(), numRequests, counter );
+		return;
+	}
+
+	JobCounter batchCounter;
+	g_theJobSystem->KickJobs( jobDecls.data(), numRequests, &batchCounter );
+	g_theJobSystem->WaitForCounter( batchCounter );
+}
@@ -5,6 +5,10 @@
 #include <vector>
 
 
+//-----------------------------------------------------------------------------------------------
+class JobCounter;
+
+
 //-----------------------------------------------------------------------------------------------
 // Will read the contents of the file to a buffer of bytes.
 bool FileReadToBuffer( std::vector<uint8_t>& outBuffer, std::string const& filename); 
@@ -20,4 +24,45 @@ bool BufferWriteToFile( std::vector<uint8_t>& outBuffer, std::string const& file
 
 
 // Similar to above, but will fill a string with the contents// returns true if file was successfully read
-bool StringWriteToFile( std::string& outString, std::string const& filename );
\ No newline at end of file
+bool StringWriteToFile( std::string& outString, std::string const& filename );
+
+
+//-----------------------------------------------------------------------------------------------
+// Read only view of a whole file, paged in by the OS on first touch instead of copied into a buffer.
+// The view stays valid until Close or destruction. Empty files fail to open
+//
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile( MappedFile const& copy ) = delete;
+	~MappedFile();
+
+	bool           Open( std::string const& filename );
+	void           Close();
+
+	bool           IsOpen() const	{ return m_data != nullptr; }
+	uint8_t const* GetData() const	{ return m_data; }
+	size_t         GetSize() const	{ return m_size; }
+
+private:
+	uint8_t const* m_data          = nullptr;
+	size_t         m_size          = 0;
+	void*          m_fileHandle    = nullptr;
+	void*          m_mappingHandle = nullptr;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct FileReadRequest
+{
+	std::string          m_filename;
+	std::vector<uint8_t> m_buffer;					// filled as FileReadToBuffer would, zero terminated
+	bool                 m_succeeded = false;
+};
+
+
+// Reads every request as its own job so the reads overlap, or in order when there is no job system.
+// Without a counter it returns once all are read; with one it returns at once and the requests must
+// stay alive until the counter is done
+void FileReadBatch( FileReadRequest* requests, int numRequests, JobCounter* counter = nullptr );
@@ -0,0 +1,82 @@
+#include "Engine/Core/FileWatcher.hpp"
+
+#include "Engine/Core/Time.hpp"
+
+
+//------------------------------------------------------------------------------------------------
+FileWatcher::FileWatcher( FileWatcherConfig const& config ) :
+	m_config( config )
+{
+}
+
+
+//------------------------------------------------------------------------------------------------
+void FileWatcher::WatchFile( std::string const& filePath )
+{
+	for ( WatchedFile const& watchedFile : m_watchedFiles )
+	{
+		if ( watchedFile.m_filePath == filePath )
+			return;
+	}
+
+	WatchedFile watchedFile;
+	watchedFile.m_filePath = filePath;
+
+	std::error_code error;
+	watchedFile.m_reportedWriteTime = std::filesystem::last_write_time( filePath, error );
+	m_watchedFiles.push_back( watchedFile );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void FileWatcher::StopWatchingAll()
+{
+	m_watchedFiles.clear();
+}
+
+
+//------------------------------------------------------------------------------------------------
+int FileWatcher::PollChangedFiles( std::vector<std::string>* out_changedFiles )
+{
+	double currentTime = GetCurrentTimeSeconds();
+	if ( currentTime - m_lastPollTime < m_config.m_pollIntervalSeconds )
+		return 0;
+
+	m_lastPollTime = currentTime;
+
+	int numChangedFiles = 0;
+	for ( WatchedFile& watchedFile : m_watchedFiles )
+	{
+		// A missing file reads as the default time, so deleting it and restoring it both count as changes
+		std::error_code error;
+		std::filesystem::file_time_type writeTime = std::filesystem::last_write_time( watchedFile.m_filePath, error );
+		if ( error )
+		{
+			writeTime = std::filesystem::file_time_type();
+		}
+
+		if ( writeTime == watchedFile.m_reportedWriteTime )
+		{
+			watchedFile.m_hasPendingChange = false;
+			continue;
+		}
+
+		if ( !watchedFile.m_hasPendingChange || writeTime != watchedFile.m_pendingWriteTime )
+		{
+			watchedFile.m_hasPendingChange = true;
+			watchedFile.m_pendingWriteTime = writeTime;
+			continue;
+		}
+
+		watchedFile.m_hasPendingChange  = false;
+		watchedFile.m_reportedWriteTime = writeTime;
+		numChangedFiles++;
+
+		if ( out_changedFiles )
+		{
+			out_changedFiles->push_back( watchedFile.m_filePath );
+		}
+	}
+
+	return numChangedFiles;
+}
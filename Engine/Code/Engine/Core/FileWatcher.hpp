@@ -0,0 +1,44 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+//------------------------------------------------------------------------------------------------
+struct FileWatcherConfig
+{
+	double m_pollIntervalSeconds = 0.25;		// wall clock, so it keeps polling while the game clock is paused
+};
+
+
+//------------------------------------------------------------------------------------------------
+struct WatchedFile
+{
+	std::string                     m_filePath;
+	std::filesystem::file_time_type m_reportedWriteTime;
+	std::filesystem::file_time_type m_pendingWriteTime;
+	bool                            m_hasPendingChange = false;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Polls last write times instead of using OS change notifications so it works the same everywhere.
+// A change is only reported once the write time held still for a whole poll, so editors that save in
+// several writes aren't read halfway through
+//
+class FileWatcher
+{
+public:
+	FileWatcher( FileWatcherConfig const& config = FileWatcherConfig() );
+
+	void WatchFile( std::string const& filePath );
+	void StopWatchingAll();
+	int  PollChangedFiles( std::vector<std::string>* out_changedFiles = nullptr );	// returns how many settled changes were found
+
+private:
+	FileWatcherConfig        m_config;
+	std::vector<WatchedFile> m_watchedFiles;
+	double                   m_lastPollTime = 0.0;
+};
@@ -0,0 +1,83 @@
+#include "Engine/Core/FixedTimestep.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <cmath>
+
+
+//------------------------------------------------------------------------------------------------
+FixedTimestep::FixedTimestep( FixedTimestepConfig const& config ) :
+	m_config( config )
+{
+	GUARANTEE_OR_DIE( m_config.m_ticksPerSecond > 0.0, "FixedTimestep needs a positive tick rate" );
+	GUARANTEE_OR_DIE( m_config.m_maxTicksPerFrame > 0, "FixedTimestep needs to allow at least one tick per frame" );
+}
+
+
+//------------------------------------------------------------------------------------------------
+int FixedTimestep::Advance( double frameDeltaSeconds )
+{
+	if ( m_config.m_isDeterministic )
+	{
+		m_accumulatedSeconds = 0.0;
+		m_ticksThisFrame     = 1;
+		m_interpolationAlpha = 1.0f;
+		m_totalTicks++;
+		return m_ticksThisFrame;
+	}
+
+	if ( frameDeltaSeconds > 0.0 )
+	{
+		m_accumulatedSeconds += frameDeltaSeconds;
+	}
+
+	double tickSeconds = GetTickSeconds();
+	int numTicks = static_cast< int >( floor( m_accumulatedSeconds / tickSeconds ) );
+	if ( numTicks > m_config.m_maxTicksPerFrame )
+	{
+		// Catching up would only make the next frame slower still; keep the fraction so alpha stays continuous
+		double droppedSeconds = static_cast< double >( numTicks - m_config.m_maxTicksPerFrame ) * tickSeconds;
+		m_droppedSeconds     += droppedSeconds;
+		m_accumulatedSeconds -= droppedSeconds;
+		numTicks = m_config.m_maxTicksPerFrame;
+	}
+
+	m_accumulatedSeconds -= static_cast< double >( numTicks ) * tickSeconds;
+	m_ticksThisFrame      = numTicks;
+	m_interpolationAlpha  = static_cast< float >( m_accumulatedSeconds / tickSeconds );
+	m_totalTicks         += static_cast< uint64_t >( numTicks );
+	return numTicks;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void FixedTimestep::Reset()
+{
+	m_accumulatedSeconds = 0.0;
+	m_droppedSeconds     = 0.0;
+	m_ticksThisFrame     = 0;
+	m_interpolationAlpha = 1.0f;
+	m_totalTicks         = 0;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void FixedTimestep::SetTicksPerSecond( double ticksPerSecond )
+{
+	if ( ticksPerSecond <= 0.0 )
+	{
+		ERROR_RECOVERABLE( "FixedTimestep tick rate must be positive" );
+		return;
+	}
+
+	m_config.m_ticksPerSecond = ticksPerSecond;
+	m_accumulatedSeconds      = 0.0;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void FixedTimestep::SetDeterministic( bool isDeterministic )
+{
+	m_config.m_isDeterministic = isDeterministic;
+	m_accumulatedSeconds       = 0.0;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+
+
+//------------------------------------------------------------------------------------------------
+struct FixedTimestepConfig
+{
+	double m_ticksPerSecond   = 60.0;
+	int    m_maxTicksPerFrame = 8;			// time beyond this many ticks is dropped instead of caught up on later
+	bool   m_isDeterministic  = false;		// one tick per frame whatever the frame took, for reproducible benchmarks
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Turns variable frame times into a whole number of fixed length simulation ticks. The time left
+// over after the last tick becomes the interpolation alpha, which the renderer uses to blend the
+// last two simulated states
+//
+class FixedTimestep
+{
+public:
+	FixedTimestep( FixedTimestepConfig const& config = FixedTimestepConfig() );
+
+	int      Advance( double frameDeltaSeconds );	// returns the number of ticks to simulate this frame
+	void     Reset();
+
+	void     SetTicksPerSecond( double ticksPerSecond );
+	void     SetDeterministic( bool isDeterministic );
+
+	double   GetTickSeconds() const				{ return 1.0 / m_config.m_ticksPerSecond; }
+	double   GetTicksPerSecond() const			{ return m_config.m_ticksPerSecond; }
+	bool     IsDeterministic() const			{ return m_config.m_isDeterministic; }
+	int      GetTicksThisFrame() const			{ return m_ticksThisFrame; }
+	float    GetInterpolationAlpha() const		{ return m_interpolationAlpha; }
+	uint64_t GetTotalTicks() const				{ return m_totalTicks; }
+	double   GetDroppedSeconds() const			{ return m_droppedSeconds; }
+
+protected:
+	FixedTimestepConfig m_config;
+	double              m_accumulatedSeconds = 0.0;
+	double              m_droppedSeconds     = 0.0;
+	int                 m_ticksThisFrame     = 0;
+	float               m_interpolationAlpha = 1.0f;
+	uint64_t            m_totalTicks         = 0;
+};
@@ -0,0 +1,260 @@
+#include "FrameArena.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//------------------------------------------------------------------------------------------------
+FrameArena* g_theFrameArena = nullptr;
+
+constexpr int    FRAME_STRINGF_STACK_LOCAL_TEMP_LENGTH = 2048;
+constexpr size_t FRAME_ARENA_BUFFER_ALIGNMENT          = 64;
+
+
+//------------------------------------------------------------------------------------------------
+FrameArena::FrameArena( FrameArenaConfig const& config ) :
+	m_config( config )
+{
+}
+
+
+//------------------------------------------------------------------------------------------------
+FrameArena::~FrameArena()
+{
+}
+
+
+//------------------------------------------------------------------------------------------------
+void FrameArena::Startup()
+{
+	ASSERT_OR_DIE( m_config.m_numFrameBuffers >= 2, "The frame arena needs at least two buffers so last frame's data survives BeginFrame" );
+	ASSERT_OR_DIE( m_config.m_bytesPerFrame > 0, "The frame arena needs a non zero buffer size" );
+
+	for ( int bufferNum = 0; bufferNum < m_config.m_numFrameBuffers; bufferNum++ )
+	{
+		FrameBuffer* buffer = new FrameBuffer();
+		buffer->m_memory = static_cast< unsigned char* >( ::operator new( m_config.m_bytesPerFrame, std::align_val_t( FRAME_ARENA_BUFFER_ALIGNMENT ) ) );
+		m_buffers.push_back( buffer );
+	}
+
+	m_currentBufferIndex.store( 0, std::memory_order_relaxed );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void FrameArena::Shutdown()
+{
+	for ( FrameBuffer* buffer : m_buffers )
+	{
+		ReleaseOverflow( *buffer );
+		::operator delete( buffer->m_memory, std::align_val_t( FRAME_ARENA_BUFFER_ALIGNMENT ) );
+		delete buffer;
+	}
+
+	m_buffers.clear();
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Rewinds the buffer used numFrameBuffers frames ago; anything still pointing into it is stale
+//
+void FrameArena::BeginFrame()
+{
+	int bufferIndex = ( m_currentBufferIndex.load( std::memory_order_relaxed ) + 1 ) % static_cast< int >( m_buffers.size() );
+
+	FrameBuffer& buffer = *m_buffers[ bufferIndex ];
+	ReleaseOverflow( buffer );
+	buffer.m_offset.store( 0, std::memory_order_relaxed );
+
+	// Published only once the buffer is rewound, so an allocating thread never sees it half reset
+	m_currentBufferIndex.store( bufferIndex, std::memory_order_release );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void FrameArena::EndFrame()
+{
+	FrameBuffer& buffer = *m_buffers[ m_currentBufferIndex.load( std::memory_order_relaxed ) ];
+
+	m_lastFrameStats.m_bytesUsed              = buffer.m_offset.load( std::memory_order_relaxed );
+	m_lastFrameStats.m_numOverflowAllocations = static_cast< int >( buffer.m_overflowBlocks.size() );
+
+	if ( m_lastFrameStats.m_bytesUsed > m_peakBytesUsed )
+	{
+		m_peakBytesUsed = m_lastFrameStats.m_bytesUsed;
+	}
+	m_lastFrameStats.m_peakBytesUsed = m_peakBytesUsed;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void* FrameArena::Allocate( size_t numBytes, size_t alignment /*= alignof( std::max_align_t ) */ )
+{
+	ASSERT_OR_DIE( ( alignment & ( alignment - 1 ) ) == 0, "Frame arena alignment must be a power of two" );
+	ASSERT_OR_DIE( !m_buffers.empty(), "Frame arena used before Startup" );
+
+	FrameBuffer& buffer = *m_buffers[ m_currentBufferIndex.load( std::memory_order_acquire ) ];
+
+	size_t offset = buffer.m_offset.load( std::memory_order_relaxed );
+	for ( ;; )
+	{
+		size_t alignedOffset = ( offset + alignment - 1 ) & ~( alignment - 1 );
+		size_t newOffset     = alignedOffset + numBytes;
+		if ( newOffset > m_config.m_bytesPerFrame )
+		{
+			return AllocateOverflow( buffer, numBytes, alignment );
+		}
+
+		if ( buffer.m_offset.compare_exchange_weak( offset, newOffset, std::memory_order_relaxed ) )
+		{
+			return buffer.m_memory + alignedOffset;
+		}
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Keeps the frame going when the buffer is undersized; the block is freed when this buffer is rewound
+//
+void* FrameArena::AllocateOverflow( FrameBuffer& buffer, size_t numBytes, size_t alignment )
+{
+	if ( alignment < alignof( std::max_align_t ) )
+	{
+		alignment = alignof( std::max_align_t );
+	}
+
+	OverflowBlock block;
+	block.m_memory    = ::operator new( numBytes, std::align_val_t( alignment ) );
+	block.m_alignment = alignment;
+
+	buffer.m_overflowLock.lock();
+	buffer.m_overflowBlocks.push_back( block );
+	buffer.m_overflowLock.unlock();
+
+	return block.m_memory;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void FrameArena::ReleaseOverflow( FrameBuffer& buffer )
+{
+	for ( OverflowBlock const& block : buffer.m_overflowBlocks )
+	{
+		::operator delete( block.m_memory, std::align_val_t( block.m_alignment ) );
+	}
+
+	buffer.m_overflowBlocks.clear();
+}
+
+
+//------------------------------------------------------------------------------------------------
+char const* FrameStringf( char const* format, ... )
+{
+	char textLiteral[ FRAME_STRINGF_STACK_LOCAL_TEMP_LENGTH ];
+	va_list variableArgumentList;
+	va_start( variableArgumentList, format );
+	vsnprintf_s( textLiteral, FRAME_STRINGF_STACK_LOCAL_TEMP_LENGTH, _TRUNCATE, format, variableArgumentList );
+	va_end( variableArgumentList );
+	textLiteral[ FRAME_STRINGF_STACK_LOCAL_TEMP_LENGTH - 1 ] = '\0';
+
+	size_t length = strlen( textLiteral );
+	FrameAllocator<char> allocator( g_theFrameArena );
+	char* frameText = allocator.allocate( length + 1 );
+	memcpy( frameText, textLiteral, length + 1 );
+	return frameText;
+}
+
+
+//------------------------------------------------------------------------------------------------
+#if defined(ENGINE_TRACK_HEAP_ALLOCATIONS)
+
+static std::atomic<uint64_t> s_numTotalHeapAllocations  = { 0 };
+static thread_local uint64_t s_numThreadHeapAllocations = 0;
+
+
+//------------------------------------------------------------------------------------------------
+void* operator new( size_t numBytes )
+{
+	s_numTotalHeapAllocations.fetch_add( 1, std::memory_order_relaxed );
+	s_numThreadHeapAllocations++;
+
+	void* memory = malloc( numBytes > 0 ? numBytes : 1 );
+	if ( memory == nullptr )
+	{
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void* operator new[]( size_t numBytes )
+{
+	return operator new( numBytes );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void operator delete( void* memory ) noexcept
+{
+	free( memory );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void operator delete[]( void* memory ) noexcept
+{
+	free( memory );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void operator delete( void* memory, size_t numBytes ) noexcept
+{
+	UNUSED( numBytes );
+	free( memory );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void operator delete[]( void* memory, size_t numBytes ) noexcept
+{
+	UNUSED( numBytes );
+	free( memory );
+}
+
+#endif
+
+
+//------------------------------------------------------------------------------------------------
+HeapAllocationScope::HeapAllocationScope()
+{
+#if defined(ENGINE_TRACK_HEAP_ALLOCATIONS)
+	m_startCount = s_numThreadHeapAllocations;
+#endif
+}
+
+
+//------------------------------------------------------------------------------------------------
+int HeapAllocationScope::GetNumAllocations() const
+{
+#if defined(ENGINE_TRACK_HEAP_ALLOCATIONS)
+	return static_cast< int >( s_numThreadHeapAllocations - m_startCount );
+#else
+	return 0;
+#endif
+}
+
+
+//------------------------------------------------------------------------------------------------
+uint64_t GetTotalHeapAllocations()
+{
+#if defined(ENGINE_TRACK_HEAP_ALLOCATIONS)
+	return s_numTotalHeapAllocations.load( std::memory_order_relaxed );
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,200 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+
+//------------------------------------------------------------------------------------------------
+struct FrameArenaConfig
+{
+	size_t m_bytesPerFrame   = 4 * 1024 * 1024;
+	int    m_numFrameBuffers = 2;		// an allocation stays valid for this many frames, so data added after EndFrame can still draw next frame
+};
+
+
+//------------------------------------------------------------------------------------------------
+struct FrameArenaStats
+{
+	size_t m_bytesUsed              = 0;
+	size_t m_peakBytesUsed          = 0;
+	int    m_numOverflowAllocations = 0;	// allocations that did not fit and went to the general heap
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Bump allocator for data that only lives for the frame it was built in. Every frame gets its own
+// buffer; BeginFrame rewinds the oldest one, so nothing is ever freed individually. Allocate is
+// lock free and may be called from any thread, BeginFrame and EndFrame only from the main thread.
+// Jobs that allocate must finish before the next BeginFrame, or their data lands in the older buffer
+//
+class FrameArena
+{
+public:
+	FrameArena( FrameArenaConfig const& config );
+	~FrameArena();
+	void Startup();
+	void Shutdown();
+	void BeginFrame();
+	void EndFrame();
+
+	void* Allocate( size_t numBytes, size_t alignment = alignof( std::max_align_t ) );
+	template <typename T>
+	T*    AllocateArray( size_t count );
+
+	FrameArenaStats const& GetLastFrameStats() const		{ return m_lastFrameStats; }
+
+private:
+	struct OverflowBlock
+	{
+		void*  m_memory    = nullptr;
+		size_t m_alignment = 0;
+	};
+
+	struct FrameBuffer
+	{
+		unsigned char*             m_memory = nullptr;
+		std::atomic<size_t>        m_offset = { 0 };
+		std::mutex                 m_overflowLock;
+		std::vector<OverflowBlock> m_overflowBlocks;
+	};
+
+	void* AllocateOverflow( FrameBuffer& buffer, size_t numBytes, size_t alignment );
+	void  ReleaseOverflow( FrameBuffer& buffer );
+
+private:
+	FrameArenaConfig          m_config;
+	std::vector<FrameBuffer*> m_buffers;
+	std::atomic<int>          m_currentBufferIndex = { 0 };	// written by BeginFrame, read by Allocate on any thread
+	FrameArenaStats           m_lastFrameStats;
+	size_t                    m_peakBytesUsed      = 0;
+};
+
+
+//------------------------------------------------------------------------------------------------
+template <typename T>
+T* FrameArena::AllocateArray( size_t count )
+{
+	static_assert( std::is_trivially_destructible<T>::value, "Frame arena memory is never destructed" );
+	return static_cast< T* >( Allocate( count * sizeof( T ), alignof( T ) ) );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// STL allocator over a frame arena. A null arena allocates from the general heap, so one container
+// type can hold both transient and persistent data. The allocator travels with the data on copy,
+// move and swap, which keeps containers of these safe to shuffle around
+//
+template <typename T>
+class FrameAllocator
+{
+public:
+	typedef T              value_type;
+	typedef std::true_type propagate_on_container_copy_assignment;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+
+	FrameAllocator() = default;
+	FrameAllocator( FrameArena* arena ) : m_arena( arena ) {}
+	template <typename U>
+	FrameAllocator( FrameAllocator<U> const& copyFrom ) : m_arena( copyFrom.GetArena() ) {}
+
+	T*   allocate( size_t count );
+	void deallocate( T* memory, size_t count );
+
+	FrameArena* GetArena() const		{ return m_arena; }
+
+private:
+	FrameArena* m_arena = nullptr;
+};
+
+
+//------------------------------------------------------------------------------------------------
+template <typename T>
+T* FrameAllocator<T>::allocate( size_t count )
+{
+	if ( m_arena != nullptr )
+	{
+		return static_cast< T* >( m_arena->Allocate( count * sizeof( T ), alignof( T ) ) );
+	}
+
+	return static_cast< T* >( ::operator new( count * sizeof( T ) ) );
+}
+
+
+//------------------------------------------------------------------------------------------------
+template <typename T>
+void FrameAllocator<T>::deallocate( T* memory, size_t count )
+{
+	UNUSED( count );
+
+	if ( m_arena == nullptr )
+	{
+		::operator delete( memory );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+template <typename T, typename U>
+bool operator==( FrameAllocator<T> const& a, FrameAllocator<U> const& b )
+{
+	return a.GetArena() == b.GetArena();
+}
+
+
+//------------------------------------------------------------------------------------------------
+template <typename T, typename U>
+bool operator!=( FrameAllocator<T> const& a, FrameAllocator<U> const& b )
+{
+	return a.GetArena() != b.GetArena();
+}
+
+
+//------------------------------------------------------------------------------------------------
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+
+//------------------------------------------------------------------------------------------------
+// Empty vector drawing from g_theFrameArena ( or the heap before the arena exists )
+//
+template <typename T>
+FrameVector<T> MakeFrameVector( size_t reserveCount = 0 )
+{
+	FrameAllocator<T> allocator( g_theFrameArena );
+	FrameVector<T>    frameVector( allocator );
+	frameVector.reserve( reserveCount );
+	return frameVector;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// printf into g_theFrameArena; the text is valid until the arena wraps back around to this frame
+//
+char const* FrameStringf( char const* format, ... );
+
+
+//------------------------------------------------------------------------------------------------
+// Counts general heap allocations ( global operator new ) made by the constructing thread while the
+// scope is alive. Transient paths that draw from the frame arena should read zero once warmed up
+//
+class HeapAllocationScope
+{
+public:
+	HeapAllocationScope();
+
+	int GetNumAllocations() const;
+
+private:
+	uint64_t m_startCount = 0;
+};
+
+
+//------------------------------------------------------------------------------------------------
+uint64_t GetTotalHeapAllocations();		// all threads, since startup; zero unless ENGINE_TRACK_HEAP_ALLOCATIONS
@@ -1,49 +1,32 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "ThirdParty/stb/stb_image.h"
 #include "Image.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "ErrorWarningAssert.hpp"
 
+#include <cstring>
+
 
 //-----------------------------------------------------------------------------------------------
+// The file is mapped rather than read, so stb decodes straight from the OS page cache
+//
 Image::Image(char const* imageFilePath):
 	m_imageFilePath(imageFilePath)
 {
-	
-	int imageTexelSizeX = 0; 
-	int imageTexelSizeY = 0; 
-	int numComponents = 0; 
-	int numComponentsRequested = 0; // don't care; we support 3 (24-bit RGB) or 4 (32-bit RGBA)
-
-	stbi_set_flip_vertically_on_load(1); // We prefer uvTexCoords has origin (0,0) at BOTTOM LEFT
-	unsigned char* imageData = stbi_load(imageFilePath, &imageTexelSizeX, &imageTexelSizeY, &numComponents, numComponentsRequested);
-	
-	GUARANTEE_OR_DIE(imageData, Stringf("Failed to load image \"%s\"", imageFilePath));
-	GUARANTEE_OR_DIE(numComponents >= 3 && numComponents <= 4 && imageTexelSizeX > 0 && imageTexelSizeY > 0, Stringf("ERROR loading image \"%s\" (Bpp=%i, size=%i,%i)", imageFilePath, numComponents, imageTexelSizeX, imageTexelSizeY));
-
-	m_dimensions = IntVec2(imageTexelSizeX, imageTexelSizeY);
-	int numTexels = imageTexelSizeX * imageTexelSizeY;
-
-	for (int texelNum = 0; texelNum < numTexels; ++texelNum) 
-	{
-		
-		unsigned char r = imageData[numComponents * texelNum];
-		unsigned char g = imageData[numComponents * texelNum + 1];
-		unsigned char b = imageData[numComponents * texelNum + 2];
-		unsigned char a = 255;
-		
-		if (numComponents == 4) 
-		{
-			a = imageData[numComponents * texelNum + 3];
-		}
+	MappedFile imageFile;
+	GUARANTEE_OR_DIE(imageFile.Open(imageFilePath), Stringf("Failed to load image \"%s\"", imageFilePath));
 
-		Rgba8 color = Rgba8(r, g, b, a);
-		m_rgbaTexels.push_back(color);
-	}
+	DecodeFromMemory(imageFile.GetData(), imageFile.GetSize());
+}
 
-	m_dimensions.x = imageTexelSizeX;
-	m_dimensions.y = imageTexelSizeY;
 
+//-----------------------------------------------------------------------------------------------
+Image::Image(char const* imageName, uint8_t const* encodedData, size_t encodedByteSize):
+	m_imageFilePath(imageName)
+{
+	DecodeFromMemory(encodedData, encodedByteSize);
 }
 
 
@@ -102,6 +85,13 @@ Rgba8 const* Image::GetRawData() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+Rgba8* Image::GetRawData()
+{
+	return m_rgbaTexels.data();
+}
+
+
 //-----------------------------------------------------------------------------------------------
 Rgba8 Image::GetTexelColor(IntVec2 const& texelCoords) const
 {
@@ -132,3 +122,50 @@ void Image::SetupAsSolidColor( int width, int height, Rgba8 const& color )
 	}
 }
 
+
+//-----------------------------------------------------------------------------------------------
+// stb is asked for RGBA directly, so its output is already laid out as Rgba8 and is copied once
+//
+void Image::DecodeFromMemory( uint8_t const* encodedData, size_t encodedByteSize )
+{
+	int imageTexelSizeX = 0; 
+	int imageTexelSizeY = 0; 
+	int numComponents = 0; 
+	int numComponentsRequested = 4; // 3 (24-bit RGB) sources get an opaque alpha from stb
+
+	stbi_set_flip_vertically_on_load_thread(1); // We prefer uvTexCoords has origin (0,0) at BOTTOM LEFT; per thread, as images decode on job workers
+	unsigned char* imageData = stbi_load_from_memory(encodedData, static_cast<int>(encodedByteSize), &imageTexelSizeX, &imageTexelSizeY, &numComponents, numComponentsRequested);
+
+	GUARANTEE_OR_DIE(imageData, Stringf("Failed to load image \"%s\"", m_imageFilePath.c_str()));
+	GUARANTEE_OR_DIE(numComponents >= 3 && numComponents <= 4 && imageTexelSizeX > 0 && imageTexelSizeY > 0, Stringf("ERROR loading image \"%s\" (Bpp=%i, size=%i,%i)", m_imageFilePath.c_str(), numComponents, imageTexelSizeX, imageTexelSizeY));
+
+	m_dimensions = IntVec2(imageTexelSizeX, imageTexelSizeY);
+	size_t numTexels = static_cast<size_t>(imageTexelSizeX) * imageTexelSizeY;
+
+	m_rgbaTexels.resize(numTexels);
+	memcpy(m_rgbaTexels.data(), imageData, numTexels * sizeof(Rgba8));
+
+	stbi_image_free(imageData);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void LoadImagesInParallel( std::vector<std::string> const& imageFilePaths, std::vector<Image>& out_images )
+{
+	int numImages = static_cast<int>(imageFilePaths.size());
+	out_images.resize(imageFilePaths.size());
+
+	if ( g_theJobSystem == nullptr )
+	{
+		for ( int imageNum = 0; imageNum < numImages; imageNum++ )
+		{
+			out_images[ imageNum ] = Image( imageFilePaths[ imageNum ].c_str() );
+		}
+		return;
+	}
+
+	g_theJobSystem->ParallelFor( numImages, 1, [ &imageFilePaths, &out_images ]( int imageNum )
+	{
+		out_images[ imageNum ] = Image( imageFilePaths[ imageNum ].c_str() );
+	} );
+}
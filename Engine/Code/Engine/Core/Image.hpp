@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Core/Rgba8.hpp"
@@ -10,6 +11,7 @@ class Image
 {
 public:
 	                      Image(char const* imageFilePath);
+	                      Image(char const* imageName, uint8_t const* encodedData, size_t encodedByteSize);	// decodes a PNG/JPG/... already in memory
 						  Image();
 					      
 	std::string const&    GetImageFilePath() const;
@@ -21,15 +23,24 @@ public:
 	int                   GetPitch() const;
 
 	Rgba8 const*		  GetRawData() const;
+	Rgba8*				  GetRawData();
 
 	Rgba8			      GetTexelColor(IntVec2 const& texelCoords) const;
 	void			      SetTexelColor(IntVec2 const& texelCoords, Rgba8 const& newColor);
 
 	void                  SetupAsSolidColor( int width, int height, Rgba8 const& color );
 
+private:
+	void                  DecodeFromMemory( uint8_t const* encodedData, size_t encodedByteSize );
+
 private:
 	std::string			  m_imageFilePath;
 	IntVec2			      m_dimensions = IntVec2(0, 0);
 	std::vector< Rgba8 >  m_rgbaTexels;
 
 };
+
+
+//-----------------------------------------------------------------------------------------------
+// One image per job on g_theJobSystem; out_images[ i ] is imageFilePaths[ i ]
+void LoadImagesInParallel( std::vector<std::string> const& imageFilePaths, std::vector<Image>& out_images );
@@ -0,0 +1,451 @@
+#include "JobSystem.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <chrono>
+
+
+//------------------------------------------------------------------------------------------------
+JobSystem* g_theJobSystem = nullptr;
+
+static thread_local int s_workerIndex = -1;
+
+// Time spent in jobs run inline ( from WaitForCounter or a full deque ) inside the job executing on this thread
+static thread_local double s_nestedJobSeconds = 0.0;
+
+
+//------------------------------------------------------------------------------------------------
+// Chase-Lev deque ( Le et al. 2013 memory orderings ). Only the owning worker pushes and pops the bottom;
+// any thread may steal from the top. A thief copies its job before claiming it and throws the copy away if the claim fails
+//
+struct JobWorker
+{
+	std::atomic<int64_t> m_top    = { 0 };
+	std::atomic<int64_t> m_bottom = { 0 };
+	Job                  m_jobs[ JOB_QUEUE_CAPACITY ];
+
+	std::atomic<int>     m_numJobsExecuted  = { 0 };
+	std::atomic<int64_t> m_busyMicroseconds = { 0 };
+	uint                 m_stealSeed        = 0;
+
+	bool Push( Job const& job )
+	{
+		int64_t bottom = m_bottom.load( std::memory_order_relaxed );
+		int64_t top    = m_top.load( std::memory_order_acquire );
+		if ( bottom - top >= JOB_QUEUE_CAPACITY )
+		{
+			return false;
+		}
+
+		m_jobs[ bottom & ( JOB_QUEUE_CAPACITY - 1 ) ] = job;
+		m_bottom.store( bottom + 1, std::memory_order_release );
+		return true;
+	}
+
+	bool Pop( Job& outJob )
+	{
+		int64_t bottom = m_bottom.load( std::memory_order_relaxed ) - 1;
+		m_bottom.store( bottom, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		int64_t top = m_top.load( std::memory_order_relaxed );
+
+		if ( top > bottom )
+		{
+			m_bottom.store( bottom + 1, std::memory_order_relaxed );
+			return false;
+		}
+
+		outJob = m_jobs[ bottom & ( JOB_QUEUE_CAPACITY - 1 ) ];
+		if ( top == bottom )
+		{
+			// Last job; race any thieves for it
+			bool isClaimed = m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+			m_bottom.store( bottom + 1, std::memory_order_relaxed );
+			return isClaimed;
+		}
+		return true;
+	}
+
+	bool Steal( Job& outJob )
+	{
+		int64_t top = m_top.load( std::memory_order_acquire );
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		int64_t bottom = m_bottom.load( std::memory_order_acquire );
+
+		if ( top >= bottom )
+		{
+			return false;
+		}
+
+		outJob = m_jobs[ top & ( JOB_QUEUE_CAPACITY - 1 ) ];
+		return m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+	}
+};
+
+
+//------------------------------------------------------------------------------------------------
+JobSystem::JobSystem( JobSystemConfig const& config ) :
+	m_config( config )
+{
+
+}
+
+
+//------------------------------------------------------------------------------------------------
+JobSystem::~JobSystem()
+{
+
+}
+
+
+//------------------------------------------------------------------------------------------------
+void JobSystem::Startup()
+{
+	int numWorkerThreads = m_config.m_numWorkerThreads;
+	if ( numWorkerThreads < 0 )
+	{
+		int hardwareThreads = static_cast< int >( std::thread::hardware_concurrency() );
+		numWorkerThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	// Worker 0 is the calling ( main ) thread
+	int numWorkers = numWorkerThreads + 1;
+	for ( int workerNum = 0; workerNum < numWorkers; workerNum++ )
+	{
+		JobWorker* worker = new JobWorker();
+		worker->m_stealSeed = static_cast< uint >( workerNum ) * 2654435761u + 1u;
+		m_workers.push_back( worker );
+	}
+	m_workerStats.resize( numWorkers );
+
+	s_workerIndex       = MAIN_THREAD_WORKER;
+	m_frameStartSeconds = GetCurrentTimeSeconds();
+	m_isQuitting        = false;
+
+	for ( int workerNum = 1; workerNum < numWorkers; workerNum++ )
+	{
+		m_threads.push_back( new std::thread( &JobSystem::WorkerThreadMain, this, workerNum ) );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+void JobSystem::Shutdown()
+{
+	m_isQuitting = true;
+	m_wakeCondition.notify_all();
+
+	for ( std::thread* thread : m_threads )
+	{
+		thread->join();
+		delete thread;
+	}
+	m_threads.clear();
+
+	for ( JobWorker* worker : m_workers )
+	{
+		delete worker;
+	}
+	m_workers.clear();
+	m_workerStats.clear();
+
+	s_workerIndex = -1;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void JobSystem::BeginFrame()
+{
+	double now          = GetCurrentTimeSeconds();
+	float  frameSeconds = static_cast< float >( now - m_frameStartSeconds );
+	m_frameStartSeconds = now;
+
+	for ( size_t workerNum = 0; workerNum < m_workers.size(); workerNum++ )
+	{
+		JobWorker*      worker = m_workers[ workerNum ];
+		JobWorkerStats& stats  = m_workerStats[ workerNum ];
+
+		stats.m_numJobsExecuted = worker->m_numJobsExecuted.exchange( 0, std::memory_order_relaxed );
+		stats.m_busySeconds     = static_cast< float >( worker->m_busyMicroseconds.exchange( 0, std::memory_order_relaxed ) ) * 0.000001f;
+		stats.m_utilization     = frameSeconds > 0.0f ? stats.m_busySeconds / frameSeconds : 0.0f;
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+void JobSystem::EndFrame()
+{
+
+}
+
+
+//------------------------------------------------------------------------------------------------
+void JobSystem::KickJob( JobDecl const& jobDecl, JobCounter* counter /*= nullptr*/ )
+{
+	KickJobs( &jobDecl, 1, counter );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void JobSystem::KickJobs( JobDecl const* jobDecls, int numJobs, JobCounter* counter /*= nullptr*/ )
+{
+	if ( counter != nullptr )
+	{
+		counter->m_numPendingJobs.fetch_add( numJobs, std::memory_order_relaxed );
+	}
+
+	for ( int jobNum = 0; jobNum < numJobs; jobNum++ )
+	{
+		Job job;
+		job.m_function = jobDecls[ jobNum ].m_function;
+		job.m_jobData  = jobDecls[ jobNum ].m_jobData;
+		job.m_name     = jobDecls[ jobNum ].m_name;
+		job.m_counter  = counter;
+		PushJob( job );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// counter is raised now so waiting on it also covers the deferred jobs
+//
+void JobSystem::KickJobsAfter( JobCounter& dependency, JobDecl const* jobDecls, int numJobs, JobCounter* counter /*= nullptr*/ )
+{
+	if ( counter != nullptr )
+	{
+		counter->m_numPendingJobs.fetch_add( numJobs, std::memory_order_relaxed );
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( dependency.m_continuationLock );
+		if ( dependency.m_numPendingJobs.load( std::memory_order_acquire ) > 0 )
+		{
+			for ( int jobNum = 0; jobNum < numJobs; jobNum++ )
+			{
+				Job job;
+				job.m_function = jobDecls[ jobNum ].m_function;
+				job.m_jobData  = jobDecls[ jobNum ].m_jobData;
+				job.m_name     = jobDecls[ jobNum ].m_name;
+				job.m_counter  = counter;
+				dependency.m_continuations.push_back( job );
+			}
+			return;
+		}
+	}
+
+	for ( int jobNum = 0; jobNum < numJobs; jobNum++ )
+	{
+		Job job;
+		job.m_function = jobDecls[ jobNum ].m_function;
+		job.m_jobData  = jobDecls[ jobNum ].m_jobData;
+		job.m_name     = jobDecls[ jobNum ].m_name;
+		job.m_counter  = counter;
+		PushJob( job );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Runs other jobs instead of blocking, so waiting from inside a job cannot deadlock the pool
+//
+void JobSystem::WaitForCounter( JobCounter& counter )
+{
+	int workerIndex = s_workerIndex;
+
+	while ( !counter.IsDone() )
+	{
+		Job job;
+		if ( FindJob( workerIndex, job ) )
+		{
+			ExecuteJob( job, workerIndex );
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// The last CompleteJob may still hold the lock; once we get it the counter is no longer touched and can go out of scope
+	std::lock_guard<std::mutex> lock( counter.m_continuationLock );
+}
+
+
+//------------------------------------------------------------------------------------------------
+int JobSystem::GetNumWorkers() const
+{
+	return static_cast< int >( m_workers.size() );
+}
+
+
+//------------------------------------------------------------------------------------------------
+int JobSystem::GetCurrentWorkerIndex() const
+{
+	return s_workerIndex;
+}
+
+
+//------------------------------------------------------------------------------------------------
+std::vector<JobWorkerStats> const& JobSystem::GetWorkerStats() const
+{
+	return m_workerStats;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void JobSystem::WorkerThreadMain( int workerIndex )
+{
+	s_workerIndex = workerIndex;
+
+	while ( !m_isQuitting.load( std::memory_order_relaxed ) )
+	{
+		Job job;
+		if ( FindJob( workerIndex, job ) )
+		{
+			ExecuteJob( job, workerIndex );
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock( m_wakeLock );
+		m_wakeCondition.wait_for( lock, std::chrono::milliseconds( 1 ), [ this ]()
+		{
+			return m_numQueuedJobs.load( std::memory_order_relaxed ) > 0 || m_isQuitting.load( std::memory_order_relaxed );
+		} );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+void JobSystem::PushJob( Job const& job )
+{
+	int workerIndex = s_workerIndex;
+	if ( workerIndex >= 0 && workerIndex < GetNumWorkers() )
+	{
+		if ( !m_workers[ workerIndex ]->Push( job ) )
+		{
+			// Deque full; running it here keeps the submitter making progress
+			ExecuteJob( job, workerIndex );
+			return;
+		}
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock( m_externalQueueLock );
+		m_externalQueue.push_back( job );
+	}
+
+	m_numQueuedJobs.fetch_add( 1, std::memory_order_relaxed );
+	m_wakeCondition.notify_one();
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool JobSystem::FindJob( int workerIndex, Job& outJob )
+{
+	bool isFound    = false;
+	int  numWorkers = GetNumWorkers();
+
+	if ( workerIndex >= 0 && workerIndex < numWorkers )
+	{
+		JobWorker* self = m_workers[ workerIndex ];
+		isFound = self->Pop( outJob );
+
+		if ( !isFound && numWorkers > 1 )
+		{
+			self->m_stealSeed ^= self->m_stealSeed << 13;
+			self->m_stealSeed ^= self->m_stealSeed >> 17;
+			self->m_stealSeed ^= self->m_stealSeed << 5;
+
+			int firstVictim = static_cast< int >( self->m_stealSeed % static_cast< uint >( numWorkers ) );
+			for ( int victimNum = 0; victimNum < numWorkers && !isFound; victimNum++ )
+			{
+				int victimIndex = ( firstVictim + victimNum ) % numWorkers;
+				if ( victimIndex != workerIndex )
+				{
+					isFound = m_workers[ victimIndex ]->Steal( outJob );
+				}
+			}
+		}
+	}
+	else
+	{
+		for ( int victimIndex = 0; victimIndex < numWorkers && !isFound; victimIndex++ )
+		{
+			isFound = m_workers[ victimIndex ]->Steal( outJob );
+		}
+	}
+
+	if ( !isFound )
+	{
+		std::lock_guard<std::mutex> lock( m_externalQueueLock );
+		if ( m_externalQueue.empty() )
+		{
+			return false;
+		}
+
+		outJob = m_externalQueue.front();
+		m_externalQueue.pop_front();
+	}
+
+	m_numQueuedJobs.fetch_sub( 1, std::memory_order_relaxed );
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void JobSystem::ExecuteJob( Job const& job, int workerIndex )
+{
+	if ( m_config.m_onJobBegin != nullptr )
+	{
+		m_config.m_onJobBegin( workerIndex, job.m_name );
+	}
+
+	double enclosingNestedSeconds = s_nestedJobSeconds;
+	s_nestedJobSeconds = 0.0;
+
+	double startSeconds = GetCurrentTimeSeconds();
+	job.m_function( job.m_jobData );
+	double endSeconds = GetCurrentTimeSeconds();
+
+	// Nested jobs already counted their own time, so this job's timer is paused while they ran
+	double jobSeconds  = endSeconds - startSeconds;
+	double selfSeconds = jobSeconds - s_nestedJobSeconds;
+	s_nestedJobSeconds = enclosingNestedSeconds + jobSeconds;
+
+	if ( m_config.m_onJobEnd != nullptr )
+	{
+		m_config.m_onJobEnd( workerIndex, job.m_name );
+	}
+
+	if ( workerIndex >= 0 && workerIndex < GetNumWorkers() )
+	{
+		JobWorker* worker = m_workers[ workerIndex ];
+		worker->m_numJobsExecuted.fetch_add( 1, std::memory_order_relaxed );
+		worker->m_busyMicroseconds.fetch_add( static_cast< int64_t >( selfSeconds * 1000000.0 ), std::memory_order_relaxed );
+	}
+
+	CompleteJob( job.m_counter );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// The decrement happens under the counter's lock so a waiter cannot free the counter while it is still in use
+//
+void JobSystem::CompleteJob( JobCounter* counter )
+{
+	if ( counter == nullptr )
+		return;
+
+	std::vector<Job> continuations;
+	{
+		std::lock_guard<std::mutex> lock( counter->m_continuationLock );
+		if ( counter->m_numPendingJobs.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+		{
+			continuations.swap( counter->m_continuations );
+		}
+	}
+
+	for ( Job const& job : continuations )
+	{
+		PushJob( job );
+	}
+}
@@ -0,0 +1,210 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+//------------------------------------------------------------------------------------------------
+class JobCounter;
+
+struct JobWorker;
+
+
+//------------------------------------------------------------------------------------------------
+typedef void (*JobFunction)( void* jobData );
+typedef void (*JobInstrumentationCallback)( int workerIndex, char const* jobName );
+
+
+//------------------------------------------------------------------------------------------------
+constexpr int JOB_QUEUE_CAPACITY  = 4096;	// per worker deque size, must be a power of two
+constexpr int MAIN_THREAD_WORKER  = 0;
+
+
+//------------------------------------------------------------------------------------------------
+struct JobSystemConfig
+{
+	int                        m_numWorkerThreads = -1;			// -1 sizes the pool to hardware threads minus the main thread
+	JobInstrumentationCallback m_onJobBegin       = nullptr;	// called on the executing thread, e.g. to open a profiler zone
+	JobInstrumentationCallback m_onJobEnd         = nullptr;
+};
+
+
+//------------------------------------------------------------------------------------------------
+struct JobDecl
+{
+	JobFunction m_function = nullptr;
+	void*       m_jobData  = nullptr;
+	char const* m_name     = "Job";
+};
+
+
+//------------------------------------------------------------------------------------------------
+struct Job
+{
+	JobFunction m_function = nullptr;
+	void*       m_jobData  = nullptr;
+	char const* m_name     = nullptr;
+	JobCounter* m_counter  = nullptr;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Counts outstanding jobs. Jobs kicked with KickJobsAfter are held here until the count reaches zero
+//
+class JobCounter
+{
+	friend class JobSystem;
+
+public:
+	JobCounter() = default;
+	JobCounter( JobCounter const& copy ) = delete;
+
+	bool IsDone() const	{ return m_numPendingJobs.load( std::memory_order_acquire ) == 0; }
+
+private:
+	std::atomic<int>     m_numPendingJobs = { 0 };
+	std::mutex           m_continuationLock;
+	std::vector<Job>     m_continuations;
+};
+
+
+//------------------------------------------------------------------------------------------------
+struct JobWorkerStats
+{
+	int   m_numJobsExecuted = 0;
+	float m_busySeconds     = 0.0f;
+	float m_utilization     = 0.0f;		// busy fraction of the last frame
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Fixed worker pool with one lock free work stealing deque per worker. The main thread is worker 0 and
+// runs jobs whenever it waits on a counter; other non worker threads submit through a shared queue
+//
+class JobSystem
+{
+public:
+	JobSystem( JobSystemConfig const& config );
+	~JobSystem();
+	void Startup();
+	void Shutdown();
+	void BeginFrame();
+	void EndFrame();
+
+	void KickJob( JobDecl const& jobDecl, JobCounter* counter = nullptr );
+	void KickJobs( JobDecl const* jobDecls, int numJobs, JobCounter* counter = nullptr );
+	void KickJobsAfter( JobCounter& dependency, JobDecl const* jobDecls, int numJobs, JobCounter* counter = nullptr );
+	void WaitForCounter( JobCounter& counter );
+
+	template <typename FUNC>
+	void ParallelFor( int count, int batchSize, FUNC const& function );			// function( int index )
+	template <typename FUNC>
+	void ParallelForRange( int count, int batchSize, FUNC const& function );	// function( int beginIndex, int endIndex )
+
+	int                                GetNumWorkers() const;
+	int                                GetCurrentWorkerIndex() const;
+	std::vector<JobWorkerStats> const& GetWorkerStats() const;
+
+private:
+	void WorkerThreadMain( int workerIndex );
+	void PushJob( Job const& job );
+	bool FindJob( int workerIndex, Job& outJob );
+	void ExecuteJob( Job const& job, int workerIndex );
+	void CompleteJob( JobCounter* counter );
+
+private:
+	JobSystemConfig             m_config;
+	std::vector<JobWorker*>     m_workers;
+	std::vector<std::thread*>   m_threads;
+	std::vector<JobWorkerStats> m_workerStats;
+
+	std::mutex                  m_externalQueueLock;
+	std::deque<Job>             m_externalQueue;
+
+	std::mutex                  m_wakeLock;
+	std::condition_variable     m_wakeCondition;
+	std::atomic<int>            m_numQueuedJobs = { 0 };
+	std::atomic<bool>           m_isQuitting    = { false };
+
+	double                      m_frameStartSeconds = 0.0;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Kicks one job per worker; each pulls batches off a shared cursor so uneven batches balance themselves
+//
+template <typename FUNC>
+void JobSystem::ParallelForRange( int count, int batchSize, FUNC const& function )
+{
+	if ( count <= 0 )
+		return;
+
+	if ( batchSize < 1 )
+	{
+		batchSize = 1;
+	}
+
+	int numBatches = ( count + batchSize - 1 ) / batchSize;
+	int numJobs    = numBatches < GetNumWorkers() ? numBatches : GetNumWorkers();
+	if ( numJobs <= 1 )
+	{
+		function( 0, count );
+		return;
+	}
+
+	struct ParallelForData
+	{
+		FUNC const*      m_function  = nullptr;
+		std::atomic<int> m_nextBatch = { 0 };
+		int              m_count     = 0;
+		int              m_batchSize = 0;
+	};
+
+	ParallelForData data;
+	data.m_function  = &function;
+	data.m_count     = count;
+	data.m_batchSize = batchSize;
+
+	JobDecl jobDecl;
+	jobDecl.m_name    = "ParallelFor";
+	jobDecl.m_jobData = &data;
+	jobDecl.m_function = []( void* jobData )
+	{
+		ParallelForData* forData = static_cast< ParallelForData* >( jobData );
+		for ( ;; )
+		{
+			int beginIndex = forData->m_nextBatch.fetch_add( 1, std::memory_order_relaxed ) * forData->m_batchSize;
+			if ( beginIndex >= forData->m_count )
+				break;
+
+			int endIndex = beginIndex + forData->m_batchSize;
+			( *forData->m_function )( beginIndex, endIndex < forData->m_count ? endIndex : forData->m_count );
+		}
+	};
+
+	JobCounter counter;
+	for ( int jobNum = 0; jobNum < numJobs; jobNum++ )
+	{
+		KickJob( jobDecl, &counter );
+	}
+	WaitForCounter( counter );
+}
+
+
+//------------------------------------------------------------------------------------------------
+template <typename FUNC>
+void JobSystem::ParallelFor( int count, int batchSize, FUNC const& function )
+{
+	ParallelForRange( count, batchSize, [ &function ]( int beginIndex, int endIndex )
+	{
+		for ( int index = beginIndex; index < endIndex; index++ )
+		{
+			function( index );
+		}
+	} );
+}
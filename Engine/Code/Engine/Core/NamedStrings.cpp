@@ -4,133 +4,353 @@
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Core/Rgba8.hpp"
 
+#include <cstring>
+
+
 //-----------------------------------------------------------------------------------------------
-void NamedStrings::PopulateFromXmlElementAttributes( XmlElement const& element )
+template <typename T>
+static T GetTypedData( NamedValue const& value )
 {
-	tinyxml2::XMLAttribute const* attribute = element.FirstAttribute();
-	while ( attribute )
+	T typedValue;
+	memcpy( static_cast< void* >( &typedValue ), value.m_data, sizeof( T ) );
+	return typedValue;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Parses a TEXT value as type T the first time it is read as T; later reads as T copy the cached
+// result. Reading it as another type reparses and replaces the cache
+//
+template <typename T, typename ParseFunction>
+static T GetParsedText( NamedValue const& value, NamedValueType type, ParseFunction parseText )
+{
+	if ( value.m_parsedType != type )
 	{
-		std::string attributeName( attribute->Name() );
-		std::string attributeValue( attribute->Value() );
-		SetValue( attributeName, attributeValue );
-		attribute = attribute->Next();
+		T parsedValue = parseText( value.m_text.c_str() );
+		memcpy( value.m_data, static_cast< void const* >( &parsedValue ), sizeof( T ) );
+		value.m_parsedType = type;
 	}
+	return GetTypedData<T>( value );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void NamedStrings::SetValue( std::string const& keyName, std::string const& newValue )
+template <typename T>
+static T ParseTextWithSetFromText( char const* text )
 {
-	m_keyValuePairs.insert( std::pair<std::string, std::string>( keyName, newValue ) );
+	T parsedValue;
+	parsedValue.SetFromText( text );
+	return parsedValue;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-std::string NamedStrings::GetValue( std::string const& keyName, std::string const& defaultValue ) const
+static bool IsNumericType( NamedValueType type )
 {
-	if ( m_keyValuePairs.find( keyName ) != m_keyValuePairs.end() )
-	{
-		return m_keyValuePairs.find( keyName )->second;
-	}
-	return defaultValue;
+	return type == NamedValueType::BOOL || type == NamedValueType::INT || type == NamedValueType::FLOAT;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-bool NamedStrings::GetValue( std::string const& keyName, bool defaultValue ) const
+static float GetNumericValueAsFloat( NamedValue const& value )
 {
-	if ( m_keyValuePairs.find( keyName ) != m_keyValuePairs.end() )
+	switch ( value.m_type )
 	{
-		bool value = false;
-		if ( _strcmpi( m_keyValuePairs.find( keyName )->second.c_str(), "true" ) == 0 )
-			value = true;
-		return value;
+		case NamedValueType::BOOL:	return GetTypedData<bool>( value ) ? 1.0f : 0.0f;
+		case NamedValueType::INT:	return static_cast< float >( GetTypedData<int>( value ) );
+		case NamedValueType::FLOAT:	return GetTypedData<float>( value );
+		default:					return 0.0f;
 	}
-	return defaultValue;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-int NamedStrings::GetValue( std::string const& keyName, int defaultValue ) const
+void NamedStrings::PopulateFromXmlElementAttributes( XmlElement const& element )
 {
-	if ( m_keyValuePairs.find( keyName ) != m_keyValuePairs.end() )
+	tinyxml2::XMLAttribute const* attribute = element.FirstAttribute();
+	while ( attribute )
 	{
-		return atoi( m_keyValuePairs.find( keyName )->second.c_str() );
+		SetValue( attribute->Name(), attribute->Value() );
+		attribute = attribute->Next();
 	}
-	return defaultValue;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-float NamedStrings::GetValue( std::string const& keyName, float defaultValue ) const
+NamedValue const* NamedStrings::FindValue( uint64_t keyHash ) const
 {
-	if ( m_keyValuePairs.find( keyName ) != m_keyValuePairs.end() )
+	for ( int valueNum = 0; valueNum < m_numInlineValues; valueNum++ )
 	{
-		return static_cast< float >( atof( m_keyValuePairs.find( keyName )->second.c_str() ) );
+		if ( m_inlineValues[ valueNum ].m_keyHash == keyHash )
+			return &m_inlineValues[ valueNum ];
 	}
-	return defaultValue;
+
+	for ( NamedValue const& value : m_overflowValues )
+	{
+		if ( value.m_keyHash == keyHash )
+			return &value;
+	}
+
+	return nullptr;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-std::string NamedStrings::GetValue( std::string const& keyName, char const* defaultValue ) const
+NamedValue& NamedStrings::FindOrAddValue( uint64_t keyHash )
 {
-	if ( m_keyValuePairs.find( keyName ) != m_keyValuePairs.end() )
+	NamedValue const* existingValue = FindValue( keyHash );
+	if ( existingValue )
+		return const_cast< NamedValue& >( *existingValue );
+
+	NamedValue* newValue = nullptr;
+	if ( m_numInlineValues < NUM_INLINE_VALUES )
 	{
-		return m_keyValuePairs.find( keyName )->second;
+		newValue = &m_inlineValues[ m_numInlineValues++ ];
 	}
-	return std::string( defaultValue );
+	else
+	{
+		m_overflowValues.emplace_back();
+		newValue = &m_overflowValues.back();
+	}
+
+	newValue->m_keyHash = keyHash;
+	return *newValue;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-Rgba8 NamedStrings::GetValue( std::string const& keyName, Rgba8 const& defaultValue ) const
+template <typename T>
+void NamedStrings::SetTypedValue( NamedKey keyName, NamedValueType type, T const& newValue )
 {
-	if ( m_keyValuePairs.find( keyName ) != m_keyValuePairs.end() )
-	{
-		Rgba8 rgba8;
-		rgba8.SetFromText( m_keyValuePairs.find( keyName )->second.c_str() );
-		return rgba8;
-	}
+	static_assert( sizeof( T ) <= sizeof( NamedValue::m_data ), "NamedValue storage too small for this type" );
 
-	return defaultValue;
+	NamedValue& value = FindOrAddValue( keyName.m_hash );
+	value.m_type       = type;
+	value.m_parsedType = NamedValueType::TEXT;
+	value.m_text.clear();
+	memcpy( value.m_data, static_cast< void const* >( &newValue ), sizeof( T ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void NamedStrings::SetValue( NamedKey keyName, std::string const& newValue )
+{
+	NamedValue& value = FindOrAddValue( keyName.m_hash );
+	value.m_type       = NamedValueType::TEXT;
+	value.m_parsedType = NamedValueType::TEXT;
+	value.m_text       = newValue;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void NamedStrings::SetValue( NamedKey keyName, char const* newValue )
+{
+	NamedValue& value = FindOrAddValue( keyName.m_hash );
+	value.m_type       = NamedValueType::TEXT;
+	value.m_parsedType = NamedValueType::TEXT;
+	value.m_text       = newValue;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void NamedStrings::SetValue( NamedKey keyName, bool newValue )				{ SetTypedValue( keyName, NamedValueType::BOOL, newValue ); }
+void NamedStrings::SetValue( NamedKey keyName, int newValue )				{ SetTypedValue( keyName, NamedValueType::INT, newValue ); }
+void NamedStrings::SetValue( NamedKey keyName, float newValue )				{ SetTypedValue( keyName, NamedValueType::FLOAT, newValue ); }
+void NamedStrings::SetValue( NamedKey keyName, Rgba8 const& newValue )		{ SetTypedValue( keyName, NamedValueType::RGBA8, newValue ); }
+void NamedStrings::SetValue( NamedKey keyName, Vec2 const& newValue )		{ SetTypedValue( keyName, NamedValueType::VEC2, newValue ); }
+void NamedStrings::SetValue( NamedKey keyName, Vec3 const& newValue )		{ SetTypedValue( keyName, NamedValueType::VEC3, newValue ); }
+void NamedStrings::SetValue( NamedKey keyName, IntVec2 const& newValue )	{ SetTypedValue( keyName, NamedValueType::INTVEC2, newValue ); }
+
+
+//-----------------------------------------------------------------------------------------------
+bool NamedStrings::HasValue( NamedKey keyName ) const
+{
+	return FindValue( keyName.m_hash ) != nullptr;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-Vec2 NamedStrings::GetValue( std::string const& keyName, Vec2 const& defaultValue ) const
+std::string NamedStrings::FormatValueAsText( NamedValue const& value ) const
 {
-	if ( m_keyValuePairs.find( keyName ) != m_keyValuePairs.end() )
+	switch ( value.m_type )
 	{
-		Vec2 vec2;
-		vec2.SetFromText( m_keyValuePairs.find( keyName )->second.c_str() );
-		return vec2;
+		case NamedValueType::BOOL:		return GetTypedData<bool>( value ) ? "true" : "false";
+		case NamedValueType::INT:		return Stringf( "%d", GetTypedData<int>( value ) );
+		case NamedValueType::FLOAT:		return Stringf( "%g", GetTypedData<float>( value ) );
+		case NamedValueType::RGBA8:
+		{
+			Rgba8 color = GetTypedData<Rgba8>( value );
+			return Stringf( "%d,%d,%d,%d", color.r, color.g, color.b, color.a );
+		}
+		case NamedValueType::VEC2:
+		{
+			Vec2 vec2 = GetTypedData<Vec2>( value );
+			return Stringf( "%g,%g", vec2.x, vec2.y );
+		}
+		case NamedValueType::VEC3:
+		{
+			Vec3 vec3 = GetTypedData<Vec3>( value );
+			return Stringf( "%g,%g,%g", vec3.x, vec3.y, vec3.z );
+		}
+		case NamedValueType::INTVEC2:
+		{
+			IntVec2 intVec2 = GetTypedData<IntVec2>( value );
+			return Stringf( "%d,%d", intVec2.x, intVec2.y );
+		}
+		default:						return value.m_text;
 	}
-	return defaultValue;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-Vec3 NamedStrings::GetValue( std::string const& keyName, Vec3 const& defaultValue ) const
+std::string NamedStrings::GetValue( NamedKey keyName, std::string const& defaultValue ) const
 {
-	if ( m_keyValuePairs.find( keyName ) != m_keyValuePairs.end() )
+	NamedValue const* value = FindValue( keyName.m_hash );
+	if ( value )
 	{
-		Vec3 vec3;
-		vec3.SetFromText( m_keyValuePairs.find( keyName )->second.c_str() );
-		return vec3;
+		return FormatValueAsText( *value );
 	}
 	return defaultValue;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-IntVec2 NamedStrings::GetValue( std::string const& keyName, IntVec2 const& defaultValue ) const
+bool NamedStrings::GetValue( NamedKey keyName, bool defaultValue ) const
 {
-	if ( m_keyValuePairs.find( keyName ) != m_keyValuePairs.end() )
+	NamedValue const* value = FindValue( keyName.m_hash );
+	if ( value == nullptr )
+		return defaultValue;
+
+	if ( value->m_type == NamedValueType::TEXT )
+		return GetParsedText<bool>( *value, NamedValueType::BOOL, []( char const* text ) { return _strcmpi( text, "true" ) == 0; } );
+
+	if ( IsNumericType( value->m_type ) )
+		return GetNumericValueAsFloat( *value ) != 0.0f;
+
+	return _strcmpi( FormatValueAsText( *value ).c_str(), "true" ) == 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int NamedStrings::GetValue( NamedKey keyName, int defaultValue ) const
+{
+	NamedValue const* value = FindValue( keyName.m_hash );
+	if ( value == nullptr )
+		return defaultValue;
+
+	if ( value->m_type == NamedValueType::INT )
+		return GetTypedData<int>( *value );
+
+	if ( IsNumericType( value->m_type ) )
+		return static_cast< int >( GetNumericValueAsFloat( *value ) );
+
+	if ( value->m_type == NamedValueType::TEXT )
+		return GetParsedText<int>( *value, NamedValueType::INT, []( char const* text ) { return atoi( text ); } );
+
+	return atoi( FormatValueAsText( *value ).c_str() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+float NamedStrings::GetValue( NamedKey keyName, float defaultValue ) const
+{
+	NamedValue const* value = FindValue( keyName.m_hash );
+	if ( value == nullptr )
+		return defaultValue;
+
+	if ( IsNumericType( value->m_type ) )
+		return GetNumericValueAsFloat( *value );
+
+	if ( value->m_type == NamedValueType::TEXT )
+		return GetParsedText<float>( *value, NamedValueType::FLOAT, []( char const* text ) { return static_cast< float >( atof( text ) ); } );
+
+	return static_cast< float >( atof( FormatValueAsText( *value ).c_str() ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+std::string NamedStrings::GetValue( NamedKey keyName, char const* defaultValue ) const
+{
+	NamedValue const* value = FindValue( keyName.m_hash );
+	if ( value )
 	{
-		IntVec2 intVec2;
-		intVec2.SetFromText( m_keyValuePairs.find( keyName )->second.c_str() );
-		return intVec2;
+		return FormatValueAsText( *value );
 	}
-	return defaultValue;
+	return std::string( defaultValue );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Rgba8 NamedStrings::GetValue( NamedKey keyName, Rgba8 const& defaultValue ) const
+{
+	NamedValue const* value = FindValue( keyName.m_hash );
+	if ( value == nullptr )
+		return defaultValue;
+
+	if ( value->m_type == NamedValueType::RGBA8 )
+		return GetTypedData<Rgba8>( *value );
+
+	if ( value->m_type == NamedValueType::TEXT )
+		return GetParsedText<Rgba8>( *value, NamedValueType::RGBA8, &ParseTextWithSetFromText<Rgba8> );
+
+	Rgba8 rgba8;
+	rgba8.SetFromText( FormatValueAsText( *value ).c_str() );
+	return rgba8;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec2 NamedStrings::GetValue( NamedKey keyName, Vec2 const& defaultValue ) const
+{
+	NamedValue const* value = FindValue( keyName.m_hash );
+	if ( value == nullptr )
+		return defaultValue;
+
+	if ( value->m_type == NamedValueType::VEC2 )
+		return GetTypedData<Vec2>( *value );
+
+	if ( value->m_type == NamedValueType::TEXT )
+		return GetParsedText<Vec2>( *value, NamedValueType::VEC2, &ParseTextWithSetFromText<Vec2> );
+
+	Vec2 vec2;
+	vec2.SetFromText( FormatValueAsText( *value ).c_str() );
+	return vec2;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec3 NamedStrings::GetValue( NamedKey keyName, Vec3 const& defaultValue ) const
+{
+	NamedValue const* value = FindValue( keyName.m_hash );
+	if ( value == nullptr )
+		return defaultValue;
+
+	if ( value->m_type == NamedValueType::VEC3 )
+		return GetTypedData<Vec3>( *value );
+
+	if ( value->m_type == NamedValueType::TEXT )
+		return GetParsedText<Vec3>( *value, NamedValueType::VEC3, &ParseTextWithSetFromText<Vec3> );
+
+	Vec3 vec3;
+	vec3.SetFromText( FormatValueAsText( *value ).c_str() );
+	return vec3;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+IntVec2 NamedStrings::GetValue( NamedKey keyName, IntVec2 const& defaultValue ) const
+{
+	NamedValue const* value = FindValue( keyName.m_hash );
+	if ( value == nullptr )
+		return defaultValue;
+
+	if ( value->m_type == NamedValueType::INTVEC2 )
+		return GetTypedData<IntVec2>( *value );
+
+	if ( value->m_type == NamedValueType::TEXT )
+		return GetParsedText<IntVec2>( *value, NamedValueType::INTVEC2, &ParseTextWithSetFromText<IntVec2> );
+
+	IntVec2 intVec2;
+	intVec2.SetFromText( FormatValueAsText( *value ).c_str() );
+	return intVec2;
 }
@@ -1,25 +1,94 @@
 #pragma once
-#include <map>
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "XMLUtils.hpp"
 
 
 
 //-----------------------------------------------------------------------------------------------
+// Keys are interned as their HashName, so string literals hash at compile time and lookups never
+// build a std::string
+//
+struct NamedKey
+{
+	constexpr NamedKey( char const* keyName ) : m_hash( HashName( keyName ) ) {}
+	NamedKey( std::string const& keyName ) : m_hash( HashName( keyName.c_str() ) ) {}
+
+	uint64_t m_hash = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+enum class NamedValueType : uint8_t
+{
+	TEXT,			// set from the console or XML; parsed by the first GetValue of each type that reads it
+	BOOL,
+	INT,
+	FLOAT,
+	RGBA8,
+	VEC2,
+	VEC3,
+	INTVEC2,
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// A TEXT value keeps its last parse in m_data, tagged with m_parsedType, so repeated typed reads of
+// console or XML values parse once. Reads update that cache, so one NamedStrings must not be read
+// from two threads at once
+//
+struct NamedValue
+{
+	uint64_t                       m_keyHash    = 0;
+	NamedValueType                 m_type       = NamedValueType::TEXT;
+	mutable NamedValueType         m_parsedType = NamedValueType::TEXT;	// TEXT only; TEXT means nothing parsed yet
+	alignas( 4 ) mutable unsigned char m_data[ 12 ] = {};				// the typed value, memcpy'd in and out
+	std::string                    m_text;								// TEXT only
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Small flat map of typed values: the first few live inline, so typical event args never allocate.
+// Values keep the type they were set with; text only gets parsed when a TEXT value is first read as
+// something else, and typed values only get formatted when read as a string
+//
 class NamedStrings {
 public:
+	static constexpr int NUM_INLINE_VALUES = 4;
+
 	void			PopulateFromXmlElementAttributes(XmlElement const& element);
-	void			SetValue(std::string const& keyName, std::string const& newValue);
-	std::string		GetValue(std::string const& keyName, std::string const& defaultValue) const;
-	bool			GetValue(std::string const& keyName, bool defaultValue) const;
-	int			    GetValue(std::string const& keyName, int defaultValue) const;
-	float			GetValue(std::string const& keyName, float defaultValue) const;
-	std::string		GetValue(std::string const& keyName, char const* defaultValue) const;
-	Rgba8			GetValue(std::string const& keyName, Rgba8 const& defaultValue) const;
-	Vec2			GetValue(std::string const& keyName, Vec2 const& defaultValue) const;
-	Vec3            GetValue( std::string const& keyName, Vec3 const& defaultValue ) const;
-	IntVec2		    GetValue(std::string const& keyName, IntVec2 const& defaultValue) const;
+	void			SetValue( NamedKey keyName, std::string const& newValue );
+	void			SetValue( NamedKey keyName, char const* newValue );
+	void			SetValue( NamedKey keyName, bool newValue );
+	void			SetValue( NamedKey keyName, int newValue );
+	void			SetValue( NamedKey keyName, float newValue );
+	void			SetValue( NamedKey keyName, Rgba8 const& newValue );
+	void			SetValue( NamedKey keyName, Vec2 const& newValue );
+	void			SetValue( NamedKey keyName, Vec3 const& newValue );
+	void			SetValue( NamedKey keyName, IntVec2 const& newValue );
+	std::string		GetValue( NamedKey keyName, std::string const& defaultValue ) const;
+	bool			GetValue( NamedKey keyName, bool defaultValue ) const;
+	int			    GetValue( NamedKey keyName, int defaultValue ) const;
+	float			GetValue( NamedKey keyName, float defaultValue ) const;
+	std::string		GetValue( NamedKey keyName, char const* defaultValue ) const;
+	Rgba8			GetValue( NamedKey keyName, Rgba8 const& defaultValue ) const;
+	Vec2			GetValue( NamedKey keyName, Vec2 const& defaultValue ) const;
+	Vec3            GetValue( NamedKey keyName, Vec3 const& defaultValue ) const;
+	IntVec2		    GetValue( NamedKey keyName, IntVec2 const& defaultValue ) const;
+
+	bool			HasValue( NamedKey keyName ) const;
+	int				GetNumValues() const	{ return m_numInlineValues + static_cast< int >( m_overflowValues.size() ); }
+
+private:
+	NamedValue const*	FindValue( uint64_t keyHash ) const;
+	NamedValue&			FindOrAddValue( uint64_t keyHash );
+	template <typename T>
+	void				SetTypedValue( NamedKey keyName, NamedValueType type, T const& newValue );
+	std::string			FormatValueAsText( NamedValue const& value ) const;
 
 private:
-	std::map< std::string, std::string >	m_keyValuePairs;
-};
\ No newline at end of file
+	NamedValue				m_inlineValues[ NUM_INLINE_VALUES ];
+	int						m_numInlineValues = 0;
+	std::vector<NamedValue>	m_overflowValues;
+};
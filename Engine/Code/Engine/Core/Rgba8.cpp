@@ -33,17 +33,17 @@ void Rgba8::GetAsFloats( float* clearColorAsFloats ) const
 //------------------------------------------------------------------------------------------------
 void Rgba8::SetFromText( const char* text )
 {
-	Strings rgba8Strings = SplitStringOnDelimiter( text, ',' );
-	int size = static_cast< int >( rgba8Strings.size() );
+	int values[ 4 ];
+	int size = ParseDelimitedInts( text, values, 4 );
 	GUARANTEE_OR_DIE( size == 3 || size == 4, "IntVec2 accepts only 2 arguments" );
-	r = static_cast< unsigned char >( atoi( rgba8Strings[ 0 ].c_str() ) );
-	g = static_cast< unsigned char >( atoi( rgba8Strings[ 1 ].c_str() ) );
-	b = static_cast< unsigned char >( atoi( rgba8Strings[ 2 ].c_str() ) );
+	r = static_cast< unsigned char >( values[ 0 ] );
+	g = static_cast< unsigned char >( values[ 1 ] );
+	b = static_cast< unsigned char >( values[ 2 ] );
 	a = 255;
 
 	if ( size == 4 )
 	{
-		a = static_cast< unsigned char >( atoi( rgba8Strings[ 3 ].c_str() ) );
+		a = static_cast< unsigned char >( values[ 3 ] );
 	}
 }
 
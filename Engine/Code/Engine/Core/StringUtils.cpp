@@ -4,6 +4,8 @@
 #include <windows.h>
 
 #include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
 #include <stringapiset.h>
 
 //-----------------------------------------------------------------------------------------------
@@ -70,6 +72,58 @@ Strings SplitStringOnDelimiter( const std::string& originalString, char delimite
 }
 
 
+//------------------------------------------------------------------------------------------------
+// atof and atoi stop at the first character they can't use, so each field parses in place
+//
+int ParseDelimitedFloats( char const* text, float* out_values, int maxValues, char delimiterToSplitOn /*= ',' */ )
+{
+	int         numFields  = 0;
+	char const* fieldStart = text;
+
+	for ( ;; )
+	{
+		if ( numFields < maxValues )
+		{
+			out_values[ numFields ] = static_cast< float >( atof( fieldStart ) );
+		}
+		numFields++;
+
+		char const* delimiter = strchr( fieldStart, delimiterToSplitOn );
+		if ( delimiter == nullptr )
+			break;
+
+		fieldStart = delimiter + 1;
+	}
+
+	return numFields;
+}
+
+
+//------------------------------------------------------------------------------------------------
+int ParseDelimitedInts( char const* text, int* out_values, int maxValues, char delimiterToSplitOn /*= ',' */ )
+{
+	int         numFields  = 0;
+	char const* fieldStart = text;
+
+	for ( ;; )
+	{
+		if ( numFields < maxValues )
+		{
+			out_values[ numFields ] = atoi( fieldStart );
+		}
+		numFields++;
+
+		char const* delimiter = strchr( fieldStart, delimiterToSplitOn );
+		if ( delimiter == nullptr )
+			break;
+
+		fieldStart = delimiter + 1;
+	}
+
+	return numFields;
+}
+
+
 //------------------------------------------------------------------------------------------------
 std::wstring StringToWideString( std::string const& string )
 {
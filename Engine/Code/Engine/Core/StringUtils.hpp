@@ -1,5 +1,6 @@
 #pragma once
 //-----------------------------------------------------------------------------------------------
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -8,11 +9,32 @@
 typedef std::vector< std::string >		Strings;
 
 
+//-----------------------------------------------------------------------------------------------
+// 64 bit FNV-1a of the exact, case sensitive text; constexpr so names can be hashed at compile time
+//
+constexpr uint64_t HashName( char const* name )
+{
+	uint64_t hash = 14695981039346656037ull;
+	for ( ; *name != '\0'; name++ )
+	{
+		hash ^= static_cast< uint8_t >( *name );
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 const std::string Stringf( char const* format, ... );
 const std::string Stringf( int maxLength, char const* format, ... );
 Strings SplitStringOnDelimiter(const std::string& originalString, char delimiterToSplitOn = ',');
 
+// Allocation free counterparts of splitting and then atof/atoi-ing each part. Every field is still
+// counted when there are more than maxValues, so callers can check the count like a split's size
+int ParseDelimitedFloats( char const* text, float* out_values, int maxValues, char delimiterToSplitOn = ',' );
+int ParseDelimitedInts( char const* text, int* out_values, int maxValues, char delimiterToSplitOn = ',' );
+
 std::wstring StringToWideString( std::string const& string );
 
 
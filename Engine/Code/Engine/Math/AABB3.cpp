@@ -1,5 +1,6 @@
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Mat44.hpp"
 
 
 //----------------------------------------------------------------------------------------------------
@@ -98,6 +99,33 @@ Vec3 AABB3::GetDimensions() const
 }
 
 
+//----------------------------------------------------------------------------------------------------
+AABB3 AABB3::GetTransformed( Mat44 const& transform ) const
+{
+	Vec3 corners[ 8 ] =
+	{
+		Vec3( m_mins.x, m_mins.y, m_mins.z ),
+		Vec3( m_maxs.x, m_mins.y, m_mins.z ),
+		Vec3( m_mins.x, m_maxs.y, m_mins.z ),
+		Vec3( m_maxs.x, m_maxs.y, m_mins.z ),
+		Vec3( m_mins.x, m_mins.y, m_maxs.z ),
+		Vec3( m_maxs.x, m_mins.y, m_maxs.z ),
+		Vec3( m_mins.x, m_maxs.y, m_maxs.z ),
+		Vec3( m_maxs.x, m_maxs.y, m_maxs.z )
+	};
+
+	transform.TransformPositionArray3D( 8, corners );
+
+	AABB3 transformedBounds( corners[ 0 ], corners[ 0 ] );
+	for ( int cornerNum = 1; cornerNum < 8; cornerNum++ )
+	{
+		transformedBounds.StretchToIncludePoint( corners[ cornerNum ] );
+	}
+
+	return transformedBounds;
+}
+
+
 //----------------------------------------------------------------------------------------------------
 void AABB3::Translate( Vec3 translation )
 {
@@ -2,6 +2,9 @@
 #include "Engine/Math/Vec3.hpp"
 
 
+class Mat44;
+
+
 struct AABB3
 {
 public:
@@ -19,6 +22,7 @@ public:
 	bool IsPointInside( Vec3 point ) const;
 	Vec3 GetCenter() const;
 	Vec3 GetDimensions() const;
+	AABB3 GetTransformed( Mat44 const& transform ) const;
 
 	void Translate( Vec3 translation );
 	void SetCenter( Vec3 center );
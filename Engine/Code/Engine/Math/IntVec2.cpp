@@ -122,8 +122,8 @@ void IntVec2::RotateMinus90Degrees() {
 
 
 void IntVec2::SetFromText(const char* text){
-	Strings intVec2Strings = SplitStringOnDelimiter(text, ',');
-	GUARANTEE_OR_DIE(intVec2Strings.size() == 2, "IntVec2 accepts only 2 arguments");
-	x = atoi(intVec2Strings[0].c_str());
-	y = atoi(intVec2Strings[1].c_str());
+	int values[2];
+	GUARANTEE_OR_DIE(ParseDelimitedInts(text, values, 2) == 2, "IntVec2 accepts only 2 arguments");
+	x = values[0];
+	y = values[1];
 }
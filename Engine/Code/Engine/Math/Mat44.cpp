@@ -6,6 +6,59 @@
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 
+#if !defined( ENGINE_DISABLE_SIMD ) && ( defined( _M_X64 ) || defined( _M_AMD64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 ) || defined( __SSE__ ) )
+#define MAT44_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+
+#if defined( MAT44_USE_SSE )
+//-----------------------------------------------------------------------------------------------
+// Computes column0 * x + column1 * y + column2 * z + column3 * w in the same order as the scalar path
+//
+static __m128 TransformColumnsSSE( __m128 const columns[ 4 ], __m128 x, __m128 y, __m128 z, __m128 w )
+{
+	__m128 result = _mm_mul_ps( columns[ 0 ], x );
+	result = _mm_add_ps( result, _mm_mul_ps( columns[ 1 ], y ) );
+	result = _mm_add_ps( result, _mm_mul_ps( columns[ 2 ], z ) );
+	result = _mm_add_ps( result, _mm_mul_ps( columns[ 3 ], w ) );
+	return result;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void LoadColumnsSSE( float const* values, __m128 columns[ 4 ] )
+{
+	columns[ 0 ] = _mm_loadu_ps( values + Mat44::Ix );
+	columns[ 1 ] = _mm_loadu_ps( values + Mat44::Jx );
+	columns[ 2 ] = _mm_loadu_ps( values + Mat44::Kx );
+	columns[ 3 ] = _mm_loadu_ps( values + Mat44::Tx );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void MultiplySSE( __m128 const lhsColumns[ 4 ], float const* rhsValues, float* outValues )
+{
+	for ( int columnNum = 0; columnNum < 4; columnNum++ )
+	{
+		float const* rhsColumn = rhsValues + ( columnNum * 4 );
+		__m128 result = TransformColumnsSSE( lhsColumns, _mm_set1_ps( rhsColumn[ 0 ] ), _mm_set1_ps( rhsColumn[ 1 ] ), _mm_set1_ps( rhsColumn[ 2 ] ), _mm_set1_ps( rhsColumn[ 3 ] ) );
+		_mm_storeu_ps( outValues + ( columnNum * 4 ), result );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void StoreXYZSSE( __m128 value, Vec3& out )
+{
+	alignas( 16 ) float result[ 4 ];
+	_mm_store_ps( result, value );
+	out.x = result[ 0 ];
+	out.y = result[ 1 ];
+	out.z = result[ 2 ];
+}
+#endif
+
 //-----------------------------------------------------------------------------------------------
 Mat44::Mat44()
 {
@@ -258,6 +311,14 @@ Vec2 const Mat44::TransformVectorQuantity2D( Vec2 const& vectorQuantityXY ) cons
 //-----------------------------------------------------------------------------------------------
 Vec3 const Mat44::TransformVectorQuantity3D( Vec3 const& vectorQuantityXYZ ) const
 {
+#if defined( MAT44_USE_SSE )
+	__m128 columns[ 4 ];
+	LoadColumnsSSE( m_values, columns );
+
+	Vec3 result;
+	StoreXYZSSE( TransformColumnsSSE( columns, _mm_set1_ps( vectorQuantityXYZ.x ), _mm_set1_ps( vectorQuantityXYZ.y ), _mm_set1_ps( vectorQuantityXYZ.z ), _mm_setzero_ps() ), result );
+	return result;
+#else
 	Vec4 quantity;
 	quantity.x = vectorQuantityXYZ.x;
 	quantity.y = vectorQuantityXYZ.y;
@@ -265,6 +326,7 @@ Vec3 const Mat44::TransformVectorQuantity3D( Vec3 const& vectorQuantityXYZ ) con
 
 	Vec4 result = TransformHomogeneous3D( quantity );
 	return Vec3( result.x, result.y, result.z );
+#endif
 }
 
 
@@ -284,6 +346,14 @@ Vec2 const Mat44::TransformPosition2D( Vec2 const& positionXY ) const
 //-----------------------------------------------------------------------------------------------
 Vec3 const Mat44::TransformPosition3D( Vec3 const& positionXYZ ) const
 {
+#if defined( MAT44_USE_SSE )
+	__m128 columns[ 4 ];
+	LoadColumnsSSE( m_values, columns );
+
+	Vec3 result;
+	StoreXYZSSE( TransformColumnsSSE( columns, _mm_set1_ps( positionXYZ.x ), _mm_set1_ps( positionXYZ.y ), _mm_set1_ps( positionXYZ.z ), _mm_set1_ps( 1.0f ) ), result );
+	return result;
+#else
 	Vec4 quantity;
 	quantity.x = positionXYZ.x;
 	quantity.y = positionXYZ.y;
@@ -292,6 +362,7 @@ Vec3 const Mat44::TransformPosition3D( Vec3 const& positionXYZ ) const
 
 	Vec4 result = TransformHomogeneous3D( quantity );
 	return Vec3( result.x, result.y, result.z );
+#endif
 }
 
 
@@ -300,6 +371,14 @@ Vec4 const Mat44::TransformHomogeneous3D( Vec4 const& homogeneousPoint3D ) const
 {
 	Vec4 quantity = homogeneousPoint3D;
 
+#if defined( MAT44_USE_SSE )
+	__m128 columns[ 4 ];
+	LoadColumnsSSE( m_values, columns );
+
+	alignas( 16 ) float transformed[ 4 ];
+	_mm_store_ps( transformed, TransformColumnsSSE( columns, _mm_set1_ps( quantity.x ), _mm_set1_ps( quantity.y ), _mm_set1_ps( quantity.z ), _mm_set1_ps( quantity.w ) ) );
+	return Vec4( transformed[ 0 ], transformed[ 1 ], transformed[ 2 ], transformed[ 3 ] );
+#else
 	Vec4 result;
 	result.x = m_values[ Ix ] * quantity.x + m_values[ Jx ] * quantity.y + m_values[ Kx ] * quantity.z + m_values[ Tx ] * quantity.w;
 	result.y = m_values[ Iy ] * quantity.x + m_values[ Jy ] * quantity.y + m_values[ Ky ] * quantity.z + m_values[ Ty ] * quantity.w;
@@ -307,6 +386,61 @@ Vec4 const Mat44::TransformHomogeneous3D( Vec4 const& homogeneousPoint3D ) const
 	result.w = m_values[ Iw ] * quantity.x + m_values[ Jw ] * quantity.y + m_values[ Kw ] * quantity.z + m_values[ Tw ] * quantity.w;
 
 	return result;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Transforms numPositions positions (w = 1) in place; stride lets callers walk the position member of a vertex array
+//
+void Mat44::TransformPositionArray3D( int numPositions, Vec3* positions, size_t strideBytes ) const
+{
+	unsigned char* positionBytes = reinterpret_cast< unsigned char* >( positions );
+
+#if defined( MAT44_USE_SSE )
+	__m128 columns[ 4 ];
+	LoadColumnsSSE( m_values, columns );
+	__m128 const one = _mm_set1_ps( 1.0f );
+
+	for ( int positionNum = 0; positionNum < numPositions; positionNum++ )
+	{
+		Vec3& position = *reinterpret_cast< Vec3* >( positionBytes + ( positionNum * strideBytes ) );
+		StoreXYZSSE( TransformColumnsSSE( columns, _mm_set1_ps( position.x ), _mm_set1_ps( position.y ), _mm_set1_ps( position.z ), one ), position );
+	}
+#else
+	for ( int positionNum = 0; positionNum < numPositions; positionNum++ )
+	{
+		Vec3& position = *reinterpret_cast< Vec3* >( positionBytes + ( positionNum * strideBytes ) );
+		position = TransformPosition3D( position );
+	}
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Transforms numVectors vector quantities (w = 0) in place; see TransformPositionArray3D for the stride
+//
+void Mat44::TransformVectorQuantityArray3D( int numVectors, Vec3* vectors, size_t strideBytes ) const
+{
+	unsigned char* vectorBytes = reinterpret_cast< unsigned char* >( vectors );
+
+#if defined( MAT44_USE_SSE )
+	__m128 columns[ 4 ];
+	LoadColumnsSSE( m_values, columns );
+	__m128 const zero = _mm_setzero_ps();
+
+	for ( int vectorNum = 0; vectorNum < numVectors; vectorNum++ )
+	{
+		Vec3& vectorQuantity = *reinterpret_cast< Vec3* >( vectorBytes + ( vectorNum * strideBytes ) );
+		StoreXYZSSE( TransformColumnsSSE( columns, _mm_set1_ps( vectorQuantity.x ), _mm_set1_ps( vectorQuantity.y ), _mm_set1_ps( vectorQuantity.z ), zero ), vectorQuantity );
+	}
+#else
+	for ( int vectorNum = 0; vectorNum < numVectors; vectorNum++ )
+	{
+		Vec3& vectorQuantity = *reinterpret_cast< Vec3* >( vectorBytes + ( vectorNum * strideBytes ) );
+		vectorQuantity = TransformVectorQuantity3D( vectorQuantity );
+	}
+#endif
 }
 
 
@@ -502,6 +636,26 @@ Mat44 const Mat44::GetTranspose() const
 //-----------------------------------------------------------------------------------------------
 Mat44 const Mat44::GetOrthonormalInverse() const
 {
+#if defined( MAT44_USE_SSE )
+	__m128 columns[ 4 ];
+	LoadColumnsSSE( m_values, columns );
+	columns[ 3 ] = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS( columns[ 0 ], columns[ 1 ], columns[ 2 ], columns[ 3 ] );
+
+	Mat44 inverse;
+	_mm_storeu_ps( inverse.m_values + Ix, columns[ 0 ] );
+	_mm_storeu_ps( inverse.m_values + Jx, columns[ 1 ] );
+	_mm_storeu_ps( inverse.m_values + Kx, columns[ 2 ] );
+
+	__m128 translation = TransformColumnsSSE( columns, _mm_set1_ps( -m_values[ Tx ] ), _mm_set1_ps( -m_values[ Ty ] ), _mm_set1_ps( -m_values[ Tz ] ), _mm_set1_ps( 1.0f ) );
+	_mm_storeu_ps( inverse.m_values + Tx, translation );
+	inverse.m_values[ Iw ] = 0.0f;
+	inverse.m_values[ Jw ] = 0.0f;
+	inverse.m_values[ Kw ] = 0.0f;
+	inverse.m_values[ Tw ] = 1.0f;
+
+	return inverse;
+#else
 	Mat44 matrixWithoutTranslation = GetMatrixWithoutTranslation();
 	Mat44 transposeMatrix = matrixWithoutTranslation.GetTranspose();
 
@@ -513,6 +667,55 @@ Mat44 const Mat44::GetOrthonormalInverse() const
 	transposeMatrix.Append( translationUndo );
 
 	return transposeMatrix;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// General 4x4 inverse by cofactor expansion; use GetOrthonormalInverse for rigid transforms
+//
+Mat44 const Mat44::GetInverse() const
+{
+	float const* m = m_values;
+	float cofactors[ 16 ];
+
+	cofactors[ 0 ]  =  m[ 5 ] * m[ 10 ] * m[ 15 ] - m[ 5 ] * m[ 11 ] * m[ 14 ] - m[ 9 ] * m[ 6 ] * m[ 15 ] + m[ 9 ] * m[ 7 ] * m[ 14 ] + m[ 13 ] * m[ 6 ] * m[ 11 ] - m[ 13 ] * m[ 7 ] * m[ 10 ];
+	cofactors[ 4 ]  = -m[ 4 ] * m[ 10 ] * m[ 15 ] + m[ 4 ] * m[ 11 ] * m[ 14 ] + m[ 8 ] * m[ 6 ] * m[ 15 ] - m[ 8 ] * m[ 7 ] * m[ 14 ] - m[ 12 ] * m[ 6 ] * m[ 11 ] + m[ 12 ] * m[ 7 ] * m[ 10 ];
+	cofactors[ 8 ]  =  m[ 4 ] * m[ 9 ]  * m[ 15 ] - m[ 4 ] * m[ 11 ] * m[ 13 ] - m[ 8 ] * m[ 5 ] * m[ 15 ] + m[ 8 ] * m[ 7 ] * m[ 13 ] + m[ 12 ] * m[ 5 ] * m[ 11 ] - m[ 12 ] * m[ 7 ] * m[ 9 ];
+	cofactors[ 12 ] = -m[ 4 ] * m[ 9 ]  * m[ 14 ] + m[ 4 ] * m[ 10 ] * m[ 13 ] + m[ 8 ] * m[ 5 ] * m[ 14 ] - m[ 8 ] * m[ 6 ] * m[ 13 ] - m[ 12 ] * m[ 5 ] * m[ 10 ] + m[ 12 ] * m[ 6 ] * m[ 9 ];
+	cofactors[ 1 ]  = -m[ 1 ] * m[ 10 ] * m[ 15 ] + m[ 1 ] * m[ 11 ] * m[ 14 ] + m[ 9 ] * m[ 2 ] * m[ 15 ] - m[ 9 ] * m[ 3 ] * m[ 14 ] - m[ 13 ] * m[ 2 ] * m[ 11 ] + m[ 13 ] * m[ 3 ] * m[ 10 ];
+	cofactors[ 5 ]  =  m[ 0 ] * m[ 10 ] * m[ 15 ] - m[ 0 ] * m[ 11 ] * m[ 14 ] - m[ 8 ] * m[ 2 ] * m[ 15 ] + m[ 8 ] * m[ 3 ] * m[ 14 ] + m[ 12 ] * m[ 2 ] * m[ 11 ] - m[ 12 ] * m[ 3 ] * m[ 10 ];
+	cofactors[ 9 ]  = -m[ 0 ] * m[ 9 ]  * m[ 15 ] + m[ 0 ] * m[ 11 ] * m[ 13 ] + m[ 8 ] * m[ 1 ] * m[ 15 ] - m[ 8 ] * m[ 3 ] * m[ 13 ] - m[ 12 ] * m[ 1 ] * m[ 11 ] + m[ 12 ] * m[ 3 ] * m[ 9 ];
+	cofactors[ 13 ] =  m[ 0 ] * m[ 9 ]  * m[ 14 ] - m[ 0 ] * m[ 10 ] * m[ 13 ] - m[ 8 ] * m[ 1 ] * m[ 14 ] + m[ 8 ] * m[ 2 ] * m[ 13 ] + m[ 12 ] * m[ 1 ] * m[ 10 ] - m[ 12 ] * m[ 2 ] * m[ 9 ];
+	cofactors[ 2 ]  =  m[ 1 ] * m[ 6 ]  * m[ 15 ] - m[ 1 ] * m[ 7 ]  * m[ 14 ] - m[ 5 ] * m[ 2 ] * m[ 15 ] + m[ 5 ] * m[ 3 ] * m[ 14 ] + m[ 13 ] * m[ 2 ] * m[ 7 ]  - m[ 13 ] * m[ 3 ] * m[ 6 ];
+	cofactors[ 6 ]  = -m[ 0 ] * m[ 6 ]  * m[ 15 ] + m[ 0 ] * m[ 7 ]  * m[ 14 ] + m[ 4 ] * m[ 2 ] * m[ 15 ] - m[ 4 ] * m[ 3 ] * m[ 14 ] - m[ 12 ] * m[ 2 ] * m[ 7 ]  + m[ 12 ] * m[ 3 ] * m[ 6 ];
+	cofactors[ 10 ] =  m[ 0 ] * m[ 5 ]  * m[ 15 ] - m[ 0 ] * m[ 7 ]  * m[ 13 ] - m[ 4 ] * m[ 1 ] * m[ 15 ] + m[ 4 ] * m[ 3 ] * m[ 13 ] + m[ 12 ] * m[ 1 ] * m[ 7 ]  - m[ 12 ] * m[ 3 ] * m[ 5 ];
+	cofactors[ 14 ] = -m[ 0 ] * m[ 5 ]  * m[ 14 ] + m[ 0 ] * m[ 6 ]  * m[ 13 ] + m[ 4 ] * m[ 1 ] * m[ 14 ] - m[ 4 ] * m[ 2 ] * m[ 13 ] - m[ 12 ] * m[ 1 ] * m[ 6 ]  + m[ 12 ] * m[ 2 ] * m[ 5 ];
+	cofactors[ 3 ]  = -m[ 1 ] * m[ 6 ]  * m[ 11 ] + m[ 1 ] * m[ 7 ]  * m[ 10 ] + m[ 5 ] * m[ 2 ] * m[ 11 ] - m[ 5 ] * m[ 3 ] * m[ 10 ] - m[ 9 ]  * m[ 2 ] * m[ 7 ]  + m[ 9 ]  * m[ 3 ] * m[ 6 ];
+	cofactors[ 7 ]  =  m[ 0 ] * m[ 6 ]  * m[ 11 ] - m[ 0 ] * m[ 7 ]  * m[ 10 ] - m[ 4 ] * m[ 2 ] * m[ 11 ] + m[ 4 ] * m[ 3 ] * m[ 10 ] + m[ 8 ]  * m[ 2 ] * m[ 7 ]  - m[ 8 ]  * m[ 3 ] * m[ 6 ];
+	cofactors[ 11 ] = -m[ 0 ] * m[ 5 ]  * m[ 11 ] + m[ 0 ] * m[ 7 ]  * m[ 9 ]  + m[ 4 ] * m[ 1 ] * m[ 11 ] - m[ 4 ] * m[ 3 ] * m[ 9 ]  - m[ 8 ]  * m[ 1 ] * m[ 7 ]  + m[ 8 ]  * m[ 3 ] * m[ 5 ];
+	cofactors[ 15 ] =  m[ 0 ] * m[ 5 ]  * m[ 10 ] - m[ 0 ] * m[ 6 ]  * m[ 9 ]  - m[ 4 ] * m[ 1 ] * m[ 10 ] + m[ 4 ] * m[ 2 ] * m[ 9 ]  + m[ 8 ]  * m[ 1 ] * m[ 6 ]  - m[ 8 ]  * m[ 2 ] * m[ 5 ];
+
+	float determinant = m[ 0 ] * cofactors[ 0 ] + m[ 1 ] * cofactors[ 4 ] + m[ 2 ] * cofactors[ 8 ] + m[ 3 ] * cofactors[ 12 ];
+	ASSERT_OR_DIE( determinant != 0.0f, "Trying to invert a singular matrix" );
+
+	float inverseDeterminant = 1.0f / determinant;
+
+	Mat44 inverse;
+#if defined( MAT44_USE_SSE )
+	__m128 scale = _mm_set1_ps( inverseDeterminant );
+	for ( int index = 0; index < 16; index += 4 )
+	{
+		_mm_storeu_ps( inverse.m_values + index, _mm_mul_ps( _mm_loadu_ps( cofactors + index ), scale ) );
+	}
+#else
+	for ( int index = 0; index < 16; index++ )
+	{
+		inverse.m_values[ index ] = cofactors[ index ] * inverseDeterminant;
+	}
+#endif
+
+	return inverse;
 }
 
 
@@ -615,6 +818,17 @@ void Mat44::SetIJKT4D( Vec4 const& iBasis4D, Vec4 const& jBasis4D, Vec4 const& k
 //-----------------------------------------------------------------------------------------------
 void Mat44::Append( Mat44 const& appendThis )
 {
+#if defined( MAT44_USE_SSE )
+	__m128 columns[ 4 ];
+	LoadColumnsSSE( m_values, columns );
+
+	alignas( 16 ) float result[ 16 ];
+	MultiplySSE( columns, appendThis.m_values, result );
+	for ( int index = 0; index < 16; index++ )
+	{
+		m_values[ index ] = result[ index ];
+	}
+#else
 	float result[ 16 ];
 
 	result[ Ix ] = m_values[ Ix ] * appendThis.m_values[ Ix ] + m_values[ Jx ] * appendThis.m_values[ Iy ] + m_values[ Kx ] * appendThis.m_values[ Iz ] + m_values[ Tx ] * appendThis.m_values[ Iw ];
@@ -641,6 +855,36 @@ void Mat44::Append( Mat44 const& appendThis )
 	{
 		m_values[ index ] = result[ index ];
 	}
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// out[ n ] = lhs * rhs[ n ]; out may alias rhs. Used for parent * local chains where the parent is shared
+//
+void Mat44::AppendArray( Mat44 const& lhs, int numMatrices, Mat44 const* rhs, Mat44* out )
+{
+#if defined( MAT44_USE_SSE )
+	__m128 columns[ 4 ];
+	LoadColumnsSSE( lhs.m_values, columns );
+
+	for ( int matrixNum = 0; matrixNum < numMatrices; matrixNum++ )
+	{
+		alignas( 16 ) float result[ 16 ];
+		MultiplySSE( columns, rhs[ matrixNum ].m_values, result );
+		for ( int index = 0; index < 16; index++ )
+		{
+			out[ matrixNum ].m_values[ index ] = result[ index ];
+		}
+	}
+#else
+	for ( int matrixNum = 0; matrixNum < numMatrices; matrixNum++ )
+	{
+		Mat44 result = lhs;
+		result.Append( rhs[ matrixNum ] );
+		out[ matrixNum ] = result;
+	}
+#endif
 }
 
 
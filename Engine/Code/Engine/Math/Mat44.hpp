@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 
 struct Vec2;
 struct Vec3;
@@ -32,6 +33,8 @@ public:
 	Vec2 const         TransformPosition2D(Vec2 const& positionXY) const;
 	Vec3 const         TransformPosition3D(Vec3 const& positionXYZ) const;
 	Vec4 const         TransformHomogeneous3D(Vec4 const& homogeneousPoint3D) const;
+	void               TransformPositionArray3D(int numPositions, Vec3* positions, size_t strideBytes = sizeof(float) * 3) const;
+	void               TransformVectorQuantityArray3D(int numVectors, Vec3* vectors, size_t strideBytes = sizeof(float) * 3) const;
 
 	float*             GetAsFloatArray();
 	float const*       GetAsFloatArray() const;
@@ -50,6 +53,7 @@ public:
 	Mat44 const        GetMatrixWithoutTranslation() const;
 	Mat44 const        GetTranspose() const;
 	Mat44 const        GetOrthonormalInverse() const;
+	Mat44 const        GetInverse() const;
 
 	void               SetTranslation2D(Vec2 const& translationXY);
 	void               SetTranslation3D(Vec3 const& translationXYZ);
@@ -69,6 +73,7 @@ public:
 	void               AppendScaleUniform3D(float uniformScaleXYZ);
 	void               AppendScaleNonUniform2D(Vec2 const& nonUniformScaleXY);
 	void               AppendScaleNonUniform3D(Vec3 const& nonUniformScaleXYZ);
+	static void        AppendArray(Mat44 const& lhs, int numMatrices, Mat44 const* rhs, Mat44* out);
 
 	static Mat44 const CreateOrthoProjection( float left, float right, float bottom, float top, float zNear, float zFar );
 	static Mat44 const CreatePerspectiveProjection( float fovYDegrees, float aspect, float zNear, float zFar );
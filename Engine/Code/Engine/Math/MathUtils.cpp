@@ -1,4 +1,6 @@
 #include <math.h>
+#include <cstdint>
+#include <cstring>
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/Capsule2.hpp"
@@ -706,6 +708,122 @@ float SmoothStep3( float t )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// IEEE 754 binary16, rounding the dropped mantissa bits to nearest
+//
+unsigned short FloatToHalf( float value )
+{
+	uint32_t bits;
+	memcpy( &bits, &value, sizeof( bits ) );
+
+	uint32_t sign     = ( bits >> 16 ) & 0x8000;
+	uint32_t mantissa = bits & 0x007FFFFF;
+	int      exponent = static_cast< int >( ( bits >> 23 ) & 0xFF ) - 127 + 15;
+
+	if ( ( bits & 0x7FFFFFFF ) >= 0x7F800000 )
+	{
+		return static_cast< unsigned short >( sign | 0x7C00 | ( mantissa != 0 ? 0x0200 : 0 ) );
+	}
+
+	if ( exponent >= 31 )
+	{
+		return static_cast< unsigned short >( sign | 0x7C00 );
+	}
+
+	if ( exponent <= 0 )
+	{
+		if ( exponent < -10 )
+		{
+			return static_cast< unsigned short >( sign );
+		}
+
+		mantissa |= 0x00800000;
+		int shift = 14 - exponent;
+		uint32_t half = mantissa >> shift;
+		if ( ( mantissa >> ( shift - 1 ) ) & 1 )
+		{
+			half++;
+		}
+		return static_cast< unsigned short >( sign | half );
+	}
+
+	uint32_t half = ( static_cast< uint32_t >( exponent ) << 10 ) | ( mantissa >> 13 );
+	if ( mantissa & 0x00001000 )
+	{
+		half++;
+	}
+	return static_cast< unsigned short >( sign | half );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+float HalfToFloat( unsigned short half )
+{
+	uint32_t sign     = static_cast< uint32_t >( half & 0x8000 ) << 16;
+	uint32_t exponent = ( half >> 10 ) & 0x1F;
+	uint32_t mantissa = half & 0x03FF;
+
+	if ( exponent == 0 )
+	{
+		float subnormal = ldexpf( static_cast< float >( mantissa ), -24 );
+		return sign != 0 ? -subnormal : subnormal;
+	}
+
+	uint32_t bits;
+	if ( exponent == 31 )
+	{
+		bits = sign | 0x7F800000 | ( mantissa << 13 );
+	}
+	else
+	{
+		bits = sign | ( ( exponent - 15 + 127 ) << 23 ) | ( mantissa << 13 );
+	}
+
+	float value;
+	memcpy( &value, &bits, sizeof( value ) );
+	return value;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Maps a unit vector onto the [-1,1] square by projecting onto the octahedron and folding the lower half
+//
+Vec2 const EncodeOctahedral( Vec3 const& unitVector )
+{
+	float sumOfAbs = fabsf( unitVector.x ) + fabsf( unitVector.y ) + fabsf( unitVector.z );
+	if ( sumOfAbs == 0.0f )
+	{
+		return Vec2( 0.0f, 0.0f );
+	}
+
+	Vec2 encoded( unitVector.x / sumOfAbs, unitVector.y / sumOfAbs );
+	if ( unitVector.z < 0.0f )
+	{
+		float signX = encoded.x >= 0.0f ? 1.0f : -1.0f;
+		float signY = encoded.y >= 0.0f ? 1.0f : -1.0f;
+		encoded = Vec2( ( 1.0f - fabsf( encoded.y ) ) * signX, ( 1.0f - fabsf( encoded.x ) ) * signY );
+	}
+
+	return encoded;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec3 const DecodeOctahedral( Vec2 const& encoded )
+{
+	Vec3 decoded( encoded.x, encoded.y, 1.0f - fabsf( encoded.x ) - fabsf( encoded.y ) );
+	if ( decoded.z < 0.0f )
+	{
+		float signX = encoded.x >= 0.0f ? 1.0f : -1.0f;
+		float signY = encoded.y >= 0.0f ? 1.0f : -1.0f;
+		decoded.x = ( 1.0f - fabsf( encoded.y ) ) * signX;
+		decoded.y = ( 1.0f - fabsf( encoded.x ) ) * signY;
+	}
+
+	return decoded.GetNormalized();
+}
+
+
 //-----------------------------------------------------------------------------------------------
 int GetTaxicabDistance2D( IntVec2 const& pointA, IntVec2 const& pointB )
 {
@@ -95,6 +95,12 @@ float         NormalizeByte( unsigned char byteValue );
 unsigned char DenormalizeByte( float zeroToOne );
 float         SmoothStep3( float t );
 
+//Vertex compression utilities
+unsigned short FloatToHalf( float value );
+float          HalfToFloat( unsigned short half );
+Vec2 const     EncodeOctahedral( Vec3 const& unitVector );
+Vec3 const     DecodeOctahedral( Vec2 const& encoded );
+
 //Geometric utilities
 int   GetTaxicabDistance2D( IntVec2 const& pointA, IntVec2 const& pointB );
 float DotProduct2D( Vec2 const& A, Vec2 const& B );
@@ -254,10 +254,10 @@ float Vec2::NormalizeAndGetPreviousLength() {
 
 //-----------------------------------------------------------------------------------------------
 void Vec2::SetFromText(const char* text){
-	Strings vec2Strings = SplitStringOnDelimiter(text, ',');
-	GUARANTEE_OR_DIE(vec2Strings.size() == 2, "Vec2 accepts only 2 arguments");
-	x = static_cast<float>(atof(vec2Strings[0].c_str()));
-	y = static_cast<float>(atof(vec2Strings[1].c_str()));
+	float values[2];
+	GUARANTEE_OR_DIE(ParseDelimitedFloats(text, values, 2) == 2, "Vec2 accepts only 2 arguments");
+	x = values[0];
+	y = values[1];
 }
 
 
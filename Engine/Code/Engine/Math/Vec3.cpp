@@ -143,11 +143,11 @@ Vec3 const Vec3::GetNormalized() const
 //-----------------------------------------------------------------------------------------------
 void Vec3::SetFromText( const char* text )
 {
-	Strings vec3Strings = SplitStringOnDelimiter( text, ',' );
-	GUARANTEE_OR_DIE( vec3Strings.size() == 3, "Vec3 accepts only 3 arguments" );
-	x = static_cast< float >( atof( vec3Strings[ 0 ].c_str() ) );
-	y = static_cast< float >( atof( vec3Strings[ 1 ].c_str() ) );
-	z = static_cast< float >( atof( vec3Strings[ 2 ].c_str() ) );
+	float values[ 3 ];
+	GUARANTEE_OR_DIE( ParseDelimitedFloats( text, values, 3 ) == 3, "Vec3 accepts only 3 arguments" );
+	x = values[ 0 ];
+	y = values[ 1 ];
+	z = values[ 2 ];
 }
 
 
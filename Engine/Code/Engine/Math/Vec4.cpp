@@ -157,10 +157,10 @@ const Vec4 operator*(float uniformScale, const Vec4& vecToScale){
 
 //-----------------------------------------------------------------------------------------------
 void Vec4::SetFromText(const char* text){
-	Strings vec3Strings = SplitStringOnDelimiter(text, ',');
-	GUARANTEE_OR_DIE(vec3Strings.size() == 4, "Vec4 accepts only 4 arguments");
-	x = static_cast<float>(atof(vec3Strings[0].c_str()));
-	y = static_cast<float>(atof(vec3Strings[1].c_str()));
-	z = static_cast<float>(atof(vec3Strings[2].c_str()));
-	w = static_cast<float>(atof(vec3Strings[3].c_str()));
+	float values[4];
+	GUARANTEE_OR_DIE(ParseDelimitedFloats(text, values, 4) == 4, "Vec4 accepts only 4 arguments");
+	x = values[0];
+	y = values[1];
+	z = values[2];
+	w = values[3];
 }
\ No newline at end of file
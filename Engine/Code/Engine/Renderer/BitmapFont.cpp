@@ -1,9 +1,11 @@
 #include "BitmapFont.hpp"
 
 #include "Engine/Core/EngineCommon.hpp"
-#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/FrameArena.hpp"
 #include "Engine/Renderer/VertexData/VertexUtils.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
 //------------------------------------------------------------------------------------------------
@@ -23,7 +25,8 @@ Texture const& BitmapFont::GetTexture() const
 
 
 //------------------------------------------------------------------------------------------------
-void BitmapFont::AddVertsForText2D( std::vector<Vertex_PCU>& vertexArray, Vec2 const& textMins, float cellHeight, std::string const& text, Rgba8 const& tint, float cellAspect )
+template <typename VERTEX_LIST>
+void BitmapFont::AddVertsForText2D( VERTEX_LIST& vertexArray, Vec2 const& textMins, float cellHeight, std::string_view text, Rgba8 const& tint, float cellAspect )
 {
 	int numChars = static_cast< int >( text.length() );
 	for ( int charNum = 0; charNum < numChars; ++charNum )
@@ -52,16 +55,34 @@ void BitmapFont::AddVertsForText2D( std::vector<Vertex_PCU>& vertexArray, Vec2 c
 
 
 //------------------------------------------------------------------------------------------------
-void BitmapFont::AddVertsForTextInBox2D( std::vector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight, std::string const& text, Rgba8 const& tint /*= Rgba8::WHITE*/, float cellAspect /*= 1.f*/, Vec2 const& alignment /*= Vec2(.5f, .5f)*/, TextBoxMode mode /*= TextBoxMode::SHRINK*/, int maxGlyphsToDraw /*= 99999999*/ )
+// Returns the line starting at lineStart and moves lineStart past its '\n'; the text is never copied
+//
+static std::string_view GetNextLine( std::string_view text, size_t& lineStart )
+{
+	size_t lineEnd = text.find( '\n', lineStart );
+	if ( lineEnd == std::string_view::npos )
+	{
+		lineEnd = text.length();
+	}
+
+	std::string_view line = text.substr( lineStart, lineEnd - lineStart );
+	lineStart = lineEnd + 1;
+	return line;
+}
+
+
+//------------------------------------------------------------------------------------------------
+template <typename VERTEX_LIST>
+void BitmapFont::AddVertsForTextInBox2D( VERTEX_LIST& vertexArray, AABB2 const& box, float cellHeight, std::string_view text, Rgba8 const& tint /*= Rgba8::WHITE*/, float cellAspect /*= 1.f*/, Vec2 const& alignment /*= Vec2(.5f, .5f)*/, TextBoxMode mode /*= TextBoxMode::SHRINK*/, int maxGlyphsToDraw /*= 99999999*/ )
 {
-	Strings linesOfText = SplitStringOnDelimiter( text, '\n' );
 	float maxPureLineWidth = 0.f;
-	int numLines = static_cast< int >( linesOfText.size() );
+	int numLines = static_cast< int >( std::count( text.begin(), text.end(), '\n' ) ) + 1;
 	float scaleValue = 1.f;
 
+	size_t lineStart = 0;
 	for ( int lineNum = 0; lineNum < numLines; lineNum++ )
 	{
-		float pureLineWidth = GetPureTextWidth( linesOfText[ lineNum ] );
+		float pureLineWidth = GetPureTextWidth( GetNextLine( text, lineStart ) );
 		if ( maxPureLineWidth < pureLineWidth )
 		{
 			maxPureLineWidth = pureLineWidth;
@@ -106,33 +127,195 @@ void BitmapFont::AddVertsForTextInBox2D( std::vector<Vertex_PCU>& vertexArray, A
 
 	int glyphsDrawn = 0;
 
+	lineStart = 0;
 	for ( int lineNum = 0; lineNum < numLines; lineNum++ )
 	{
-		float lineWidth = GetPureTextWidth( linesOfText[ lineNum ] ) * cellAspect * cellHeight;
+		std::string_view lineText = GetNextLine( text, lineStart );
+		float lineWidth = GetPureTextWidth( lineText ) * cellAspect * cellHeight;
 
 		Vec2 textMins;
 
 		textMins.x = imaginaryBoxBottomLeft.x + alignment.x * ( imaginaryBoxXSize - lineWidth );
 		textMins.y = imaginaryBoxBottomLeft.y + ( numLines - lineNum - 1 ) * cellHeight;
 
-		int glyphsToDraw = static_cast< int >( linesOfText[ lineNum ].length() );
+		int glyphsToDraw = static_cast< int >( lineText.length() );
 		glyphsDrawn += glyphsToDraw;
 
 		if ( glyphsDrawn > maxGlyphsToDraw )
 		{
 			glyphsToDraw = glyphsToDraw - ( glyphsDrawn - maxGlyphsToDraw );
-			std::string partText = linesOfText[ lineNum ].substr( 0, glyphsToDraw );
-			AddVertsForText2D( vertexArray, textMins, cellHeight, partText, tint, cellAspect );
+			AddVertsForText2D( vertexArray, textMins, cellHeight, lineText.substr( 0, glyphsToDraw ), tint, cellAspect );
 			break;
 		}
 
-		AddVertsForText2D( vertexArray, textMins, cellHeight, linesOfText[ lineNum ], tint, cellAspect );
+		AddVertsForText2D( vertexArray, textMins, cellHeight, lineText, tint, cellAspect );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Continues a HashName style FNV-1a hash over raw bytes
+//
+template <typename T>
+static uint64_t HashAppend( uint64_t hash, T const& value )
+{
+	unsigned char bytes[ sizeof( T ) ];
+	memcpy( bytes, static_cast< void const* >( &value ), sizeof( T ) );
+
+	for ( unsigned char byte : bytes )
+	{
+		hash ^= byte;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+
+//------------------------------------------------------------------------------------------------
+template <typename VERTEX_LIST>
+void BitmapFont::AddCachedVertsForTextInBox2D( VERTEX_LIST& vertexArray, AABB2 const& box, float cellHeight, std::string_view text, Rgba8 const& tint /*= Rgba8::WHITE*/, float cellAspect /*= 1.f*/, Vec2 const& alignment /*= Vec2(.5f, .5f)*/, TextBoxMode mode /*= TextBoxMode::SHRINK*/ )
+{
+	uint64_t layoutKey = HashName( "" );
+	layoutKey = HashAppend( layoutKey, box.m_mins );
+	layoutKey = HashAppend( layoutKey, box.m_maxs );
+	layoutKey = HashAppend( layoutKey, cellHeight );
+	layoutKey = HashAppend( layoutKey, tint );
+	layoutKey = HashAppend( layoutKey, cellAspect );
+	layoutKey = HashAppend( layoutKey, alignment );
+	layoutKey = HashAppend( layoutKey, mode );
+
+	m_textLayoutCacheLock.lock();
+
+	CachedTextLayout const& layout = FindOrAddTextLayout( layoutKey, box, cellHeight, text, tint, cellAspect, alignment, mode );
+	vertexArray.insert( vertexArray.end(), layout.m_verts.begin(), layout.m_verts.end() );
+
+	m_textLayoutCacheLock.unlock();
+}
+
+
+//------------------------------------------------------------------------------------------------
+void BitmapFont::ClearTextLayoutCache()
+{
+	m_textLayoutCacheLock.lock();
+	m_cachedTextLayouts.clear();
+	m_textLayoutCacheLock.unlock();
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Exact match first, then the least recently used layout that can be patched, and only then a
+// fresh layout, written over the least recently used entry once the cache is full
+//
+CachedTextLayout const& BitmapFont::FindOrAddTextLayout( uint64_t layoutKey, AABB2 const& box, float cellHeight, std::string_view text, Rgba8 const& tint, float cellAspect, Vec2 const& alignment, TextBoxMode mode )
+{
+	m_textLayoutUseCount++;
+
+	CachedTextLayout* patchableLayout = nullptr;
+	CachedTextLayout* oldestLayout = nullptr;
+	for ( CachedTextLayout& layout : m_cachedTextLayouts )
+	{
+		if ( layout.m_layoutKey == layoutKey && std::string_view( layout.m_text ) == text )
+		{
+			layout.m_lastUsed = m_textLayoutUseCount;
+			return layout;
+		}
+
+		if ( CanPatchTextLayout( layout, layoutKey, text ) && ( patchableLayout == nullptr || layout.m_lastUsed < patchableLayout->m_lastUsed ) )
+		{
+			patchableLayout = &layout;
+		}
+
+		if ( oldestLayout == nullptr || layout.m_lastUsed < oldestLayout->m_lastUsed )
+		{
+			oldestLayout = &layout;
+		}
+	}
+
+	if ( patchableLayout )
+	{
+		PatchTextLayout( *patchableLayout, text );
+		patchableLayout->m_lastUsed = m_textLayoutUseCount;
+		return *patchableLayout;
+	}
+
+	CachedTextLayout* newLayout = oldestLayout;
+	if ( static_cast< int >( m_cachedTextLayouts.size() ) < MAX_CACHED_TEXT_LAYOUTS )
+	{
+		m_cachedTextLayouts.emplace_back();
+		newLayout = &m_cachedTextLayouts.back();
 	}
+
+	newLayout->m_layoutKey = layoutKey;
+	newLayout->m_text.assign( text );
+	newLayout->m_verts.clear();
+	newLayout->m_lastUsed = m_textLayoutUseCount;
+	AddVertsForTextInBox2D( newLayout->m_verts, box, cellHeight, text, tint, cellAspect, alignment, mode );
+	return *newLayout;
 }
 
 
 //------------------------------------------------------------------------------------------------
-std::string BitmapFont::GetFontPathWithoutExtension() const
+// Patching keeps every glyph quad where it is, so it needs a single line of the same length whose
+// changed glyphs are all as wide as the ones they replace
+//
+bool BitmapFont::CanPatchTextLayout( CachedTextLayout const& layout, uint64_t layoutKey, std::string_view text ) const
+{
+	if ( layout.m_layoutKey != layoutKey || layout.m_text.length() != text.length() )
+		return false;
+
+	if ( layout.m_verts.size() != text.length() * 6 )
+		return false;
+
+	for ( size_t charNum = 0; charNum < text.length(); charNum++ )
+	{
+		unsigned char oldCharacter = layout.m_text[ charNum ];
+		unsigned char newCharacter = text[ charNum ];
+		if ( oldCharacter == '\n' || newCharacter == '\n' )
+			return false;
+
+		if ( oldCharacter != newCharacter && GetGlyphAspect( oldCharacter ) != GetGlyphAspect( newCharacter ) )
+			return false;
+	}
+
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Each glyph is one AddVertsForAABB2D quad, so every UV sits on a corner of the old glyph's rect
+// and moves to the same corner of the new one
+//
+void BitmapFont::PatchTextLayout( CachedTextLayout& layout, std::string_view text ) const
+{
+	for ( size_t charNum = 0; charNum < text.length(); charNum++ )
+	{
+		unsigned char oldCharacter = layout.m_text[ charNum ];
+		unsigned char newCharacter = text[ charNum ];
+		if ( oldCharacter == newCharacter )
+			continue;
+
+		Vec2 oldUVMins;
+		Vec2 oldUVMaxs;
+		m_fontGlyphsSpriteSheet.GetSpriteUVs( oldUVMins, oldUVMaxs, oldCharacter );
+
+		Vec2 newUVMins;
+		Vec2 newUVMaxs;
+		m_fontGlyphsSpriteSheet.GetSpriteUVs( newUVMins, newUVMaxs, newCharacter );
+
+		for ( size_t vertNum = charNum * 6; vertNum < ( charNum + 1 ) * 6; vertNum++ )
+		{
+			Vec2& uv = layout.m_verts[ vertNum ].m_uvTexCoords;
+			uv.x = ( uv.x == oldUVMins.x ) ? newUVMins.x : newUVMaxs.x;
+			uv.y = ( uv.y == oldUVMins.y ) ? newUVMins.y : newUVMaxs.y;
+		}
+
+		layout.m_text[ charNum ] = text[ charNum ];
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+std::string const& BitmapFont::GetFontPathWithoutExtension() const
 {
 	return m_fontFilePathNameWithNoExtension;
 }
@@ -147,7 +330,7 @@ float BitmapFont::GetGlyphAspect( int glyphUnicode ) const
 
 
 //------------------------------------------------------------------------------------------------
-float BitmapFont::GetPureTextWidth( std::string const& text ) const
+float BitmapFont::GetPureTextWidth( std::string_view text ) const
 {
 	int numChars = static_cast< int >( text.length() );
 	float widthofText = 0.0f;
@@ -160,3 +343,11 @@ float BitmapFont::GetPureTextWidth( std::string const& text ) const
 	return widthofText;
 }
 
+
+//------------------------------------------------------------------------------------------------
+template void BitmapFont::AddVertsForText2D( std::vector<Vertex_PCU>& vertexArray, Vec2 const& textMins, float cellHeight, std::string_view text, Rgba8 const& tint, float cellAspect );
+template void BitmapFont::AddVertsForText2D( FrameVector<Vertex_PCU>& vertexArray, Vec2 const& textMins, float cellHeight, std::string_view text, Rgba8 const& tint, float cellAspect );
+template void BitmapFont::AddVertsForTextInBox2D( std::vector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight, std::string_view text, Rgba8 const& tint, float cellAspect, Vec2 const& alignment, TextBoxMode mode, int maxGlyphsToDraw );
+template void BitmapFont::AddVertsForTextInBox2D( FrameVector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight, std::string_view text, Rgba8 const& tint, float cellAspect, Vec2 const& alignment, TextBoxMode mode, int maxGlyphsToDraw );
+template void BitmapFont::AddCachedVertsForTextInBox2D( std::vector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight, std::string_view text, Rgba8 const& tint, float cellAspect, Vec2 const& alignment, TextBoxMode mode );
+template void BitmapFont::AddCachedVertsForTextInBox2D( FrameVector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight, std::string_view text, Rgba8 const& tint, float cellAspect, Vec2 const& alignment, TextBoxMode mode );
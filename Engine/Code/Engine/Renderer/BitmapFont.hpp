@@ -1,7 +1,10 @@
 #pragma once
 #include "Engine/Renderer/VertexData/Vertex_PCU.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "SpriteSheet.hpp"
 
@@ -14,10 +17,24 @@ enum class TextBoxMode{
 
 
 
+//------------------------------------------------------------------------------------------------
+// One laid out string. m_layoutKey hashes every argument except the text, so two entries with the
+// same key and text length differ only in which glyphs they show
+//
+struct CachedTextLayout
+{
+	uint64_t                m_layoutKey = 0;
+	std::string             m_text;
+	std::vector<Vertex_PCU> m_verts;
+	uint64_t                m_lastUsed = 0;
+};
+
+
 //------------------------------------------------------------------------------------------------
 class BitmapFont
 {
 	friend class Renderer; // Only the RenderContext can create new BitmapFont objects!
+	friend struct TextLayoutTestAccess; // EngineTests checks the layout cache without a Renderer
 
 private:
 	BitmapFont(char const* fontFilePathNameWithNoExtension, Texture const& fontTexture);
@@ -25,21 +42,44 @@ private:
 public:
 	Texture const& GetTexture() const;
 
-	void AddVertsForText2D(std::vector<Vertex_PCU>& vertexArray, Vec2 const& textMins,
-		float cellHeight, std::string const& text, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f);
+	// VERTEX_LIST is std::vector<Vertex_PCU> or FrameVector<Vertex_PCU>
+	template <typename VERTEX_LIST>
+	void AddVertsForText2D(VERTEX_LIST& vertexArray, Vec2 const& textMins,
+		float cellHeight, std::string_view text, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f);
 
-	void AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight,
-		std::string const& text, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f,
+	template <typename VERTEX_LIST>
+	void AddVertsForTextInBox2D(VERTEX_LIST& vertexArray, AABB2 const& box, float cellHeight,
+		std::string_view text, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f,
 		Vec2 const& alignment = Vec2(.5f, .5f), TextBoxMode mode = TextBoxMode::SHRINK, int maxGlyphsToDraw = 99999999);
 
+	// Same result as AddVertsForTextInBox2D, but repeated calls copy the verts from the last layout.
+	// A string that only changed some characters (FPS counters, positions) patches those glyphs'
+	// UVs into an older layout of the same length instead of laying the whole string out again
+	template <typename VERTEX_LIST>
+	void AddCachedVertsForTextInBox2D(VERTEX_LIST& vertexArray, AABB2 const& box, float cellHeight,
+		std::string_view text, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f,
+		Vec2 const& alignment = Vec2(.5f, .5f), TextBoxMode mode = TextBoxMode::SHRINK);
+	void ClearTextLayoutCache();
 
-	std::string GetFontPathWithoutExtension() const;
+
+	std::string const& GetFontPathWithoutExtension() const;
 
 protected:
 	float GetGlyphAspect(int glyphUnicode) const;
-	float GetPureTextWidth(std::string const& text) const;
+	float GetPureTextWidth(std::string_view text) const;
+
+	CachedTextLayout const& FindOrAddTextLayout(uint64_t layoutKey, AABB2 const& box, float cellHeight,
+		std::string_view text, Rgba8 const& tint, float cellAspect, Vec2 const& alignment, TextBoxMode mode);
+	bool CanPatchTextLayout(CachedTextLayout const& layout, uint64_t layoutKey, std::string_view text) const;
+	void PatchTextLayout(CachedTextLayout& layout, std::string_view text) const;
 
 protected:
-	std::string	m_fontFilePathNameWithNoExtension;
-	SpriteSheet	m_fontGlyphsSpriteSheet;
+	static constexpr int MAX_CACHED_TEXT_LAYOUTS = 128;
+
+	std::string						m_fontFilePathNameWithNoExtension;
+	SpriteSheet						m_fontGlyphsSpriteSheet;
+
+	std::vector<CachedTextLayout>	m_cachedTextLayouts;
+	uint64_t						m_textLayoutUseCount = 0;
+	std::mutex						m_textLayoutCacheLock;		// debug text can be added from any thread
 };
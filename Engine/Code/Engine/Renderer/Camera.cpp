@@ -1,6 +1,11 @@
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Renderer/Camera.hpp"
 
+
+//------------------------------------------------------------------------------------------------
+int Camera::s_numMatrixRebuilds = 0;
+
+
 //------------------------------------------------------------------------------------------------
 Vec3 Camera::GetOrthoBottomLeft() const
 {
@@ -30,17 +35,22 @@ EulerAngles Camera::GetOrientation() const
 
 
 //------------------------------------------------------------------------------------------------
-Mat44 Camera::GetProjectionMatrix() const
+Mat44 const& Camera::GetProjectionMatrix() const
 {
-	Mat44 matrix;
+	if ( !m_isProjectionDirty )
+		return m_cachedProjectionMatrix;
+
+	s_numMatrixRebuilds++;
+	m_isProjectionDirty = false;
+	m_cachedProjectionMatrix  = Mat44();
 
 	if ( m_cameraType == CameraType::ORTHOGRAPHIC )
-		return Mat44::CreateOrthoProjection( m_orthoBottomLeft.x, m_orthoTopRight.x, m_orthoBottomLeft.y, m_orthoTopRight.y, m_orthoBottomLeft.z, m_orthoTopRight.z );
+		m_cachedProjectionMatrix = Mat44::CreateOrthoProjection( m_orthoBottomLeft.x, m_orthoTopRight.x, m_orthoBottomLeft.y, m_orthoTopRight.y, m_orthoBottomLeft.z, m_orthoTopRight.z );
 
 	else if ( m_cameraType == CameraType::PERSPECTIVE )
-		return Mat44::CreatePerspectiveProjection( m_fieldOfView, m_aspect, m_zNear, m_zFar );
+		m_cachedProjectionMatrix = Mat44::CreatePerspectiveProjection( m_fieldOfView, m_aspect, m_zNear, m_zFar );
 
-	return matrix;
+	return m_cachedProjectionMatrix;
 }
 
 
@@ -67,7 +77,7 @@ Mat44 Camera::GetCameraOrientationMatrix() const
 
 
 //------------------------------------------------------------------------------------------------
-Mat44 Camera::GetViewMatrix() const
+Mat44 Camera::ComputeViewMatrix() const
 {
 	Mat44 viewMatrix;
 
@@ -80,6 +90,24 @@ Mat44 Camera::GetViewMatrix() const
 }
 
 
+//------------------------------------------------------------------------------------------------
+Mat44 const& Camera::GetViewMatrix() const
+{
+	if ( m_isViewDirty )
+	{
+		s_numMatrixRebuilds++;
+		m_isViewDirty = false;
+
+		m_cachedViewMatrix = ComputeViewMatrix();
+		
+		m_cachedRenderViewMatrix = m_gameSpace;
+		m_cachedRenderViewMatrix.Append( m_cachedViewMatrix );
+	}
+
+	return m_cachedViewMatrix;
+}
+
+
 //------------------------------------------------------------------------------------------------
 Mat44 Camera::GetRenderMatrix() const
 {
@@ -87,6 +115,46 @@ Mat44 Camera::GetRenderMatrix() const
 }
 
 
+//------------------------------------------------------------------------------------------------
+Mat44 const& Camera::GetRenderViewMatrix() const
+{
+	GetViewMatrix();
+	return m_cachedRenderViewMatrix;
+}
+
+
+//------------------------------------------------------------------------------------------------
+Mat44 const& Camera::GetViewProjectionMatrix() const
+{
+	if ( m_isViewProjectionDirty || m_isViewDirty || m_isProjectionDirty )
+	{
+		m_cachedViewProjectionMatrix = GetProjectionMatrix();
+		m_cachedViewProjectionMatrix.Append( GetRenderViewMatrix() );
+
+		s_numMatrixRebuilds++;
+		m_isViewProjectionDirty = false;
+	}
+
+	return m_cachedViewProjectionMatrix;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void Camera::MarkViewDirty()
+{
+	m_isViewDirty           = true;
+	m_isViewProjectionDirty = true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void Camera::MarkProjectionDirty()
+{
+	m_isProjectionDirty     = true;
+	m_isViewProjectionDirty = true;
+}
+
+
 //------------------------------------------------------------------------------------------------
 void Camera::SetGameSpace( Vec3 const& gameRight, Vec3 const& gameUp, Vec3 const& gameAway )
 {
@@ -103,36 +171,58 @@ void Camera::SetGameSpace( Vec3 const& gameRight, Vec3 const& gameUp, Vec3 const
 	m_gameSpace.m_values[ Mat44::Kz ] = gameAway.z;
 
 	m_gameSpace = m_gameSpace.GetOrthonormalInverse();
+	MarkViewDirty();
 }
 
 
 //------------------------------------------------------------------------------------------------
 void Camera::SetCameraPositionAndOrientation( Vec3 position, EulerAngles const& orientation )
 {
+	if ( m_position == position &&
+		 m_orientation.m_yawDegrees == orientation.m_yawDegrees &&
+		 m_orientation.m_pitchDegrees == orientation.m_pitchDegrees &&
+		 m_orientation.m_rollDegrees == orientation.m_rollDegrees )
+	{
+		return;
+	}
+
 	m_position = position;
 	m_orientation = orientation;
+	MarkViewDirty();
 }
 
 
 //------------------------------------------------------------------------------------------------
 void Camera::SetFieldOfView( float fov )
 {
+	if ( m_fieldOfView == fov )
+		return;
+
 	m_fieldOfView = fov;
+	MarkProjectionDirty();
 }
 
 
 //------------------------------------------------------------------------------------------------
 void Camera::SetAspect( float aspect )
 {
+	if ( m_aspect == aspect )
+		return;
+
 	m_aspect = aspect;
+	MarkProjectionDirty();
 }
 
 
 //------------------------------------------------------------------------------------------------
 void Camera::SetZNearZFar( float near, float far )
 {
+	if ( m_zNear == near && m_zFar == far )
+		return;
+
 	m_zNear = near;
 	m_zFar  = far;
+	MarkProjectionDirty();
 }
 
 
@@ -169,6 +259,7 @@ void Camera::SetOrthoView( Vec3 const& bottomLeft, Vec3 const& topRight )
 {
 	m_orthoBottomLeft = bottomLeft;
 	m_orthoTopRight = topRight;
+	MarkProjectionDirty();
 }
 
 
@@ -202,7 +293,11 @@ AABB2 Camera::GetViewport( Vec2 const& outputSize ) const
 //------------------------------------------------------------------------------------------------
 void Camera::SetCameraType( CameraType type )
 {
+	if ( m_cameraType == type )
+		return;
+
 	m_cameraType = type;
+	MarkProjectionDirty();
 }
 
 
@@ -211,4 +306,19 @@ void Camera::Translate3D( const Vec3& translation3D )
 {
 	m_orthoBottomLeft += translation3D;
 	m_orthoTopRight += translation3D;
+	MarkProjectionDirty();
+}
+
+
+//------------------------------------------------------------------------------------------------
+int Camera::GetNumMatrixRebuilds()
+{
+	return s_numMatrixRebuilds;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void Camera::ResetNumMatrixRebuilds()
+{
+	s_numMatrixRebuilds = 0;
 }
\ No newline at end of file
@@ -40,6 +40,23 @@ private:
 
 	AABB2       m_normalizedViewport = AABB2::ZEROTOONE;
 
+protected:
+	mutable Mat44 m_cachedViewMatrix;
+	mutable Mat44 m_cachedRenderViewMatrix;
+	mutable Mat44 m_cachedProjectionMatrix;
+	mutable Mat44 m_cachedViewProjectionMatrix;
+
+	mutable bool  m_isViewDirty           = true;
+	mutable bool  m_isProjectionDirty     = true;
+	mutable bool  m_isViewProjectionDirty = true;
+
+	static int    s_numMatrixRebuilds;
+
+protected:
+	virtual Mat44         ComputeViewMatrix() const;
+	void                  MarkViewDirty();
+	void                  MarkProjectionDirty();
+
 public:
 	void                  SetOrthoView(Vec3 const& bottomLeft, Vec3 const& topRight);
 	void                  SetNormalizedViewport( AABB2 const& viewport = AABB2::ZEROTOONE );
@@ -53,11 +70,13 @@ public:
 	virtual Vec3          GetPosition() const;
 	virtual EulerAngles   GetOrientation() const;
 		  		  
-	Mat44                 GetProjectionMatrix() const;
+	Mat44 const&          GetProjectionMatrix() const;
 	Mat44                 GetCameraModelMatrix() const;
 	Mat44                 GetCameraOrientationMatrix() const;
-	virtual Mat44         GetViewMatrix() const;
+	Mat44 const&          GetViewMatrix() const;
 	Mat44                 GetRenderMatrix() const;
+	Mat44 const&          GetRenderViewMatrix() const;
+	Mat44 const&          GetViewProjectionMatrix() const;
 		                  		        
 	void                  SetGameSpace(Vec3 const& gameRight, Vec3 const& gameUp, Vec3 const& gameAway );
 	void                  SetCameraPositionAndOrientation( Vec3 position, EulerAngles const& orientation );
@@ -71,4 +90,7 @@ public:
 	float                 GetFOV() const;
 
 	void                  Translate3D(const Vec3& translation2D);
+
+	static int            GetNumMatrixRebuilds();
+	static void           ResetNumMatrixRebuilds();
 };
@@ -1,71 +1,90 @@
 #include "Engine/Core/Clock.hpp"
-#include "Engine/Core/Stopwatch.hpp"
 #include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/FrameArena.hpp"
 #include "Engine/Math/Mathutils.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
 #include "Engine/Renderer/VertexData/VertexUtils.hpp"
 #include "Engine/Renderer/VertexData/Vertex_PCU.hpp"
 
-#include <vector>
+#include <algorithm>
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 
 #if defined(ENGINE_DEBUG_RENDERING)
 
 //------------------------------------------------------------------------
-enum class DebugWorldObjectType
-{
-	POINT,
-	LINE,
-	CYLINDER,
-	SPHERE,
-	SOLIDSPHERE,
-	FRUSTUM,
-	WIREAABB,
-	ARROW,
-	BASIS,
-	TEXT,
-	BILLBOARDTEXT
+// Shapes built once at startup in unit space; each debug object places one with its transform
+//
+enum class DebugMesh : unsigned char
+{
+	CUSTOM,			// the object's own verts in its list's custom vert pool ( text )
+	CUBE,			// size 1, centered on the origin
+	CYLINDER,		// radius 1, z from 0 to 1, 16 slices
+	LINE,			// radius 1, z from 0 to 1, 8 slices
+	SPHERE,			// radius 1, 16 slices by 8 stacks
+	ARROW,			// shaft radius 0.25 to z 0.8, cone radius 0.5 to z 1
+	BASIS,			// red, green and blue unit arrows along i, j and k
+	NUM_MESHES
 };
 
 
 //------------------------------------------------------------------------
-enum class DebugScreenObjectType
+enum class DebugPlacement : unsigned char
 {
-	TEXT,
-	MESSAGE
+	FIXED,			// transform used as is
+	BILLBOARD,		// transform translation only, rotated to face the camera when drawn
+	MESSAGE			// stacked under the top right corner of the screen camera when drawn
+};
+
+
+//------------------------------------------------------------------------
+// Everything that changes pipeline state between debug draws; objects sharing one are drawn as a
+// single range of the frame's debug vertex stream
+//
+struct DebugDrawState
+{
+	DebugRenderMode m_renderMode = DebugRenderMode::USE_DEPTH;
+	RasterState     m_rasterState;
+	Texture const*  m_texture    = nullptr;
 };
 
 
 //------------------------------------------------------------------------
-struct DebugScreenObject
-{
-	std::vector<Vertex_PCU> m_localVerts;
-	Stopwatch               m_lifeTimeStopWatch;
-	Rgba8                   m_startColor;
-	Rgba8                   m_endColor;
-	DebugRenderMode         m_renderMode;
-	Mat44                   m_transformMatrix;
-	DebugScreenObjectType   m_objectType;
-	Texture const* m_texture = nullptr;
+struct DebugDrawRange
+{
+	int m_firstVert = 0;
+	int m_numVerts  = 0;
+	int m_nextVert  = 0;		// write cursor while the stream is being built
 };
 
 
 //------------------------------------------------------------------------
-struct DebugWorldObject
-{
-	std::vector<Vertex_PCU> m_localVerts;
-	Stopwatch               m_lifeTimeStopWatch;
-	Rgba8                   m_startColor;
-	Rgba8                   m_endColor;
-	DebugRenderMode         m_renderMode;
-	Mat44                   m_modelMatrix;
-	DebugWorldObjectType    m_objectType;
-	RasterState             m_rasterState;
-	Texture const* m_texture = nullptr;
+// Live debug objects as parallel arrays, one entry per object in the order they were added.
+// Objects with their own verts ( text ) reference a range of m_customVerts, which is kept in the
+// same order so compaction can slide both down together
+//
+struct DebugObjectList
+{
+	std::vector<double>         m_startSeconds;
+	std::vector<float>          m_durations;			// negative lives until cleared, zero draws for one frame
+	std::vector<Rgba8>          m_startColors;
+	std::vector<Rgba8>          m_endColors;
+	std::vector<Mat44>          m_transforms;
+	std::vector<DebugMesh>      m_meshes;
+	std::vector<DebugPlacement> m_placements;
+	std::vector<unsigned short> m_drawStates;			// index into DebugRenderer::m_drawStates
+	std::vector<int>            m_firstCustomVerts;
+	std::vector<int>            m_numCustomVerts;
+	std::vector<Vertex_PCU>     m_customVerts;
+
+	int  GetNumObjects() const		{ return static_cast< int >( m_durations.size() ); }
+	void RemoveExpired( double totalSeconds );
+	void Clear();
 };
 
 
@@ -76,8 +95,14 @@ public:
 	Clock* m_debugClock = nullptr;
 	DebugRenderConfig              m_config;
 	std::atomic<bool>              m_isVisible = false;
-	std::vector<DebugWorldObject>  m_worldObjects;
-	std::vector<DebugScreenObject> m_screenObjects;
+	DebugObjectList                m_worldObjects;
+	DebugObjectList                m_screenObjects;
+	std::vector<DebugDrawState>    m_drawStates;			// found or added by the Add functions, never removed
+	std::vector<DebugDrawRange>    m_drawRanges;			// one per draw state, rebuilt for every stream
+	DebugVertexStream              m_worldStream;			// reused by DebugRenderWorldToCamera and DebugRenderScreenToCamera
+	DebugVertexStream              m_screenStream;
+	std::vector<Vertex_PCU>        m_unitMeshes[ static_cast< int >( DebugMesh::NUM_MESHES ) ];
+	VertexBuffer*                  m_streamVBO = nullptr;	// every debug vert drawn to a camera goes through this one buffer
 };
 
 
@@ -87,651 +112,730 @@ std::mutex g_debugRenderLock;
 
 
 //-----------------------------------------------------------------------------------------------
-bool DebugRenderClear( EventArgs& args )
+// Compacts the arrays in place, keeping add order; custom verts only ever slide down, so a forward
+// copy is safe
+//
+void DebugObjectList::RemoveExpired( double totalSeconds )
 {
-	UNUSED( args );
-	DebugRenderClear();
-	return true;
-}
+	int numObjects   = GetNumObjects();
+	int numKept      = 0;
+	int numKeptVerts = 0;
 
+	for ( int objNum = 0; objNum < numObjects; objNum++ )
+	{
+		float duration   = m_durations[ objNum ];
+		bool  hasElapsed = totalSeconds - m_startSeconds[ objNum ] >= static_cast< double >( duration );
+		if ( hasElapsed && duration >= 0.0f )
+			continue;
+
+		int firstVert = m_firstCustomVerts[ objNum ];
+		int numVerts  = m_numCustomVerts[ objNum ];
+		if ( firstVert != numKeptVerts )
+		{
+			std::copy( m_customVerts.begin() + firstVert, m_customVerts.begin() + firstVert + numVerts, m_customVerts.begin() + numKeptVerts );
+		}
 
-//-----------------------------------------------------------------------------------------------
-bool DebugRenderToggle( EventArgs& args )
-{
-	UNUSED( args );
-
-	if ( !g_theDebugRenderer.m_isVisible )
-		DebugRenderSetVisible();
+		if ( objNum != numKept )
+		{
+			m_startSeconds[ numKept ]   = m_startSeconds[ objNum ];
+			m_durations[ numKept ]      = m_durations[ objNum ];
+			m_startColors[ numKept ]    = m_startColors[ objNum ];
+			m_endColors[ numKept ]      = m_endColors[ objNum ];
+			m_transforms[ numKept ]     = m_transforms[ objNum ];
+			m_meshes[ numKept ]         = m_meshes[ objNum ];
+			m_placements[ numKept ]     = m_placements[ objNum ];
+			m_drawStates[ numKept ]     = m_drawStates[ objNum ];
+			m_numCustomVerts[ numKept ] = numVerts;
+		}
 
-	else
-		DebugRenderSetHidden();
+		m_firstCustomVerts[ numKept ] = numKeptVerts;
+		numKeptVerts += numVerts;
+		numKept++;
+	}
 
-	return true;
+	m_startSeconds.resize( numKept );
+	m_durations.resize( numKept );
+	m_startColors.resize( numKept );
+	m_endColors.resize( numKept );
+	m_transforms.resize( numKept );
+	m_meshes.resize( numKept );
+	m_placements.resize( numKept );
+	m_drawStates.resize( numKept );
+	m_firstCustomVerts.resize( numKept );
+	m_numCustomVerts.resize( numKept );
+	m_customVerts.resize( numKeptVerts );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-bool DebugRenderSetTimeScale( EventArgs& args )
+void DebugObjectList::Clear()
 {
-	float scale = args.GetValue( "Scale", 1.0f );
+	m_startSeconds.clear();
+	m_durations.clear();
+	m_startColors.clear();
+	m_endColors.clear();
+	m_transforms.clear();
+	m_meshes.clear();
+	m_placements.clear();
+	m_drawStates.clear();
+	m_firstCustomVerts.clear();
+	m_numCustomVerts.clear();
+	m_customVerts.clear();
+}
 
-	g_theDebugRenderer.m_debugClock->SetTimeDilation( scale );
 
-	return true;
+//-----------------------------------------------------------------------------------------------
+static std::vector<Vertex_PCU>& GetUnitMesh( DebugMesh mesh )
+{
+	return g_theDebugRenderer.m_unitMeshes[ static_cast< int >( mesh ) ];
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugRenderSystemStartup( DebugRenderConfig const& config )
+static void BuildUnitMeshes()
 {
-	g_theDebugRenderer.m_config = config;
-	g_theDebugRenderer.m_isVisible = config.m_startHidden;
-	g_theDebugRenderer.m_debugClock = new Clock();
+	AddVertsForAABBZ3D( GetUnitMesh( DebugMesh::CUBE ), AABB3( -0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f ) );
+	AddVertsForCylinderZ3D( GetUnitMesh( DebugMesh::CYLINDER ), Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, 1.0f ), 1.0f, 16.f );
+	AddVertsForCylinderZ3D( GetUnitMesh( DebugMesh::LINE ), Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, 1.0f ), 1.0f, 8.f );
+	AddVertsForUVSphereZ3D( GetUnitMesh( DebugMesh::SPHERE ), Vec3( 0.0f, 0.0f, 0.0f ), 1.0f, 16.f, 8.f );
 
-	SubscribeEventCallbackFunction( "DebugRenderToggle", DebugRenderToggle );
-	SubscribeEventCallbackFunction( "DebugRenderClear", DebugRenderClear );
-	SubscribeEventCallbackFunction( "DebugRenderSetTimeScale", DebugRenderSetTimeScale );
+	std::vector<Vertex_PCU>& arrowVerts = GetUnitMesh( DebugMesh::ARROW );
+	AddVertsForCylinderZ3D( arrowVerts, Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, 0.8f ), 0.25f, 16.f );
+	AddVertsForConeZ3D( arrowVerts, Vec2( 0.0f, 0.0f ), FloatRange( 0.8f, 1.0f ), 0.5f, 16.f );
+
+	// Each axis is built along Z, then the verts just appended are rotated into place
+	std::vector<Vertex_PCU>& basisVerts = GetUnitMesh( DebugMesh::BASIS );
+	Mat44 transformMatrix;
+	transformMatrix.AppendYRotation( 90.0f );
+	size_t axisStart = basisVerts.size();
+	AddVertsForCylinderZ3D( basisVerts, Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, 0.8f ), 0.150f * 0.25f, 16.f, Rgba8::RED );
+	AddVertsForConeZ3D( basisVerts, Vec2( 0.0f, 0.0f ), FloatRange( 0.8f, 1.f ), 0.150f * 0.5f, 16.f, Rgba8::RED );
+	TransformVertexArrayUsingMatrix( static_cast< int >( basisVerts.size() - axisStart ), basisVerts.data() + axisStart, transformMatrix );
+
+	transformMatrix = Mat44();
+	transformMatrix.AppendXRotation( -90.0f );
+	axisStart = basisVerts.size();
+	AddVertsForCylinderZ3D( basisVerts, Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, 0.8f ), 0.150f * 0.25f, 16.f, Rgba8::GREEN );
+	AddVertsForConeZ3D( basisVerts, Vec2( 0.0f, 0.0f ), FloatRange( 0.8f, 1.f ), 0.150f * 0.5f, 16.f, Rgba8::GREEN );
+	TransformVertexArrayUsingMatrix( static_cast< int >( basisVerts.size() - axisStart ), basisVerts.data() + axisStart, transformMatrix );
+
+	AddVertsForCylinderZ3D( basisVerts, Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, 0.8f ), 0.150f * 0.25f, 16.f, Rgba8::BLUE );
+	AddVertsForConeZ3D( basisVerts, Vec2( 0.0f, 0.0f ), FloatRange( 0.8f, 1.f ), 0.150f * 0.5f, 16.f, Rgba8::BLUE );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugRenderSystemShutdown()
+static BitmapFont* GetDebugFont()
 {
-	DebugRenderClear();
-	delete( g_theDebugRenderer.m_debugClock );
-	g_theDebugRenderer.m_debugClock = nullptr;
+	return g_theDebugRenderer.m_config.m_renderer->CreateOrGetBitmapFontFromFile( "Data/Fonts/FixedFont" );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugRenderSetVisible()
+static DebugDrawState MakeDrawState( DebugRenderMode mode, CullMode cullMode, FillMode fillMode, Texture const* texture = nullptr )
 {
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_isVisible = true;
-	g_debugRenderLock.unlock();
+	DebugDrawState state;
+	state.m_renderMode                 = mode;
+	state.m_rasterState.m_cullmode     = cullMode;
+	state.m_rasterState.m_fillMode     = fillMode;
+	state.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
+	state.m_texture                    = texture;
+	return state;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugRenderSetHidden()
+// Caller holds g_debugRenderLock
+//
+static unsigned short FindOrAddDrawState( DebugDrawState const& state )
 {
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_isVisible = false;
-	g_debugRenderLock.unlock();
+	std::vector<DebugDrawState>& drawStates = g_theDebugRenderer.m_drawStates;
+	for ( size_t stateNum = 0; stateNum < drawStates.size(); stateNum++ )
+	{
+		DebugDrawState const& existing = drawStates[ stateNum ];
+		if ( existing.m_renderMode == state.m_renderMode && existing.m_texture == state.m_texture &&
+			existing.m_rasterState.m_cullmode == state.m_rasterState.m_cullmode &&
+			existing.m_rasterState.m_fillMode == state.m_rasterState.m_fillMode &&
+			existing.m_rasterState.m_windingOrder == state.m_rasterState.m_windingOrder )
+		{
+			return static_cast< unsigned short >( stateNum );
+		}
+	}
+
+	drawStates.push_back( state );
+	return static_cast< unsigned short >( drawStates.size() - 1 );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugRenderClear()
+static void AddDebugObject( DebugObjectList& list, DebugMesh mesh, Mat44 const& transform, float duration, Rgba8 startColor, Rgba8 endColor, DebugDrawState const& state,
+	DebugPlacement placement = DebugPlacement::FIXED, Vertex_PCU const* customVerts = nullptr, int numCustomVerts = 0 )
 {
 	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.erase( g_theDebugRenderer.m_worldObjects.begin(), g_theDebugRenderer.m_worldObjects.end() );
-	g_theDebugRenderer.m_screenObjects.erase( g_theDebugRenderer.m_screenObjects.begin(), g_theDebugRenderer.m_screenObjects.end() );
+
+	list.m_startSeconds.push_back( g_theDebugRenderer.m_debugClock->GetTotalSeconds() );
+	list.m_durations.push_back( duration );
+	list.m_startColors.push_back( startColor );
+	list.m_endColors.push_back( endColor );
+	list.m_transforms.push_back( transform );
+	list.m_meshes.push_back( mesh );
+	list.m_placements.push_back( placement );
+	list.m_drawStates.push_back( FindOrAddDrawState( state ) );
+	list.m_firstCustomVerts.push_back( static_cast< int >( list.m_customVerts.size() ) );
+	list.m_numCustomVerts.push_back( numCustomVerts );
+	list.m_customVerts.insert( list.m_customVerts.end(), customVerts, customVerts + numCustomVerts );
+
 	g_debugRenderLock.unlock();
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugRenderBeginFrame()
+// Maps the unit mesh Z axis onto start -> end, with radius scaling the other two axes
+//
+static Mat44 GetSegmentTransform( Vec3 const& start, Vec3 const& end, float radius )
 {
+	Vec3 startToEnd = end - start;
 
-}
+	Vec3 kBasis( startToEnd );
 
+	kBasis = kBasis.GetNormalized();
 
-//-----------------------------------------------------------------------------------------------
-void DebugRenderWorldToCamera( Camera const& camera )
-{
-	if ( !g_theDebugRenderer.m_isVisible )
-		return;
+	Vec3 iBasis;
+	Vec3 jBasis = CrossProduct3D( kBasis, Vec3( 1.0f, 0.0f, 0.0f ) ).GetNormalized();
 
-	Renderer* renderer = g_theDebugRenderer.m_config.m_renderer;
-	renderer->SetBlendMode( BlendMode::ALPHA );
-	renderer->BindShader( nullptr );
-	int numWorldObjects = static_cast< int >( g_theDebugRenderer.m_worldObjects.size() );
-	for ( int objNum = 0; objNum < numWorldObjects; objNum++ )
+	if ( jBasis.GetLength() == 0 )
 	{
-		DebugWorldObject const& obj = g_theDebugRenderer.m_worldObjects[ objNum ];
-		if ( !obj.m_lifeTimeStopWatch.HasElapsed() || obj.m_lifeTimeStopWatch.GetDuration() <= 0.0 )
-		{
-			ModelTransformationData data;
-			Rgba8::LerpColor( obj.m_startColor, obj.m_endColor, obj.m_lifeTimeStopWatch.GetDuration() <= 0.0 ? 1.0f : static_cast< float >( obj.m_lifeTimeStopWatch.GetElapsedFraction() ) ).GetAsFloats( data.tint );
-			data.modelMatrix = obj.m_modelMatrix;
+		iBasis = CrossProduct3D( Vec3( 0.0f, 1.0f, 0.0f ), kBasis );
+		jBasis = CrossProduct3D( kBasis, iBasis );
+	}
 
-			if ( obj.m_objectType == DebugWorldObjectType::BILLBOARDTEXT )
-			{
-				Mat44 cameraToText = camera.GetCameraOrientationMatrix();
-				cameraToText.SetIJK3D( -cameraToText.GetJBasis3D(), cameraToText.GetKBasis3D(), -cameraToText.GetIBasis3D() );
+	else
+	{
+		iBasis = CrossProduct3D( jBasis, kBasis );
+	}
 
-				data.modelMatrix = Mat44();
-				data.modelMatrix.AppendTranslation3D( obj.m_modelMatrix.GetTranslation3D() );
-				data.modelMatrix.Append( cameraToText );
-			}
+	Mat44 transform;
+	transform.SetIJKT3D( iBasis, jBasis, kBasis, start );
+	transform.AppendScaleNonUniform3D( Vec3( radius, radius, startToEnd.GetLength() ) );
+	return transform;
+}
 
-			renderer->SetModelBuffer( data );
-			renderer->SetRasterState( obj.m_rasterState );
 
-			if ( obj.m_renderMode == DebugRenderMode::ALWAYS )
-			{
-				renderer->SetDepthOptions( DepthTest::ALWAYS, false );
-			}
+//-----------------------------------------------------------------------------------------------
+static bool IsDebugObjectAlive( DebugObjectList const& list, int objNum, double totalSeconds )
+{
+	float duration = list.m_durations[ objNum ];
+	return duration <= 0.0f || totalSeconds - list.m_startSeconds[ objNum ] < static_cast< double >( duration );
+}
 
-			else
-			{
-				renderer->SetDepthOptions( DepthTest::LESS_EQUAL, true );
-			}
 
-			renderer->BindTexture( obj.m_texture );
-			renderer->DrawVertexArray( static_cast< int >( obj.m_localVerts.size() ), obj.m_localVerts.data() );
+//-----------------------------------------------------------------------------------------------
+static int GetNumDebugObjectVerts( DebugObjectList const& list, int objNum )
+{
+	if ( list.m_meshes[ objNum ] == DebugMesh::CUSTOM )
+	{
+		return list.m_numCustomVerts[ objNum ];
+	}
 
-			if ( obj.m_renderMode == DebugRenderMode::XRAY )
-			{
-				renderer->SetDepthOptions( DepthTest::GREATER, false );
-				data.tint[ 0 ] *= 0.5f;
-				data.tint[ 1 ] *= 0.5f;
-				data.tint[ 2 ] *= 0.5f;
-
-				renderer->SetModelBuffer( data );
-				renderer->BindTexture( obj.m_texture );
-				renderer->DrawVertexArray( static_cast< int >( obj.m_localVerts.size() ), obj.m_localVerts.data() );
-			}
-		}
+	return static_cast< int >( GetUnitMesh( list.m_meshes[ objNum ] ).size() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static Vertex_PCU const* GetDebugObjectVerts( DebugObjectList const& list, int objNum )
+{
+	if ( list.m_meshes[ objNum ] == DebugMesh::CUSTOM )
+	{
+		return list.m_customVerts.data() + list.m_firstCustomVerts[ objNum ];
 	}
 
+	return GetUnitMesh( list.m_meshes[ objNum ] ).data();
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugRenderScreenToCamera( Camera const& camera )
+static Rgba8 MultiplyColors( Rgba8 a, Rgba8 b )
 {
-	if ( !g_theDebugRenderer.m_isVisible )
-		return;
+	return Rgba8( static_cast< unsigned char >( ( a.r * b.r ) / 255 ), static_cast< unsigned char >( ( a.g * b.g ) / 255 ),
+		static_cast< unsigned char >( ( a.b * b.b ) / 255 ), static_cast< unsigned char >( ( a.a * b.a ) / 255 ) );
+}
 
-	Renderer* renderer = g_theDebugRenderer.m_config.m_renderer;
-	int numScreenObjects = static_cast< int >( g_theDebugRenderer.m_screenObjects.size() );
 
-	int messageNum = 3;
+//-----------------------------------------------------------------------------------------------
+// Counting sort by draw state: the first pass sizes each state's range, the second expands every live
+// object into its range in add order, transform and tint baked into the verts. Caller holds g_debugRenderLock
+//
+static int BuildDebugVertexStream( DebugObjectList const& list, Camera const& camera, bool isScreen, DebugVertexStream& out_stream )
+{
+	DebugRenderer& debugRenderer = g_theDebugRenderer;
+	double totalSeconds = debugRenderer.m_debugClock->GetTotalSeconds();
+	int numObjects = list.GetNumObjects();
 
-	renderer->SetBlendMode( BlendMode::ALPHA );
-	renderer->BindShader( nullptr );
+	debugRenderer.m_drawRanges.assign( debugRenderer.m_drawStates.size(), DebugDrawRange() );
 
-	RasterState state;
-	state.m_cullmode = CullMode::BACK;
-	state.m_fillMode = FillMode::SOLID;
-	state.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
-	renderer->SetRasterState( state );
+	int numStreamVerts = 0;
+	for ( int objNum = 0; objNum < numObjects; objNum++ )
+	{
+		if ( !IsDebugObjectAlive( list, objNum, totalSeconds ) )
+			continue;
+
+		int numVerts = GetNumDebugObjectVerts( list, objNum );
+		debugRenderer.m_drawRanges[ list.m_drawStates[ objNum ] ].m_numVerts += numVerts;
+		numStreamVerts += numVerts;
+	}
 
-	for ( int objNum = 0; objNum < numScreenObjects; objNum++ )
+	out_stream.m_drawStateVertCounts.clear();
+	if ( numStreamVerts == 0 )
 	{
-		DebugScreenObject const& obj = g_theDebugRenderer.m_screenObjects[ objNum ];
-		if ( !obj.m_lifeTimeStopWatch.HasElapsed() || obj.m_lifeTimeStopWatch.GetDuration() <= 0.0 )
-		{
-			ModelTransformationData data;
-			Rgba8::LerpColor( obj.m_startColor, obj.m_endColor, obj.m_lifeTimeStopWatch.GetDuration() <= 0.0 ? 0.0f : static_cast< float >( obj.m_lifeTimeStopWatch.GetElapsedFraction() ) ).GetAsFloats( data.tint );
-			data.modelMatrix = obj.m_transformMatrix;
+		out_stream.m_verts.clear();
+		return 0;
+	}
 
-			if ( obj.m_objectType == DebugScreenObjectType::MESSAGE )
-			{
-				Vec2 translationAmount = Vec2( camera.GetOrthoTopRight().x, camera.GetOrthoTopRight().y ) - static_cast< float >( messageNum ) * Vec2( 0.0f, 7.0f );
-				data.modelMatrix.AppendTranslation2D( translationAmount );
-				messageNum++;
-			}
+	int firstVert = 0;
+	for ( DebugDrawRange& range : debugRenderer.m_drawRanges )
+	{
+		range.m_firstVert = firstVert;
+		range.m_nextVert  = firstVert;
+		firstVert        += range.m_numVerts;
+	}
 
-			renderer->SetModelBuffer( data );
-			renderer->BindTexture( obj.m_texture );
-			renderer->DrawVertexArray( static_cast< int >( obj.m_localVerts.size() ), obj.m_localVerts.data() );
-		}
+	out_stream.m_verts.resize( numStreamVerts );
+
+	Mat44 cameraToText;
+	if ( !isScreen )
+	{
+		cameraToText = camera.GetCameraOrientationMatrix();
+		cameraToText.SetIJK3D( -cameraToText.GetJBasis3D(), cameraToText.GetKBasis3D(), -cameraToText.GetIBasis3D() );
 	}
-}
 
+	Vec2 screenTopRight = Vec2( camera.GetOrthoTopRight().x, camera.GetOrthoTopRight().y );
+	int  messageNum     = 3;
 
-//-----------------------------------------------------------------------------------------------
-void DebugRenderEndFrame()
-{
-	for ( int objNum = 0; objNum < static_cast< int >( g_theDebugRenderer.m_worldObjects.size() ); objNum++ )
+	for ( int objNum = 0; objNum < numObjects; objNum++ )
 	{
-		DebugWorldObject const& obj = g_theDebugRenderer.m_worldObjects[ objNum ];
-		if ( obj.m_lifeTimeStopWatch.HasElapsed() && !( obj.m_lifeTimeStopWatch.GetDuration() < 0.0 ) )
+		if ( !IsDebugObjectAlive( list, objNum, totalSeconds ) )
+			continue;
+
+		// Objects without a lifetime show their end color in the world and their start color on screen
+		float duration      = list.m_durations[ objNum ];
+		float colorFraction = isScreen ? 0.0f : 1.0f;
+		if ( duration > 0.0f )
 		{
-			g_theDebugRenderer.m_worldObjects.erase( g_theDebugRenderer.m_worldObjects.begin() + objNum );
-			objNum--;
+			colorFraction = static_cast< float >( ( totalSeconds - list.m_startSeconds[ objNum ] ) / static_cast< double >( duration ) );
 		}
-	}
+		Rgba8 tint = Rgba8::LerpColor( list.m_startColors[ objNum ], list.m_endColors[ objNum ], colorFraction );
 
-	for ( int objNum = 0; objNum < static_cast< int >( g_theDebugRenderer.m_screenObjects.size() ); objNum++ )
-	{
-		DebugScreenObject const& obj = g_theDebugRenderer.m_screenObjects[ objNum ];
-		if ( obj.m_lifeTimeStopWatch.HasElapsed() && !( obj.m_lifeTimeStopWatch.GetDuration() < 0.0 ) )
+		Mat44 transform = list.m_transforms[ objNum ];
+		if ( list.m_placements[ objNum ] == DebugPlacement::BILLBOARD )
+		{
+			transform = Mat44();
+			transform.AppendTranslation3D( list.m_transforms[ objNum ].GetTranslation3D() );
+			transform.Append( cameraToText );
+		}
+
+		else if ( list.m_placements[ objNum ] == DebugPlacement::MESSAGE )
 		{
-			g_theDebugRenderer.m_screenObjects.erase( g_theDebugRenderer.m_screenObjects.begin() + objNum );
-			objNum--;
+			transform.AppendTranslation2D( screenTopRight - static_cast< float >( messageNum ) * Vec2( 0.0f, 7.0f ) );
+			messageNum++;
 		}
+
+		DebugDrawRange&   range      = debugRenderer.m_drawRanges[ list.m_drawStates[ objNum ] ];
+		Vertex_PCU const* localVerts = GetDebugObjectVerts( list, objNum );
+		Vertex_PCU*       streamVerts = out_stream.m_verts.data() + range.m_nextVert;
+		int               numVerts   = GetNumDebugObjectVerts( list, objNum );
+
+		for ( int vertNum = 0; vertNum < numVerts; vertNum++ )
+		{
+			streamVerts[ vertNum ].m_position    = transform.TransformPosition3D( localVerts[ vertNum ].m_position );
+			streamVerts[ vertNum ].m_color       = MultiplyColors( localVerts[ vertNum ].m_color, tint );
+			streamVerts[ vertNum ].m_uvTexCoords = localVerts[ vertNum ].m_uvTexCoords;
+		}
+
+		range.m_nextVert += numVerts;
 	}
+
+	for ( DebugDrawRange const& range : debugRenderer.m_drawRanges )
+	{
+		out_stream.m_drawStateVertCounts.push_back( range.m_numVerts );
+	}
+
+	return numStreamVerts;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldPoint( Vec3 pos, float size, Rgba8 startColor, Rgba8 endColor, float duration, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+// One upload, then one draw per draw state ( two for XRAY ). Caller holds g_debugRenderLock
+//
+static void DrawDebugVertexStream( DebugVertexStream const& stream, bool isScreen )
 {
-	DebugWorldObject obj;
-	obj.m_objectType = DebugWorldObjectType::POINT;
+	Renderer*     renderer       = g_theDebugRenderer.m_config.m_renderer;
+	VertexBuffer* streamVBO      = g_theDebugRenderer.m_streamVBO;
+	int           numStreamVerts = static_cast< int >( stream.m_verts.size() );
 
-	obj.m_rasterState.m_cullmode = CullMode::BACK;
-	obj.m_rasterState.m_fillMode = FillMode::SOLID;
-	obj.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
+	streamVBO->CopyVertexData( stream.m_verts.data(), numStreamVerts * sizeof( Vertex_PCU ), sizeof( Vertex_PCU ) );
 
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
+	ModelTransformationData data;
+	ModelTransformationData xrayData;
+	xrayData.tint[ 0 ] = 0.5f;
+	xrayData.tint[ 1 ] = 0.5f;
+	xrayData.tint[ 2 ] = 0.5f;
 
-	obj.m_startColor = startColor;
-	obj.m_endColor = endColor;
+	renderer->SetBlendMode( BlendMode::ALPHA );
+	renderer->BindShader( nullptr );
+	renderer->SetModelBuffer( data );
 
-	obj.m_renderMode = mode;
+	// States added after the stream was built have no verts in it, so the stream's own counts bound the loop
+	int numDrawStates = static_cast< int >( stream.m_drawStateVertCounts.size() );
+	int firstVert     = 0;
+	for ( int stateNum = 0; stateNum < numDrawStates; stateNum++ )
+	{
+		DebugDrawRange range;
+		range.m_firstVert = firstVert;
+		range.m_numVerts  = stream.m_drawStateVertCounts[ stateNum ];
+		firstVert        += range.m_numVerts;
+		if ( range.m_numVerts == 0 )
+			continue;
 
-	AABB3 pointBounds( -size * 0.5f, -size * 0.5f, -size * 0.5f, size * 0.5f, size * 0.5f, size * 0.5f );
+		DebugDrawState const& state = g_theDebugRenderer.m_drawStates[ stateNum ];
+		renderer->SetRasterState( state.m_rasterState );
 
-	AddVertsForAABBZ3D( obj.m_localVerts, pointBounds, startColor );
+		if ( !isScreen )
+		{
+			if ( state.m_renderMode == DebugRenderMode::ALWAYS )
+			{
+				renderer->SetDepthOptions( DepthTest::ALWAYS, false );
+			}
 
-	obj.m_modelMatrix.AppendTranslation3D( pos );
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.push_back( obj );
-	g_debugRenderLock.unlock();
-}
+			else
+			{
+				renderer->SetDepthOptions( DepthTest::LESS_EQUAL, true );
+			}
+		}
 
+		renderer->BindTexture( state.m_texture );
+		renderer->DrawVertexBuffer( streamVBO, range.m_numVerts, range.m_firstVert );
 
-//-----------------------------------------------------------------------------------------------
-void DebugAddWorldPoint( Vec3 pos, float size, Rgba8 color, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
-{
-	DebugAddWorldPoint( pos, size, color, Rgba8( 0, 0, 0, 0 ), duration, mode );
+		if ( !isScreen && state.m_renderMode == DebugRenderMode::XRAY )
+		{
+			renderer->SetDepthOptions( DepthTest::GREATER, false );
+			renderer->SetModelBuffer( xrayData );
+			renderer->Draw( range.m_numVerts, range.m_firstVert );
+			renderer->SetModelBuffer( data );
+		}
+	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldPoint( Vec3 pos, Rgba8 color, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+bool DebugRenderClear( EventArgs& args )
 {
-	DebugAddWorldPoint( pos, 0.1250f, color, Rgba8( 0, 0, 0, 255 ), duration, mode );
+	UNUSED( args );
+	DebugRenderClear();
+	return true;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldPoint( Vec3 pos, Rgba8 color, Rgba8 endColor, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+bool DebugRenderToggle( EventArgs& args )
 {
-	DebugAddWorldPoint( pos, 0.1250f, color, endColor, duration, mode );
+	UNUSED( args );
+
+	if ( !g_theDebugRenderer.m_isVisible )
+		DebugRenderSetVisible();
+
+	else
+		DebugRenderSetHidden();
+
+	return true;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldLine( Vec3 start, Vec3 end, Rgba8 startColor, Rgba8 endColor, float thickness, float duration, DebugRenderMode mode )
+bool DebugRenderSetTimeScale( EventArgs& args )
 {
-	DebugWorldObject obj;
-	obj.m_objectType = DebugWorldObjectType::LINE;
-	obj.m_renderMode = mode;
+	float scale = args.GetValue( "Scale", 1.0f );
 
-	obj.m_rasterState.m_cullmode = CullMode::BACK;
-	obj.m_rasterState.m_fillMode = FillMode::SOLID;
-	obj.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
+	g_theDebugRenderer.m_debugClock->SetTimeDilation( scale );
 
-	obj.m_startColor = startColor;
-	obj.m_endColor = endColor;
+	return true;
+}
 
-	Vec3 startToEnd = end - start;
 
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
+//-----------------------------------------------------------------------------------------------
+void DebugRenderSystemStartup( DebugRenderConfig const& config )
+{
+	g_theDebugRenderer.m_config = config;
+	g_theDebugRenderer.m_isVisible = config.m_startHidden;
+	g_theDebugRenderer.m_debugClock = new Clock();
+	g_theDebugRenderer.m_streamVBO = config.m_renderer->CreateDynamicVertexBuffer( sizeof( Vertex_PCU ) );
 
-	AddVertsForCylinderZ3D( obj.m_localVerts, Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, startToEnd.GetLength() ), thickness * 0.5f, 16.f );
+	BuildUnitMeshes();
 
-	Vec3 kBasis( startToEnd );
+	SubscribeEventCallbackFunction( "DebugRenderToggle", DebugRenderToggle );
+	SubscribeEventCallbackFunction( "DebugRenderClear", DebugRenderClear );
+	SubscribeEventCallbackFunction( "DebugRenderSetTimeScale", DebugRenderSetTimeScale );
+}
 
-	kBasis = kBasis.GetNormalized();
 
-	Vec3 iBasis;
-	Vec3 jBasis = CrossProduct3D( kBasis, Vec3( 1.0f, 0.0f, 0.0f ) ).GetNormalized();
+//-----------------------------------------------------------------------------------------------
+void DebugRenderSystemShutdown()
+{
+	DebugRenderClear();
 
-	if ( jBasis.GetLength() == 0 )
+	for ( std::vector<Vertex_PCU>& unitMesh : g_theDebugRenderer.m_unitMeshes )
 	{
-		iBasis = CrossProduct3D( Vec3( 0.0f, 1.0f, 0.0f ), kBasis );
-		jBasis = CrossProduct3D( kBasis, iBasis );
+		unitMesh.clear();
 	}
+	g_theDebugRenderer.m_drawStates.clear();
 
-	else
-	{
-		iBasis = CrossProduct3D( jBasis, kBasis );
-	}
+	g_theDebugRenderer.m_config.m_renderer->DestroyVertexBuffer( g_theDebugRenderer.m_streamVBO );
+	g_theDebugRenderer.m_streamVBO = nullptr;
 
-	obj.m_modelMatrix.SetIJKT3D( iBasis, jBasis, kBasis, start );
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.push_back( obj );
-	g_debugRenderLock.unlock();
+	delete( g_theDebugRenderer.m_debugClock );
+	g_theDebugRenderer.m_debugClock = nullptr;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldLine( Vec3 start, Vec3 end, Rgba8 color /*= Rgba8::WHITE*/, float thickness /*= 0.125f*/, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+void DebugRenderSetVisible()
 {
-	DebugAddWorldLine( start, end, color, color, thickness, duration, mode );
+	g_debugRenderLock.lock();
+	g_theDebugRenderer.m_isVisible = true;
+	g_debugRenderLock.unlock();
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldWireCylinder( Vec3 base, Vec3 top, float radius, float duration, Rgba8 color, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+void DebugRenderSetHidden()
 {
-	DebugWorldObject obj;
-	obj.m_objectType = DebugWorldObjectType::CYLINDER;
-	obj.m_renderMode = mode;
-
-	obj.m_rasterState.m_cullmode = CullMode::NONE;
-	obj.m_rasterState.m_fillMode = FillMode::WIREFRAME;
-	obj.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
-
-	obj.m_startColor = color;
-	obj.m_endColor = Rgba8::RED;
-
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
+	g_debugRenderLock.lock();
+	g_theDebugRenderer.m_isVisible = false;
+	g_debugRenderLock.unlock();
+}
 
-	Vec3 startToEnd = top - base;
 
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
+//-----------------------------------------------------------------------------------------------
+void DebugRenderClear()
+{
+	g_debugRenderLock.lock();
+	g_theDebugRenderer.m_worldObjects.Clear();
+	g_theDebugRenderer.m_screenObjects.Clear();
+	g_debugRenderLock.unlock();
+}
 
-	AddVertsForCylinderZ3D( obj.m_localVerts, Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, startToEnd.GetLength() ), radius, 16.f );
 
-	Vec3 kBasis( startToEnd );
+//-----------------------------------------------------------------------------------------------
+void DebugRenderBeginFrame()
+{
 
-	kBasis = kBasis.GetNormalized();
+}
 
-	Vec3 iBasis;
-	Vec3 jBasis = CrossProduct3D( kBasis, Vec3( 1.0f, 0.0f, 0.0f ) ).GetNormalized();
 
-	if ( jBasis.GetLength() == 0 )
-	{
-		iBasis = CrossProduct3D( Vec3( 0.0f, 1.0f, 0.0f ), kBasis );
-		jBasis = CrossProduct3D( kBasis, iBasis );
-	}
+//-----------------------------------------------------------------------------------------------
+void DebugRenderWorldToCamera( Camera const& camera )
+{
+	if ( !g_theDebugRenderer.m_isVisible )
+		return;
 
-	else
+	g_debugRenderLock.lock();
+	int numStreamVerts = BuildDebugVertexStream( g_theDebugRenderer.m_worldObjects, camera, false, g_theDebugRenderer.m_worldStream );
+	if ( numStreamVerts > 0 )
 	{
-		iBasis = CrossProduct3D( jBasis, kBasis );
+		DrawDebugVertexStream( g_theDebugRenderer.m_worldStream, false );
 	}
-
-	obj.m_modelMatrix.SetIJKT3D( iBasis, jBasis, kBasis, base );
-
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.push_back( obj );
 	g_debugRenderLock.unlock();
 }
 
 
-void DebugAddWorldWireCylinder( Vec3 base, Vec3 top, float radius, float duration, Rgba8 startcolor, Rgba8 endColor, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+//-----------------------------------------------------------------------------------------------
+void DebugRenderScreenToCamera( Camera const& camera )
 {
-	DebugWorldObject obj;
-	obj.m_objectType = DebugWorldObjectType::CYLINDER;
-	obj.m_renderMode = mode;
-
-	obj.m_rasterState.m_cullmode = CullMode::NONE;
-	obj.m_rasterState.m_fillMode = FillMode::WIREFRAME;
-	obj.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
-
-	obj.m_startColor = startcolor;
-	obj.m_endColor = endColor;
-
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
-
-	Vec3 startToEnd = top - base;
-
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
-
-	AddVertsForCylinderZ3D( obj.m_localVerts, Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, startToEnd.GetLength() ), radius, 16.f );
-
-	Vec3 kBasis( startToEnd );
-
-	kBasis = kBasis.GetNormalized();
-
-	Vec3 iBasis;
-	Vec3 jBasis = CrossProduct3D( kBasis, Vec3( 1.0f, 0.0f, 0.0f ) ).GetNormalized();
+	if ( !g_theDebugRenderer.m_isVisible )
+		return;
 
-	if ( jBasis.GetLength() == 0 )
+	g_debugRenderLock.lock();
+	int numStreamVerts = BuildDebugVertexStream( g_theDebugRenderer.m_screenObjects, camera, true, g_theDebugRenderer.m_screenStream );
+	if ( numStreamVerts > 0 )
 	{
-		iBasis = CrossProduct3D( Vec3( 0.0f, 1.0f, 0.0f ), kBasis );
-		jBasis = CrossProduct3D( kBasis, iBasis );
+		DrawDebugVertexStream( g_theDebugRenderer.m_screenStream, true );
 	}
+	g_debugRenderLock.unlock();
+}
 
-	else
+
+//-----------------------------------------------------------------------------------------------
+void DebugRenderBuildWorldStream( Camera const& camera, DebugVertexStream& out_stream )
+{
+	if ( !g_theDebugRenderer.m_isVisible )
 	{
-		iBasis = CrossProduct3D( jBasis, kBasis );
+		out_stream.m_verts.clear();
+		out_stream.m_drawStateVertCounts.clear();
+		return;
 	}
 
-	obj.m_modelMatrix.SetIJKT3D( iBasis, jBasis, kBasis, base );
-
 	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.push_back( obj );
+	BuildDebugVertexStream( g_theDebugRenderer.m_worldObjects, camera, false, out_stream );
 	g_debugRenderLock.unlock();
 }
 
 
-//------------------------------------------------------------------------------------------------
-void DebugAddWorldWireAABB3( AABB3 aabb, Mat44 matrix, float duration, Rgba8 startcolor, Rgba8 endColor, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+//-----------------------------------------------------------------------------------------------
+void DebugRenderWorldStream( DebugVertexStream const& stream )
 {
-	DebugWorldObject obj;
-	obj.m_objectType = DebugWorldObjectType::CYLINDER;
-	obj.m_renderMode = mode;
-
-	obj.m_rasterState.m_cullmode = CullMode::NONE;
-	obj.m_rasterState.m_fillMode = FillMode::WIREFRAME;
-	obj.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
-
-	obj.m_startColor = startcolor;
-	obj.m_endColor = endColor;
+	if ( stream.m_verts.empty() )
+		return;
 
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
+	g_debugRenderLock.lock();
+	DrawDebugVertexStream( stream, false );
+	g_debugRenderLock.unlock();
+}
 
-	AddVertsForAABBZ3D( obj.m_localVerts, aabb );
 
-	obj.m_modelMatrix = matrix;
+//-----------------------------------------------------------------------------------------------
+void DebugRenderEndFrame()
+{
+	double totalSeconds = g_theDebugRenderer.m_debugClock->GetTotalSeconds();
 
 	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.push_back( obj );
+	g_theDebugRenderer.m_worldObjects.RemoveExpired( totalSeconds );
+	g_theDebugRenderer.m_screenObjects.RemoveExpired( totalSeconds );
 	g_debugRenderLock.unlock();
 }
 
 
-//------------------------------------------------------------------------------------------------
-void DebugAddWorldWireAABB3( AABB3 aabb, Mat44 matrix, float duration, Rgba8 color, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+//-----------------------------------------------------------------------------------------------
+void DebugAddWorldPoint( Vec3 pos, float size, Rgba8 startColor, Rgba8 endColor, float duration, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
 {
-	DebugAddWorldWireAABB3( aabb, matrix, duration, color, color, mode );
+	Mat44 transform;
+	transform.AppendTranslation3D( pos );
+	transform.AppendScaleUniform3D( size );
+
+	AddDebugObject( g_theDebugRenderer.m_worldObjects, DebugMesh::CUBE, transform, duration, startColor, endColor, MakeDrawState( mode, CullMode::BACK, FillMode::SOLID ) );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldSphere( Vec3 center, float radius, float duration, Rgba8 color, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+void DebugAddWorldPoint( Vec3 pos, float size, Rgba8 color, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
 {
-	DebugWorldObject obj;
-	obj.m_objectType = DebugWorldObjectType::SOLIDSPHERE;
-	obj.m_renderMode = mode;
-
-	obj.m_rasterState.m_cullmode = CullMode::BACK;
-	obj.m_rasterState.m_fillMode = FillMode::SOLID;
-	obj.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
-
-	obj.m_startColor = color;
-	obj.m_endColor = color;
+	DebugAddWorldPoint( pos, size, color, Rgba8( 0, 0, 0, 0 ), duration, mode );
+}
 
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
 
-	AddVertsForUVSphereZ3D( obj.m_localVerts, Vec3( 0.0f, 0.0f, 0.0f ), radius, 16.f, 8.f );
+//-----------------------------------------------------------------------------------------------
+void DebugAddWorldPoint( Vec3 pos, Rgba8 color, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+{
+	DebugAddWorldPoint( pos, 0.1250f, color, Rgba8( 0, 0, 0, 255 ), duration, mode );
+}
 
-	obj.m_modelMatrix.SetTranslation3D( center );
 
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.push_back( obj );
-	g_debugRenderLock.unlock();
+//-----------------------------------------------------------------------------------------------
+void DebugAddWorldPoint( Vec3 pos, Rgba8 color, Rgba8 endColor, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+{
+	DebugAddWorldPoint( pos, 0.1250f, color, endColor, duration, mode );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldWireSphere( Vec3 center, float radius, float duration, Rgba8 color, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+void DebugAddWorldLine( Vec3 start, Vec3 end, Rgba8 startColor, Rgba8 endColor, float thickness, float duration, DebugRenderMode mode )
 {
-	DebugWorldObject obj;
-	obj.m_objectType = DebugWorldObjectType::SPHERE;
-	obj.m_renderMode = mode;
+	Mat44 transform = GetSegmentTransform( start, end, thickness * 0.5f );
+	AddDebugObject( g_theDebugRenderer.m_worldObjects, DebugMesh::CYLINDER, transform, duration, startColor, endColor, MakeDrawState( mode, CullMode::BACK, FillMode::SOLID ) );
+}
 
-	obj.m_rasterState.m_cullmode = CullMode::BACK;
-	obj.m_rasterState.m_fillMode = FillMode::WIREFRAME;
-	obj.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
 
-	obj.m_startColor = color;
-	obj.m_endColor = Rgba8::RED;
+//-----------------------------------------------------------------------------------------------
+void DebugAddWorldLine( Vec3 start, Vec3 end, Rgba8 color /*= Rgba8::WHITE*/, float thickness /*= 0.125f*/, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+{
+	DebugAddWorldLine( start, end, color, color, thickness, duration, mode );
+}
 
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
 
-	AddVertsForUVSphereZ3D( obj.m_localVerts, Vec3( 0.0f, 0.0f, 0.0f ), radius, 16.f, 8.f );
+//-----------------------------------------------------------------------------------------------
+void DebugAddWorldWireCylinder( Vec3 base, Vec3 top, float radius, float duration, Rgba8 color, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+{
+	DebugAddWorldWireCylinder( base, top, radius, duration, color, Rgba8::RED, mode );
+}
 
-	obj.m_modelMatrix.SetTranslation3D( center );
 
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.push_back( obj );
-	g_debugRenderLock.unlock();
+//-----------------------------------------------------------------------------------------------
+void DebugAddWorldWireCylinder( Vec3 base, Vec3 top, float radius, float duration, Rgba8 startcolor, Rgba8 endColor, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+{
+	Mat44 transform = GetSegmentTransform( base, top, radius );
+	AddDebugObject( g_theDebugRenderer.m_worldObjects, DebugMesh::CYLINDER, transform, duration, startcolor, endColor, MakeDrawState( mode, CullMode::NONE, FillMode::WIREFRAME ) );
 }
 
 
 //------------------------------------------------------------------------------------------------
-void DebugAddFrustum( Vec3 points[ 8 ] )
+void DebugAddWorldWireAABB3( AABB3 aabb, Mat44 matrix, float duration, Rgba8 startcolor, Rgba8 endColor, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
 {
-	DebugWorldObject obj;
-	obj.m_objectType = DebugWorldObjectType::FRUSTUM;
-	obj.m_renderMode = DebugRenderMode::USE_DEPTH;
-
-	obj.m_rasterState.m_cullmode = CullMode::BACK;
-	obj.m_rasterState.m_fillMode = FillMode::WIREFRAME;
-	obj.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
-
-	obj.m_startColor = Rgba8::WHITE;
-	obj.m_endColor = Rgba8::WHITE;
-
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( 0 );
-
-	AddVertsForLine3D( obj.m_localVerts, points[ 0 ], points[ 1 ], 0.0635f );
-	AddVertsForLine3D( obj.m_localVerts, points[ 0 ], points[ 2 ], 0.0635f );
-	AddVertsForLine3D( obj.m_localVerts, points[ 2 ], points[ 3 ], 0.0635f );
-	AddVertsForLine3D( obj.m_localVerts, points[ 1 ], points[ 3 ], 0.0635f );
+	Mat44 transform = matrix;
+	transform.AppendTranslation3D( aabb.GetCenter() );
+	transform.AppendScaleNonUniform3D( aabb.GetDimensions() );
 
-	AddVertsForLine3D( obj.m_localVerts, points[ 0 ], points[ 4 ], 0.0635f );
-	AddVertsForLine3D( obj.m_localVerts, points[ 1 ], points[ 5 ], 0.0635f );
-	AddVertsForLine3D( obj.m_localVerts, points[ 2 ], points[ 6 ], 0.0635f );
-	AddVertsForLine3D( obj.m_localVerts, points[ 3 ], points[ 7 ], 0.0635f );
-
-	AddVertsForLine3D( obj.m_localVerts, points[ 4 ], points[ 5 ], 0.0635f );
-	AddVertsForLine3D( obj.m_localVerts, points[ 5 ], points[ 7 ], 0.0635f );
-	AddVertsForLine3D( obj.m_localVerts, points[ 4 ], points[ 6 ], 0.0635f );
-	AddVertsForLine3D( obj.m_localVerts, points[ 6 ], points[ 7 ], 0.0635f );
+	AddDebugObject( g_theDebugRenderer.m_worldObjects, DebugMesh::CUBE, transform, duration, startcolor, endColor, MakeDrawState( mode, CullMode::NONE, FillMode::WIREFRAME ) );
+}
 
-	obj.m_modelMatrix = Mat44();
 
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.push_back( obj );
-	g_debugRenderLock.unlock();
+//------------------------------------------------------------------------------------------------
+void DebugAddWorldWireAABB3( AABB3 aabb, Mat44 matrix, float duration, Rgba8 color, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+{
+	DebugAddWorldWireAABB3( aabb, matrix, duration, color, color, mode );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldArrow( Vec3 start, Vec3 end, Rgba8 color /*= Rgba8::WHITE*/, float thickness /*= 0.125f*/, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+void DebugAddWorldSphere( Vec3 center, float radius, float duration, Rgba8 color, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
 {
-	float arrowLength = ( end - start ).GetLength();
-	float baseLength = 0.8f * arrowLength;
-	float coneLength = 0.2f * arrowLength;
-
-	DebugWorldObject obj;
-	obj.m_objectType = DebugWorldObjectType::ARROW;
-	obj.m_renderMode = mode;
+	Mat44 transform;
+	transform.AppendTranslation3D( center );
+	transform.AppendScaleUniform3D( radius );
 
-	obj.m_rasterState.m_cullmode = CullMode::BACK;
-	obj.m_rasterState.m_fillMode = FillMode::SOLID;
-	obj.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
-
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
-
-	obj.m_startColor = color;
-	obj.m_endColor = color;
+	AddDebugObject( g_theDebugRenderer.m_worldObjects, DebugMesh::SPHERE, transform, duration, color, color, MakeDrawState( mode, CullMode::BACK, FillMode::SOLID ) );
+}
 
-	AddVertsForCylinderZ3D( obj.m_localVerts, Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, baseLength ), thickness * 0.25f, 16.f );
-	AddVertsForConeZ3D( obj.m_localVerts, Vec2( 0.0f, 0.0f ), FloatRange( baseLength, coneLength + baseLength ), thickness * 0.5f, 16.f );
 
-	Vec3 kBasis( end - start );
+//-----------------------------------------------------------------------------------------------
+void DebugAddWorldWireSphere( Vec3 center, float radius, float duration, Rgba8 color, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+{
+	Mat44 transform;
+	transform.AppendTranslation3D( center );
+	transform.AppendScaleUniform3D( radius );
 
-	kBasis = kBasis.GetNormalized();
+	AddDebugObject( g_theDebugRenderer.m_worldObjects, DebugMesh::SPHERE, transform, duration, color, Rgba8::RED, MakeDrawState( mode, CullMode::BACK, FillMode::WIREFRAME ) );
+}
 
-	Vec3 iBasis;
-	Vec3 jBasis = CrossProduct3D( kBasis, Vec3( 1.0f, 0.0f, 0.0f ) ).GetNormalized();
 
-	if ( jBasis.GetLength() == 0 )
+//------------------------------------------------------------------------------------------------
+void DebugAddFrustum( Vec3 points[ 8 ] )
+{
+	static int const FRUSTUM_EDGES[ 12 ][ 2 ] =
 	{
-		iBasis = CrossProduct3D( Vec3( 0.0f, 1.0f, 0.0f ), kBasis );
-		jBasis = CrossProduct3D( kBasis, iBasis );
-	}
+		{ 0, 1 }, { 0, 2 }, { 2, 3 }, { 1, 3 },
+		{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 },
+		{ 4, 5 }, { 5, 7 }, { 4, 6 }, { 6, 7 }
+	};
 
-	else
+	DebugDrawState state = MakeDrawState( DebugRenderMode::USE_DEPTH, CullMode::BACK, FillMode::WIREFRAME );
+	for ( int edgeNum = 0; edgeNum < 12; edgeNum++ )
 	{
-		iBasis = CrossProduct3D( jBasis, kBasis );
+		Mat44 transform = GetSegmentTransform( points[ FRUSTUM_EDGES[ edgeNum ][ 0 ] ], points[ FRUSTUM_EDGES[ edgeNum ][ 1 ] ], 0.0635f * 0.5f );
+		AddDebugObject( g_theDebugRenderer.m_worldObjects, DebugMesh::LINE, transform, 0.0f, Rgba8::WHITE, Rgba8::WHITE, state );
 	}
+}
 
-	obj.m_modelMatrix.SetIJKT3D( iBasis, jBasis, kBasis, start );
 
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.push_back( obj );
-	g_debugRenderLock.unlock();
+//-----------------------------------------------------------------------------------------------
+void DebugAddWorldArrow( Vec3 start, Vec3 end, Rgba8 color /*= Rgba8::WHITE*/, float thickness /*= 0.125f*/, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+{
+	Mat44 transform = GetSegmentTransform( start, end, thickness );
+	AddDebugObject( g_theDebugRenderer.m_worldObjects, DebugMesh::ARROW, transform, duration, color, color, MakeDrawState( mode, CullMode::BACK, FillMode::SOLID ) );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void DebugAddWorldBasis( Mat44 basis, Rgba8 startTint, Rgba8 endTint, float duration, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
 {
-	DebugWorldObject obj;
-	obj.m_objectType = DebugWorldObjectType::BASIS;
-	obj.m_renderMode = mode;
-
-	obj.m_rasterState.m_cullmode = CullMode::BACK;
-	obj.m_rasterState.m_fillMode = FillMode::SOLID;
-	obj.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
-
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
-
-	obj.m_startColor = startTint;
-	obj.m_endColor = endTint;
-
-	std::vector<Vertex_PCU> zAxis;
-	AddVertsForCylinderZ3D( zAxis, Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, 0.8f ), 0.150f * 0.25f, 16.f, Rgba8::BLUE );
-	AddVertsForConeZ3D( zAxis, Vec2( 0.0f, 0.0f ), FloatRange( 0.8f, 1.f ), 0.150f * 0.5f, 16.f, Rgba8::BLUE );
-
-	Mat44 transformMatrix;
-	transformMatrix.AppendYRotation( 90.0f );
-	std::vector<Vertex_PCU> xAxis;
-	AddVertsForCylinderZ3D( xAxis, Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, 0.8f ), 0.150f * 0.25f, 16.f, Rgba8::RED );
-	AddVertsForConeZ3D( xAxis, Vec2( 0.0f, 0.0f ), FloatRange( 0.8f, 1.f ), 0.150f * 0.5f, 16.f, Rgba8::RED );
-	TransformVertexArrayUsingMatrix( static_cast< int >( xAxis.size() ), xAxis.data(), transformMatrix );
-
-	transformMatrix = Mat44();
-	transformMatrix.AppendXRotation( -90.0f );
-	std::vector<Vertex_PCU> yAxis;
-	AddVertsForCylinderZ3D( yAxis, Vec2( 0.0f, 0.0f ), FloatRange( 0.0f, 0.8f ), 0.150f * 0.25f, 16.f, Rgba8::GREEN );
-	AddVertsForConeZ3D( yAxis, Vec2( 0.0f, 0.0f ), FloatRange( 0.8f, 1.f ), 0.150f * 0.5f, 16.f, Rgba8::GREEN );
-	TransformVertexArrayUsingMatrix( static_cast< int >( yAxis.size() ), yAxis.data(), transformMatrix );
-
-	obj.m_localVerts.insert( obj.m_localVerts.end(), xAxis.begin(), xAxis.end() );
-	obj.m_localVerts.insert( obj.m_localVerts.end(), yAxis.begin(), yAxis.end() );
-	obj.m_localVerts.insert( obj.m_localVerts.end(), zAxis.begin(), zAxis.end() );
-
-	obj.m_modelMatrix = basis;
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.push_back( obj );
-	g_debugRenderLock.unlock();
+	AddDebugObject( g_theDebugRenderer.m_worldObjects, DebugMesh::BASIS, basis, duration, startTint, endTint, MakeDrawState( mode, CullMode::BACK, FillMode::SOLID ) );
 }
 
 
@@ -743,7 +847,7 @@ void DebugAddWorldBasis( Mat44 basis, float duration /*= 0.0f*/, DebugRenderMode
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldText( std::string const& text, float textHeight, Vec2 alignment, Rgba8 startColor, Rgba8 endColor, Mat44 const& transform /*= Mat44()*/, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+void DebugAddWorldText( std::string_view text, float textHeight, Vec2 alignment, Rgba8 startColor, Rgba8 endColor, Mat44 const& transform /*= Mat44()*/, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
 {
 	float textAspect = 0.8f;
 	float textWidth = text.length() * textHeight * textAspect;
@@ -753,57 +857,25 @@ void DebugAddWorldText( std::string const& text, float textHeight, Vec2 alignmen
 	bounds.m_mins = -Vec2( alignment.x * textWidth, alignment.y * textHeight );
 	bounds.m_maxs = Vec2( ( 1.f - alignment.x ) * textWidth, ( 1.f - alignment.y ) * textHeight );
 
-	DebugWorldObject obj;
-	obj.m_objectType = DebugWorldObjectType::TEXT;
-	obj.m_renderMode = mode;
-
-	obj.m_rasterState.m_cullmode = CullMode::NONE;
-	obj.m_rasterState.m_fillMode = FillMode::SOLID;
-	obj.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
-
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
-
-	obj.m_startColor = startColor;
-	obj.m_endColor = endColor;
-
-	BitmapFont* fontForWorldTextAttract = g_theDebugRenderer.m_config.m_renderer->CreateOrGetBitmapFontFromFile( "Data/Fonts/FixedFont" );
-	obj.m_texture = &fontForWorldTextAttract->GetTexture();
-
-	fontForWorldTextAttract->AddVertsForTextInBox2D( obj.m_localVerts, bounds, textHeight, text, startColor, textAspect, alignment );
-
-	obj.m_modelMatrix = transform;
+	BitmapFont* font = GetDebugFont();
+	FrameVector<Vertex_PCU> textVerts = MakeFrameVector<Vertex_PCU>();
+	font->AddCachedVertsForTextInBox2D( textVerts, bounds, textHeight, text, startColor, textAspect, alignment );
 
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.push_back( obj );
-	g_debugRenderLock.unlock();
+	AddDebugObject( g_theDebugRenderer.m_worldObjects, DebugMesh::CUSTOM, transform, duration, startColor, endColor, MakeDrawState( mode, CullMode::NONE, FillMode::SOLID, &font->GetTexture() ),
+		DebugPlacement::FIXED, textVerts.data(), static_cast< int >( textVerts.size() ) );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldText( std::string const& text, float textHeight /*= 0.25f*/, Vec2 alignment /*= Vec2( 0.5f, 0.5f )*/, Rgba8 color /*= Rgba8::WHITE*/, Mat44 const& transform /*= Mat44()*/, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+void DebugAddWorldText( std::string_view text, float textHeight /*= 0.25f*/, Vec2 alignment /*= Vec2( 0.5f, 0.5f )*/, Rgba8 color /*= Rgba8::WHITE*/, Mat44 const& transform /*= Mat44()*/, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
 {
 	DebugAddWorldText( text, textHeight, alignment, color, color, transform, duration, mode );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldBillboardText( Vec3 origin, std::string const& text, float textHeight, Vec2 alignment, Rgba8 startcolor, Rgba8 endColor, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+void DebugAddWorldBillboardText( Vec3 origin, std::string_view text, float textHeight, Vec2 alignment, Rgba8 startcolor, Rgba8 endColor, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
 {
-	DebugWorldObject obj;
-	obj.m_objectType = DebugWorldObjectType::BILLBOARDTEXT;
-	obj.m_renderMode = mode;
-
-	obj.m_rasterState.m_cullmode = CullMode::NONE;
-	obj.m_rasterState.m_fillMode = FillMode::SOLID;
-	obj.m_rasterState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
-
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
-
-	obj.m_startColor = startcolor;
-	obj.m_endColor = endColor;
-
 	float textAspect = 0.8f;
 	float textWidth = text.length() * textHeight * textAspect;
 
@@ -811,38 +883,28 @@ void DebugAddWorldBillboardText( Vec3 origin, std::string const& text, float tex
 	bounds.m_mins = -Vec2( alignment.x * textWidth, alignment.y * textHeight );
 	bounds.m_maxs = Vec2( ( 1.f - alignment.x ) * textWidth, ( 1.f - alignment.y ) * textHeight );
 
-	BitmapFont* fontForWorldTextAttract = g_theDebugRenderer.m_config.m_renderer->CreateOrGetBitmapFontFromFile( "Data/Fonts/FixedFont" );
-	obj.m_texture = &fontForWorldTextAttract->GetTexture();
-
-	fontForWorldTextAttract->AddVertsForTextInBox2D( obj.m_localVerts, bounds, textHeight, text, Rgba8::WHITE, textAspect, alignment );
+	BitmapFont* font = GetDebugFont();
+	FrameVector<Vertex_PCU> textVerts = MakeFrameVector<Vertex_PCU>();
+	font->AddCachedVertsForTextInBox2D( textVerts, bounds, textHeight, text, Rgba8::WHITE, textAspect, alignment );
 
-	obj.m_modelMatrix.AppendTranslation3D( origin );
+	Mat44 transform;
+	transform.AppendTranslation3D( origin );
 
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_worldObjects.push_back( obj );
-	g_debugRenderLock.unlock();
+	AddDebugObject( g_theDebugRenderer.m_worldObjects, DebugMesh::CUSTOM, transform, duration, startcolor, endColor, MakeDrawState( mode, CullMode::NONE, FillMode::SOLID, &font->GetTexture() ),
+		DebugPlacement::BILLBOARD, textVerts.data(), static_cast< int >( textVerts.size() ) );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddWorldBillboardText( Vec3 origin, std::string const& text, float textHeight /*= 0.5f*/, Vec2 alignment /*= Vec2( 0.5f, 0.5f )*/, Rgba8 color /*= Rgba8::WHITE*/, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
+void DebugAddWorldBillboardText( Vec3 origin, std::string_view text, float textHeight /*= 0.5f*/, Vec2 alignment /*= Vec2( 0.5f, 0.5f )*/, Rgba8 color /*= Rgba8::WHITE*/, float duration /*= 0.0f*/, DebugRenderMode mode /*= DebugRenderMode::USE_DEPTH */ )
 {
 	DebugAddWorldBillboardText( origin, text, textHeight, alignment, color, Rgba8::RED, duration, mode );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddScreenText( std::string const& text, Vec2 position, float duration, Vec2 pivot, float size, Rgba8 startColor, Rgba8 endColor )
+void DebugAddScreenText( std::string_view text, Vec2 position, float duration, Vec2 pivot, float size, Rgba8 startColor, Rgba8 endColor )
 {
-	DebugScreenObject obj;
-	obj.m_objectType = DebugScreenObjectType::TEXT;
-
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
-
-	obj.m_startColor = startColor;
-	obj.m_endColor = endColor;
-
 	float textAspect = 0.75f;
 	float textWidth = text.length() * size * textAspect;
 
@@ -850,38 +912,28 @@ void DebugAddScreenText( std::string const& text, Vec2 position, float duration,
 	bounds.m_mins = -Vec2( pivot.x * textWidth, pivot.y * size );
 	bounds.m_maxs = Vec2( ( 1.f - pivot.x ) * textWidth, ( 1.f - pivot.y ) * size );
 
-	BitmapFont* fontForWorldTextAttract = g_theDebugRenderer.m_config.m_renderer->CreateOrGetBitmapFontFromFile( "Data/Fonts/FixedFont" );
-	obj.m_texture = &fontForWorldTextAttract->GetTexture();
-
-	fontForWorldTextAttract->AddVertsForTextInBox2D( obj.m_localVerts, bounds, size, text, Rgba8::WHITE, textAspect, pivot );
+	BitmapFont* font = GetDebugFont();
+	FrameVector<Vertex_PCU> textVerts = MakeFrameVector<Vertex_PCU>();
+	font->AddCachedVertsForTextInBox2D( textVerts, bounds, size, text, Rgba8::WHITE, textAspect, pivot );
 
-	obj.m_transformMatrix.AppendTranslation2D( position );
+	Mat44 transform;
+	transform.AppendTranslation2D( position );
 
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_screenObjects.push_back( obj );
-	g_debugRenderLock.unlock();
+	AddDebugObject( g_theDebugRenderer.m_screenObjects, DebugMesh::CUSTOM, transform, duration, startColor, endColor, MakeDrawState( DebugRenderMode::ALWAYS, CullMode::BACK, FillMode::SOLID, &font->GetTexture() ),
+		DebugPlacement::FIXED, textVerts.data(), static_cast< int >( textVerts.size() ) );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddScreenText( std::string const& text, Vec2 position, float duration /*= 0.0f*/, Vec2 pivot /*= Vec2( 0.0f, 0.0f )*/, float size /*= 32.0f*/, Rgba8 color /*= Rgba8::WHITE */ )
+void DebugAddScreenText( std::string_view text, Vec2 position, float duration /*= 0.0f*/, Vec2 pivot /*= Vec2( 0.0f, 0.0f )*/, float size /*= 32.0f*/, Rgba8 color /*= Rgba8::WHITE */ )
 {
 	DebugAddScreenText( text, position, duration, pivot, size, color, Rgba8::RED );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddMessage( std::string const& text, float duration, Rgba8 startColor, Rgba8 endColor )
+void DebugAddMessage( std::string_view text, float duration, Rgba8 startColor, Rgba8 endColor )
 {
-	DebugScreenObject obj;
-	obj.m_objectType = DebugScreenObjectType::MESSAGE;
-
-	obj.m_lifeTimeStopWatch.SetClock( *( g_theDebugRenderer.m_debugClock ) );
-	obj.m_lifeTimeStopWatch.Start( duration );
-
-	obj.m_startColor = startColor;
-	obj.m_endColor = endColor;
-
 	float textSize = 7.f;
 	float textAspect = 0.75f;
 	float textWidth = text.length() * textSize * textAspect;
@@ -891,19 +943,17 @@ void DebugAddMessage( std::string const& text, float duration, Rgba8 startColor,
 	bounds.m_mins = -Vec2( pivot.x * textWidth, pivot.y * textSize );
 	bounds.m_maxs = Vec2( ( 1.f - pivot.x ) * textWidth, ( 1.f - pivot.y ) * textSize );
 
-	BitmapFont* fontForWorldTextAttract = g_theDebugRenderer.m_config.m_renderer->CreateOrGetBitmapFontFromFile( "Data/Fonts/FixedFont" );
-	obj.m_texture = &fontForWorldTextAttract->GetTexture();
+	BitmapFont* font = GetDebugFont();
+	FrameVector<Vertex_PCU> textVerts = MakeFrameVector<Vertex_PCU>();
+	font->AddCachedVertsForTextInBox2D( textVerts, bounds, textSize, text, Rgba8::WHITE, textAspect, pivot );
 
-	fontForWorldTextAttract->AddVertsForTextInBox2D( obj.m_localVerts, bounds, textSize, text, Rgba8::WHITE, textAspect, pivot );
-
-	g_debugRenderLock.lock();
-	g_theDebugRenderer.m_screenObjects.push_back( obj );
-	g_debugRenderLock.unlock();
+	AddDebugObject( g_theDebugRenderer.m_screenObjects, DebugMesh::CUSTOM, Mat44(), duration, startColor, endColor, MakeDrawState( DebugRenderMode::ALWAYS, CullMode::BACK, FillMode::SOLID, &font->GetTexture() ),
+		DebugPlacement::MESSAGE, textVerts.data(), static_cast< int >( textVerts.size() ) );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void DebugAddMessage( std::string const& text, float duration /*= 0.0f*/, Rgba8 color /*= Rgba8::WHITE */ )
+void DebugAddMessage( std::string_view text, float duration /*= 0.0f*/, Rgba8 color /*= Rgba8::WHITE */ )
 {
 	DebugAddMessage( text, duration, color, Rgba8::RED );
 }
@@ -8,8 +8,10 @@
 #include "Engine/Math/Mat44.hpp"
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Math/Vec3.hpp"
+#include "Engine/Renderer/VertexData/Vertex_PCU.hpp"
 
-#include <string>
+#include <string_view>
+#include <vector>
 
 
 #if defined(ENGINE_DEBUG_RENDERING)
@@ -36,6 +38,15 @@ struct DebugRenderConfig
 };
 
 
+//------------------------------------------------------------------------
+// Debug objects expanded for one camera: verts grouped by draw state, transforms and tints baked in
+struct DebugVertexStream
+{
+	std::vector<Vertex_PCU> m_verts;
+	std::vector<int>        m_drawStateVertCounts;		// consecutive ranges of m_verts, one per draw state
+};
+
+
 //------------------------------------------------------------------------
 // setup
 void DebugRenderSystemStartup( DebugRenderConfig const& config );    // setup the debug render system (call from Renderer::Startup)
@@ -52,6 +63,10 @@ void DebugRenderWorldToCamera( Camera const& camera );		// Draws all world objec
 void DebugRenderScreenToCamera( Camera const& camera );		// Draws all screen objects onto this texture (screen coordinate system is up to you.  I like a 1080p default)
 void DebugRenderEndFrame();									// ...handle any post frame needs of the system, call from `Renderer::EndFrame`
 
+// deferred world output - the stream is built without touching the renderer, so another thread can draw it later
+void DebugRenderBuildWorldStream( Camera const& camera, DebugVertexStream& out_stream );
+void DebugRenderWorldStream( DebugVertexStream const& stream );	// Draws a built stream to the current camera
+
 // points
 void DebugAddWorldPoint( Vec3 pos, float size, Rgba8 startColor, Rgba8 endColor, float duration, DebugRenderMode mode = DebugRenderMode::USE_DEPTH );
 void DebugAddWorldPoint( Vec3 pos, float size, Rgba8 color, float duration = 0.0f, DebugRenderMode mode = DebugRenderMode::USE_DEPTH );
@@ -85,19 +100,19 @@ void DebugAddWorldBasis( Mat44 basis, Rgba8 startTint, Rgba8 endTint, float dura
 void DebugAddWorldBasis( Mat44 basis, float duration = 0.0f, DebugRenderMode mode = DebugRenderMode::USE_DEPTH );
 
 // text
-void DebugAddWorldText( std::string const& text, float textHeight, Vec2 alignment, Rgba8 startColor, Rgba8 endColor, Mat44 const& transform = Mat44(), float duration = 0.0f, DebugRenderMode mode = DebugRenderMode::USE_DEPTH );
-void DebugAddWorldText( std::string const& text, float textHeight = 0.25f, Vec2 alignment = Vec2( 0.5f, 0.5f ), Rgba8 color = Rgba8::WHITE, Mat44 const& transform = Mat44(), float duration = 0.0f, DebugRenderMode mode = DebugRenderMode::USE_DEPTH );
+void DebugAddWorldText( std::string_view text, float textHeight, Vec2 alignment, Rgba8 startColor, Rgba8 endColor, Mat44 const& transform = Mat44(), float duration = 0.0f, DebugRenderMode mode = DebugRenderMode::USE_DEPTH );
+void DebugAddWorldText( std::string_view text, float textHeight = 0.25f, Vec2 alignment = Vec2( 0.5f, 0.5f ), Rgba8 color = Rgba8::WHITE, Mat44 const& transform = Mat44(), float duration = 0.0f, DebugRenderMode mode = DebugRenderMode::USE_DEPTH );
 
-void DebugAddWorldBillboardText( Vec3 origin, std::string const& text, float textHeight, Vec2 alignment, Rgba8 startcolor, Rgba8 endColor, float duration = 0.0f, DebugRenderMode mode = DebugRenderMode::USE_DEPTH );
-void DebugAddWorldBillboardText( Vec3 origin, std::string const& text, float textHeight = 0.5f, Vec2 alignment = Vec2( 0.5f, 0.5f ), Rgba8 color = Rgba8::WHITE, float duration = 0.0f, DebugRenderMode mode = DebugRenderMode::USE_DEPTH );
+void DebugAddWorldBillboardText( Vec3 origin, std::string_view text, float textHeight, Vec2 alignment, Rgba8 startcolor, Rgba8 endColor, float duration = 0.0f, DebugRenderMode mode = DebugRenderMode::USE_DEPTH );
+void DebugAddWorldBillboardText( Vec3 origin, std::string_view text, float textHeight = 0.5f, Vec2 alignment = Vec2( 0.5f, 0.5f ), Rgba8 color = Rgba8::WHITE, float duration = 0.0f, DebugRenderMode mode = DebugRenderMode::USE_DEPTH );
 
 // text - put anywhere on the screen.  Useful for debugging values.
-void DebugAddScreenText( std::string const& text, Vec2 position, float duration, Vec2 pivot, float size, Rgba8 startColor, Rgba8 endColor );
-void DebugAddScreenText( std::string const& text, Vec2 position, float duration = 0.0f, Vec2 pivot = Vec2( 0.0f, 0.0f ), float size = 32.0f, Rgba8 color = Rgba8::WHITE );
+void DebugAddScreenText( std::string_view text, Vec2 position, float duration, Vec2 pivot, float size, Rgba8 startColor, Rgba8 endColor );
+void DebugAddScreenText( std::string_view text, Vec2 position, float duration = 0.0f, Vec2 pivot = Vec2( 0.0f, 0.0f ), float size = 32.0f, Rgba8 color = Rgba8::WHITE );
 
 // messages - messages display after text, at the top of the screen, most recent on top.  
-void DebugAddMessage( std::string const& text, float duration, Rgba8 startColor, Rgba8 endColor );
-void DebugAddMessage( std::string const& text, float duration = 0.0f, Rgba8 color = Rgba8::WHITE );
+void DebugAddMessage( std::string_view text, float duration, Rgba8 startColor, Rgba8 endColor );
+void DebugAddMessage( std::string_view text, float duration = 0.0f, Rgba8 color = Rgba8::WHITE );
 
 #endif
 
@@ -0,0 +1,95 @@
+#include "Engine/Renderer/DrawCommandList.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+
+//------------------------------------------------------------------------------------------------
+// Keeps the vectors' capacity so lists rebuilt every frame stop allocating after the first few frames
+//
+void DrawCommandList::Reset()
+{
+	m_commands.clear();
+	m_modelData.clear();
+	m_numDraws = 0;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void DrawCommandList::BindShader( Shader* shader )
+{
+	DrawCommand command;
+	command.m_type   = DrawCommandType::BIND_SHADER;
+	command.m_shader = shader;
+	m_commands.push_back( command );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void DrawCommandList::SetModelBuffer( ModelTransformationData const& data )
+{
+	DrawCommand command;
+	command.m_type           = DrawCommandType::SET_MODEL_BUFFER;
+	command.m_modelDataIndex = static_cast< uint >( m_modelData.size() );
+	m_modelData.push_back( data );
+	m_commands.push_back( command );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void DrawCommandList::DrawVertexArray( int numVertexes, Vertex_PCU const* vertexes )
+{
+	DrawCommand command;
+	command.m_type     = DrawCommandType::DRAW_VERTEX_ARRAY_PCU;
+	command.m_vertexes = vertexes;
+	command.m_count    = numVertexes;
+	m_commands.push_back( command );
+	m_numDraws++;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void DrawCommandList::DrawVertexArray( int numVertexes, Vertex_PCUTBN const* vertexes )
+{
+	DrawCommand command;
+	command.m_type     = DrawCommandType::DRAW_VERTEX_ARRAY_PCUTBN;
+	command.m_vertexes = vertexes;
+	command.m_count    = numVertexes;
+	m_commands.push_back( command );
+	m_numDraws++;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void DrawCommandList::DrawIndexedVertexBuffer( VertexBuffer const* vbo, IndexBuffer const* ibo, int indexCount, int indexOffset /*= 0*/ )
+{
+	DrawCommand command;
+	command.m_type   = DrawCommandType::DRAW_INDEXED_VERTEX_BUFFER;
+	command.m_vbo    = vbo;
+	command.m_ibo    = ibo;
+	command.m_count  = indexCount;
+	command.m_offset = indexOffset;
+	m_commands.push_back( command );
+	m_numDraws++;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void DrawCommandList::DrawIndexedVertexStreams( VertexBuffer const* positionVBO, VertexBuffer const* attributeVBO, IndexBuffer const* ibo, int indexCount, int indexOffset /*= 0*/ )
+{
+	DrawCommand command;
+	command.m_type         = DrawCommandType::DRAW_INDEXED_VERTEX_STREAMS;
+	command.m_vbo          = positionVBO;
+	command.m_attributeVBO = attributeVBO;
+	command.m_ibo          = ibo;
+	command.m_count        = indexCount;
+	command.m_offset       = indexOffset;
+	m_commands.push_back( command );
+	m_numDraws++;
+}
+
+
+//------------------------------------------------------------------------------------------------
+ModelTransformationData const& DrawCommandList::GetModelData( uint modelDataIndex ) const
+{
+	ASSERT_OR_DIE( modelDataIndex < m_modelData.size(), "Draw command model data index out of range" );
+	return m_modelData[ modelDataIndex ];
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Renderer/ModelTransformationData.hpp"
+
+#include <vector>
+
+
+//------------------------------------------------------------------------------------------------
+class IndexBuffer;
+class Shader;
+class VertexBuffer;
+
+struct Vertex_PCU;
+struct Vertex_PCUTBN;
+
+
+//------------------------------------------------------------------------------------------------
+enum class DrawCommandType : unsigned char
+{
+	BIND_SHADER,
+	SET_MODEL_BUFFER,
+	DRAW_VERTEX_ARRAY_PCU,
+	DRAW_VERTEX_ARRAY_PCUTBN,
+	DRAW_INDEXED_VERTEX_BUFFER,
+	DRAW_INDEXED_VERTEX_STREAMS,
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Only the fields the command type needs are filled in. Vertex arrays are referenced, not copied,
+// so they must outlive the list's execution
+//
+struct DrawCommand
+{
+	DrawCommandType     m_type           = DrawCommandType::BIND_SHADER;
+	Shader*             m_shader         = nullptr;
+	VertexBuffer const* m_vbo            = nullptr;
+	VertexBuffer const* m_attributeVBO   = nullptr;
+	IndexBuffer const*  m_ibo            = nullptr;
+	void const*         m_vertexes       = nullptr;
+	int                 m_count          = 0;
+	int                 m_offset         = 0;
+	uint                m_modelDataIndex = 0;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Backend agnostic recording of a single view's draws. Any thread may record into its own list;
+// Renderer::ExecuteDrawCommandList replays it on the thread that owns the device context.
+// Model constants are packed into the list while recording so replay is just copies and draws.
+// Commands replay in recording order; views that want state sorting go through RenderQueue instead
+//
+class DrawCommandList
+{
+public:
+	void Reset();
+
+	void BindShader( Shader* shader );
+	void SetModelBuffer( ModelTransformationData const& data );
+	void DrawVertexArray( int numVertexes, Vertex_PCU const* vertexes );
+	void DrawVertexArray( int numVertexes, Vertex_PCUTBN const* vertexes );
+	void DrawIndexedVertexBuffer( VertexBuffer const* vbo, IndexBuffer const* ibo, int indexCount, int indexOffset = 0 );
+	void DrawIndexedVertexStreams( VertexBuffer const* positionVBO, VertexBuffer const* attributeVBO, IndexBuffer const* ibo, int indexCount, int indexOffset = 0 );
+
+	std::vector<DrawCommand> const& GetCommands() const			{ return m_commands; }
+	ModelTransformationData const&  GetModelData( uint modelDataIndex ) const;
+	int                             GetNumDraws() const			{ return m_numDraws; }
+	bool                            IsEmpty() const				{ return m_commands.empty(); }
+
+private:
+	std::vector<DrawCommand>             m_commands;
+	std::vector<ModelTransformationData> m_modelData;
+	int                                  m_numDraws = 0;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+
+
+//------------------------------------------------------------------------------------------------
+struct ID3D11Buffer;
+class Renderer;
+
+
+//------------------------------------------------------------------------------------------------
+class IndexBuffer
+{
+	friend class Renderer;
+
+public:
+	void CopyIndexData( uint const* indices, size_t indexCount );
+
+	inline size_t GetIndexCount() const { return m_indexCount; }
+
+protected:
+	IndexBuffer( Renderer* source );
+	IndexBuffer( IndexBuffer const& copy ) = delete;
+	virtual ~IndexBuffer();
+
+	ID3D11Buffer* GetHandle() const;
+
+protected:
+	Renderer*     m_sourceRenderer  = nullptr;
+	ID3D11Buffer* m_gpuBuffer       = nullptr;
+
+	size_t        m_indexCount      = 0;
+	size_t        m_byteMaxSize     = 0;
+};
@@ -17,6 +17,11 @@ constexpr uint DIRECTIONAL_LIGHT  = 1;
 constexpr uint SPOT_LIGHT         = 2;
 constexpr uint POINT_LIGHT        = 3;
 constexpr uint DEPTH_TEXTURE_SIZE = 4096;
+constexpr uint NUM_CUBE_FACES     = 6;
+constexpr uint MAX_SHADOW_MATRICES = MAXLIGHTS * NUM_CASCADES;
+constexpr uint NO_SHADOW_MATRIX    = 0xFFFFFFFF;
+
+static_assert( NUM_CUBE_FACES <= NUM_CASCADES, "Point light faces are stored in the cascade slots" );
 
 
 //------------------------------------------------------------------------------------------------
@@ -36,28 +41,34 @@ struct LightDataC
 				 					           
 	Vec3         m_specularAttenuation         = Vec3( 0.0f, 0.0f, 1.0f ); 
 	float        m_dotOuterAngle               = -1.0f; 
-									           
-	Mat44        m_viewMat                     = Mat44();
-	Mat44        m_projectionMat[NUM_CASCADES] = {};
 
 	uint         m_isShadowCasting             = 0;
 	float        m_ShadowBias                  = 0.002f;
-									           
-	float        padding0                      = 777.0f;
-	float        padding1                      = 777.0f;
+	uint         m_shadowMatrixIndex           = NO_SHADOW_MATRIX; // first light view-projection in ShaderShadowMatrixData
+	float        m_shadowViewportScale         = 1.0f;             // shadow resolution / the light's depth texture size
 };
 
 
 //------------------------------------------------------------------------------------------------
+// Only the header and the first m_numLights records are uploaded, so the header stays in front
 struct ShaderLightData
 {
 	Vec4		m_ambientLight;								
-	LightDataC	m_lights[ MAXLIGHTS ];
-	
 	float		m_diffuseFactor  = 1;							
 	float		m_specularFactor = 1;							
 	float		m_specularPower  = 32;						
-	float		padding00 = 0.f;
+	uint		m_numLights      = 0;
+
+	LightDataC	m_lights[ MAXLIGHTS ];
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Light view-projection matrices, packed back to back for shadow casting lights only.
+// A directional light owns numCascades consecutive entries, a point light one per cube face and a spot light one.
+struct ShaderShadowMatrixData
+{
+	Mat44		m_lightViewProjection[ MAX_SHADOW_MATRICES ];
 };
 
 
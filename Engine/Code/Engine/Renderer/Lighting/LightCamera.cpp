@@ -11,7 +11,10 @@
 //-----------------------------------------------------------------------------------------------
 LightCamera::LightCamera()
 {
-	CreateDepthTextures( 1 );
+	for ( int viewNum = 0; viewNum < NUM_CASCADES; viewNum++ )
+	{
+		m_shadowResolution[ viewNum ] = DEPTH_TEXTURE_SIZE;
+	}
 }
 
 
@@ -24,15 +27,27 @@ LightCamera::~LightCamera()
 
 
 //-----------------------------------------------------------------------------------------------
-void LightCamera::SetLightValues( LightDataC data )
+void LightCamera::SetLightValues( LightDataC const& data )
 {
+	bool isViewChanged = ( m_lightValues.m_lightType != data.m_lightType ) ||
+						 ( m_lightValues.m_worldPosition != data.m_worldPosition ) ||
+						 ( m_lightValues.m_direction != data.m_direction );
+
 	m_lightValues = data;
+
+	if ( isViewChanged )
+	{
+		MarkViewDirty();
+		m_viewProjectionDirtyMask = 0xFF;
+	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-Mat44 LightCamera::GetViewMatrix() const
+Mat44 LightCamera::ComputeViewMatrix() const
 {
+	m_viewProjectionDirtyMask = 0xFF;
+
 	Mat44 viewMatrix;
 	if ( m_lightValues.m_lightType != DIRECTIONAL_LIGHT )
 	{
@@ -54,19 +69,160 @@ Mat44 LightCamera::GetViewMatrix() const
 
 
 //------------------------------------------------------------------------------------------------
-void LightCamera::SetProjectionMatrix( Mat44 proj, int projNum /*= 0*/ ) 
+void LightCamera::SetProjectionMatrix( Mat44 const& proj, int projNum /*= 0*/ ) 
 {
 	m_projectionMatrix[ projNum ] = proj;
+	m_viewProjectionDirtyMask |= static_cast< uint8_t >( 1u << projNum );
 }
 
 
 //------------------------------------------------------------------------------------------------
-Mat44 LightCamera::GetProjectionMatrix( int projnum /*= 0 */ ) const
+Mat44 const& LightCamera::GetProjectionMatrix( int projnum /*= 0 */ ) const
 {
 	return m_projectionMatrix[ projnum ];
 }
 
 
+//------------------------------------------------------------------------------------------------
+Mat44 const& LightCamera::GetViewProjectionMatrix( int projNum /*= 0 */ ) const
+{
+	Mat44 const& renderViewMatrix = GetRenderViewMatrix();
+
+	uint8_t projBit = static_cast< uint8_t >( 1u << projNum );
+	if ( ( m_viewProjectionDirtyMask & projBit ) != 0 )
+	{
+		m_viewProjectionMatrix[ projNum ] = m_projectionMatrix[ projNum ];
+		m_viewProjectionMatrix[ projNum ].Append( renderViewMatrix );
+		m_viewProjectionDirtyMask &= static_cast< uint8_t >( ~projBit );
+
+		s_numMatrixRebuilds++;
+	}
+
+	return m_viewProjectionMatrix[ projNum ];
+}
+
+
+//------------------------------------------------------------------------------------------------
+void LightCamera::SetShadowResolution( uint resolution, int num /*= 0 */ )
+{
+	if ( resolution == 0 || resolution > DEPTH_TEXTURE_SIZE )
+	{
+		resolution = DEPTH_TEXTURE_SIZE;
+	}
+
+	m_shadowResolution[ num ] = resolution;
+}
+
+
+//------------------------------------------------------------------------------------------------
+uint LightCamera::GetShadowResolution( int num /*= 0 */ ) const
+{
+	return m_shadowResolution[ num ];
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Distance at which c + l*d + q*d^2 attenuates the light below cutoffIntensity
+float LightCamera::GetAttenuationRadius( float cutoffIntensity, float maxRadius ) const
+{
+	float constant  = m_lightValues.m_attenuation.x;
+	float linear    = m_lightValues.m_attenuation.y;
+	float quadratic = m_lightValues.m_attenuation.z;
+	float target    = m_lightValues.m_intensity / cutoffIntensity;
+
+	float radius = maxRadius;
+	if ( quadratic > 0.0f )
+	{
+		float discriminant = ( linear * linear ) - ( 4.0f * quadratic * ( constant - target ) );
+		if ( discriminant > 0.0f )
+		{
+			radius = ( -linear + sqrtf( discriminant ) ) / ( 2.0f * quadratic );
+		}
+	}
+	else if ( linear > 0.0f )
+	{
+		radius = ( target - constant ) / linear;
+	}
+
+	return Clamp( radius, 0.0f, maxRadius );
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool LightCamera::IsSphereInsideSpotCone( Vec3 const& center, float radius, float range ) const
+{
+	Vec3 apexToCenter = center - m_lightValues.m_worldPosition;
+	Vec3 coneAxis     = m_lightValues.m_direction.GetNormalized();
+
+	float distanceAlongAxis = DotProduct3D( apexToCenter, coneAxis );
+	if ( distanceAlongAxis > range + radius || distanceAlongAxis < -radius )
+		return false;
+
+	float cosAngle = Clamp( m_lightValues.m_dotOuterAngle, -1.0f, 1.0f );
+	float sinAngle = sqrtf( 1.0f - ( cosAngle * cosAngle ) );
+
+	float distanceFromAxisSquared = apexToCenter.GetLengthSquared() - ( distanceAlongAxis * distanceAlongAxis );
+	float distanceFromAxis        = distanceFromAxisSquared > 0.0f ? sqrtf( distanceFromAxisSquared ) : 0.0f;
+	
+	float distanceFromConeSurface = ( cosAngle * distanceFromAxis ) - ( sinAngle * distanceAlongAxis );
+	return distanceFromConeSurface <= radius;
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool LightCamera::IsSphereInsideCubeFace( Vec3 const& center, float radius, float range, int faceNum ) const
+{
+	if ( GetDistanceSquared3D( center, m_lightValues.m_worldPosition ) > ( range + radius ) * ( range + radius ) )
+		return false;
+
+	Mat44 worldToFace = GetCubeFaceRotation( faceNum );
+	worldToFace.Append( GetRenderViewMatrix() );
+
+	Vec3 faceCenter = worldToFace.TransformPosition3D( center );
+	if ( faceCenter.z < -radius )
+		return false;
+
+	// 90 degree face frustum side planes are x = +-z and y = +-z
+	float planeRadius = radius * 1.41421356f;
+	return ( faceCenter.x - faceCenter.z <= planeRadius ) &&
+		   ( -faceCenter.x - faceCenter.z <= planeRadius ) &&
+		   ( faceCenter.y - faceCenter.z <= planeRadius ) &&
+		   ( -faceCenter.y - faceCenter.z <= planeRadius );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Rotates light view space so that the given cube face looks down +z
+Mat44 LightCamera::GetCubeFaceRotation( int faceNum )
+{
+	static Vec3 const faceForward[ NUM_CUBE_FACES ] =
+	{
+		Vec3(  1.0f,  0.0f,  0.0f ),
+		Vec3( -1.0f,  0.0f,  0.0f ),
+		Vec3(  0.0f,  1.0f,  0.0f ),
+		Vec3(  0.0f, -1.0f,  0.0f ),
+		Vec3(  0.0f,  0.0f,  1.0f ),
+		Vec3(  0.0f,  0.0f, -1.0f )
+	};
+	static Vec3 const faceUp[ NUM_CUBE_FACES ] =
+	{
+		Vec3( 0.0f, 1.0f,  0.0f ),
+		Vec3( 0.0f, 1.0f,  0.0f ),
+		Vec3( 0.0f, 0.0f, -1.0f ),
+		Vec3( 0.0f, 0.0f,  1.0f ),
+		Vec3( 0.0f, 1.0f,  0.0f ),
+		Vec3( 0.0f, 1.0f,  0.0f )
+	};
+
+	Vec3 forward = faceForward[ faceNum ];
+	Vec3 up      = faceUp[ faceNum ];
+	Vec3 right   = CrossProduct3D( up, forward );
+
+	Mat44 faceToView( right, up, forward, Vec3::ZERO );
+	return faceToView.GetOrthonormalInverse();
+}
+
+
 //-----------------------------------------------------------------------------------------------
 Texture* LightCamera::GetDepthTexture() const
 {
@@ -78,10 +234,7 @@ Texture* LightCamera::GetDepthTexture() const
 LightCameraData LightCamera::GetLightCameraData() const
 {
 	LightCameraData data;
-	//Mat44 renderMatrix = camera.GetRenderMatrix().GetOrthonormalInverse();
-	Mat44 renderMatrix = GetRenderMatrix();
-	renderMatrix.Append( GetViewMatrix() );
-	data.m_viewMatrix = renderMatrix;
+	data.m_viewMatrix = GetRenderViewMatrix();
 	
 	for ( int cascadeNum = 0; cascadeNum < NUM_CASCADES; cascadeNum++ )
 	{
@@ -94,23 +247,45 @@ LightCameraData LightCamera::GetLightCameraData() const
 }
 
 
+//------------------------------------------------------------------------------------------------
+DepthPassView LightCamera::GetDepthPassView( int num /*= 0 */ ) const
+{
+	DepthPassView view;
+	view.m_viewMatrix       = GetRenderViewMatrix();
+	view.m_projectionMatrix = m_projectionMatrix[ num ];
+	view.m_position         = GetPosition();
+	view.m_depthTexture     = m_texture;
+	view.m_depthSlice       = static_cast< uint >( num );
+	view.m_resolution       = m_shadowResolution[ num ];
+	return view;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void LightCamera::ToggleShadowCasting()
 {
-	m_shadowCasting = !m_shadowCasting;
+	m_lightValues.m_isShadowCasting = m_lightValues.m_isShadowCasting ? 0 : 1;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 bool LightCamera::IsShadowCasting() const
 {
-	return m_shadowCasting;
+	return m_lightValues.m_isShadowCasting != 0;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void LightCamera::GetLightCameraAxes( Vec3& out_iBasis, Vec3& out_jBasis, Vec3& out_kBasis ) const
 {
+	if ( m_lightValues.m_lightType == POINT_LIGHT )
+	{
+		out_iBasis = Vec3( 1.0f, 0.0f, 0.0f );
+		out_jBasis = Vec3( 0.0f, 1.0f, 0.0f );
+		out_kBasis = Vec3( 0.0f, 0.0f, 1.0f );
+		return;
+	}
+
 	out_iBasis = ( m_lightValues.m_direction );
 	out_iBasis = out_iBasis.GetNormalized();
 
@@ -130,22 +305,44 @@ void LightCamera::GetLightCameraAxes( Vec3& out_iBasis, Vec3& out_jBasis, Vec3&
 
 
 //------------------------------------------------------------------------------------------------
-void LightCamera::CreateDepthTextures( uint numCascades /*= 1 */ )
+// Each slice is textureSize squared; views smaller than that render into its top left corner
+//
+void LightCamera::CreateDepthTextures( uint numCascades /*= 1 */, uint textureSize /*= DEPTH_TEXTURE_SIZE */ )
 {
-	if ( m_texture != nullptr && m_numCascades == numCascades )
+	if ( m_texture != nullptr && m_numCascades == numCascades && m_depthTextureSize == textureSize )
 		return;
 
-	if ( m_texture != nullptr )
-	{ 
-		g_theRenderer->DeleteTexture( m_texture );
-		m_texture = nullptr;
-	}
+	ReleaseDepthTextures();
 
-	m_numCascades = numCascades;
+	m_numCascades      = numCascades;
+	m_depthTextureSize = textureSize;
 
 	IntVec2 dimensions;
-	dimensions.x = DEPTH_TEXTURE_SIZE;
-	dimensions.y = DEPTH_TEXTURE_SIZE;
+	dimensions.x = static_cast< int >( textureSize );
+	dimensions.y = static_cast< int >( textureSize );
 
 	m_texture = g_theRenderer->CreateDepthBufferTexture( dimensions, numCascades );
 }
+
+
+//------------------------------------------------------------------------------------------------
+void LightCamera::ReleaseDepthTextures()
+{
+	g_theRenderer->DeleteTexture( m_texture );
+	m_numCascades      = 0;
+	m_depthTextureSize = 0;
+}
+
+
+//------------------------------------------------------------------------------------------------
+uint LightCamera::GetNumDepthSlices() const
+{
+	return m_numCascades;
+}
+
+
+//------------------------------------------------------------------------------------------------
+uint LightCamera::GetDepthTextureSize() const
+{
+	return m_depthTextureSize;
+}
@@ -2,10 +2,14 @@
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/LightStructure.hpp"
 
+#include <cstdint>
+
 
 //-----------------------------------------------------------------------------------------------
 class Texture;
 
+struct DepthPassView;
+
 
 //-----------------------------------------------------------------------------------------------
 struct LightCameraData
@@ -23,8 +27,12 @@ private:
 	LightDataC m_lightValues;
 
 	Texture*   m_texture  = nullptr; 
-	bool       m_shadowCasting = false;
+	uint       m_depthTextureSize = 0;
 	Mat44      m_projectionMatrix[ NUM_CASCADES ];
+	uint       m_shadowResolution[ NUM_CASCADES ];
+
+	mutable Mat44   m_viewProjectionMatrix[ NUM_CASCADES ];
+	mutable uint8_t m_viewProjectionDirtyMask = 0xFF;
 
 	uint       m_numCascades = 0;
 
@@ -34,22 +42,37 @@ public:
 	~LightCamera();
 	LightCamera( LightCamera const& copy ) = delete;
 
-	void            SetLightValues( LightDataC data );
-			        
-	Mat44           GetViewMatrix() const override;
+	void            SetLightValues( LightDataC const& data );
 			        
-	void            SetProjectionMatrix( Mat44 proj, int num = 0 );
+	void            SetProjectionMatrix( Mat44 const& proj, int num = 0 );
 			        
-	Mat44           GetProjectionMatrix( int num = 0 ) const;
+	Mat44 const&    GetProjectionMatrix( int num = 0 ) const;
+	Mat44 const&    GetViewProjectionMatrix( int num = 0 ) const;
+
+	void            SetShadowResolution( uint resolution, int num = 0 );
+	uint            GetShadowResolution( int num = 0 ) const;
+
+	float           GetAttenuationRadius( float cutoffIntensity, float maxRadius ) const;
+	bool            IsSphereInsideSpotCone( Vec3 const& center, float radius, float range ) const;
+	bool            IsSphereInsideCubeFace( Vec3 const& center, float radius, float range, int faceNum ) const;
+
+	static Mat44    GetCubeFaceRotation( int faceNum );
 	Texture*        GetDepthTexture() const;
 	
 	LightCameraData GetLightCameraData() const;
+	DepthPassView   GetDepthPassView( int num = 0 ) const;
 	
 	void            ToggleShadowCasting();
 	bool            IsShadowCasting() const;
 			        
 	void            GetLightCameraAxes( Vec3& iBasis, Vec3& jBasis, Vec3& kBasis ) const;
 
-	void            CreateDepthTextures( uint numCascades = 1 );
+	void            CreateDepthTextures( uint numCascades = 1, uint textureSize = DEPTH_TEXTURE_SIZE );
+	void            ReleaseDepthTextures();
+	uint            GetNumDepthSlices() const;
+	uint            GetDepthTextureSize() const;
+
+protected:
+	Mat44           ComputeViewMatrix() const override;
 };
 
@@ -0,0 +1,14 @@
+#pragma once
+#include "Engine/Math/Mat44.hpp"
+
+
+//------------------------------------------------------------------------------------------------
+// Model constant buffer contents; kept apart from Renderer.hpp so recorded draw lists can hold it
+//
+struct ModelTransformationData
+{
+	Mat44 modelMatrix;
+	float tint[ 4 ]                 = { 1.0f, 1.0f, 1.0f, 1.0f };
+	float packedPositionOffset[ 4 ] = { 0.0f, 0.0f, 0.0f, 0.0f };	// mesh bounds mins, used to dequantize Vertex_PackedPUTBN positions
+	float packedPositionScale[ 4 ]  = { 1.0f, 1.0f, 1.0f, 0.0f };	// mesh bounds extent
+};
@@ -0,0 +1,267 @@
+#include "Engine/Renderer/RenderQueue.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+
+//------------------------------------------------------------------------------------------------
+// Ids past the field's range share the last value; that only costs grouping, never correctness
+//
+template <typename KEY>
+static uint GetOrAssignID( std::map<KEY, uint>& ids, KEY const& key, int numBits )
+{
+	auto found = ids.find( key );
+	if ( found != ids.end() )
+	{
+		return found->second;
+	}
+
+	uint maxID = ( 1u << numBits ) - 1u;
+	uint newID = static_cast< uint >( ids.size() ) < maxID ? static_cast< uint >( ids.size() ) : maxID;
+	ids[ key ] = newID;
+	return newID;
+}
+
+
+//------------------------------------------------------------------------------------------------
+static bool AreRasterStatesEqual( RasterState const& a, RasterState const& b )
+{
+	return a.m_cullmode == b.m_cullmode && a.m_windingOrder == b.m_windingOrder && a.m_fillMode == b.m_fillMode;
+}
+
+
+//------------------------------------------------------------------------------------------------
+template <typename KEY>
+static bool IsIDRangeFull( std::map<KEY, uint> const& ids, int numBits )
+{
+	return static_cast< uint >( ids.size() ) >= ( 1u << numBits ) - 1u;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// A table that has run out of ids starts over, so a long session of streaming meshes in and out keeps
+// sorting into distinct groups instead of piling everything onto the last id
+//
+void RenderQueue::Reset()
+{
+	m_items.clear();
+	m_sortEntries.clear();
+
+	if ( IsIDRangeFull( m_shaderIDs, SORT_KEY_SHADER_BITS ) )
+	{
+		m_shaderIDs.clear();
+	}
+	if ( IsIDRangeFull( m_materialIDs, SORT_KEY_MATERIAL_BITS ) )
+	{
+		m_materialIDs.clear();
+	}
+	if ( IsIDRangeFull( m_meshIDs, SORT_KEY_MESH_BITS ) )
+	{
+		m_meshIDs.clear();
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+void RenderQueue::ResetStateIDs()
+{
+	m_shaderIDs.clear();
+	m_materialIDs.clear();
+	m_meshIDs.clear();
+}
+
+
+//------------------------------------------------------------------------------------------------
+void RenderQueue::AddItem( RenderQueueItem const& item )
+{
+	ASSERT_OR_DIE( item.m_vbo != nullptr, "Render queue items need a vertex buffer" );
+
+	SortEntry entry;
+	entry.m_key   = MakeSortKey( item );
+	entry.m_index = static_cast< uint >( m_items.size() );
+
+	m_items.push_back( item );
+	m_sortEntries.push_back( entry );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void RenderQueue::Submit( Renderer* renderer )
+{
+	m_stats = RenderQueueStats();
+
+	SortItems();
+
+	Shader*             boundShader       = nullptr;
+	Texture const*      boundDiffuse      = nullptr;
+	Texture const*      boundNormal       = nullptr;
+	VertexBuffer const* boundVBO          = nullptr;
+	VertexBuffer const* boundAttributeVBO = nullptr;
+	IndexBuffer const*  boundIBO          = nullptr;
+	RasterState         boundRasterState;
+	bool                isFirstDraw       = true;
+
+	for ( SortEntry const& entry : m_sortEntries )
+	{
+		RenderQueueItem const& item = m_items[ entry.m_index ];
+
+		bool shaderChanged = isFirstDraw || item.m_shader != boundShader;
+		if ( shaderChanged )
+		{
+			renderer->BindShader( item.m_shader );
+			boundShader = item.m_shader;
+			m_stats.m_bindsIssued++;
+		}
+		else
+		{
+			m_stats.m_bindsSkipped++;
+		}
+
+		if ( isFirstDraw || item.m_diffuseTexture != boundDiffuse )
+		{
+			renderer->BindTexture( item.m_diffuseTexture );
+			boundDiffuse = item.m_diffuseTexture;
+			m_stats.m_bindsIssued++;
+		}
+		else
+		{
+			m_stats.m_bindsSkipped++;
+		}
+
+		if ( isFirstDraw || item.m_normalTexture != boundNormal )
+		{
+			renderer->BindTexture( item.m_normalTexture, 1 );
+			boundNormal = item.m_normalTexture;
+			m_stats.m_bindsIssued++;
+		}
+		else
+		{
+			m_stats.m_bindsSkipped++;
+		}
+
+		if ( isFirstDraw || !AreRasterStatesEqual( item.m_rasterState, boundRasterState ) )
+		{
+			renderer->SetRasterState( item.m_rasterState );
+			boundRasterState = item.m_rasterState;
+			m_stats.m_bindsIssued++;
+		}
+		else
+		{
+			m_stats.m_bindsSkipped++;
+		}
+
+		renderer->SetModelBuffer( item.m_modelData );
+
+		// The input layout comes from the bound shader, so a shader change forces the buffers to rebind too
+		bool meshChanged = shaderChanged || item.m_vbo != boundVBO || item.m_attributeVBO != boundAttributeVBO || item.m_ibo != boundIBO;
+		if ( meshChanged )
+		{
+			if ( item.m_ibo == nullptr )
+			{
+				renderer->DrawVertexBuffer( item.m_vbo, item.m_count );
+			}
+			else if ( item.m_attributeVBO != nullptr )
+			{
+				renderer->DrawIndexedVertexStreams( item.m_vbo, item.m_attributeVBO, item.m_ibo, item.m_count, item.m_indexOffset );
+			}
+			else
+			{
+				renderer->DrawIndexedVertexBuffer( item.m_vbo, item.m_ibo, item.m_count, item.m_indexOffset );
+			}
+
+			boundVBO          = item.m_vbo;
+			boundAttributeVBO = item.m_attributeVBO;
+			boundIBO          = item.m_ibo;
+			m_stats.m_bindsIssued++;
+		}
+		else
+		{
+			if ( item.m_ibo == nullptr )
+			{
+				renderer->Draw( item.m_count );
+			}
+			else
+			{
+				renderer->DrawIndexed( item.m_count, item.m_indexOffset );
+			}
+			m_stats.m_bindsSkipped++;
+		}
+
+		m_stats.m_numDraws++;
+		isFirstDraw = false;
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+RenderQueueItem const& RenderQueue::GetSortedItem( int sortedIndex ) const
+{
+	return m_items[ m_sortEntries[ sortedIndex ].m_index ];
+}
+
+
+//------------------------------------------------------------------------------------------------
+uint64_t RenderQueue::GetSortedKey( int sortedIndex ) const
+{
+	return m_sortEntries[ sortedIndex ].m_key;
+}
+
+
+//------------------------------------------------------------------------------------------------
+uint64_t RenderQueue::MakeSortKey( RenderQueueItem const& item )
+{
+	uint64_t layer      = static_cast< uint64_t >( item.m_layer ) & ( ( 1ull << SORT_KEY_LAYER_BITS ) - 1ull );
+	uint64_t shaderID   = GetOrAssignID( m_shaderIDs, static_cast< void const* >( item.m_shader ), SORT_KEY_SHADER_BITS );
+	uint64_t materialID = GetOrAssignID( m_materialIDs, std::make_pair( static_cast< void const* >( item.m_diffuseTexture ), static_cast< void const* >( item.m_normalTexture ) ), SORT_KEY_MATERIAL_BITS );
+	uint64_t meshID     = GetOrAssignID( m_meshIDs, std::make_pair( static_cast< void const* >( item.m_vbo ), static_cast< void const* >( item.m_ibo ) ), SORT_KEY_MESH_BITS );
+
+	float    maxDepth   = static_cast< float >( ( 1u << SORT_KEY_DEPTH_BITS ) - 1u );
+	uint64_t depth      = static_cast< uint64_t >( ClampZeroToOne( item.m_depth ) * maxDepth );
+
+	uint64_t key = layer;
+	key = ( key << SORT_KEY_SHADER_BITS ) | shaderID;
+	key = ( key << SORT_KEY_MATERIAL_BITS ) | materialID;
+	key = ( key << SORT_KEY_MESH_BITS ) | meshID;
+	key = ( key << SORT_KEY_DEPTH_BITS ) | depth;
+	return key;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// LSD radix sort, one byte per pass. Stable, so equal keys keep submission order. Passes where every
+// key has the same byte are skipped, which with few state groups removes most of them
+//
+void RenderQueue::SortItems()
+{
+	size_t numEntries = m_sortEntries.size();
+	if ( numEntries < 2 )
+		return;
+
+	m_sortScratch.resize( numEntries );
+
+	for ( int shift = 0; shift < 64; shift += 8 )
+	{
+		uint counts[ 256 ] = {};
+		for ( SortEntry const& entry : m_sortEntries )
+		{
+			counts[ ( entry.m_key >> shift ) & 0xFF ]++;
+		}
+
+		if ( counts[ ( m_sortEntries[ 0 ].m_key >> shift ) & 0xFF ] == numEntries )
+			continue;
+
+		uint offsets[ 256 ];
+		uint runningOffset = 0;
+		for ( int digit = 0; digit < 256; digit++ )
+		{
+			offsets[ digit ] = runningOffset;
+			runningOffset   += counts[ digit ];
+		}
+
+		for ( SortEntry const& entry : m_sortEntries )
+		{
+			m_sortScratch[ offsets[ ( entry.m_key >> shift ) & 0xFF ]++ ] = entry;
+		}
+
+		m_sortEntries.swap( m_sortScratch );
+	}
+}
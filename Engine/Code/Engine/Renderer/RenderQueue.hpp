@@ -0,0 +1,91 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+
+#include <map>
+#include <vector>
+
+
+//------------------------------------------------------------------------------------------------
+class IndexBuffer;
+class Shader;
+class Texture;
+class VertexBuffer;
+
+
+//------------------------------------------------------------------------------------------------
+// Sort key layout, most significant first: layer | shader | material | mesh | depth
+//
+constexpr int SORT_KEY_LAYER_BITS    = 4;
+constexpr int SORT_KEY_SHADER_BITS   = 12;
+constexpr int SORT_KEY_MATERIAL_BITS = 16;
+constexpr int SORT_KEY_MESH_BITS     = 16;
+constexpr int SORT_KEY_DEPTH_BITS    = 16;
+
+
+//------------------------------------------------------------------------------------------------
+struct RenderQueueItem
+{
+	ModelTransformationData m_modelData;
+	RasterState             m_rasterState;
+	Shader*                 m_shader         = nullptr;
+	Texture const*          m_diffuseTexture = nullptr;		// nullptr binds the renderer's default maps
+	Texture const*          m_normalTexture  = nullptr;
+	VertexBuffer const*     m_vbo            = nullptr;
+	VertexBuffer const*     m_attributeVBO   = nullptr;		// set when positions and attributes are split streams
+	IndexBuffer const*      m_ibo            = nullptr;		// nullptr draws m_count vertices without indices
+	int                     m_count          = 0;
+	int                     m_indexOffset    = 0;
+	uint8_t                 m_layer          = 0;			// coarse ordering, e.g. opaque before transparent
+	float                   m_depth          = 0.0f;		// normalized view depth, front to back within a state group
+};
+
+
+//------------------------------------------------------------------------------------------------
+struct RenderQueueStats
+{
+	int m_numDraws     = 0;
+	int m_bindsIssued  = 0;
+	int m_bindsSkipped = 0;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Collects one view's draws, radix sorts them by a 64 bit state key and submits them binding only
+// the shader, textures, raster state and buffers that differ from the previous draw
+//
+class RenderQueue
+{
+public:
+	void Reset();
+	void ResetStateIDs();
+	void AddItem( RenderQueueItem const& item );
+	void SortItems();
+	void Submit( Renderer* renderer );
+
+	int                     GetNumItems() const				{ return static_cast< int >( m_items.size() ); }
+	RenderQueueItem const&  GetSortedItem( int sortedIndex ) const;
+	uint64_t                GetSortedKey( int sortedIndex ) const;
+	RenderQueueStats const& GetStats() const				{ return m_stats; }
+
+private:
+	struct SortEntry
+	{
+		uint64_t m_key   = 0;
+		uint     m_index = 0;
+	};
+
+	uint64_t MakeSortKey( RenderQueueItem const& item );
+
+private:
+	std::vector<RenderQueueItem> m_items;
+	std::vector<SortEntry>       m_sortEntries;
+	std::vector<SortEntry>       m_sortScratch;
+	RenderQueueStats             m_stats;
+
+	// Ids are handed out on first sight and kept, so state groups sort the same way every frame. They are
+	// keyed on addresses, so whoever frees GPU objects calls ResetStateIDs before the addresses get reused
+	std::map<void const*, uint>                         m_shaderIDs;
+	std::map<std::pair<void const*, void const*>, uint> m_materialIDs;
+	std::map<std::pair<void const*, void const*>, uint> m_meshIDs;
+};
@@ -0,0 +1,193 @@
+#include "Engine/Renderer/RenderThread.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//------------------------------------------------------------------------------------------------
+RenderThread* g_theRenderThread = nullptr;
+
+
+//------------------------------------------------------------------------------------------------
+RenderThread::RenderThread( RenderThreadConfig const& config ) :
+	m_config( config )
+{
+}
+
+
+//------------------------------------------------------------------------------------------------
+RenderThread::~RenderThread()
+{
+}
+
+
+//------------------------------------------------------------------------------------------------
+void RenderThread::Startup()
+{
+	ASSERT_OR_DIE( m_config.m_maxFramesInFlight >= 1, "RenderThread needs room for at least one frame in flight" );
+
+	m_queuedFrames.resize( static_cast< size_t >( m_config.m_maxFramesInFlight ) );
+	m_numFramesSubmitted = 0;
+	m_numFramesFinished  = 0;
+
+	if ( m_config.m_isThreaded )
+	{
+		StartThread();
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Every submitted frame still runs, so nothing a packet references is released under it
+//
+void RenderThread::Shutdown()
+{
+	WaitUntilIdle();
+	StopThread();
+	m_queuedFrames.clear();
+}
+
+
+//------------------------------------------------------------------------------------------------
+void RenderThread::BeginFrame()
+{
+	m_queueLock.lock();
+	m_stats.m_lastWaitSeconds = static_cast< float >( m_waitSecondsThisFrame );
+	m_waitSecondsThisFrame    = 0.0;
+	m_queueLock.unlock();
+}
+
+
+//------------------------------------------------------------------------------------------------
+void RenderThread::SubmitFrame( RenderFrameFunction function, void const* framePacket )
+{
+	QueuedFrame frame;
+	frame.m_function    = function;
+	frame.m_framePacket = framePacket;
+
+	if ( !m_config.m_isThreaded )
+	{
+		m_queueLock.lock();
+		m_numFramesSubmitted++;
+		m_queueLock.unlock();
+
+		ExecuteFrame( frame );
+		return;
+	}
+
+	double   waitStartSeconds  = GetCurrentTimeSeconds();
+	uint64_t maxFramesInFlight = static_cast< uint64_t >( m_queuedFrames.size() );
+	{
+		std::unique_lock<std::mutex> lock( m_queueLock );
+		m_frameFinishedCondition.wait( lock, [ this, maxFramesInFlight ]() { return m_numFramesSubmitted - m_numFramesFinished < maxFramesInFlight; } );
+		m_waitSecondsThisFrame += GetCurrentTimeSeconds() - waitStartSeconds;
+
+		m_queuedFrames[ m_numFramesSubmitted % maxFramesInFlight ] = frame;
+		m_numFramesSubmitted++;
+	}
+	m_frameQueuedCondition.notify_one();
+}
+
+
+//------------------------------------------------------------------------------------------------
+void RenderThread::WaitUntilIdle()
+{
+	double waitStartSeconds = GetCurrentTimeSeconds();
+
+	std::unique_lock<std::mutex> lock( m_queueLock );
+	m_frameFinishedCondition.wait( lock, [ this ]() { return m_numFramesFinished == m_numFramesSubmitted; } );
+	m_waitSecondsThisFrame += GetCurrentTimeSeconds() - waitStartSeconds;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void RenderThread::SetThreaded( bool isThreaded )
+{
+	if ( isThreaded == m_config.m_isThreaded )
+		return;
+
+	WaitUntilIdle();
+	if ( isThreaded )
+	{
+		StartThread();
+	}
+	else
+	{
+		StopThread();
+	}
+	m_config.m_isThreaded = isThreaded;
+}
+
+
+//------------------------------------------------------------------------------------------------
+RenderThreadStats RenderThread::GetStats() const
+{
+	m_queueLock.lock();
+	RenderThreadStats stats = m_stats;
+	m_queueLock.unlock();
+	return stats;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void RenderThread::StartThread()
+{
+	m_isQuitting = false;
+	m_thread     = new std::thread( &RenderThread::RenderThreadMain, this );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void RenderThread::StopThread()
+{
+	if ( m_thread == nullptr )
+		return;
+
+	m_queueLock.lock();
+	m_isQuitting = true;
+	m_queueLock.unlock();
+	m_frameQueuedCondition.notify_all();
+
+	m_thread->join();
+	delete m_thread;
+	m_thread = nullptr;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Frames run strictly in submission order; a quit request is only honored once the queue is empty
+//
+void RenderThread::RenderThreadMain()
+{
+	uint64_t maxFramesInFlight = static_cast< uint64_t >( m_queuedFrames.size() );
+
+	for ( ;; )
+	{
+		QueuedFrame frame;
+		{
+			std::unique_lock<std::mutex> lock( m_queueLock );
+			m_frameQueuedCondition.wait( lock, [ this ]() { return m_isQuitting || m_numFramesFinished < m_numFramesSubmitted; } );
+			if ( m_numFramesFinished == m_numFramesSubmitted )
+				return;
+
+			frame = m_queuedFrames[ m_numFramesFinished % maxFramesInFlight ];
+		}
+
+		ExecuteFrame( frame );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+void RenderThread::ExecuteFrame( QueuedFrame const& frame )
+{
+	double startSeconds = GetCurrentTimeSeconds();
+	frame.m_function( frame.m_framePacket );
+	float frameSeconds = static_cast< float >( GetCurrentTimeSeconds() - startSeconds );
+
+	m_queueLock.lock();
+	m_stats.m_lastFrameSeconds = frameSeconds;
+	m_numFramesFinished++;
+	m_queueLock.unlock();
+
+	m_frameFinishedCondition.notify_all();
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+//------------------------------------------------------------------------------------------------
+typedef void (*RenderFrameFunction)( void const* framePacket );
+
+
+//------------------------------------------------------------------------------------------------
+struct RenderThreadConfig
+{
+	int  m_maxFramesInFlight = 1;		// submitted but unfinished frames; SubmitFrame blocks past this, capping latency
+	bool m_isThreaded        = true;	// false executes every frame inside SubmitFrame, on the submitting thread
+};
+
+
+//------------------------------------------------------------------------------------------------
+struct RenderThreadStats
+{
+	float m_lastFrameSeconds = 0.0f;	// executing the most recently finished frame
+	float m_lastWaitSeconds  = 0.0f;	// the submitting thread spent blocked on the render thread last frame
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Executes frames on a dedicated thread, which owns the renderer's device context while a frame runs.
+// A submitted packet must stay untouched until the frame has finished, so callers keep one more packet
+// than m_maxFramesInFlight and build the next frame into whichever one is free. Anything else that uses
+// the renderer, or destroys resources a packet may reference, calls WaitUntilIdle first
+//
+class RenderThread
+{
+public:
+	RenderThread( RenderThreadConfig const& config );
+	~RenderThread();
+	void Startup();
+	void Shutdown();
+	void BeginFrame();
+
+	void SubmitFrame( RenderFrameFunction function, void const* framePacket );
+	void WaitUntilIdle();
+	void SetThreaded( bool isThreaded );
+
+	bool              IsThreaded() const				{ return m_config.m_isThreaded; }
+	int               GetMaxFramesInFlight() const		{ return m_config.m_maxFramesInFlight; }
+	RenderThreadStats GetStats() const;
+
+private:
+	struct QueuedFrame
+	{
+		RenderFrameFunction m_function    = nullptr;
+		void const*         m_framePacket = nullptr;
+	};
+
+	void StartThread();
+	void StopThread();
+	void RenderThreadMain();
+	void ExecuteFrame( QueuedFrame const& frame );
+
+private:
+	RenderThreadConfig       m_config;
+	std::thread*             m_thread = nullptr;
+
+	mutable std::mutex       m_queueLock;
+	std::condition_variable  m_frameQueuedCondition;		// the render thread sleeps on this
+	std::condition_variable  m_frameFinishedCondition;		// submitters waiting for room or for idle sleep on this
+	std::vector<QueuedFrame> m_queuedFrames;				// ring of m_maxFramesInFlight, indexed by frame number
+	uint64_t                 m_numFramesSubmitted = 0;
+	uint64_t                 m_numFramesFinished  = 0;
+	bool                     m_isQuitting         = false;
+
+	RenderThreadStats        m_stats;
+	double                   m_waitSecondsThisFrame = 0.0;
+};
@@ -11,11 +11,15 @@
 #include "Engine/Renderer/D3D11Internal.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
 #include "Engine/Renderer/DefaultShaderSource.hpp"
+#include "Engine/Renderer/DrawCommandList.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/ErrorShaderSource.hpp"
 #include "Engine/Renderer/Lighting/LightCamera.hpp"
 #include "Engine/Renderer/Shader.hpp"
 #include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/TextureStreamer.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
+#include "Engine/Renderer/VertexData/Vertex_PackedPUTBN.hpp"
 #include "Engine/Window/Window.hpp"
 
 #include "ThirdParty/stb/stb_image.h"
@@ -28,6 +32,8 @@
 #include <shobjidl_core.h>
 
 #include <d3d11sdklayers.h>
+#include <cstddef>
+#include <cstring>
 
 #if defined(ENGINE_DEBUG_RENDERER)
 
@@ -65,11 +71,24 @@ void Renderer::Startup()
 	m_cameraCBO = CreateConstantBuffer( sizeof( ShaderTransformationData ) );
 	m_modelCBO = CreateConstantBuffer( sizeof( ModelTransformationData ) );
 	m_lightCBO = CreateConstantBuffer( sizeof( ShaderLightData ) );
+	m_shadowMatrixCBO = CreateConstantBuffer( sizeof( ShaderShadowMatrixData ) );
 	m_immediateVBO = CreateDynamicVertexBuffer( sizeof( Vertex_PCUTBN ) );
 	CreateDefaultAndErrorShader();
 	CreateBlendStates();
 	CreateSamplerStates();
 	CreateDefaultTexture();
+
+	if ( m_config.m_streamTextures )
+	{
+		TextureStreamerConfig streamerConfig;
+		streamerConfig.m_renderer                  = this;
+		streamerConfig.m_useCookedTextures         = m_config.m_useCookedTextures;
+		streamerConfig.m_residentBudgetBytes       = m_config.m_textureBudgetBytes;
+		streamerConfig.m_uploadBudgetBytesPerFrame = m_config.m_textureUploadBytesPerFrame;
+		m_textureStreamer = new TextureStreamer( streamerConfig );
+		m_textureStreamer->Startup();
+	}
+
 	m_defaultDepthStencil = CreateDepthStencilTexture( IntVec2( m_config.m_window->GetClientWidth(), m_config.m_window->GetClientHeight() ) );
 
 #if defined(ENGINE_DEBUG_RENDERING)
@@ -86,6 +105,12 @@ void Renderer::Startup()
 //-----------------------------------------------------------------------------------------------
 void Renderer::BeginFrame()
 {
+	Camera::ResetNumMatrixRebuilds();
+
+	if ( m_textureStreamer != nullptr )
+	{
+		m_textureStreamer->BeginFrame();
+	}
 
 #if defined(ENGINE_DEBUG_RENDERING)
 
@@ -114,6 +139,14 @@ void Renderer::EndFrame()
 //-----------------------------------------------------------------------------------------------
 void Renderer::Shutdown()
 {
+	// Loader threads write into textures' stream entries, so they stop before anything is released
+	if ( m_textureStreamer != nullptr )
+	{
+		m_textureStreamer->Shutdown();
+		delete m_textureStreamer;
+		m_textureStreamer = nullptr;
+	}
+
 	DestroyRC();
 
 #if defined (ENGINE_DEBUG_RENDERING)
@@ -150,6 +183,8 @@ void Renderer::Shutdown()
 
 	DestroyConstantBuffer( m_lightCBO );
 	m_lightCBO = nullptr;
+	DestroyConstantBuffer( m_shadowMatrixCBO );
+	m_shadowMatrixCBO = nullptr;
 
 #if defined(ENGINE_DEBUG_RENDERER)
 
@@ -204,9 +239,7 @@ void Renderer::BeginCamera( const Camera& camera )
 	m_context->RSSetViewports( 1, &viewport );
 
 	ShaderTransformationData data;
-	Mat44 renderMatrix = camera.GetRenderMatrix();
-	renderMatrix.Append( camera.GetViewMatrix() );
-	data.m_viewMatrix = renderMatrix;
+	data.m_viewMatrix = camera.GetRenderViewMatrix();
 	data.m_projectionMatrix = camera.GetProjectionMatrix();
 	data.m_cameraPosition = camera.GetPosition();
 
@@ -234,38 +267,40 @@ void Renderer::BeginCamera( const Camera& camera )
 //-----------------------------------------------------------------------------------------------
 void Renderer::BeginCamera( const LightCamera& camera, int cascadeNum /*= 0*/ )
 {
-	ClearDepthBuffer( camera.GetDepthTexture(), 1.0f, cascadeNum );
+	BeginDepthPass( camera.GetDepthPassView( cascadeNum ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Renderer::BeginDepthPass( DepthPassView const& view )
+{
+	ClearDepthBuffer( view.m_depthTexture, 1.0f, view.m_depthSlice );
 	ClearScreen( Rgba8::WHITE );
 	SetDepthOptions( DepthTest::LESS_EQUAL, true );
 
 	ID3D11RenderTargetView* renderTargetView = nullptr;
-	ID3D11DepthStencilView* depthStencilView = camera.GetDepthTexture()->GetOrCreateDepthStencilBufferView( this, cascadeNum );
+	ID3D11DepthStencilView* depthStencilView = view.m_depthTexture->GetOrCreateDepthStencilBufferView( this, static_cast< int >( view.m_depthSlice ) );
 
 	m_context->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
 
 	m_context->OMSetRenderTargets( 1, &renderTargetView, depthStencilView );
 
-	Vec2 screenSize = Vec2( static_cast< float >( m_config.m_window->GetClientWidth() ), static_cast< float >( m_config.m_window->GetClientHeight() ) );
-
-	AABB2 viewPort = camera.GetViewport( screenSize );
+	float shadowResolution = static_cast< float >( view.m_resolution );
 
 	D3D11_VIEWPORT viewport = {};
 	viewport.TopLeftX       = 0;
 	viewport.TopLeftY       = 0;
-	viewport.Width          = DEPTH_TEXTURE_SIZE;
-	viewport.Height         = DEPTH_TEXTURE_SIZE;
+	viewport.Width          = shadowResolution;
+	viewport.Height         = shadowResolution;
 	viewport.MinDepth       = 0;
 	viewport.MaxDepth       = 1;
 
 	m_context->RSSetViewports( 1, &viewport );
 
 	ShaderTransformationData data;
-	//Mat44 renderMatrix = camera.GetRenderMatrix().GetOrthonormalInverse();
-	Mat44 renderViewMatrix = camera.GetRenderMatrix();
-	renderViewMatrix.Append( camera.GetViewMatrix() );
-	data.m_viewMatrix = renderViewMatrix;
-	data.m_projectionMatrix = camera.GetProjectionMatrix( cascadeNum );
-	data.m_cameraPosition   = camera.GetPosition();
+	data.m_viewMatrix       = view.m_viewMatrix;
+	data.m_projectionMatrix = view.m_projectionMatrix;
+	data.m_cameraPosition   = view.m_position;
 
 	ModelTransformationData defaultData;
 	Rgba8::WHITE.GetAsFloats( defaultData.tint );
@@ -308,13 +343,20 @@ void Renderer::EndCamera( const Camera& camera )
 
 //-----------------------------------------------------------------------------------------------
 void Renderer::EndCamera( const LightCamera& camera )
+{
+	EndDepthPass();
+
+	UNUSED( camera );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Renderer::EndDepthPass()
 {
 	ID3D11RenderTargetView* rtv[ 1 ];
 	rtv[ 0 ] = nullptr;
 
 	m_context->OMSetRenderTargets( 1, rtv, NULL );
-
-	UNUSED( camera );
 }
 
 
@@ -688,7 +730,7 @@ Shader* Renderer::CreateOrGetShaderFromFile( char const* fileNameWithoutExtensio
 {
 	for ( int shaderNum = 0; shaderNum < m_loadedShaders.size(); shaderNum++ )
 	{
-		std::string shaderPath = m_loadedShaders[ shaderNum ]->m_config.m_name;
+		std::string const& shaderPath = m_loadedShaders[ shaderNum ]->m_config.m_name;
 
 		if ( _strcmpi( fileNameWithoutExtension, shaderPath.c_str() ) == 0 )
 		{
@@ -751,17 +793,51 @@ void Renderer::SetModelBuffer( ModelTransformationData data )
 
 
 //-----------------------------------------------------------------------------------------------
-void Renderer::SetLightBuffer( ShaderLightData data )
+void Renderer::SetLightBuffer( ShaderLightData const& data )
 {
-	if ( !m_lightCBO->SetData( data ) )
+	GUARANTEE_OR_DIE( data.m_numLights <= MAXLIGHTS, "Light count exceeds MAXLIGHTS" );
+
+	size_t byteCount = offsetof( ShaderLightData, m_lights ) + ( data.m_numLights * sizeof( LightDataC ) );
+	
+	bool isUnchanged = ( byteCount == m_uploadedLightBytes ) && ( memcmp( &m_uploadedLightData, &data, byteCount ) == 0 );
+	if ( !isUnchanged )
 	{
-		ERROR_RECOVERABLE( "Error in setting the light data" );
+		if ( !m_lightCBO->SetData( &data, byteCount ) )
+		{
+			ERROR_RECOVERABLE( "Error in setting the light data" );
+		}
+
+		memcpy( &m_uploadedLightData, &data, byteCount );
+		m_uploadedLightBytes = byteCount;
 	}
 
 	BindConstantBuffer( 4, m_lightCBO );
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void Renderer::SetShadowMatrixBuffer( ShaderShadowMatrixData const& data, uint numMatrices )
+{
+	GUARANTEE_OR_DIE( numMatrices <= MAX_SHADOW_MATRICES, "Shadow matrix count exceeds MAX_SHADOW_MATRICES" );
+
+	size_t byteCount = numMatrices * sizeof( Mat44 );
+
+	bool isUnchanged = ( byteCount == m_uploadedShadowBytes ) && ( memcmp( &m_uploadedShadowData, &data, byteCount ) == 0 );
+	if ( !isUnchanged && byteCount > 0 )
+	{
+		if ( !m_shadowMatrixCBO->SetData( &data, byteCount ) )
+		{
+			ERROR_RECOVERABLE( "Error in setting the shadow matrix data" );
+		}
+
+		memcpy( &m_uploadedShadowData, &data, byteCount );
+		m_uploadedShadowBytes = byteCount;
+	}
+
+	BindConstantBuffer( 7, m_shadowMatrixCBO );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void Renderer::BindConstantBuffer( int slot, ConstantBuffer* constantBuffer )
 {
@@ -824,6 +900,21 @@ void Renderer::DestroyVertexBuffer( VertexBuffer const* vbo )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+IndexBuffer* Renderer::CreateIndexBuffer()
+{
+	return new IndexBuffer( this );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Renderer::DestroyIndexBuffer( IndexBuffer const* ibo )
+{
+	delete ibo;
+	ibo = nullptr;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 Texture* Renderer::CreateDepthStencilTexture( IntVec2 size )
 {
@@ -932,7 +1023,44 @@ void Renderer::Draw( int vertexCount, int vertexOffset /*= 0*/ )
 
 
 //-----------------------------------------------------------------------------------------------
-void Renderer::DrawVertexBuffer( VertexBuffer const* vbo, int vertexCount )
+void Renderer::DrawIndexed( int indexCount, int indexOffset /*= 0*/, int vertexOffset /*= 0*/ )
+{
+	if ( IsRasterStateDirty() )
+	{
+		DX_SAFE_RELEASE( m_rasterState );
+		m_rasterState = CreateRasterizerState( m_device, m_desiredState );
+		m_context->RSSetState( m_rasterState );
+
+		m_currentState = m_desiredState;
+	}
+
+	UpdateDepthStencilState();
+
+	m_context->DrawIndexed( indexCount, indexOffset, vertexOffset );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Renderer::DrawVertexBuffer( VertexBuffer const* vbo, int vertexCount, int vertexOffset /*= 0 */ )
+{
+	BindVertexBuffer( vbo );
+	Draw( vertexCount, vertexOffset );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Renderer::DrawIndexedVertexBuffer( VertexBuffer const* vbo, IndexBuffer const* ibo, int indexCount, int indexOffset /*= 0*/ )
+{
+	m_context->IASetIndexBuffer( ibo->GetHandle(), DXGI_FORMAT_R32_UINT, 0 );
+	BindVertexBuffer( vbo );
+	DrawIndexed( indexCount, indexOffset );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Binds vbo to slot 0 and picks the input layout from its stride
+//
+void Renderer::BindVertexBuffer( VertexBuffer const* vbo )
 {
 	ID3D11Buffer* vboHandle = vbo->GetHandle();
 	UINT stride = static_cast< UINT >( vbo->GetStride() );
@@ -952,13 +1080,74 @@ void Renderer::DrawVertexBuffer( VertexBuffer const* vbo, int vertexCount )
 	{
 		layout = m_currentShader->CreateOrGetInputLayoutFor_Vertex_PCUTBN();
 	}
+	else if ( stride == static_cast< UINT >( sizeof( Vertex_PackedPosition ) ) )
+	{
+		layout = m_currentShader->CreateOrGetInputLayoutFor_Vertex_PackedPosition();
+	}
 	else
 	{
 		layout = m_currentShader->CreateOrGetInputLayoutFor_Vertex_PCU();
 	}
 	m_context->IASetInputLayout( layout );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Draws a mesh split into a Vertex_PackedPosition stream ( slot 0 ) and a Vertex_PackedUTBN stream ( slot 1 )
+//
+void Renderer::DrawIndexedVertexStreams( VertexBuffer const* positionVBO, VertexBuffer const* attributeVBO, IndexBuffer const* ibo, int indexCount, int indexOffset /*= 0*/ )
+{
+	ASSERT_OR_DIE( positionVBO->GetStride() == sizeof( Vertex_PackedPosition ) && attributeVBO->GetStride() == sizeof( Vertex_PackedUTBN ), "Vertex streams must be Vertex_PackedPosition and Vertex_PackedUTBN" );
+
+	m_context->IASetIndexBuffer( ibo->GetHandle(), DXGI_FORMAT_R32_UINT, 0 );
+
+	ID3D11Buffer* vboHandles[ 2 ] = { positionVBO->GetHandle(), attributeVBO->GetHandle() };
+	UINT strides[ 2 ] = { static_cast< UINT >( positionVBO->GetStride() ), static_cast< UINT >( attributeVBO->GetStride() ) };
+	UINT offsets[ 2 ] = { 0, 0 };
+
+	m_context->IASetVertexBuffers(
+		0,
+		2,
+		vboHandles,
+		strides,
+		offsets
+	);
+
+	m_context->IASetInputLayout( m_currentShader->CreateOrGetInputLayoutFor_Vertex_PackedPUTBN() );
+
+	DrawIndexed( indexCount, indexOffset );
+}
+
 
-	Draw( vertexCount );
+//-----------------------------------------------------------------------------------------------
+void Renderer::ExecuteDrawCommandList( DrawCommandList const& commandList )
+{
+	for ( DrawCommand const& command : commandList.GetCommands() )
+	{
+		switch ( command.m_type )
+		{
+			case DrawCommandType::BIND_SHADER:
+				BindShader( command.m_shader );
+				break;
+			case DrawCommandType::SET_MODEL_BUFFER:
+				SetModelBuffer( commandList.GetModelData( command.m_modelDataIndex ) );
+				break;
+			case DrawCommandType::DRAW_VERTEX_ARRAY_PCU:
+				DrawVertexArray( command.m_count, static_cast< Vertex_PCU const* >( command.m_vertexes ) );
+				break;
+			case DrawCommandType::DRAW_VERTEX_ARRAY_PCUTBN:
+				DrawVertexArray( command.m_count, static_cast< Vertex_PCUTBN const* >( command.m_vertexes ) );
+				break;
+			case DrawCommandType::DRAW_INDEXED_VERTEX_BUFFER:
+				DrawIndexedVertexBuffer( command.m_vbo, command.m_ibo, command.m_count, command.m_offset );
+				break;
+			case DrawCommandType::DRAW_INDEXED_VERTEX_STREAMS:
+				DrawIndexedVertexStreams( command.m_vbo, command.m_attributeVBO, command.m_ibo, command.m_count, command.m_offset );
+				break;
+			default:
+				ERROR_AND_DIE( "Unknown draw command type" );
+		}
+	}
 }
 
 
@@ -1012,6 +1201,14 @@ ID3D11DeviceContext* Renderer::GetDeviceContext() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+TextureStreamingStats const& Renderer::GetTextureStreamingStats() const
+{
+	static TextureStreamingStats const s_noStreamingStats;
+	return m_textureStreamer != nullptr ? m_textureStreamer->GetStats() : s_noStreamingStats;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 IDXGISwapChain* Renderer::GetSwapChain() const
 {
@@ -1020,7 +1217,7 @@ IDXGISwapChain* Renderer::GetSwapChain() const
 
 
 //-----------------------------------------------------------------------------------------------
-Texture* Renderer::CreateOrGetTextureFromFile( char const* imageFilePath )
+Texture* Renderer::CreateOrGetTextureFromFile( char const* imageFilePath, TextureUsage usage /*= TextureUsage::COLOR */ )
 {
 	std::map<std::string, Texture* >::iterator it = m_loadedTextures.find( imageFilePath );
 
@@ -1029,7 +1226,7 @@ Texture* Renderer::CreateOrGetTextureFromFile( char const* imageFilePath )
 		return it->second;
 	}
 
-	Texture* newTexture = CreateTextureFromFile( imageFilePath );
+	Texture* newTexture = CreateTextureFromFile( imageFilePath, usage );
 
 	return newTexture;
 }
@@ -1058,7 +1255,7 @@ BitmapFont* Renderer::CreateOrGetBitmapFontFromFile( char const* filePathWithout
 
 	for ( int fontNum = 0; fontNum < numFonts; fontNum++ )
 	{
-		std::string fontImgPath = m_loadedFonts[ fontNum ]->GetFontPathWithoutExtension();
+		std::string const& fontImgPath = m_loadedFonts[ fontNum ]->GetFontPathWithoutExtension();
 
 		if ( _strcmpi( filePathWithoutExtension, fontImgPath.c_str() ) == 0 )
 		{
@@ -1078,6 +1275,11 @@ void Renderer::DeleteTexture( Texture*& texture )
 	if ( texture == nullptr )
 		return;
 
+	if ( texture->IsStreamed() && m_textureStreamer != nullptr )
+	{
+		m_textureStreamer->ForgetTexture( texture );
+	}
+
 	delete texture;
 	texture = nullptr;
 }
@@ -1397,6 +1599,15 @@ void Renderer::BindTexture( Texture const* texture, int slot /*= 0*/ )
 		}
 
 	}
+	else if ( texture->IsStreamed() )
+	{
+		m_textureStreamer->MarkTextureUsed( texture );
+
+		if ( !texture->IsValid() )
+		{
+			texture = texture->GetUsage() == TextureUsage::NORMAL_MAP ? m_defaultNormal : m_defaultDiffuse;
+		}
+	}
 
 	ID3D11ShaderResourceView* srv = const_cast< Texture* >( texture )->GetOrCreateShaderResourceView( this );
 	m_context->PSSetShaderResources( slot, 1, &srv );
@@ -1471,10 +1682,23 @@ Texture* Renderer::RegisterTexture( char const* textureName, Texture* texture )
 
 
 //-----------------------------------------------------------------------------------------------
-Texture* Renderer::CreateTextureFromFile( const char* imageFilePath )
+// UI textures are small and their size is needed at once, so they never stream
+//
+Texture* Renderer::CreateTextureFromFile( const char* imageFilePath, TextureUsage usage )
 {
 	Texture* newTexture = new Texture();
-	newTexture->LoadFromFile( this, imageFilePath );
+
+	if ( m_textureStreamer != nullptr && usage != TextureUsage::UI )
+	{
+		newTexture->m_imageFilePath = imageFilePath;
+		newTexture->m_usage         = usage;
+		newTexture->m_isStreamed    = true;
+		m_textureStreamer->RequestTexture( newTexture );
+
+		return RegisterTexture( imageFilePath, newTexture );
+	}
+
+	newTexture->LoadFromFile( this, imageFilePath, usage, m_config.m_useCookedTextures );
 
 	if ( newTexture->IsValid() )
 	{
@@ -1516,7 +1740,7 @@ BitmapFont* Renderer::CreateBitmapFontFromFile( char const* filePathWithoutExten
 {
 	std::string fontFile = std::string( std::string( filePathWithoutExtension ).append( ".png" ).c_str() );
 
-	Texture* texture = CreateOrGetTextureFromFile( fontFile.c_str() );
+	Texture* texture = CreateOrGetTextureFromFile( fontFile.c_str(), TextureUsage::UI );
 	BitmapFont* font = new BitmapFont( filePathWithoutExtension, *texture );
 
 	m_loadedFonts.push_back( font );
@@ -5,19 +5,26 @@
 #include "Engine/Renderer/VertexData/Vertex_PCU.hpp"
 #include "Engine/Renderer/VertexData/Vertex_PCUTBN.hpp"
 #include "Engine/Renderer/LightStructure.hpp"
+#include "Engine/Renderer/ModelTransformationData.hpp"
+#include "Engine/Renderer/TextureCooker.hpp"
 
+#include <map>
 #include <vector>
 
 
 //-----------------------------------------------------------------------------------------------
 class Window;
 class Texture;
+class TextureStreamer;
 class BitmapFont;
 class Shader;
 class ConstantBuffer;
+class DrawCommandList;
 class VertexBuffer;
+class IndexBuffer;
 
 struct LightCamera;
+struct TextureStreamingStats;
 struct ID3D11Device;
 struct ID3D11DeviceContext;
 struct ID3D11RenderTargetView;
@@ -46,10 +53,15 @@ struct ShaderTransformationData
 
 
 //------------------------------------------------------------------------------------------------
-struct ModelTransformationData
+// Everything a light depth pass needs from its camera, so the pass can run after the camera has moved on
+struct DepthPassView
 {
-	Mat44 modelMatrix;
-	float tint[ 4 ] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	Mat44    m_viewMatrix;
+	Mat44    m_projectionMatrix;
+	Vec3     m_position;
+	Texture* m_depthTexture = nullptr;
+	uint     m_depthSlice   = 0;
+	uint     m_resolution   = 0;
 };
 
 
@@ -131,7 +143,11 @@ struct RasterState
 //-----------------------------------------------------------------------------------------------
 struct RenderConfig
 {
-	Window* m_window = nullptr;
+	Window* m_window                     = nullptr;
+	bool    m_useCookedTextures          = true;					// load mipped, block compressed .ctex files, cooking them next to the source image when stale
+	bool    m_streamTextures             = true;					// file textures load in the background and bind as the default until resident
+	size_t  m_textureBudgetBytes         = 256 * 1024 * 1024;
+	size_t  m_textureUploadBytesPerFrame = 8 * 1024 * 1024;
 };
 
 
@@ -169,6 +185,8 @@ public:
 	
 	void                 BeginCamera( const LightCamera& camera, int cascadeNum /*= 0*/ );
 	void                 EndCamera( const LightCamera& camera );
+	void                 BeginDepthPass( DepthPassView const& view );
+	void                 EndDepthPass();
 
 
 //--------------------------------------------------------------------------------------------------------------------------------------------
@@ -185,7 +203,7 @@ public:
 //--------------------------------------------------------------------------------------------------------------------------------------------
 	
 
-	Texture*             CreateOrGetTextureFromFile( const char* imageFilePath );
+	Texture*             CreateOrGetTextureFromFile( const char* imageFilePath, TextureUsage usage = TextureUsage::COLOR );
 	Texture*             CreateOrGetCubeTextureFromFiles( std::vector<std::string>& imagePaths );
 	BitmapFont*          CreateOrGetBitmapFontFromFile(const char* filePathWithoutExtension);
 	
@@ -207,6 +225,7 @@ public:
 	
 	ID3D11Device*        GetDevice() const;
 	ID3D11DeviceContext* GetDeviceContext() const;
+	TextureStreamingStats const& GetTextureStreamingStats() const;
 	IDXGISwapChain*      GetSwapChain() const;
 	Shader*              CreateOrGetShaderFromFile( char const* fileNameWithoutExtension );
 	Shader*              CreateOrGetShaderFromSource( char const* shaderName, std::string source );
@@ -221,7 +240,8 @@ public:
 	void                 DestroyConstantBuffer(ConstantBuffer* cbo);
 	void                 BindConstantBuffer( int slot, ConstantBuffer* constantBuffer );
 	void				 SetModelBuffer( ModelTransformationData data );
-	void				 SetLightBuffer( ShaderLightData data );
+	void				 SetLightBuffer( ShaderLightData const& data );
+	void				 SetShadowMatrixBuffer( ShaderShadowMatrixData const& data, uint numMatrices );
 					     
 
 //--------------------------------------------------------------------------------------------------------------------------------------------
@@ -232,6 +252,8 @@ public:
 	VertexBuffer*        CreateDynamicVertexBuffer( size_t const initialByteSize = 0 );
 	void                 CreateNewVertexBuffer( VertexBuffer* vertexBuffer, size_t byteSize );
 	void                 DestroyVertexBuffer( VertexBuffer const* vbo );
+	IndexBuffer*         CreateIndexBuffer();
+	void                 DestroyIndexBuffer( IndexBuffer const* ibo );
 
 	Texture*             CreateDepthStencilTexture( IntVec2 size );
 	void                 SetDepthOptions( DepthTest test, bool writeDepth ); 
@@ -252,7 +274,11 @@ public:
 //--------------------------------------------------------------------------------------------------------------------------------------------
 		                 
 	void                 Draw( int vertexCount, int vertexOffset = 0 );
-	void                 DrawVertexBuffer( VertexBuffer const* vbo, int vertexCount );
+	void                 DrawIndexed( int indexCount, int indexOffset = 0, int vertexOffset = 0 );
+	void                 DrawVertexBuffer( VertexBuffer const* vbo, int vertexCount, int vertexOffset = 0 );
+	void                 DrawIndexedVertexBuffer( VertexBuffer const* vbo, IndexBuffer const* ibo, int indexCount, int indexOffset = 0 );
+	void                 DrawIndexedVertexStreams( VertexBuffer const* positionVBO, VertexBuffer const* attributeVBO, IndexBuffer const* ibo, int indexCount, int indexOffset = 0 );
+	void                 ExecuteDrawCommandList( DrawCommandList const& commandList );
 		                 
 	bool                 IsRasterStateDirty();
 	void                 SetRasterState( RasterState state );
@@ -282,6 +308,7 @@ protected:
 #endif
 
 	void                 AcquireBackBufferRenderTargetView();
+	void                 BindVertexBuffer( VertexBuffer const* vbo );
 
 //--------------------------------------------------------------------------------------------------------------------------------------------
 //			SHADER CREATION
@@ -307,7 +334,7 @@ protected:
 	void                 CreateDefaultTexture();
 	Texture*             RegisterColorTexture( char const* textureName, Rgba8 const& color );
 	Texture*             RegisterTexture( char const* textureName, Texture* texture );
-	Texture*             CreateTextureFromFile(char const* imageFilePath);
+	Texture*             CreateTextureFromFile( char const* imageFilePath, TextureUsage usage );
 	Texture*             CreateTextureCubeFromFile(std::vector<std::string>& imageFilePaths);
 	BitmapFont*          CreateBitmapFontFromFile(char const* filePathWithoutExtension);
 
@@ -321,6 +348,7 @@ protected:
 
 	RenderConfig                    m_config;
 	std::map<std::string, Texture*> m_loadedTextures;
+	TextureStreamer*                m_textureStreamer     = nullptr;
 	std::vector<BitmapFont*>        m_loadedFonts;
 
 	Camera const*                   m_currentCamera       = nullptr;
@@ -343,6 +371,12 @@ protected:
 	ConstantBuffer*                 m_cameraCBO           = nullptr;
 	ConstantBuffer*                 m_modelCBO            = nullptr;
 	ConstantBuffer*                 m_lightCBO            = nullptr;
+	ConstantBuffer*                 m_shadowMatrixCBO     = nullptr;
+
+	ShaderLightData                 m_uploadedLightData;
+	size_t                          m_uploadedLightBytes  = 0;
+	ShaderShadowMatrixData          m_uploadedShadowData;
+	size_t                          m_uploadedShadowBytes = 0;
 	
 
 //--------------------------------------------------------------------------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/VertexData/Vertex_PCU.hpp"
 #include "Engine/Renderer/VertexData/Vertex_PCUTBN.hpp"
+#include "Engine/Renderer/VertexData/Vertex_PackedPUTBN.hpp"
 #include "Engine/Renderer/ErrorShaderSource.hpp"
 
 #include <d3dcompiler.h>
@@ -158,6 +159,100 @@ ID3D11InputLayout* Shader::CreateOrGetInputLayoutFor_Vertex_PCUTBN()
 }
 
 
+//------------------------------------------------------------------------------------------------
+ID3D11InputLayout* Shader::CreateOrGetInputLayoutFor_Vertex_PackedPosition()
+{
+	if ( m_inputLayoutFor_Vertex_PackedPosition != nullptr )
+	{
+		return m_inputLayoutFor_Vertex_PackedPosition;
+	}
+
+	D3D11_INPUT_ELEMENT_DESC vertexDesc[ 1 ];
+
+	vertexDesc[ 0 ].SemanticName = "POSITION";
+	vertexDesc[ 0 ].SemanticIndex = 0;
+	vertexDesc[ 0 ].Format = DXGI_FORMAT_R16G16B16A16_UNORM;
+	vertexDesc[ 0 ].InputSlot = 0;
+	vertexDesc[ 0 ].AlignedByteOffset = offsetof( Vertex_PackedPosition, m_position );
+	vertexDesc[ 0 ].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+	vertexDesc[ 0 ].InstanceDataStepRate = 0;
+
+	ASSERT_OR_DIE( m_vertexByteCode.size() != 0, "Vertex Byte Code is Empty!" );
+
+	m_sourceRenderer->GetDevice()->CreateInputLayout(
+		vertexDesc,
+		_countof( vertexDesc ),
+		&m_vertexByteCode[ 0 ],
+		m_vertexByteCode.size(),
+		&m_inputLayoutFor_Vertex_PackedPosition
+	);
+
+	ASSERT_OR_DIE( m_inputLayoutFor_Vertex_PackedPosition != nullptr, "Failure in creating Input Layout" );
+
+	return m_inputLayoutFor_Vertex_PackedPosition;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Position comes from slot 0 ( Vertex_PackedPosition ), everything else from slot 1 ( Vertex_PackedUTBN )
+//
+ID3D11InputLayout* Shader::CreateOrGetInputLayoutFor_Vertex_PackedPUTBN()
+{
+	if ( m_inputLayoutFor_Vertex_PackedPUTBN != nullptr )
+	{
+		return m_inputLayoutFor_Vertex_PackedPUTBN;
+	}
+
+	D3D11_INPUT_ELEMENT_DESC vertexDesc[ 4 ];
+
+	vertexDesc[ 0 ].SemanticName = "POSITION";
+	vertexDesc[ 0 ].SemanticIndex = 0;
+	vertexDesc[ 0 ].Format = DXGI_FORMAT_R16G16B16A16_UNORM;
+	vertexDesc[ 0 ].InputSlot = 0;
+	vertexDesc[ 0 ].AlignedByteOffset = offsetof( Vertex_PackedPosition, m_position );
+	vertexDesc[ 0 ].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+	vertexDesc[ 0 ].InstanceDataStepRate = 0;
+
+	vertexDesc[ 1 ].SemanticName = "TEXCOORD";
+	vertexDesc[ 1 ].SemanticIndex = 0;
+	vertexDesc[ 1 ].Format = DXGI_FORMAT_R16G16_FLOAT;
+	vertexDesc[ 1 ].InputSlot = 1;
+	vertexDesc[ 1 ].AlignedByteOffset = offsetof( Vertex_PackedUTBN, m_uvTexCoords );
+	vertexDesc[ 1 ].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+	vertexDesc[ 1 ].InstanceDataStepRate = 0;
+
+	vertexDesc[ 2 ].SemanticName = "TANGENT";
+	vertexDesc[ 2 ].SemanticIndex = 0;
+	vertexDesc[ 2 ].Format = DXGI_FORMAT_R16G16_SNORM;
+	vertexDesc[ 2 ].InputSlot = 1;
+	vertexDesc[ 2 ].AlignedByteOffset = offsetof( Vertex_PackedUTBN, m_tangent );
+	vertexDesc[ 2 ].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+	vertexDesc[ 2 ].InstanceDataStepRate = 0;
+
+	vertexDesc[ 3 ].SemanticName = "NORMAL";
+	vertexDesc[ 3 ].SemanticIndex = 0;
+	vertexDesc[ 3 ].Format = DXGI_FORMAT_R16G16_SNORM;
+	vertexDesc[ 3 ].InputSlot = 1;
+	vertexDesc[ 3 ].AlignedByteOffset = offsetof( Vertex_PackedUTBN, m_normal );
+	vertexDesc[ 3 ].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+	vertexDesc[ 3 ].InstanceDataStepRate = 0;
+
+	ASSERT_OR_DIE( m_vertexByteCode.size() != 0, "Vertex Byte Code is Empty!" );
+
+	m_sourceRenderer->GetDevice()->CreateInputLayout(
+		vertexDesc,
+		_countof( vertexDesc ),
+		&m_vertexByteCode[ 0 ],
+		m_vertexByteCode.size(),
+		&m_inputLayoutFor_Vertex_PackedPUTBN
+	);
+
+	ASSERT_OR_DIE( m_inputLayoutFor_Vertex_PackedPUTBN != nullptr, "Failure in creating Input Layout" );
+
+	return m_inputLayoutFor_Vertex_PackedPUTBN;
+}
+
+
 //------------------------------------------------------------------------------------------------
 Shader::Shader()
 {
@@ -210,6 +305,8 @@ void Shader::Destroy()
 {
 	DX_SAFE_RELEASE( m_inputLayoutFor_Vertex_PCU );
 	DX_SAFE_RELEASE( m_inputLayoutFor_Vertex_PCUTBN );
+	DX_SAFE_RELEASE( m_inputLayoutFor_Vertex_PackedPosition );
+	DX_SAFE_RELEASE( m_inputLayoutFor_Vertex_PackedPUTBN );
 	DX_SAFE_RELEASE( m_vertexShader );
 	DX_SAFE_RELEASE( m_pixelShader );
 }
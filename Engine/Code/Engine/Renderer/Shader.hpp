@@ -39,6 +39,8 @@ public:
 protected:
 	ID3D11InputLayout* CreateOrGetInputLayoutFor_Vertex_PCU();
 	ID3D11InputLayout* CreateOrGetInputLayoutFor_Vertex_PCUTBN();
+	ID3D11InputLayout* CreateOrGetInputLayoutFor_Vertex_PackedPosition();
+	ID3D11InputLayout* CreateOrGetInputLayoutFor_Vertex_PackedPUTBN();
 
 private:
 	Shader();
@@ -60,8 +62,10 @@ protected:
 	ID3D11PixelShader*    m_pixelShader                  = nullptr;
 	ID3D11GeometryShader* m_geometryShader               = nullptr;
 						 
-	ID3D11InputLayout*    m_inputLayoutFor_Vertex_PCU    = nullptr;
-	ID3D11InputLayout*    m_inputLayoutFor_Vertex_PCUTBN = nullptr;
+	ID3D11InputLayout*    m_inputLayoutFor_Vertex_PCU            = nullptr;
+	ID3D11InputLayout*    m_inputLayoutFor_Vertex_PCUTBN         = nullptr;
+	ID3D11InputLayout*    m_inputLayoutFor_Vertex_PackedPosition = nullptr;
+	ID3D11InputLayout*    m_inputLayoutFor_Vertex_PackedPUTBN    = nullptr;
 						  
 	std::vector<uint8_t>  m_vertexByteCode;
 };
@@ -21,8 +21,17 @@ Texture::~Texture()
 
 
 //-----------------------------------------------------------------------------------------------
-bool Texture::LoadFromFile( Renderer* source, char const* imageFilePath )
+bool Texture::LoadFromFile( Renderer* source, char const* imageFilePath, TextureUsage usage /*= TextureUsage::COLOR*/, bool useCookedTexture /*= false */ )
 {
+	if ( useCookedTexture )
+	{
+		CookedTexture cookedTexture;
+		if ( LoadOrCookTexture( cookedTexture, imageFilePath, usage ) )
+		{
+			return CreateFromCookedTexture( source, imageFilePath, cookedTexture );
+		}
+	}
+
 	Image newImage = Image( imageFilePath );
 	bool  result   = CreateFromImage( source, imageFilePath, newImage );
 
@@ -76,6 +85,125 @@ bool Texture::CreateFromImage( Renderer* source, char const* imageFilePath, Imag
 }
 
 
+//-----------------------------------------------------------------------------------------------
+static DXGI_FORMAT GetCookedTextureDXGIFormat( CookedTextureFormat format )
+{
+	switch ( format )
+	{
+		case CookedTextureFormat::BC1:	return DXGI_FORMAT_BC1_UNORM;
+		case CookedTextureFormat::BC3:	return DXGI_FORMAT_BC3_UNORM;
+		case CookedTextureFormat::BC5:	return DXGI_FORMAT_BC5_UNORM;
+		default:						return DXGI_FORMAT_R8G8B8A8_UNORM;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Every mip is already in its GPU format, so each one is handed to CreateTexture2D as is. Mips finer
+// than firstMip are left out; streamed textures grow by being recreated with a smaller firstMip
+//
+bool Texture::CreateFromCookedTexture( Renderer* source, char const* imageFilePath, CookedTexture const& cookedTexture, int firstMip /*= 0 */ )
+{
+	int numMips = static_cast< int >( cookedTexture.m_mips.size() ) - firstMip;
+	if ( firstMip < 0 || numMips <= 0 || numMips > D3D11_REQ_MIP_LEVELS )
+		return false;
+
+	ID3D11Texture2D* textureHandle = nullptr;
+
+	D3D11_TEXTURE2D_DESC textureDesc = {};
+	textureDesc.Width              = cookedTexture.m_mips[ firstMip ].m_dimensions.x;
+	textureDesc.Height             = cookedTexture.m_mips[ firstMip ].m_dimensions.y;
+	textureDesc.MipLevels          = numMips;
+	textureDesc.ArraySize          = 1;
+	textureDesc.Usage              = m_isStreamed ? D3D11_USAGE_DEFAULT : D3D11_USAGE_IMMUTABLE;	// streamed mips are copied out when evicted
+	textureDesc.Format             = GetCookedTextureDXGIFormat( cookedTexture.m_format );
+	textureDesc.BindFlags          = D3D11_BIND_SHADER_RESOURCE;
+	textureDesc.CPUAccessFlags     = 0;
+	textureDesc.MiscFlags          = 0;
+	textureDesc.SampleDesc.Count   = 1;
+	textureDesc.SampleDesc.Quality = 0;
+
+	D3D11_SUBRESOURCE_DATA initialData[ D3D11_REQ_MIP_LEVELS ] = {};
+	for ( int mipNum = 0; mipNum < numMips; mipNum++ )
+	{
+		CookedTextureMip const& mip = cookedTexture.m_mips[ firstMip + mipNum ];
+		initialData[ mipNum ].pSysMem          = cookedTexture.m_data.data() + mip.m_byteOffset;
+		initialData[ mipNum ].SysMemPitch      = mip.m_rowPitch;
+		initialData[ mipNum ].SysMemSlicePitch = 0;
+	}
+
+	HRESULT hResult = source->GetDevice()->CreateTexture2D( &textureDesc, initialData, &textureHandle );
+
+	if ( !SUCCEEDED( hResult ) )
+		return false;
+
+
+#if defined(ENGINE_DEBUG_RENDERER)
+
+	source->SetResourceDebugName( textureHandle, imageFilePath );
+
+#endif
+
+	ReleaseResources();
+	m_handle = textureHandle;
+
+	textureHandle = nullptr;
+
+	m_imageFilePath    = imageFilePath;
+	m_dimensions       = cookedTexture.m_dimensions;
+	m_usage            = cookedTexture.m_usage;
+	m_firstResidentMip = firstMip;
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Eviction: the coarser mips are copied on the GPU into a smaller texture, so no CPU copy is needed
+//
+bool Texture::DropResidentMips( Renderer* source, int newFirstMip, IntVec2 const& newTopDimensions )
+{
+	if ( m_handle == nullptr || newFirstMip <= m_firstResidentMip )
+		return false;
+
+	D3D11_TEXTURE2D_DESC textureDesc = {};
+	m_handle->GetDesc( &textureDesc );
+
+	int numDroppedMips = newFirstMip - m_firstResidentMip;
+	if ( numDroppedMips >= static_cast< int >( textureDesc.MipLevels ) )
+		return false;
+
+	textureDesc.Width     = newTopDimensions.x;
+	textureDesc.Height    = newTopDimensions.y;
+	textureDesc.MipLevels = textureDesc.MipLevels - numDroppedMips;
+
+	ID3D11Texture2D* textureHandle = nullptr;
+	HRESULT hResult = source->GetDevice()->CreateTexture2D( &textureDesc, nullptr, &textureHandle );
+
+	if ( !SUCCEEDED( hResult ) )
+		return false;
+
+	for ( UINT mipNum = 0; mipNum < textureDesc.MipLevels; mipNum++ )
+	{
+		source->GetDeviceContext()->CopySubresourceRegion( textureHandle, mipNum, 0, 0, 0, m_handle, mipNum + numDroppedMips, nullptr );
+	}
+
+
+#if defined(ENGINE_DEBUG_RENDERER)
+
+	source->SetResourceDebugName( textureHandle, m_imageFilePath.c_str() );
+
+#endif
+
+	ReleaseResources();
+	m_handle = textureHandle;
+
+	m_firstResidentMip = newFirstMip;
+
+	return true;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 ID3D11RenderTargetView* Texture::GetOrCreateRenderTargetView( Renderer* renderer )
 {
@@ -211,10 +339,10 @@ bool Texture::CreateCubemapfromFile( Renderer* source, std::vector<std::string>&
 
 	D3D11_SUBRESOURCE_DATA initialData[6] = {};
 	
-	Image newImage[6];
+	std::vector<Image> newImage;
+	LoadImagesInParallel( imagePaths, newImage );
 	for ( int imageNum = 0; imageNum < 6; imageNum++ )
 	{
-		newImage[imageNum] = Image( imagePaths[imageNum].c_str() );
 		initialData[imageNum].pSysMem          = newImage[imageNum].GetRawData();
 		initialData[imageNum].SysMemPitch      = newImage[imageNum].GetBytePerPixel() * newImage[imageNum].GetPitch();
 		initialData[imageNum].SysMemSlicePitch = 0;
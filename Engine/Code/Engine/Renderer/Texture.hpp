@@ -2,6 +2,7 @@
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Renderer/LightStructure.hpp"
+#include "Engine/Renderer/TextureCooker.hpp"
 #include <string>
 #include <vector>
 
@@ -23,6 +24,8 @@ struct ID3D11DepthStencilView;
 class Texture{
 
 	friend class Renderer;
+	friend class TextureStreamer;
+	friend struct TextLayoutTestAccess;		// EngineTests builds fonts without a device
 
 private:
 	                          Texture(); 
@@ -33,8 +36,10 @@ private:
 //			Base Texture Functions
 //--------------------------------------------------------------------------------------------------------------------------------------------
 
-	bool                      LoadFromFile( Renderer* source, char const* imageFilePath );						 
+	bool                      LoadFromFile( Renderer* source, char const* imageFilePath, TextureUsage usage = TextureUsage::COLOR, bool useCookedTexture = false );
 	bool                      CreateFromImage( Renderer* source, char const* imageFilePath, Image const& image ); 
+	bool                      CreateFromCookedTexture( Renderer* source, char const* imageFilePath, CookedTexture const& cookedTexture, int firstMip = 0 );
+	bool                      DropResidentMips( Renderer* source, int newFirstMip, IntVec2 const& newTopDimensions );
 
 //--------------------------------------------------------------------------------------------------------------------------------------------
 //			Render Target Functions
@@ -84,12 +89,19 @@ public:
 						      
 	float				      GetAspect() const { return (float)m_dimensions.x / (float)m_dimensions.y; }
 	bool                      IsValid() const;
+	bool                      IsStreamed() const { return m_isStreamed; }
+	TextureUsage              GetUsage() const { return m_usage; }
 
 public:
 	std::string                 m_imageFilePath;
 	IntVec2                     m_dimensions          = IntVec2(0,0);
 
 	uint                        m_texArraySize        = 0;
+
+	TextureUsage                m_usage               = TextureUsage::COLOR;
+	bool                        m_isStreamed          = false;		// owned by the TextureStreamer; may have no handle or only its coarser mips
+	int                         m_firstResidentMip    = 0;
+	mutable uint64_t            m_lastUsedFrame       = 0;		// bookkeeping only; binding a const texture still marks it used
 	
 	ID3D11Texture2D*            m_handle              = nullptr;
 							    				      
@@ -0,0 +1,1157 @@
+#include "Engine/Renderer/TextureCooker.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+
+#if !defined( ENGINE_DISABLE_SIMD ) && ( defined( _M_X64 ) || defined( _M_AMD64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 ) || defined( __SSE__ ) )
+#define TEXTURE_COOKER_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+
+//------------------------------------------------------------------------------------------------
+constexpr uint32_t COOKED_TEXTURE_FOURCC   = 0x58455443;	// "CTEX"
+constexpr uint32_t COOKED_TEXTURE_VERSION  = 1;
+constexpr uint32_t MAX_COOKED_TEXTURE_MIPS = 32;
+constexpr int      COOKER_ROWS_PER_BATCH   = 16;
+
+
+//------------------------------------------------------------------------------------------------
+struct CookedTextureFileHeader
+{
+	uint32_t m_fourCC       = COOKED_TEXTURE_FOURCC;
+	uint32_t m_version      = COOKED_TEXTURE_VERSION;
+	uint32_t m_format       = 0;
+	uint32_t m_usage        = 0;
+	uint32_t m_width        = 0;
+	uint32_t m_height       = 0;
+	uint32_t m_numMips      = 0;
+	uint32_t m_dataByteSize = 0;
+};
+
+
+//------------------------------------------------------------------------------------------------
+struct CookedTextureFileMip
+{
+	uint32_t m_width      = 0;
+	uint32_t m_height     = 0;
+	uint32_t m_rowPitch   = 0;
+	uint32_t m_byteOffset = 0;
+	uint32_t m_byteSize   = 0;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Mips are filtered in linear space at full float precision and only quantized on the way out
+//
+struct alignas( 16 ) LinearTexel
+{
+	float m_values[ 4 ];
+};
+
+
+//------------------------------------------------------------------------------------------------
+static thread_local bool s_cookOnJobSystem = true;
+
+
+//------------------------------------------------------------------------------------------------
+void SetCookOnJobSystem( bool useJobSystem )
+{
+	s_cookOnJobSystem = useJobSystem;
+}
+
+
+//------------------------------------------------------------------------------------------------
+template <typename FUNC>
+static void ForEachRowRange( int numRows, FUNC const& function )
+{
+	if ( g_theJobSystem != nullptr && s_cookOnJobSystem )
+	{
+		g_theJobSystem->ParallelForRange( numRows, COOKER_ROWS_PER_BATCH, function );
+	}
+	else
+	{
+		function( 0, numRows );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+static float SRGBToLinear( float srgb )
+{
+	return srgb <= 0.04045f ? srgb / 12.92f : powf( ( srgb + 0.055f ) / 1.055f, 2.4f );
+}
+
+
+//------------------------------------------------------------------------------------------------
+static float LinearToSRGB( float linear )
+{
+	return linear <= 0.0031308f ? linear * 12.92f : 1.055f * powf( linear, 1.0f / 2.4f ) - 0.055f;
+}
+
+
+//------------------------------------------------------------------------------------------------
+static unsigned char QuantizeUnitFloat( float value )
+{
+	value = value < 0.0f ? 0.0f : ( value > 1.0f ? 1.0f : value );
+	return static_cast< unsigned char >( value * 255.0f + 0.5f );
+}
+
+
+//------------------------------------------------------------------------------------------------
+static float const* GetSRGBToLinearTable()
+{
+	struct Table
+	{
+		Table()
+		{
+			for ( int value = 0; value < 256; value++ )
+			{
+				m_values[ value ] = SRGBToLinear( static_cast< float >( value ) / 255.0f );
+			}
+		}
+
+		float m_values[ 256 ];
+	};
+
+	static Table const s_table;
+	return s_table.m_values;
+}
+
+
+//------------------------------------------------------------------------------------------------
+static void ImageToLinear( Image const& image, TextureUsage usage, std::vector<LinearTexel>& out_texels )
+{
+	int          width        = image.GetWidth();
+	Rgba8 const* sourceTexels = image.GetRawData();
+	float const* srgbToLinear = GetSRGBToLinearTable();
+
+	out_texels.resize( static_cast< size_t >( width ) * image.GetHeight() );
+
+	ForEachRowRange( image.GetHeight(), [ & ]( int beginRow, int endRow )
+	{
+		for ( int texelNum = beginRow * width; texelNum < endRow * width; texelNum++ )
+		{
+			Rgba8 const& color  = sourceTexels[ texelNum ];
+			float*       values = out_texels[ texelNum ].m_values;
+
+			if ( usage == TextureUsage::NORMAL_MAP )
+			{
+				values[ 0 ] = static_cast< float >( color.r ) / 127.5f - 1.0f;
+				values[ 1 ] = static_cast< float >( color.g ) / 127.5f - 1.0f;
+				values[ 2 ] = static_cast< float >( color.b ) / 127.5f - 1.0f;
+			}
+			else
+			{
+				values[ 0 ] = srgbToLinear[ color.r ];
+				values[ 1 ] = srgbToLinear[ color.g ];
+				values[ 2 ] = srgbToLinear[ color.b ];
+			}
+			values[ 3 ] = static_cast< float >( color.a ) / 255.0f;
+		}
+	} );
+}
+
+
+//------------------------------------------------------------------------------------------------
+static void LinearToImage( std::vector<LinearTexel> const& texels, IntVec2 const& dimensions, TextureUsage usage, Image& out_image )
+{
+	out_image = Image();
+	out_image.SetupAsSolidColor( dimensions.x, dimensions.y, Rgba8::WHITE );
+	Rgba8* destTexels = out_image.GetRawData();
+
+	ForEachRowRange( dimensions.y, [ & ]( int beginRow, int endRow )
+	{
+		for ( int texelNum = beginRow * dimensions.x; texelNum < endRow * dimensions.x; texelNum++ )
+		{
+			float const* values = texels[ texelNum ].m_values;
+			Rgba8&       color  = destTexels[ texelNum ];
+
+			if ( usage == TextureUsage::NORMAL_MAP )
+			{
+				color.r = QuantizeUnitFloat( values[ 0 ] * 0.5f + 0.5f );
+				color.g = QuantizeUnitFloat( values[ 1 ] * 0.5f + 0.5f );
+				color.b = QuantizeUnitFloat( values[ 2 ] * 0.5f + 0.5f );
+			}
+			else
+			{
+				color.r = QuantizeUnitFloat( LinearToSRGB( values[ 0 ] ) );
+				color.g = QuantizeUnitFloat( LinearToSRGB( values[ 1 ] ) );
+				color.b = QuantizeUnitFloat( LinearToSRGB( values[ 2 ] ) );
+			}
+			color.a = QuantizeUnitFloat( values[ 3 ] );
+		}
+	} );
+}
+
+
+//------------------------------------------------------------------------------------------------
+struct DownsampleTaps
+{
+	int   m_index[ 3 ]  = {};
+	float m_weight[ 3 ] = {};
+	int   m_numTaps     = 0;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Source texels covered by one destination texel along one axis. An odd size has no texel pairs to
+// average, so each destination texel spans 2 + 1/destSize source texels and takes three taps weighted
+// by how much of each it covers; every source texel then contributes equally to the level below
+//
+static DownsampleTaps GetDownsampleTaps( int destIndex, int sourceSize, int destSize )
+{
+	DownsampleTaps taps;
+	if ( sourceSize == 1 )
+	{
+		taps.m_index[ 0 ]  = 0;
+		taps.m_weight[ 0 ] = 1.0f;
+		taps.m_numTaps     = 1;
+	}
+	else if ( ( sourceSize & 1 ) == 0 )
+	{
+		taps.m_index[ 0 ]  = destIndex * 2;
+		taps.m_index[ 1 ]  = destIndex * 2 + 1;
+		taps.m_weight[ 0 ] = 0.5f;
+		taps.m_weight[ 1 ] = 0.5f;
+		taps.m_numTaps     = 2;
+	}
+	else
+	{
+		float invSourceSize = 1.0f / static_cast< float >( sourceSize );
+		taps.m_index[ 0 ]  = destIndex * 2;
+		taps.m_index[ 1 ]  = destIndex * 2 + 1;
+		taps.m_index[ 2 ]  = destIndex * 2 + 2;
+		taps.m_weight[ 0 ] = static_cast< float >( destSize - destIndex ) * invSourceSize;
+		taps.m_weight[ 1 ] = static_cast< float >( destSize ) * invSourceSize;
+		taps.m_weight[ 2 ] = static_cast< float >( destIndex + 1 ) * invSourceSize;
+		taps.m_numTaps     = 3;
+	}
+	return taps;
+}
+
+
+//------------------------------------------------------------------------------------------------
+static void RenormalizeLinearNormal( float* values )
+{
+	float length = sqrtf( values[ 0 ] * values[ 0 ] + values[ 1 ] * values[ 1 ] + values[ 2 ] * values[ 2 ] );
+	if ( length > 0.0f )
+	{
+		values[ 0 ] /= length;
+		values[ 1 ] /= length;
+		values[ 2 ] /= length;
+	}
+	else
+	{
+		values[ 0 ] = 0.0f;
+		values[ 1 ] = 0.0f;
+		values[ 2 ] = 1.0f;
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// 2x2 box filter when both axes are even ( or already 1 ); an odd axis switches to the three tap
+// filter from GetDownsampleTaps so its last row or column is not dropped
+//
+static void DownsampleLinear( std::vector<LinearTexel> const& source, IntVec2 const& sourceDimensions, TextureUsage usage, std::vector<LinearTexel>& out_dest, IntVec2 const& destDimensions )
+{
+	out_dest.resize( static_cast< size_t >( destDimensions.x ) * destDimensions.y );
+
+	bool isOddX = sourceDimensions.x > 1 && ( sourceDimensions.x & 1 ) != 0;
+	bool isOddY = sourceDimensions.y > 1 && ( sourceDimensions.y & 1 ) != 0;
+	bool useBoxFilter = !isOddX && !isOddY;
+
+	ForEachRowRange( destDimensions.y, [ & ]( int beginRow, int endRow )
+	{
+		for ( int destY = beginRow; destY < endRow; destY++ )
+		{
+			LinearTexel* destRow = out_dest.data() + static_cast< size_t >( destY ) * destDimensions.x;
+
+			if ( !useBoxFilter )
+			{
+				DownsampleTaps rowTaps = GetDownsampleTaps( destY, sourceDimensions.y, destDimensions.y );
+				for ( int destX = 0; destX < destDimensions.x; destX++ )
+				{
+					DownsampleTaps columnTaps = GetDownsampleTaps( destX, sourceDimensions.x, destDimensions.x );
+					float* values = destRow[ destX ].m_values;
+					values[ 0 ] = values[ 1 ] = values[ 2 ] = values[ 3 ] = 0.0f;
+
+					for ( int rowTap = 0; rowTap < rowTaps.m_numTaps; rowTap++ )
+					{
+						LinearTexel const* sourceRow = source.data() + static_cast< size_t >( rowTaps.m_index[ rowTap ] ) * sourceDimensions.x;
+						for ( int columnTap = 0; columnTap < columnTaps.m_numTaps; columnTap++ )
+						{
+							float        weight       = rowTaps.m_weight[ rowTap ] * columnTaps.m_weight[ columnTap ];
+							float const* sourceValues = sourceRow[ columnTaps.m_index[ columnTap ] ].m_values;
+							for ( int channel = 0; channel < 4; channel++ )
+							{
+								values[ channel ] += weight * sourceValues[ channel ];
+							}
+						}
+					}
+
+					if ( usage == TextureUsage::NORMAL_MAP )
+					{
+						RenormalizeLinearNormal( values );
+					}
+				}
+			}
+			else
+			{
+				int sourceY0 = std::min( destY * 2, sourceDimensions.y - 1 );
+				int sourceY1 = std::min( destY * 2 + 1, sourceDimensions.y - 1 );
+				LinearTexel const* row0 = source.data() + static_cast< size_t >( sourceY0 ) * sourceDimensions.x;
+				LinearTexel const* row1 = source.data() + static_cast< size_t >( sourceY1 ) * sourceDimensions.x;
+
+				for ( int destX = 0; destX < destDimensions.x; destX++ )
+				{
+					int sourceX0 = std::min( destX * 2, sourceDimensions.x - 1 );
+					int sourceX1 = std::min( destX * 2 + 1, sourceDimensions.x - 1 );
+
+#if defined( TEXTURE_COOKER_USE_SSE )
+					__m128 sum = _mm_add_ps( _mm_add_ps( _mm_load_ps( row0[ sourceX0 ].m_values ), _mm_load_ps( row0[ sourceX1 ].m_values ) ),
+											 _mm_add_ps( _mm_load_ps( row1[ sourceX0 ].m_values ), _mm_load_ps( row1[ sourceX1 ].m_values ) ) );
+					_mm_store_ps( destRow[ destX ].m_values, _mm_mul_ps( sum, _mm_set1_ps( 0.25f ) ) );
+#else
+					for ( int channel = 0; channel < 4; channel++ )
+					{
+						destRow[ destX ].m_values[ channel ] = 0.25f * ( row0[ sourceX0 ].m_values[ channel ] + row0[ sourceX1 ].m_values[ channel ] +
+																		 row1[ sourceX0 ].m_values[ channel ] + row1[ sourceX1 ].m_values[ channel ] );
+					}
+#endif
+
+					if ( usage == TextureUsage::NORMAL_MAP )
+					{
+						RenormalizeLinearNormal( destRow[ destX ].m_values );
+					}
+				}
+			}
+		}
+	} );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void GenerateMipChain( Image const& source, TextureUsage usage, std::vector<Image>& out_mipChain )
+{
+	out_mipChain.clear();
+	out_mipChain.push_back( source );
+
+	if ( usage == TextureUsage::UI )
+		return;
+
+	std::vector<LinearTexel> level;
+	std::vector<LinearTexel> nextLevel;
+	ImageToLinear( source, usage, level );
+
+	IntVec2 dimensions = source.GetDimensions();
+	while ( dimensions.x > 1 || dimensions.y > 1 )
+	{
+		IntVec2 nextDimensions( std::max( dimensions.x / 2, 1 ), std::max( dimensions.y / 2, 1 ) );
+		DownsampleLinear( level, dimensions, usage, nextLevel, nextDimensions );
+
+		out_mipChain.emplace_back();
+		LinearToImage( nextLevel, nextDimensions, usage, out_mipChain.back() );
+
+		level.swap( nextLevel );
+		dimensions = nextDimensions;
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Block compression. Texel i of a 4x4 block is row i / 4, column i % 4, rows in memory order
+//
+static void WriteUInt16( uint8_t* out_bytes, uint16_t value )
+{
+	out_bytes[ 0 ] = static_cast< uint8_t >( value & 0xFF );
+	out_bytes[ 1 ] = static_cast< uint8_t >( value >> 8 );
+}
+
+
+//------------------------------------------------------------------------------------------------
+static uint16_t ReadUInt16( uint8_t const* bytes )
+{
+	return static_cast< uint16_t >( bytes[ 0 ] | ( bytes[ 1 ] << 8 ) );
+}
+
+
+//------------------------------------------------------------------------------------------------
+static uint16_t PackColor565( float r, float g, float b )
+{
+	int r5 = static_cast< int >( std::clamp( r, 0.0f, 255.0f ) * 31.0f / 255.0f + 0.5f );
+	int g6 = static_cast< int >( std::clamp( g, 0.0f, 255.0f ) * 63.0f / 255.0f + 0.5f );
+	int b5 = static_cast< int >( std::clamp( b, 0.0f, 255.0f ) * 31.0f / 255.0f + 0.5f );
+	return static_cast< uint16_t >( ( r5 << 11 ) | ( g6 << 5 ) | b5 );
+}
+
+
+//------------------------------------------------------------------------------------------------
+static void UnpackColor565( uint16_t packed, int* out_rgb )
+{
+	int r5 = ( packed >> 11 ) & 0x1F;
+	int g6 = ( packed >> 5 ) & 0x3F;
+	int b5 = packed & 0x1F;
+	out_rgb[ 0 ] = ( r5 << 3 ) | ( r5 >> 2 );
+	out_rgb[ 1 ] = ( g6 << 2 ) | ( g6 >> 4 );
+	out_rgb[ 2 ] = ( b5 << 3 ) | ( b5 >> 2 );
+}
+
+
+//------------------------------------------------------------------------------------------------
+static void GetBC1Palette( uint16_t color0, uint16_t color1, int out_palette[ 4 ][ 3 ] )
+{
+	UnpackColor565( color0, out_palette[ 0 ] );
+	UnpackColor565( color1, out_palette[ 1 ] );
+
+	for ( int channel = 0; channel < 3; channel++ )
+	{
+		if ( color0 > color1 )
+		{
+			out_palette[ 2 ][ channel ] = ( 2 * out_palette[ 0 ][ channel ] + out_palette[ 1 ][ channel ] ) / 3;
+			out_palette[ 3 ][ channel ] = ( out_palette[ 0 ][ channel ] + 2 * out_palette[ 1 ][ channel ] ) / 3;
+		}
+		else
+		{
+			out_palette[ 2 ][ channel ] = ( out_palette[ 0 ][ channel ] + out_palette[ 1 ][ channel ] ) / 2;
+			out_palette[ 3 ][ channel ] = 0;
+		}
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Picks the nearest palette entry per texel; returns the summed squared error
+//
+static int ChooseBC1Indices( Rgba8 const block[ 16 ], uint16_t color0, uint16_t color1, uint32_t& out_indices )
+{
+	int palette[ 4 ][ 3 ];
+	GetBC1Palette( color0, color1, palette );
+
+	int totalError = 0;
+	out_indices = 0;
+	for ( int texelNum = 0; texelNum < 16; texelNum++ )
+	{
+		int bestIndex = 0;
+		int bestError = INT_MAX;
+		for ( int paletteNum = 0; paletteNum < 4; paletteNum++ )
+		{
+			int dr = block[ texelNum ].r - palette[ paletteNum ][ 0 ];
+			int dg = block[ texelNum ].g - palette[ paletteNum ][ 1 ];
+			int db = block[ texelNum ].b - palette[ paletteNum ][ 2 ];
+			int error = dr * dr + dg * dg + db * db;
+			if ( error < bestError )
+			{
+				bestError = error;
+				bestIndex = paletteNum;
+			}
+		}
+
+		totalError  += bestError;
+		out_indices |= static_cast< uint32_t >( bestIndex ) << ( texelNum * 2 );
+	}
+
+	return totalError;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Least squares fit of both endpoints to the current index assignment
+//
+static bool RefineBC1Endpoints( Rgba8 const block[ 16 ], uint32_t indices, uint16_t& out_color0, uint16_t& out_color1 )
+{
+	static float const WEIGHTS_0[ 4 ] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+	float aa = 0.0f;
+	float ab = 0.0f;
+	float bb = 0.0f;
+	float ax[ 3 ] = {};
+	float bx[ 3 ] = {};
+
+	for ( int texelNum = 0; texelNum < 16; texelNum++ )
+	{
+		int   index = ( indices >> ( texelNum * 2 ) ) & 3;
+		float a     = WEIGHTS_0[ index ];
+		float b     = 1.0f - a;
+		float texel[ 3 ] = { static_cast< float >( block[ texelNum ].r ), static_cast< float >( block[ texelNum ].g ), static_cast< float >( block[ texelNum ].b ) };
+
+		aa += a * a;
+		ab += a * b;
+		bb += b * b;
+		for ( int channel = 0; channel < 3; channel++ )
+		{
+			ax[ channel ] += a * texel[ channel ];
+			bx[ channel ] += b * texel[ channel ];
+		}
+	}
+
+	float determinant = aa * bb - ab * ab;
+	if ( fabsf( determinant ) < 1e-6f )
+		return false;
+
+	float endpoint0[ 3 ];
+	float endpoint1[ 3 ];
+	for ( int channel = 0; channel < 3; channel++ )
+	{
+		endpoint0[ channel ] = ( bb * ax[ channel ] - ab * bx[ channel ] ) / determinant;
+		endpoint1[ channel ] = ( aa * bx[ channel ] - ab * ax[ channel ] ) / determinant;
+	}
+
+	out_color0 = PackColor565( endpoint0[ 0 ], endpoint0[ 1 ], endpoint0[ 2 ] );
+	out_color1 = PackColor565( endpoint1[ 0 ], endpoint1[ 1 ], endpoint1[ 2 ] );
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Endpoints start at the texels furthest apart along the block's principal axis, then get one least
+// squares refinement. Always four color mode, so the block is also valid as BC3's color half
+//
+static void EncodeBC1Block( Rgba8 const block[ 16 ], uint8_t* out_block )
+{
+	float mean[ 3 ] = {};
+	for ( int texelNum = 0; texelNum < 16; texelNum++ )
+	{
+		mean[ 0 ] += block[ texelNum ].r;
+		mean[ 1 ] += block[ texelNum ].g;
+		mean[ 2 ] += block[ texelNum ].b;
+	}
+	mean[ 0 ] /= 16.0f;
+	mean[ 1 ] /= 16.0f;
+	mean[ 2 ] /= 16.0f;
+
+	float covariance[ 6 ] = {};		// rr rg rb gg gb bb
+	for ( int texelNum = 0; texelNum < 16; texelNum++ )
+	{
+		float r = block[ texelNum ].r - mean[ 0 ];
+		float g = block[ texelNum ].g - mean[ 1 ];
+		float b = block[ texelNum ].b - mean[ 2 ];
+		covariance[ 0 ] += r * r;
+		covariance[ 1 ] += r * g;
+		covariance[ 2 ] += r * b;
+		covariance[ 3 ] += g * g;
+		covariance[ 4 ] += g * b;
+		covariance[ 5 ] += b * b;
+	}
+
+	float axis[ 3 ] = { 1.0f, 1.0f, 1.0f };
+	for ( int iteration = 0; iteration < 8; iteration++ )
+	{
+		float x = axis[ 0 ] * covariance[ 0 ] + axis[ 1 ] * covariance[ 1 ] + axis[ 2 ] * covariance[ 2 ];
+		float y = axis[ 0 ] * covariance[ 1 ] + axis[ 1 ] * covariance[ 3 ] + axis[ 2 ] * covariance[ 4 ];
+		float z = axis[ 0 ] * covariance[ 2 ] + axis[ 1 ] * covariance[ 4 ] + axis[ 2 ] * covariance[ 5 ];
+		float largest = std::max( fabsf( x ), std::max( fabsf( y ), fabsf( z ) ) );
+		if ( largest <= 0.0f )
+			break;
+
+		axis[ 0 ] = x / largest;
+		axis[ 1 ] = y / largest;
+		axis[ 2 ] = z / largest;
+	}
+
+	int   minTexel      = 0;
+	int   maxTexel      = 0;
+	float minProjection = FLT_MAX;
+	float maxProjection = -FLT_MAX;
+	for ( int texelNum = 0; texelNum < 16; texelNum++ )
+	{
+		float projection = block[ texelNum ].r * axis[ 0 ] + block[ texelNum ].g * axis[ 1 ] + block[ texelNum ].b * axis[ 2 ];
+		if ( projection < minProjection )
+		{
+			minProjection = projection;
+			minTexel      = texelNum;
+		}
+		if ( projection > maxProjection )
+		{
+			maxProjection = projection;
+			maxTexel      = texelNum;
+		}
+	}
+
+	uint16_t color0 = PackColor565( block[ maxTexel ].r, block[ maxTexel ].g, block[ maxTexel ].b );
+	uint16_t color1 = PackColor565( block[ minTexel ].r, block[ minTexel ].g, block[ minTexel ].b );
+	if ( color0 < color1 )
+	{
+		std::swap( color0, color1 );
+	}
+
+	uint32_t indices = 0;
+	if ( color0 == color1 )
+	{
+		WriteUInt16( out_block, color0 );
+		WriteUInt16( out_block + 2, color1 );
+		memset( out_block + 4, 0, 4 );
+		return;
+	}
+
+	int error = ChooseBC1Indices( block, color0, color1, indices );
+
+	uint16_t refined0 = 0;
+	uint16_t refined1 = 0;
+	if ( RefineBC1Endpoints( block, indices, refined0, refined1 ) )
+	{
+		if ( refined0 < refined1 )
+		{
+			std::swap( refined0, refined1 );
+		}
+
+		if ( refined0 != refined1 )
+		{
+			uint32_t refinedIndices = 0;
+			int refinedError = ChooseBC1Indices( block, refined0, refined1, refinedIndices );
+			if ( refinedError < error )
+			{
+				color0  = refined0;
+				color1  = refined1;
+				indices = refinedIndices;
+			}
+		}
+	}
+
+	WriteUInt16( out_block, color0 );
+	WriteUInt16( out_block + 2, color1 );
+	out_block[ 4 ] = static_cast< uint8_t >( indices );
+	out_block[ 5 ] = static_cast< uint8_t >( indices >> 8 );
+	out_block[ 6 ] = static_cast< uint8_t >( indices >> 16 );
+	out_block[ 7 ] = static_cast< uint8_t >( indices >> 24 );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// One channel, eight value mode: the endpoints are the block's extremes and the six values between
+// are evenly spaced, so the nearest entry is just the rounded position along the range
+//
+static void EncodeBC4Block( uint8_t const values[ 16 ], uint8_t* out_block )
+{
+	uint8_t minValue = 255;
+	uint8_t maxValue = 0;
+	for ( int texelNum = 0; texelNum < 16; texelNum++ )
+	{
+		minValue = std::min( minValue, values[ texelNum ] );
+		maxValue = std::max( maxValue, values[ texelNum ] );
+	}
+
+	out_block[ 0 ] = maxValue;
+	out_block[ 1 ] = minValue;
+
+	uint64_t indices = 0;
+	if ( maxValue != minValue )
+	{
+		float range = static_cast< float >( maxValue - minValue );
+		for ( int texelNum = 0; texelNum < 16; texelNum++ )
+		{
+			int position = static_cast< int >( static_cast< float >( maxValue - values[ texelNum ] ) * 7.0f / range + 0.5f );
+			int index    = position == 0 ? 0 : ( position == 7 ? 1 : position + 1 );
+			indices |= static_cast< uint64_t >( index ) << ( texelNum * 3 );
+		}
+	}
+
+	for ( int byteNum = 0; byteNum < 6; byteNum++ )
+	{
+		out_block[ 2 + byteNum ] = static_cast< uint8_t >( indices >> ( byteNum * 8 ) );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+static void DecodeBC1Block( uint8_t const* block, Rgba8 out_texels[ 16 ] )
+{
+	int palette[ 4 ][ 3 ];
+	uint16_t color0 = ReadUInt16( block );
+	uint16_t color1 = ReadUInt16( block + 2 );
+	GetBC1Palette( color0, color1, palette );
+
+	uint32_t indices = block[ 4 ] | ( block[ 5 ] << 8 ) | ( block[ 6 ] << 16 ) | ( static_cast< uint32_t >( block[ 7 ] ) << 24 );
+	for ( int texelNum = 0; texelNum < 16; texelNum++ )
+	{
+		int index = ( indices >> ( texelNum * 2 ) ) & 3;
+		out_texels[ texelNum ] = Rgba8( static_cast< unsigned char >( palette[ index ][ 0 ] ), static_cast< unsigned char >( palette[ index ][ 1 ] ), static_cast< unsigned char >( palette[ index ][ 2 ] ),
+										color0 <= color1 && index == 3 ? 0 : 255 );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+static void DecodeBC4Block( uint8_t const* block, uint8_t out_values[ 16 ] )
+{
+	int value0 = block[ 0 ];
+	int value1 = block[ 1 ];
+
+	int palette[ 8 ] = { value0, value1 };
+	if ( value0 > value1 )
+	{
+		for ( int step = 1; step < 7; step++ )
+		{
+			palette[ step + 1 ] = ( ( 7 - step ) * value0 + step * value1 ) / 7;
+		}
+	}
+	else
+	{
+		for ( int step = 1; step < 5; step++ )
+		{
+			palette[ step + 1 ] = ( ( 5 - step ) * value0 + step * value1 ) / 5;
+		}
+		palette[ 6 ] = 0;
+		palette[ 7 ] = 255;
+	}
+
+	uint64_t indices = 0;
+	for ( int byteNum = 0; byteNum < 6; byteNum++ )
+	{
+		indices |= static_cast< uint64_t >( block[ 2 + byteNum ] ) << ( byteNum * 8 );
+	}
+
+	for ( int texelNum = 0; texelNum < 16; texelNum++ )
+	{
+		out_values[ texelNum ] = static_cast< uint8_t >( palette[ ( indices >> ( texelNum * 3 ) ) & 7 ] );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+static int GetBlockByteSize( CookedTextureFormat format )
+{
+	return format == CookedTextureFormat::BC1 ? 8 : 16;
+}
+
+
+//------------------------------------------------------------------------------------------------
+static bool IsBlockCompressed( CookedTextureFormat format )
+{
+	return format != CookedTextureFormat::RGBA8;
+}
+
+
+//------------------------------------------------------------------------------------------------
+static bool IsValidCookedFormat( uint32_t format )
+{
+	return format <= static_cast< uint32_t >( CookedTextureFormat::BC5 );
+}
+
+
+//------------------------------------------------------------------------------------------------
+static bool IsValidTextureUsage( uint32_t usage )
+{
+	return usage <= static_cast< uint32_t >( TextureUsage::UI );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Row pitch and byte size a mip of these dimensions takes in this format
+//
+static void GetMipLayout( CookedTextureFormat format, IntVec2 const& dimensions, int& out_rowPitch, size_t& out_byteSize )
+{
+	if ( IsBlockCompressed( format ) )
+	{
+		out_rowPitch = ( ( dimensions.x + 3 ) / 4 ) * GetBlockByteSize( format );
+		out_byteSize = static_cast< size_t >( out_rowPitch ) * ( ( dimensions.y + 3 ) / 4 );
+	}
+	else
+	{
+		out_rowPitch = dimensions.x * static_cast< int >( sizeof( Rgba8 ) );
+		out_byteSize = static_cast< size_t >( out_rowPitch ) * dimensions.y;
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// D3D11 needs block compressed textures to start at a multiple of 4; smaller mips may be partial blocks
+//
+static CookedTextureFormat ChooseCookedFormat( Image const& source, TextureUsage usage )
+{
+	if ( usage == TextureUsage::UI || source.GetWidth() % 4 != 0 || source.GetHeight() % 4 != 0 )
+		return CookedTextureFormat::RGBA8;
+
+	if ( usage == TextureUsage::NORMAL_MAP )
+		return CookedTextureFormat::BC5;
+
+	Rgba8 const* texels    = source.GetRawData();
+	int          numTexels = source.GetWidth() * source.GetHeight();
+	for ( int texelNum = 0; texelNum < numTexels; texelNum++ )
+	{
+		if ( texels[ texelNum ].a != 255 )
+			return CookedTextureFormat::BC3;
+	}
+
+	return CookedTextureFormat::BC1;
+}
+
+
+//------------------------------------------------------------------------------------------------
+static void EncodeMip( Image const& mip, CookedTextureFormat format, uint8_t* out_data, int rowPitch )
+{
+	int width  = mip.GetWidth();
+	int height = mip.GetHeight();
+	Rgba8 const* texels = mip.GetRawData();
+
+	if ( !IsBlockCompressed( format ) )
+	{
+		memcpy( out_data, texels, static_cast< size_t >( width ) * height * sizeof( Rgba8 ) );
+		return;
+	}
+
+	int numBlocksWide = ( width + 3 ) / 4;
+	int numBlocksHigh = ( height + 3 ) / 4;
+	int blockByteSize = GetBlockByteSize( format );
+
+	ForEachRowRange( numBlocksHigh, [ & ]( int beginBlockRow, int endBlockRow )
+	{
+		for ( int blockY = beginBlockRow; blockY < endBlockRow; blockY++ )
+		{
+			for ( int blockX = 0; blockX < numBlocksWide; blockX++ )
+			{
+				// Partial blocks repeat their last row and column
+				Rgba8 block[ 16 ];
+				for ( int texelNum = 0; texelNum < 16; texelNum++ )
+				{
+					int x = std::min( blockX * 4 + texelNum % 4, width - 1 );
+					int y = std::min( blockY * 4 + texelNum / 4, height - 1 );
+					block[ texelNum ] = texels[ y * width + x ];
+				}
+
+				uint8_t* outBlock = out_data + static_cast< size_t >( blockY ) * rowPitch + static_cast< size_t >( blockX ) * blockByteSize;
+				uint8_t  channel[ 16 ];
+
+				if ( format == CookedTextureFormat::BC1 )
+				{
+					EncodeBC1Block( block, outBlock );
+				}
+				else if ( format == CookedTextureFormat::BC3 )
+				{
+					for ( int texelNum = 0; texelNum < 16; texelNum++ )
+					{
+						channel[ texelNum ] = block[ texelNum ].a;
+					}
+					EncodeBC4Block( channel, outBlock );
+					EncodeBC1Block( block, outBlock + 8 );
+				}
+				else
+				{
+					for ( int texelNum = 0; texelNum < 16; texelNum++ )
+					{
+						channel[ texelNum ] = block[ texelNum ].r;
+					}
+					EncodeBC4Block( channel, outBlock );
+
+					for ( int texelNum = 0; texelNum < 16; texelNum++ )
+					{
+						channel[ texelNum ] = block[ texelNum ].g;
+					}
+					EncodeBC4Block( channel, outBlock + 8 );
+				}
+			}
+		}
+	} );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void CookTexture( Image const& source, TextureUsage usage, CookedTexture& out_cookedTexture, bool allowCompression /*= true */ )
+{
+	std::vector<Image> mipChain;
+	GenerateMipChain( source, usage, mipChain );
+
+	out_cookedTexture.m_format     = allowCompression ? ChooseCookedFormat( source, usage ) : CookedTextureFormat::RGBA8;
+	out_cookedTexture.m_usage      = usage;
+	out_cookedTexture.m_dimensions = source.GetDimensions();
+	out_cookedTexture.m_mips.clear();
+
+	size_t totalByteSize = 0;
+	for ( Image const& mip : mipChain )
+	{
+		CookedTextureMip mipInfo;
+		mipInfo.m_dimensions = mip.GetDimensions();
+		mipInfo.m_byteOffset = totalByteSize;
+
+		GetMipLayout( out_cookedTexture.m_format, mipInfo.m_dimensions, mipInfo.m_rowPitch, mipInfo.m_byteSize );
+
+		totalByteSize += mipInfo.m_byteSize;
+		out_cookedTexture.m_mips.push_back( mipInfo );
+	}
+
+	out_cookedTexture.m_data.resize( totalByteSize );
+	for ( size_t mipNum = 0; mipNum < mipChain.size(); mipNum++ )
+	{
+		CookedTextureMip const& mipInfo = out_cookedTexture.m_mips[ mipNum ];
+		EncodeMip( mipChain[ mipNum ], out_cookedTexture.m_format, out_cookedTexture.m_data.data() + mipInfo.m_byteOffset, mipInfo.m_rowPitch );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// BC5 decodes to ( x, y, 0, 255 ) like the GPU does; compare normal maps over two channels
+//
+void DecodeCookedTextureMip( CookedTexture const& cookedTexture, int mipNum, Image& out_image )
+{
+	CookedTextureMip const& mipInfo = cookedTexture.m_mips[ mipNum ];
+	uint8_t const*          data    = cookedTexture.m_data.data() + mipInfo.m_byteOffset;
+	int                     width   = mipInfo.m_dimensions.x;
+	int                     height  = mipInfo.m_dimensions.y;
+
+	out_image = Image();
+	out_image.SetupAsSolidColor( width, height, Rgba8::WHITE );
+	Rgba8* texels = out_image.GetRawData();
+
+	if ( !IsBlockCompressed( cookedTexture.m_format ) )
+	{
+		memcpy( texels, data, static_cast< size_t >( width ) * height * sizeof( Rgba8 ) );
+		return;
+	}
+
+	int numBlocksWide = ( width + 3 ) / 4;
+	int numBlocksHigh = ( height + 3 ) / 4;
+	int blockByteSize = GetBlockByteSize( cookedTexture.m_format );
+
+	for ( int blockY = 0; blockY < numBlocksHigh; blockY++ )
+	{
+		for ( int blockX = 0; blockX < numBlocksWide; blockX++ )
+		{
+			uint8_t const* block = data + static_cast< size_t >( blockY ) * mipInfo.m_rowPitch + static_cast< size_t >( blockX ) * blockByteSize;
+			Rgba8   decoded[ 16 ];
+			uint8_t channel[ 16 ];
+
+			if ( cookedTexture.m_format == CookedTextureFormat::BC1 )
+			{
+				DecodeBC1Block( block, decoded );
+			}
+			else if ( cookedTexture.m_format == CookedTextureFormat::BC3 )
+			{
+				DecodeBC1Block( block + 8, decoded );
+				DecodeBC4Block( block, channel );
+				for ( int texelNum = 0; texelNum < 16; texelNum++ )
+				{
+					decoded[ texelNum ].a = channel[ texelNum ];
+				}
+			}
+			else
+			{
+				DecodeBC4Block( block, channel );
+				for ( int texelNum = 0; texelNum < 16; texelNum++ )
+				{
+					decoded[ texelNum ] = Rgba8( channel[ texelNum ], 0, 0, 255 );
+				}
+
+				DecodeBC4Block( block + 8, channel );
+				for ( int texelNum = 0; texelNum < 16; texelNum++ )
+				{
+					decoded[ texelNum ].g = channel[ texelNum ];
+				}
+			}
+
+			for ( int texelNum = 0; texelNum < 16; texelNum++ )
+			{
+				int x = blockX * 4 + texelNum % 4;
+				int y = blockY * 4 + texelNum / 4;
+				if ( x < width && y < height )
+				{
+					texels[ y * width + x ] = decoded[ texelNum ];
+				}
+			}
+		}
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+float ComputeImagePSNR( Image const& reference, Image const& test, int numChannels /*= 3 */ )
+{
+	ASSERT_OR_DIE( reference.GetDimensions() == test.GetDimensions(), "PSNR needs images of the same size" );
+
+	Rgba8 const* referenceTexels = reference.GetRawData();
+	Rgba8 const* testTexels      = test.GetRawData();
+	int          numTexels       = reference.GetWidth() * reference.GetHeight();
+
+	double squaredErrorSum = 0.0;
+	for ( int texelNum = 0; texelNum < numTexels; texelNum++ )
+	{
+		unsigned char const* referenceChannels = &referenceTexels[ texelNum ].r;
+		unsigned char const* testChannels      = &testTexels[ texelNum ].r;
+		for ( int channel = 0; channel < numChannels; channel++ )
+		{
+			double difference = static_cast< double >( referenceChannels[ channel ] ) - static_cast< double >( testChannels[ channel ] );
+			squaredErrorSum  += difference * difference;
+		}
+	}
+
+	double meanSquaredError = squaredErrorSum / ( static_cast< double >( numTexels ) * numChannels );
+	if ( meanSquaredError <= 0.0 )
+		return INFINITY;
+
+	return static_cast< float >( 10.0 * log10( 255.0 * 255.0 / meanSquaredError ) );
+}
+
+
+//------------------------------------------------------------------------------------------------
+template <typename T>
+static void AppendBytes( std::vector<uint8_t>& buffer, T const& value )
+{
+	uint8_t const* bytes = reinterpret_cast< uint8_t const* >( &value );
+	buffer.insert( buffer.end(), bytes, bytes + sizeof( T ) );
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool WriteCookedTextureFile( CookedTexture const& cookedTexture, std::string const& filePath )
+{
+	CookedTextureFileHeader header;
+	header.m_format       = static_cast< uint32_t >( cookedTexture.m_format );
+	header.m_usage        = static_cast< uint32_t >( cookedTexture.m_usage );
+	header.m_width        = static_cast< uint32_t >( cookedTexture.m_dimensions.x );
+	header.m_height       = static_cast< uint32_t >( cookedTexture.m_dimensions.y );
+	header.m_numMips      = static_cast< uint32_t >( cookedTexture.m_mips.size() );
+	header.m_dataByteSize = static_cast< uint32_t >( cookedTexture.m_data.size() );
+
+	std::vector<uint8_t> buffer;
+	buffer.reserve( sizeof( header ) + cookedTexture.m_mips.size() * sizeof( CookedTextureFileMip ) + cookedTexture.m_data.size() );
+	AppendBytes( buffer, header );
+
+	for ( CookedTextureMip const& mip : cookedTexture.m_mips )
+	{
+		CookedTextureFileMip fileMip;
+		fileMip.m_width      = static_cast< uint32_t >( mip.m_dimensions.x );
+		fileMip.m_height     = static_cast< uint32_t >( mip.m_dimensions.y );
+		fileMip.m_rowPitch   = static_cast< uint32_t >( mip.m_rowPitch );
+		fileMip.m_byteOffset = static_cast< uint32_t >( mip.m_byteOffset );
+		fileMip.m_byteSize   = static_cast< uint32_t >( mip.m_byteSize );
+		AppendBytes( buffer, fileMip );
+	}
+
+	buffer.insert( buffer.end(), cookedTexture.m_data.begin(), cookedTexture.m_data.end() );
+	return BufferWriteToFile( buffer, filePath );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Anything that does not describe exactly what CookTexture would have written is rejected, so a
+// truncated or corrupt file is re-cooked instead of uploaded or decoded out of bounds
+//
+bool ReadCookedTextureFile( CookedTexture& out_cookedTexture, std::string const& filePath )
+{
+	MappedFile file;
+	if ( !file.Open( filePath ) || file.GetSize() < sizeof( CookedTextureFileHeader ) )
+		return false;
+
+	uint8_t const* fileData = file.GetData();
+
+	CookedTextureFileHeader header;
+	memcpy( &header, fileData, sizeof( header ) );
+	if ( header.m_fourCC != COOKED_TEXTURE_FOURCC || header.m_version != COOKED_TEXTURE_VERSION )
+		return false;
+	if ( !IsValidCookedFormat( header.m_format ) || !IsValidTextureUsage( header.m_usage ) )
+		return false;
+	if ( header.m_width == 0 || header.m_height == 0 || header.m_width > INT_MAX / 4 || header.m_height > INT_MAX / 4 )
+		return false;
+	if ( header.m_numMips == 0 || header.m_numMips > MAX_COOKED_TEXTURE_MIPS )
+		return false;
+
+	size_t mipTableOffset = sizeof( header );
+	size_t dataOffset     = mipTableOffset + header.m_numMips * sizeof( CookedTextureFileMip );
+	if ( file.GetSize() < dataOffset + header.m_dataByteSize )
+		return false;
+
+	CookedTextureFormat format = static_cast< CookedTextureFormat >( header.m_format );
+	out_cookedTexture.m_format     = format;
+	out_cookedTexture.m_usage      = static_cast< TextureUsage >( header.m_usage );
+	out_cookedTexture.m_dimensions = IntVec2( static_cast< int >( header.m_width ), static_cast< int >( header.m_height ) );
+	out_cookedTexture.m_mips.clear();
+
+	// Mips halve down from the top level and are packed back to back
+	IntVec2 expectedDimensions = out_cookedTexture.m_dimensions;
+	size_t  expectedOffset     = 0;
+	for ( uint32_t mipNum = 0; mipNum < header.m_numMips; mipNum++ )
+	{
+		CookedTextureFileMip fileMip;
+		memcpy( &fileMip, fileData + mipTableOffset + mipNum * sizeof( CookedTextureFileMip ), sizeof( fileMip ) );
+
+		CookedTextureMip mip;
+		mip.m_dimensions = IntVec2( static_cast< int >( fileMip.m_width ), static_cast< int >( fileMip.m_height ) );
+		if ( fileMip.m_width > INT_MAX / 4 || fileMip.m_height > INT_MAX / 4 || !( mip.m_dimensions == expectedDimensions ) )
+			return false;
+
+		GetMipLayout( format, mip.m_dimensions, mip.m_rowPitch, mip.m_byteSize );
+		mip.m_byteOffset = expectedOffset;
+		if ( fileMip.m_rowPitch != static_cast< uint32_t >( mip.m_rowPitch ) || fileMip.m_byteSize != mip.m_byteSize || fileMip.m_byteOffset != mip.m_byteOffset )
+			return false;
+
+		expectedOffset    += mip.m_byteSize;
+		expectedDimensions = IntVec2( std::max( expectedDimensions.x / 2, 1 ), std::max( expectedDimensions.y / 2, 1 ) );
+		out_cookedTexture.m_mips.push_back( mip );
+	}
+
+	if ( expectedOffset != header.m_dataByteSize )
+		return false;
+
+	out_cookedTexture.m_data.assign( fileData + dataOffset, fileData + dataOffset + header.m_dataByteSize );
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+std::string GetCookedTexturePath( std::string const& imageFilePath )
+{
+	size_t extensionStart = imageFilePath.find_last_of( '.' );
+	size_t directoryEnd   = imageFilePath.find_last_of( "/\\" );
+	if ( extensionStart == std::string::npos || ( directoryEnd != std::string::npos && extensionStart < directoryEnd ) )
+	{
+		return imageFilePath + ".ctex";
+	}
+
+	return imageFilePath.substr( 0, extensionStart ) + ".ctex";
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool LoadOrCookTexture( CookedTexture& out_cookedTexture, char const* imageFilePath, TextureUsage usage )
+{
+	std::string     cookedFilePath = GetCookedTexturePath( imageFilePath );
+	std::error_code sourceError;
+	std::error_code cookedError;
+	std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time( imageFilePath, sourceError );
+	std::filesystem::file_time_type cookedTime = std::filesystem::last_write_time( cookedFilePath, cookedError );
+
+	// A cooked file without its source is still usable, so shipped data can leave the images out
+	bool isCookedFileCurrent = !cookedError && ( sourceError || cookedTime >= sourceTime );
+	if ( isCookedFileCurrent )
+	{
+		if ( ReadCookedTextureFile( out_cookedTexture, cookedFilePath ) )
+		{
+			if ( out_cookedTexture.m_usage == usage )
+				return true;
+		}
+		else
+		{
+			DebuggerPrintf( "Cooked texture \"%s\" is invalid; cooking it again\n", cookedFilePath.c_str() );
+		}
+	}
+
+	if ( sourceError )
+		return false;
+
+	Image source( imageFilePath );
+	CookTexture( source, usage, out_cookedTexture );
+
+	if ( out_cookedTexture.m_format != CookedTextureFormat::RGBA8 )
+	{
+		Image decoded;
+		DecodeCookedTextureMip( out_cookedTexture, 0, decoded );
+		int numChannels = usage == TextureUsage::NORMAL_MAP ? 2 : ( out_cookedTexture.m_format == CookedTextureFormat::BC3 ? 4 : 3 );
+		DebuggerPrintf( "Cooked \"%s\": %d mips, PSNR %.2f dB\n", imageFilePath, static_cast< int >( out_cookedTexture.m_mips.size() ), ComputeImagePSNR( source, decoded, numChannels ) );
+	}
+
+	if ( !WriteCookedTextureFile( out_cookedTexture, cookedFilePath ) )
+	{
+		DebuggerPrintf( "Failed to write cooked texture \"%s\"\n", cookedFilePath.c_str() );
+	}
+
+	return true;
+}
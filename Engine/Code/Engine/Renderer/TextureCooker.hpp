@@ -0,0 +1,74 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/IntVec2.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+//------------------------------------------------------------------------------------------------
+class Image;
+
+
+//------------------------------------------------------------------------------------------------
+// How a texture is sampled, which decides how its mips are filtered and how it is encoded
+//
+enum class TextureUsage : uint32_t
+{
+	COLOR,			// gamma correct mips; BC1, or BC3 when any texel is translucent
+	NORMAL_MAP,		// renormalized mips; BC5 keeps x and y only and shaders rebuild z
+	UI,				// drawn near 1:1 ( font atlases ); one uncompressed level
+};
+
+
+//------------------------------------------------------------------------------------------------
+enum class CookedTextureFormat : uint32_t
+{
+	RGBA8,
+	BC1,
+	BC3,
+	BC5,
+};
+
+
+//------------------------------------------------------------------------------------------------
+struct CookedTextureMip
+{
+	IntVec2 m_dimensions;
+	int     m_rowPitch   = 0;		// bytes per row of texels, or per row of 4x4 blocks
+	size_t  m_byteOffset = 0;		// into CookedTexture::m_data
+	size_t  m_byteSize   = 0;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Upload ready texture: every mip already in its GPU format, packed back to back in m_data
+//
+struct CookedTexture
+{
+	CookedTextureFormat           m_format = CookedTextureFormat::RGBA8;
+	TextureUsage                  m_usage  = TextureUsage::COLOR;
+	IntVec2                       m_dimensions;
+	std::vector<CookedTextureMip> m_mips;
+	std::vector<uint8_t>          m_data;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Cooking runs the per row and per block work on g_theJobSystem when there is one, unless the calling
+// thread opted out with SetCookOnJobSystem( false )
+//
+void        SetCookOnJobSystem( bool useJobSystem );	// per calling thread; background loaders cook serially so frame jobs never wait behind them
+void        GenerateMipChain( Image const& source, TextureUsage usage, std::vector<Image>& out_mipChain );	// out_mipChain[ 0 ] is source
+void        CookTexture( Image const& source, TextureUsage usage, CookedTexture& out_cookedTexture, bool allowCompression = true );	// false keeps every mip RGBA8
+void        DecodeCookedTextureMip( CookedTexture const& cookedTexture, int mipNum, Image& out_image );
+float       ComputeImagePSNR( Image const& reference, Image const& test, int numChannels = 3 );				// over the first numChannels of RGBA, in dB
+
+bool        WriteCookedTextureFile( CookedTexture const& cookedTexture, std::string const& filePath );
+bool        ReadCookedTextureFile( CookedTexture& out_cookedTexture, std::string const& filePath );
+std::string GetCookedTexturePath( std::string const& imageFilePath );
+
+// Reads the cooked file next to the image, cooking and writing it first when it is missing, stale or
+// was cooked for another usage. Returns false only when the source image itself can't be used
+bool        LoadOrCookTexture( CookedTexture& out_cookedTexture, char const* imageFilePath, TextureUsage usage );
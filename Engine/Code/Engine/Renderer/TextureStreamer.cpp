@@ -0,0 +1,467 @@
+#include "Engine/Renderer/TextureStreamer.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/Texture.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+
+//------------------------------------------------------------------------------------------------
+TextureStreamer::TextureStreamer( TextureStreamerConfig const& config ) :
+	m_config( config )
+{
+}
+
+
+//------------------------------------------------------------------------------------------------
+TextureStreamer::~TextureStreamer()
+{
+}
+
+
+//------------------------------------------------------------------------------------------------
+void TextureStreamer::Startup()
+{
+	m_isQuitting = false;
+
+	for ( int threadNum = 0; threadNum < m_config.m_numLoaderThreads; threadNum++ )
+	{
+		m_loaderThreads.push_back( new std::thread( &TextureStreamer::LoaderThreadMain, this ) );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// A loader finishes the entry it is on before it sees the quit flag; queued entries are dropped
+//
+void TextureStreamer::Shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock( m_loadQueueLock );
+		m_isQuitting = true;
+		m_loadQueue.clear();
+	}
+	m_loadQueueCondition.notify_all();
+
+	for ( std::thread* thread : m_loaderThreads )
+	{
+		thread->join();
+		delete thread;
+	}
+	m_loaderThreads.clear();
+
+	for ( TextureStreamEntry* entry : m_entries )
+	{
+		delete entry;
+	}
+	m_entries.clear();
+	m_uploadCandidates.clear();
+
+	m_stats = TextureStreamingStats();
+}
+
+
+//------------------------------------------------------------------------------------------------
+void TextureStreamer::BeginFrame()
+{
+	m_stats.m_uploadedBytesThisFrame = 0;
+	m_stats.m_numEvictionsThisFrame  = 0;
+
+	// Entries of deleted textures go once no loader thread can still be writing into them
+	for ( size_t entryNum = 0; entryNum < m_entries.size(); )
+	{
+		TextureStreamEntry* entry = m_entries[ entryNum ];
+		if ( entry->m_texture == nullptr && entry->m_state.load( std::memory_order_acquire ) != TextureStreamState::LOADING )
+		{
+			delete entry;
+			m_entries[ entryNum ] = m_entries.back();
+			m_entries.pop_back();
+			continue;
+		}
+
+		entryNum++;
+	}
+
+	UploadLoadedEntries();
+	RequeueUsedEntries();
+
+	m_stats.m_numStreamedTextures = 0;
+	m_stats.m_numPendingRequests  = 0;
+	for ( TextureStreamEntry const* entry : m_entries )
+	{
+		if ( entry->m_texture == nullptr )
+			continue;
+
+		TextureStreamState state = entry->m_state.load( std::memory_order_relaxed );
+		m_stats.m_numStreamedTextures++;
+		m_stats.m_numPendingRequests += ( state == TextureStreamState::LOADING || state == TextureStreamState::LOADED ) ? 1 : 0;
+	}
+
+	m_frameNumber++;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void TextureStreamer::RequestTexture( Texture* texture )
+{
+	TextureStreamEntry* entry = new TextureStreamEntry();
+	entry->m_texture       = texture;
+	entry->m_imageFilePath = texture->m_imageFilePath;
+	entry->m_usage         = texture->m_usage;
+	m_entries.push_back( entry );
+
+	texture->m_lastUsedFrame = m_frameNumber;
+
+	QueueLoad( entry );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void TextureStreamer::ForgetTexture( Texture* texture )
+{
+	for ( TextureStreamEntry* entry : m_entries )
+	{
+		if ( entry->m_texture == texture )
+		{
+			m_stats.m_residentBytes -= entry->m_residentBytes;
+			entry->m_residentBytes   = 0;
+			entry->m_texture         = nullptr;
+			return;
+		}
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+void TextureStreamer::MarkTextureUsed( Texture const* texture ) const
+{
+	texture->m_lastUsedFrame = m_frameNumber;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Cooks stay on this thread; jobs kicked from here would land in the shared queue, where the main
+// thread waiting on its frame jobs could end up running a whole texture cook
+//
+void TextureStreamer::LoaderThreadMain()
+{
+	SetCookOnJobSystem( false );
+
+	for ( ;; )
+	{
+		TextureStreamEntry* entry = nullptr;
+		{
+			std::unique_lock<std::mutex> lock( m_loadQueueLock );
+			m_loadQueueCondition.wait( lock, [ this ]() { return m_isQuitting || !m_loadQueue.empty(); } );
+			if ( m_isQuitting )
+				return;
+
+			entry = m_loadQueue.front();
+			m_loadQueue.pop_front();
+		}
+
+		LoadEntry( *entry );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Runs on a loader thread; only touches the entry's cooked texture until it publishes LOADED
+//
+void TextureStreamer::LoadEntry( TextureStreamEntry& entry ) const
+{
+	bool isLoaded = false;
+	if ( m_config.m_useCookedTextures )
+	{
+		isLoaded = LoadOrCookTexture( entry.m_cookedTexture, entry.m_imageFilePath.c_str(), entry.m_usage );
+	}
+	else
+	{
+		std::error_code error;
+		if ( std::filesystem::exists( entry.m_imageFilePath, error ) )
+		{
+			Image source( entry.m_imageFilePath.c_str() );
+			CookTexture( source, entry.m_usage, entry.m_cookedTexture, false );
+			isLoaded = true;
+		}
+	}
+
+	if ( !isLoaded )
+	{
+		DebuggerPrintf( "Failed to stream texture \"%s\"\n", entry.m_imageFilePath.c_str() );
+	}
+
+	entry.m_state.store( isLoaded ? TextureStreamState::LOADED : TextureStreamState::FAILED, std::memory_order_release );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void TextureStreamer::QueueLoad( TextureStreamEntry* entry )
+{
+	entry->m_state.store( TextureStreamState::LOADING, std::memory_order_relaxed );
+
+	if ( m_loaderThreads.empty() )
+	{
+		LoadEntry( *entry );
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( m_loadQueueLock );
+		m_loadQueue.push_back( entry );
+	}
+	m_loadQueueCondition.notify_one();
+}
+
+
+//------------------------------------------------------------------------------------------------
+void TextureStreamer::ReleaseCPUData( TextureStreamEntry& entry ) const
+{
+	entry.m_cookedTexture = CookedTexture();
+	entry.m_state.store( TextureStreamState::IDLE, std::memory_order_relaxed );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Textures showing their coarsest mips go first, so everything on screen gets some detail before
+// anything gets full detail. Each texture jumps to the finest mip that fits what is left of the frame
+//
+void TextureStreamer::UploadLoadedEntries()
+{
+	m_uploadCandidates.clear();
+	for ( TextureStreamEntry* entry : m_entries )
+	{
+		if ( entry->m_texture == nullptr || entry->m_state.load( std::memory_order_acquire ) != TextureStreamState::LOADED )
+			continue;
+
+		if ( entry->m_mips.empty() )
+		{
+			entry->m_format                = entry->m_cookedTexture.m_format;
+			entry->m_mips                  = entry->m_cookedTexture.m_mips;
+			entry->m_texture->m_dimensions = entry->m_cookedTexture.m_dimensions;
+		}
+
+		if ( GetFirstResidentMip( *entry ) == 0 )
+		{
+			ReleaseCPUData( *entry );
+			continue;
+		}
+
+		m_uploadCandidates.push_back( entry );
+	}
+
+	std::sort( m_uploadCandidates.begin(), m_uploadCandidates.end(), [ this ]( TextureStreamEntry const* a, TextureStreamEntry const* b )
+	{
+		int aTopTexels = a->m_texture->IsValid() ? a->m_mips[ GetFirstResidentMip( *a ) ].m_dimensions.x * a->m_mips[ GetFirstResidentMip( *a ) ].m_dimensions.y : 0;
+		int bTopTexels = b->m_texture->IsValid() ? b->m_mips[ GetFirstResidentMip( *b ) ].m_dimensions.x * b->m_mips[ GetFirstResidentMip( *b ) ].m_dimensions.y : 0;
+		if ( aTopTexels != bTopTexels )
+			return aTopTexels < bTopTexels;
+
+		return a->m_texture->m_lastUsedFrame > b->m_texture->m_lastUsedFrame;
+	} );
+
+	for ( TextureStreamEntry* entry : m_uploadCandidates )
+	{
+		size_t uploadedBytes  = m_stats.m_uploadedBytesThisFrame;
+		size_t remainingBytes = uploadedBytes < m_config.m_uploadBudgetBytesPerFrame ? m_config.m_uploadBudgetBytesPerFrame - uploadedBytes : 0;
+		bool   mustProgress   = uploadedBytes == 0;
+
+		int uploadMip = -1;
+		for ( int mipNum = GetFirstResidentMip( *entry ) - 1; mipNum >= 0; mipNum-- )
+		{
+			if ( !IsValidTopMip( *entry, mipNum ) )
+				continue;
+
+			if ( GetByteSizeFromMip( *entry, mipNum ) > remainingBytes )
+			{
+				if ( uploadMip < 0 && mustProgress )
+				{
+					uploadMip = mipNum;
+				}
+				break;
+			}
+
+			uploadMip = mipNum;
+		}
+
+		if ( uploadMip < 0 )
+			continue;
+
+		size_t uploadBytes = GetByteSizeFromMip( *entry, uploadMip );
+		size_t growthBytes = uploadBytes - entry->m_residentBytes;
+		if ( m_stats.m_residentBytes + growthBytes > m_config.m_residentBudgetBytes && !EvictForUpload( growthBytes, *entry ) )
+		{
+			// Nothing older left to evict; try again from disk once the texture is used with room to spare
+			ReleaseCPUData( *entry );
+			continue;
+		}
+
+		if ( !entry->m_texture->CreateFromCookedTexture( m_config.m_renderer, entry->m_imageFilePath.c_str(), entry->m_cookedTexture, uploadMip ) )
+		{
+			DebuggerPrintf( "Failed to upload streamed texture \"%s\"\n", entry->m_imageFilePath.c_str() );
+			ReleaseCPUData( *entry );
+			entry->m_state.store( TextureStreamState::FAILED, std::memory_order_relaxed );
+			continue;
+		}
+
+		m_stats.m_residentBytes          += growthBytes;
+		m_stats.m_uploadedBytesThisFrame += uploadBytes;
+		entry->m_residentBytes            = uploadBytes;
+
+		if ( uploadMip == 0 )
+		{
+			ReleaseCPUData( *entry );
+		}
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Evicted textures that were drawn last frame load again, but only when their next mip could fit by
+// evicting textures that weren't; otherwise a working set over budget would reload every frame
+//
+void TextureStreamer::RequeueUsedEntries()
+{
+	size_t evictableBytes = 0;
+	for ( TextureStreamEntry const* entry : m_entries )
+	{
+		if ( entry->m_texture != nullptr && entry->m_texture->m_lastUsedFrame < m_frameNumber )
+		{
+			evictableBytes += entry->m_residentBytes;
+		}
+	}
+
+	for ( TextureStreamEntry* entry : m_entries )
+	{
+		if ( entry->m_texture == nullptr || entry->m_texture->m_lastUsedFrame < m_frameNumber )
+			continue;
+
+		if ( entry->m_state.load( std::memory_order_relaxed ) != TextureStreamState::IDLE )
+			continue;
+
+		int nextMip = GetNextFinerMip( *entry );
+		if ( nextMip < 0 )
+			continue;
+
+		size_t growthBytes = GetByteSizeFromMip( *entry, nextMip ) - entry->m_residentBytes;
+		if ( m_stats.m_residentBytes + growthBytes > m_config.m_residentBudgetBytes + evictableBytes )
+			continue;
+
+		QueueLoad( entry );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Only textures used less recently than the requester are evicted, one mip step at a time
+//
+bool TextureStreamer::EvictForUpload( size_t numBytesNeeded, TextureStreamEntry const& requester )
+{
+	while ( m_stats.m_residentBytes + numBytesNeeded > m_config.m_residentBudgetBytes )
+	{
+		TextureStreamEntry* victim = nullptr;
+		for ( TextureStreamEntry* entry : m_entries )
+		{
+			if ( entry == &requester || entry->m_texture == nullptr || entry->m_residentBytes == 0 )
+				continue;
+
+			if ( entry->m_texture->m_lastUsedFrame >= requester.m_texture->m_lastUsedFrame )
+				continue;
+
+			if ( victim == nullptr || entry->m_texture->m_lastUsedFrame < victim->m_texture->m_lastUsedFrame )
+			{
+				victim = entry;
+			}
+		}
+
+		if ( victim == nullptr )
+			return false;
+
+		EvictFinestMips( *victim );
+	}
+
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Steps down to the next mip that can start a texture; past the coarsest one the texture goes
+// back to binding as the default
+//
+void TextureStreamer::EvictFinestMips( TextureStreamEntry& entry )
+{
+	int numMips     = static_cast< int >( entry.m_mips.size() );
+	int newFirstMip = -1;
+	for ( int mipNum = GetFirstResidentMip( entry ) + 1; mipNum < numMips; mipNum++ )
+	{
+		if ( IsValidTopMip( entry, mipNum ) )
+		{
+			newFirstMip = mipNum;
+			break;
+		}
+	}
+
+	m_stats.m_residentBytes -= entry.m_residentBytes;
+
+	if ( newFirstMip >= 0 && entry.m_texture->DropResidentMips( m_config.m_renderer, newFirstMip, entry.m_mips[ newFirstMip ].m_dimensions ) )
+	{
+		entry.m_residentBytes = GetByteSizeFromMip( entry, newFirstMip );
+	}
+	else
+	{
+		entry.m_texture->ReleaseResources();
+		entry.m_residentBytes = 0;
+	}
+
+	m_stats.m_residentBytes += entry.m_residentBytes;
+	m_stats.m_numEvictions++;
+	m_stats.m_numEvictionsThisFrame++;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// D3D11 wants the top level of a block compressed texture to be whole blocks
+//
+bool TextureStreamer::IsValidTopMip( TextureStreamEntry const& entry, int mipNum ) const
+{
+	if ( entry.m_format == CookedTextureFormat::RGBA8 )
+		return true;
+
+	IntVec2 const& dimensions = entry.m_mips[ mipNum ].m_dimensions;
+	return ( dimensions.x % 4 ) == 0 && ( dimensions.y % 4 ) == 0;
+}
+
+
+//------------------------------------------------------------------------------------------------
+int TextureStreamer::GetFirstResidentMip( TextureStreamEntry const& entry ) const
+{
+	return entry.m_texture->IsValid() ? entry.m_texture->m_firstResidentMip : static_cast< int >( entry.m_mips.size() );
+}
+
+
+//------------------------------------------------------------------------------------------------
+int TextureStreamer::GetNextFinerMip( TextureStreamEntry const& entry ) const
+{
+	for ( int mipNum = GetFirstResidentMip( entry ) - 1; mipNum >= 0; mipNum-- )
+	{
+		if ( IsValidTopMip( entry, mipNum ) )
+			return mipNum;
+	}
+
+	return -1;
+}
+
+
+//------------------------------------------------------------------------------------------------
+size_t TextureStreamer::GetByteSizeFromMip( TextureStreamEntry const& entry, int firstMip ) const
+{
+	size_t byteSize = 0;
+	for ( size_t mipNum = static_cast< size_t >( firstMip ); mipNum < entry.m_mips.size(); mipNum++ )
+	{
+		byteSize += entry.m_mips[ mipNum ].m_byteSize;
+	}
+
+	return byteSize;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Renderer/TextureCooker.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+//------------------------------------------------------------------------------------------------
+class Renderer;
+class Texture;
+
+
+//------------------------------------------------------------------------------------------------
+struct TextureStreamerConfig
+{
+	Renderer* m_renderer                  = nullptr;
+	bool      m_useCookedTextures         = true;
+	int       m_numLoaderThreads          = 1;							// 0 loads on the requesting thread
+	size_t    m_residentBudgetBytes       = 256 * 1024 * 1024;			// GPU bytes across every streamed mip
+	size_t    m_uploadBudgetBytesPerFrame = 8 * 1024 * 1024;			// one step is still uploaded when it alone is larger
+};
+
+
+//------------------------------------------------------------------------------------------------
+struct TextureStreamingStats
+{
+	size_t m_residentBytes          = 0;
+	size_t m_uploadedBytesThisFrame = 0;
+	int    m_numStreamedTextures    = 0;
+	int    m_numPendingRequests     = 0;		// loading, or loaded and still uploading
+	int    m_numEvictionsThisFrame  = 0;
+	int    m_numEvictions           = 0;
+};
+
+
+//------------------------------------------------------------------------------------------------
+enum class TextureStreamState : int
+{
+	IDLE,			// no CPU copy; the texture keeps whatever mips are resident
+	LOADING,		// queued for or running on a loader thread
+	LOADED,			// CPU copy ready, finer mips still to upload
+	FAILED,
+};
+
+
+//------------------------------------------------------------------------------------------------
+// m_cookedTexture belongs to the loader thread while LOADING and to the main thread otherwise
+//
+struct TextureStreamEntry
+{
+	Texture*                        m_texture       = nullptr;		// nullptr once the renderer deleted it
+	std::string                     m_imageFilePath;
+	TextureUsage                    m_usage         = TextureUsage::COLOR;
+	std::atomic<TextureStreamState> m_state         = { TextureStreamState::IDLE };
+	CookedTexture                   m_cookedTexture;
+	CookedTextureFormat             m_format        = CookedTextureFormat::RGBA8;
+	std::vector<CookedTextureMip>   m_mips;							// outlives m_cookedTexture so evictions know the mip sizes
+	size_t                          m_residentBytes = 0;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Textures are handed out immediately and bound as the default texture until their first mips land.
+// Loader threads read and cook; BeginFrame uploads coarse to fine under a per frame byte budget and
+// evicts the finest mips of the least recently used textures to stay under the resident budget
+//
+class TextureStreamer
+{
+public:
+	TextureStreamer( TextureStreamerConfig const& config );
+	~TextureStreamer();
+	void Startup();
+	void Shutdown();
+	void BeginFrame();
+
+	void RequestTexture( Texture* texture );
+	void ForgetTexture( Texture* texture );
+	void MarkTextureUsed( Texture const* texture ) const;
+
+	TextureStreamingStats const& GetStats() const	{ return m_stats; }
+
+private:
+	void   LoaderThreadMain();
+	void   LoadEntry( TextureStreamEntry& entry ) const;
+	void   QueueLoad( TextureStreamEntry* entry );
+	void   ReleaseCPUData( TextureStreamEntry& entry ) const;
+
+	void   UploadLoadedEntries();
+	void   RequeueUsedEntries();
+	bool   EvictForUpload( size_t numBytesNeeded, TextureStreamEntry const& requester );
+	void   EvictFinestMips( TextureStreamEntry& entry );
+
+	bool   IsValidTopMip( TextureStreamEntry const& entry, int mipNum ) const;
+	int    GetFirstResidentMip( TextureStreamEntry const& entry ) const;
+	int    GetNextFinerMip( TextureStreamEntry const& entry ) const;
+	size_t GetByteSizeFromMip( TextureStreamEntry const& entry, int firstMip ) const;
+
+private:
+	TextureStreamerConfig            m_config;
+	std::vector<TextureStreamEntry*> m_entries;
+	std::vector<TextureStreamEntry*> m_uploadCandidates;
+	uint64_t                         m_frameNumber = 1;
+	TextureStreamingStats            m_stats;
+
+	std::vector<std::thread*>        m_loaderThreads;
+	std::mutex                       m_loadQueueLock;
+	std::condition_variable          m_loadQueueCondition;
+	std::deque<TextureStreamEntry*>  m_loadQueue;
+	bool                             m_isQuitting  = false;
+};
@@ -1,5 +1,6 @@
 #include "VertexUtils.hpp"
 
+#include "Engine/Core/FrameArena.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Math/AABB2.hpp"
@@ -12,6 +13,21 @@
 #include <math.h>
 
 
+//-------------------------------------------------------------------------------------------------
+// Reserving the exact size on every call defeats the vector's geometric growth; text and UI build
+// thousands of quads into one list, which would reallocate ( or burn frame arena space ) per quad
+//
+template <typename VERTEX_LIST>
+static void ReserveForAppend( VERTEX_LIST& verts, size_t numNewVerts )
+{
+	size_t requiredSize = verts.size() + numNewVerts;
+	if ( requiredSize > verts.capacity() )
+	{
+		verts.reserve( requiredSize > verts.capacity() * 2 ? requiredSize : verts.capacity() * 2 );
+	}
+}
+
+
 //-------------------------------------------------------------------------------------------------
 void TransformVertexArray2D( int numVerts, Vertex_PCU* verts, float uniformScaleXY, float rotatingDegreesAboutZ, Vec2 const& translationXY )
 {
@@ -43,40 +59,48 @@ void TransformVertexArrayXY3D( int numVerts, Vertex_PCU* verts, float uniformSca
 //-------------------------------------------------------------------------------------------------
 void TransformVertexArrayPositionsUsingMatrix( int numVerts, Vertex_PCU* verts, Mat44 const& transformMatrix )
 {
-	for ( int vertNum = 0; vertNum < numVerts; vertNum++ )
+	if ( numVerts <= 0 )
 	{
-		verts[ vertNum ].m_position = transformMatrix.TransformPosition3D( verts[ vertNum ].m_position );
+		return;
 	}
+
+	transformMatrix.TransformPositionArray3D( numVerts, &verts[ 0 ].m_position, sizeof( Vertex_PCU ) );
 }
 
 
 //-------------------------------------------------------------------------------------------------
 void TransformVertexArrayUsingMatrix( int numVerts, Vertex_PCU* verts, Mat44 const& transformMatrix )
 {
-	for ( int vertNum = 0; vertNum < numVerts; vertNum++ )
+	if ( numVerts <= 0 )
 	{
-		verts[ vertNum ].m_position = transformMatrix.TransformVectorQuantity3D( verts[ vertNum ].m_position );
+		return;
 	}
+
+	transformMatrix.TransformVectorQuantityArray3D( numVerts, &verts[ 0 ].m_position, sizeof( Vertex_PCU ) );
 }
 
 
 //-------------------------------------------------------------------------------------------------
 void TransformVertexArrayUsingMatrix( int numVerts, Vertex_PCUTBN* verts, Mat44 const& transformMatrix )
 {
-	for ( int vertNum = 0; vertNum < numVerts; vertNum++ )
+	if ( numVerts <= 0 )
 	{
-		verts[ vertNum ].m_position = transformMatrix.TransformVectorQuantity3D( verts[ vertNum ].m_position );
+		return;
 	}
+
+	transformMatrix.TransformVectorQuantityArray3D( numVerts, &verts[ 0 ].m_position, sizeof( Vertex_PCUTBN ) );
 }
 
 
 //-------------------------------------------------------------------------------------------------
 void TransformVertexArrayPositionsUsingMatrix( int numVerts, Vertex_PCUTBN* verts, Mat44 const& transformMatrix )
 {
-	for ( int vertNum = 0; vertNum < numVerts; vertNum++ )
+	if ( numVerts <= 0 )
 	{
-		verts[ vertNum ].m_position = transformMatrix.TransformPosition3D( verts[ vertNum ].m_position );
+		return;
 	}
+
+	transformMatrix.TransformPositionArray3D( numVerts, &verts[ 0 ].m_position, sizeof( Vertex_PCUTBN ) );
 }
 
 
@@ -94,7 +118,7 @@ void AddVertsForCapsule2D( std::vector<Vertex_PCU>& verts, Vec2 const& boneStart
 	constexpr int noOfVerts = 3 * noOfSides;
 	constexpr float degreesPerSide = 180.f / static_cast< float >( noOfSides );
 
-	verts.reserve( verts.size() + noOfVerts * 2 + 12 );
+	ReserveForAppend( verts, noOfVerts * 2 + 12 );
 
 	Vec2 startToEndVector = boneEnd - boneStart;
 	Vec2 startToEndVectorNormalized = startToEndVector.GetNormalized();
@@ -204,7 +228,7 @@ void AddVertsForDisc2D( std::vector<Vertex_PCU>& verts, Vec2 const& center, floa
 
 	std::vector<Vec2> sideEndVerts;
 
-	verts.reserve( verts.size() + noOfVerts );
+	ReserveForAppend( verts, noOfVerts );
 
 	for ( int sideIndex = 0; sideIndex < noOfSides; ++sideIndex )
 	{
@@ -235,7 +259,7 @@ void AddVertsForDisc2D( std::vector<Vertex_PCU>& verts, Vec2 const& center, floa
 //-------------------------------------------------------------------------------------------------
 void AddVertsForOBB2D( std::vector<Vertex_PCU>& verts, OBB2 const& box, Rgba8 const& color )
 {
-	verts.reserve( verts.size() + 6 );
+	ReserveForAppend( verts, 6 );
 
 	Vec2 iBasis = box.m_iBasisNormal;
 	Vec2 jBasis = box.m_iBasisNormal.GetRotated90Degrees();
@@ -281,10 +305,11 @@ void AddVertsForOBB2D( std::vector<Vertex_PCU>& verts, OBB2 const& box, Rgba8 co
 
 
 //-------------------------------------------------------------------------------------------------
-void AddVertsForAABB2D( std::vector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& color, AABB2 const& uvBounds )
+template <typename VERTEX_LIST>
+void AddVertsForAABB2D( VERTEX_LIST& verts, AABB2 const& bounds, Rgba8 const& color, AABB2 const& uvBounds )
 {
 	constexpr int NUM_VERTS = 6;
-	verts.reserve( verts.size() + NUM_VERTS );
+	ReserveForAppend( verts, NUM_VERTS );
 
 	Vec3 BottomLeft = Vec3( bounds.m_mins.x, bounds.m_mins.y, 0.f );
 	Vec3 BottomRight = Vec3( bounds.m_maxs.x, bounds.m_mins.y, 0.f );
@@ -411,9 +436,10 @@ void AddVertsForLineSegment2DWithArrow( std::vector<Vertex_PCU>& verts, LineSegm
 
 
 //-------------------------------------------------------------------------------------------------
-void AddVertsForAABBZ3D( std::vector<Vertex_PCU>& verts, AABB3 const& bounds, Rgba8 const& tint /*= Rgba8::WHITE*/, AABB2 const& UVs /*= AABB2::ZEROTOONE */ )
+template <typename VERTEX_LIST>
+void AddVertsForAABBZ3D( VERTEX_LIST& verts, AABB3 const& bounds, Rgba8 const& tint /*= Rgba8::WHITE*/, AABB2 const& UVs /*= AABB2::ZEROTOONE */ )
 {
-	verts.reserve( verts.size() + 36 );
+	ReserveForAppend( verts, 36 );
 
 	verts.push_back( Vertex_PCU( Vec3( bounds.m_maxs.x, bounds.m_mins.y, bounds.m_mins.z ), tint, Vec2( UVs.m_mins.x, UVs.m_mins.y ) ) );
 	verts.push_back( Vertex_PCU( Vec3( bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_mins.z ), tint, Vec2( UVs.m_maxs.x, UVs.m_mins.y ) ) );
@@ -460,9 +486,10 @@ void AddVertsForAABBZ3D( std::vector<Vertex_PCU>& verts, AABB3 const& bounds, Rg
 
 
 //-------------------------------------------------------------------------------------------------
-void AddVertsForUVSphereZ3D( std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, float numSlices /*= 64*/, float numStacks /*= 32.0f*/, Rgba8 const& tint /*= Rgba8::WHITE*/, AABB2 const& UVs /*= AABB2::ZEROTOONE */ )
+template <typename VERTEX_LIST>
+void AddVertsForUVSphereZ3D( VERTEX_LIST& verts, Vec3 const& center, float radius, float numSlices /*= 64*/, float numStacks /*= 32.0f*/, Rgba8 const& tint /*= Rgba8::WHITE*/, AABB2 const& UVs /*= AABB2::ZEROTOONE */ )
 {
-	verts.reserve( verts.size() + static_cast< size_t >( numSlices * numStacks ) * 6 );
+	ReserveForAppend( verts, static_cast< size_t >( numSlices * numStacks ) * 6 );
 
 	float yawAnglePerSlice = 360.f / numSlices;
 	float pitchAnglePerStack = 180.f / numStacks;
@@ -502,9 +529,10 @@ void AddVertsForUVSphereZ3D( std::vector<Vertex_PCU>& verts, Vec3 const& center,
 
 
 //-------------------------------------------------------------------------------------------------
-void AddVertsForCylinderZ3D( std::vector<Vertex_PCU>& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices /*= 64.f*/, Rgba8 const& tint /*= Rgba8::WHITE*/, AABB2 const& UVs /*= AABB2::ZEROTOONE */ )
+template <typename VERTEX_LIST>
+void AddVertsForCylinderZ3D( VERTEX_LIST& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices /*= 64.f*/, Rgba8 const& tint /*= Rgba8::WHITE*/, AABB2 const& UVs /*= AABB2::ZEROTOONE */ )
 {
-	verts.reserve( verts.size() + static_cast< size_t >( numSlices ) * 12 );
+	ReserveForAppend( verts, static_cast< size_t >( numSlices ) * 12 );
 
 	float anglePerSlice = 360.f / numSlices;
 	float uRange = UVs.m_maxs.x - UVs.m_mins.x;
@@ -544,15 +572,16 @@ void AddVertsForCylinderZ3D( std::vector<Vertex_PCU>& verts, Vec2 const& centerX
 
 
 //-------------------------------------------------------------------------------------------------
-void AddVertsForLine3D( std::vector<Vertex_PCU>& verts, Vec3 start, Vec3 end, float thickness /*= 0.125f*/, Rgba8 const& tint /*= Rgba8::WHITE*/, AABB2 const& UVs /*= AABB2::ZEROTOONE */ )
+template <typename VERTEX_LIST>
+void AddVertsForLine3D( VERTEX_LIST& verts, Vec3 start, Vec3 end, float thickness /*= 0.125f*/, Rgba8 const& tint /*= Rgba8::WHITE*/, AABB2 const& UVs /*= AABB2::ZEROTOONE */ )
 {
-	std::vector<Vertex_PCU> lineLocalVerts;
+	size_t firstVertIndex = verts.size();
 
 	Vec3 startToEnd = end - start;
 
 	float length = startToEnd.GetLength();
 
-	AddVertsForCylinderZ3D( lineLocalVerts, Vec2::ZERO, FloatRange( 0.0f, length ), thickness * 0.5f, 8.f, tint, UVs );
+	AddVertsForCylinderZ3D( verts, Vec2::ZERO, FloatRange( 0.0f, length ), thickness * 0.5f, 8.f, tint, UVs );
 
 	Vec3 kBasis( startToEnd );
 
@@ -575,14 +604,8 @@ void AddVertsForLine3D( std::vector<Vertex_PCU>& verts, Vec3 start, Vec3 end, fl
 	Mat44 transformMat;
 	transformMat.SetIJKT3D( iBasis, jBasis, kBasis, start );
 
-	TransformVertexArrayPositionsUsingMatrix( static_cast< int >( lineLocalVerts.size() ), lineLocalVerts.data(), transformMat );
-
-	verts.reserve( verts.size() + lineLocalVerts.size() );
-
-	for ( Vertex_PCU vertex : lineLocalVerts )
-	{
-		verts.push_back( vertex );
-	}
+	// The cylinder was appended in local space; move just those verts into place
+	TransformVertexArrayPositionsUsingMatrix( static_cast< int >( verts.size() - firstVertIndex ), verts.data() + firstVertIndex, transformMat );
 }
 
 
@@ -695,7 +718,8 @@ void AddVertsForCylinderZ3DWireFrame( std::vector<Vertex_PCU>& verts, Vec2 const
 
 
 //-------------------------------------------------------------------------------------------------
-void AddVertsForConeZ3D( std::vector<Vertex_PCU>& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices /*= 64.f*/, Rgba8 const& tint /*= Rgba8::WHITE*/, AABB2 const& UVs /*= AABB2::ZEROTOONE */ )
+template <typename VERTEX_LIST>
+void AddVertsForConeZ3D( VERTEX_LIST& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices /*= 64.f*/, Rgba8 const& tint /*= Rgba8::WHITE*/, AABB2 const& UVs /*= AABB2::ZEROTOONE */ )
 {
 	float anglePerSlice = 360.f / numSlices;
 	float uRange = UVs.m_maxs.x - UVs.m_mins.x;
@@ -725,7 +749,7 @@ void AddVertsForConeZ3D( std::vector<Vertex_PCU>& verts, Vec2 const& centerXY, F
 void AddVertsForQuad3D( std::vector<Vertex_PCU>& verts, Vec3 bottomLeft, Vec3 bottomRight, Vec3 topLeft, Vec3 topRight, Rgba8 const& tint /*= Rgba8::WHITE*/, AABB2 const& uvBounds /*= AABB2::ZEROTOONE */ )
 {
 	constexpr int NUM_VERTS = 6;
-	verts.reserve( verts.size() + NUM_VERTS );
+	ReserveForAppend( verts, NUM_VERTS );
 
 	Vec2 bottomLeftUV = uvBounds.m_mins;
 	Vec2 bottomRightUV = Vec2( uvBounds.m_maxs.x, uvBounds.m_mins.y );
@@ -745,7 +769,7 @@ void AddVertsForQuad3D( std::vector<Vertex_PCU>& verts, Vec3 bottomLeft, Vec3 bo
 //--------------------------------------------------------------------------------------------------------------------------------------------
 void AddVertsForAABB3TBN( std::vector<Vertex_PCUTBN>& verts, AABB3 const& bounds, Rgba8 const& tint /*= Rgba8::WHITE*/, AABB2 const& UVs /*= AABB2::ZEROTOONE */ )
 {
-	verts.reserve( verts.size() + 36 );
+	ReserveForAppend( verts, 36 );
 
 	Vec3 vertex1 = Vec3( bounds.m_maxs.x, bounds.m_mins.y, bounds.m_mins.z );
 	Vec3 vertex2 = Vec3( bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_mins.z );
@@ -836,4 +860,19 @@ void AddVertsForAABB3TBN( std::vector<Vertex_PCUTBN>& verts, AABB3 const& bounds
 	verts.push_back( Vertex_PCUTBN( Vec3( bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_mins.z ), tint, Vec2( UVs.m_maxs.x, UVs.m_mins.y ), bottomFaceTangent, Vec3::ZERO, bottomFaceNormal ) );
 	verts.push_back( Vertex_PCUTBN( Vec3( bounds.m_maxs.x, bounds.m_mins.y, bounds.m_mins.z ), tint, Vec2( UVs.m_maxs.x, UVs.m_maxs.y ), bottomFaceTangent, Vec3::ZERO, bottomFaceNormal ) );
 	verts.push_back( Vertex_PCUTBN( Vec3( bounds.m_mins.x, bounds.m_maxs.y, bounds.m_mins.z ), tint, Vec2( UVs.m_mins.x, UVs.m_mins.y ), bottomFaceTangent, Vec3::ZERO, bottomFaceNormal ) );
-}
\ No newline at end of file
+}
+
+
+//-------------------------------------------------------------------------------------------------
+template void AddVertsForAABB2D( std::vector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& color, AABB2 const& uvBounds );
+template void AddVertsForAABB2D( FrameVector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& color, AABB2 const& uvBounds );
+template void AddVertsForAABBZ3D( std::vector<Vertex_PCU>& verts, AABB3 const& bounds, Rgba8 const& tint, AABB2 const& UVs );
+template void AddVertsForAABBZ3D( FrameVector<Vertex_PCU>& verts, AABB3 const& bounds, Rgba8 const& tint, AABB2 const& UVs );
+template void AddVertsForUVSphereZ3D( std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint, AABB2 const& UVs );
+template void AddVertsForUVSphereZ3D( FrameVector<Vertex_PCU>& verts, Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint, AABB2 const& UVs );
+template void AddVertsForCylinderZ3D( std::vector<Vertex_PCU>& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices, Rgba8 const& tint, AABB2 const& UVs );
+template void AddVertsForCylinderZ3D( FrameVector<Vertex_PCU>& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices, Rgba8 const& tint, AABB2 const& UVs );
+template void AddVertsForLine3D( std::vector<Vertex_PCU>& verts, Vec3 start, Vec3 end, float thickness, Rgba8 const& tint, AABB2 const& UVs );
+template void AddVertsForLine3D( FrameVector<Vertex_PCU>& verts, Vec3 start, Vec3 end, float thickness, Rgba8 const& tint, AABB2 const& UVs );
+template void AddVertsForConeZ3D( std::vector<Vertex_PCU>& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices, Rgba8 const& tint, AABB2 const& UVs );
+template void AddVertsForConeZ3D( FrameVector<Vertex_PCU>& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices, Rgba8 const& tint, AABB2 const& UVs );
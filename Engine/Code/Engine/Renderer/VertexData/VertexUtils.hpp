@@ -20,6 +20,9 @@ class Mat44;
 
 
 //----------------------------------------------------------------------------------------------------
+// The templated builders take std::vector<Vertex_PCU> or FrameVector<Vertex_PCU>; both are explicitly
+// instantiated in VertexUtils.cpp
+//
 void TransformVertexArray2D( int numVerts, Vertex_PCU* verts, float uniformScaleXY, float rotatingDegreesAboutZ, Vec2 const& translationXY );
 void TransformVertexArrayXY3D( int numVerts, Vertex_PCU* verts, float uniformScaleXY, float rotatingDegreesAboutZ, Vec2 const& translationXY );
 
@@ -29,7 +32,8 @@ void TransformVertexArrayPositionsUsingMatrix( int numVerts, Vertex_PCU* verts,
 void TransformVertexArrayUsingMatrix( int numVerts, Vertex_PCUTBN* verts, Mat44 const& transformMatrix );
 void TransformVertexArrayPositionsUsingMatrix( int numVerts, Vertex_PCUTBN* verts, Mat44 const& transformMatrix );
 
-void AddVertsForAABB2D( std::vector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& color, AABB2 const& uvBounds = AABB2::ZEROTOONE );
+template <typename VERTEX_LIST>
+void AddVertsForAABB2D( VERTEX_LIST& verts, AABB2 const& bounds, Rgba8 const& color, AABB2 const& uvBounds = AABB2::ZEROTOONE );
 void AddVertsForCapsule2D( std::vector<Vertex_PCU>& verts, Capsule2 const& capsule, Rgba8 const& color );
 void AddVertsForCapsule2D( std::vector<Vertex_PCU>& verts, Vec2 const& boneStart, Vec2 const& boneEnd, float radius, Rgba8 const& color );
 void AddVertsForDisc2D( std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, Rgba8 const& color );
@@ -40,18 +44,23 @@ void AddVertsForLineSegment2D( std::vector<Vertex_PCU>& verts, LineSegment2 cons
 void AddVertsForLineSegment2DWithArrow( std::vector<Vertex_PCU>& verts, Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color );
 void AddVertsForLineSegment2DWithArrow( std::vector<Vertex_PCU>& verts, LineSegment2 const& lineSegment, float thickness, Rgba8 const& color );
 
-void AddVertsForAABBZ3D( std::vector<Vertex_PCU>& verts, AABB3 const& bounds, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE );
-void AddVertsForUVSphereZ3D( std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, float numSlices = 64, float numStacks = 32.0f, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE );
-void AddVertsForCylinderZ3D( std::vector<Vertex_PCU>& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices = 64.f, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE );
+template <typename VERTEX_LIST>
+void AddVertsForAABBZ3D( VERTEX_LIST& verts, AABB3 const& bounds, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE );
+template <typename VERTEX_LIST>
+void AddVertsForUVSphereZ3D( VERTEX_LIST& verts, Vec3 const& center, float radius, float numSlices = 64, float numStacks = 32.0f, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE );
+template <typename VERTEX_LIST>
+void AddVertsForCylinderZ3D( VERTEX_LIST& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices = 64.f, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE );
 
-void AddVertsForLine3D( std::vector<Vertex_PCU>& verts, Vec3 start, Vec3 end, float thickness = 0.125f, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE );
+template <typename VERTEX_LIST>
+void AddVertsForLine3D( VERTEX_LIST& verts, Vec3 start, Vec3 end, float thickness = 0.125f, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE );
 void AddVertsForLine3DWithArrow( std::vector<Vertex_PCU>& verts, Vec3 start, Vec3 end, float thickness = 0.125f, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE );
 
 void AddVertsForAABBZ3DWireFrame( std::vector<Vertex_PCU>& verts, AABB3 const& bounds, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE, float thickness = 0.03125f );
 void AddVertsForUVSphereZ3DWireFrame( std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, float numSlices = 64, float numStacks = 32.0f, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE, float thickness = 0.03125f );
 void AddVertsForCylinderZ3DWireFrame( std::vector<Vertex_PCU>& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices = 64.f, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE, float thickness = 0.03125f );
 
-void AddVertsForConeZ3D( std::vector<Vertex_PCU>& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices = 64.f, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE );
+template <typename VERTEX_LIST>
+void AddVertsForConeZ3D( VERTEX_LIST& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices = 64.f, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZEROTOONE );
 
 void AddVertsForQuad3D( std::vector<Vertex_PCU>& verts, Vec3 bottomLeft, Vec3 bottomRight, Vec3 topLeft, Vec3 topRight, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& uvBounds = AABB2::ZEROTOONE );
 
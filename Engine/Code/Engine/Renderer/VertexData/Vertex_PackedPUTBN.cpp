@@ -0,0 +1,97 @@
+#include "Vertex_PackedPUTBN.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+
+//----------------------------------------------------------------------------------------------------
+static uint16_t EncodeUnorm16( float zeroToOne )
+{
+	float clamped = Clamp( zeroToOne, 0.0f, 1.0f );
+	return static_cast< uint16_t >( clamped * 65535.0f + 0.5f );
+}
+
+
+//----------------------------------------------------------------------------------------------------
+static float DecodeUnorm16( uint16_t value )
+{
+	return static_cast< float >( value ) / 65535.0f;
+}
+
+
+//----------------------------------------------------------------------------------------------------
+static int16_t EncodeSnorm16( float minusOneToOne )
+{
+	float scaled = Clamp( minusOneToOne, -1.0f, 1.0f ) * 32767.0f;
+	return static_cast< int16_t >( scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f );
+}
+
+
+//----------------------------------------------------------------------------------------------------
+static float DecodeSnorm16( int16_t value )
+{
+	return Clamp( static_cast< float >( value ) / 32767.0f, -1.0f, 1.0f );
+}
+
+
+//----------------------------------------------------------------------------------------------------
+static float GetFractionWithinBounds( float value, float boundsMin, float boundsMax )
+{
+	float extent = boundsMax - boundsMin;
+	if ( extent <= 0.0f )
+	{
+		return 0.0f;
+	}
+
+	return ( value - boundsMin ) / extent;
+}
+
+
+//----------------------------------------------------------------------------------------------------
+Vertex_PackedPUTBN Vertex_PackedPUTBN::Encode( Vertex_PCUTBN const& vertex, AABB3 const& bounds )
+{
+	Vertex_PackedPUTBN packed;
+
+	packed.m_position.m_position[ 0 ] = EncodeUnorm16( GetFractionWithinBounds( vertex.m_position.x, bounds.m_mins.x, bounds.m_maxs.x ) );
+	packed.m_position.m_position[ 1 ] = EncodeUnorm16( GetFractionWithinBounds( vertex.m_position.y, bounds.m_mins.y, bounds.m_maxs.y ) );
+	packed.m_position.m_position[ 2 ] = EncodeUnorm16( GetFractionWithinBounds( vertex.m_position.z, bounds.m_mins.z, bounds.m_maxs.z ) );
+
+	float bitangentSign = DotProduct3D( CrossProduct3D( vertex.m_normal, vertex.m_tangent ), vertex.m_binormal );
+	packed.m_position.m_position[ 3 ] = bitangentSign >= 0.0f ? 0xFFFF : 0;
+
+	packed.m_attributes.m_uvTexCoords[ 0 ] = FloatToHalf( vertex.m_uvTexCoords.x );
+	packed.m_attributes.m_uvTexCoords[ 1 ] = FloatToHalf( vertex.m_uvTexCoords.y );
+
+	Vec2 octTangent = EncodeOctahedral( vertex.m_tangent.GetNormalized() );
+	packed.m_attributes.m_tangent[ 0 ] = EncodeSnorm16( octTangent.x );
+	packed.m_attributes.m_tangent[ 1 ] = EncodeSnorm16( octTangent.y );
+
+	Vec2 octNormal = EncodeOctahedral( vertex.m_normal.GetNormalized() );
+	packed.m_attributes.m_normal[ 0 ] = EncodeSnorm16( octNormal.x );
+	packed.m_attributes.m_normal[ 1 ] = EncodeSnorm16( octNormal.y );
+
+	return packed;
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// Mirrors the decode in Data/Shaders/PackedVertex.hlsl
+//
+Vertex_PCUTBN Vertex_PackedPUTBN::Decode( AABB3 const& bounds ) const
+{
+	Vertex_PCUTBN vertex;
+
+	Vec3 extent = bounds.m_maxs - bounds.m_mins;
+	vertex.m_position.x = bounds.m_mins.x + DecodeUnorm16( m_position.m_position[ 0 ] ) * extent.x;
+	vertex.m_position.y = bounds.m_mins.y + DecodeUnorm16( m_position.m_position[ 1 ] ) * extent.y;
+	vertex.m_position.z = bounds.m_mins.z + DecodeUnorm16( m_position.m_position[ 2 ] ) * extent.z;
+
+	vertex.m_uvTexCoords.x = HalfToFloat( m_attributes.m_uvTexCoords[ 0 ] );
+	vertex.m_uvTexCoords.y = HalfToFloat( m_attributes.m_uvTexCoords[ 1 ] );
+
+	vertex.m_tangent = DecodeOctahedral( Vec2( DecodeSnorm16( m_attributes.m_tangent[ 0 ] ), DecodeSnorm16( m_attributes.m_tangent[ 1 ] ) ) );
+	vertex.m_normal  = DecodeOctahedral( Vec2( DecodeSnorm16( m_attributes.m_normal[ 0 ] ), DecodeSnorm16( m_attributes.m_normal[ 1 ] ) ) );
+
+	float bitangentSign = m_position.m_position[ 3 ] != 0 ? 1.0f : -1.0f;
+	vertex.m_binormal = CrossProduct3D( vertex.m_normal, vertex.m_tangent ) * bitangentSign;
+
+	return vertex;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Renderer/VertexData/Vertex_PCUTBN.hpp"
+
+#include <cstdint>
+
+
+//----------------------------------------------------------------------------------------------------
+// Position stream - unorm16 xyz relative to the mesh bounds, w holds the bitangent sign ( 0 = negative, 0xFFFF = positive )
+// Depth-only passes bind this stream alone
+//
+struct Vertex_PackedPosition
+{
+public:
+	uint16_t m_position[ 4 ] = {};
+};
+
+
+//----------------------------------------------------------------------------------------------------
+// Attribute stream - half float uvs, octahedral snorm16 tangent and normal
+//
+struct Vertex_PackedUTBN
+{
+public:
+	uint16_t m_uvTexCoords[ 2 ] = {};
+	int16_t  m_tangent[ 2 ]     = {};
+	int16_t  m_normal[ 2 ]      = {};
+};
+
+
+//----------------------------------------------------------------------------------------------------
+// Compact mesh vertex ( 20 bytes vs 60 for Vertex_PCUTBN ), uploaded as a position stream and an attribute stream.
+// Color is dropped since imported meshes are always white.
+//
+struct Vertex_PackedPUTBN
+{
+public:
+	Vertex_PackedPosition m_position;
+	Vertex_PackedUTBN     m_attributes;
+
+public:
+	static Vertex_PackedPUTBN Encode( Vertex_PCUTBN const& vertex, AABB3 const& bounds );
+	Vertex_PCUTBN             Decode( AABB3 const& bounds ) const;
+};
+
+// Renderer::DrawVertexBuffer picks the input layout from the stride, so the position stream must not match any other vertex size
+static_assert( sizeof( Vertex_PackedPosition ) == 8, "Vertex_PackedPosition must stay tightly packed" );
+static_assert( sizeof( Vertex_PackedUTBN ) == 12, "Vertex_PackedUTBN must stay tightly packed" );
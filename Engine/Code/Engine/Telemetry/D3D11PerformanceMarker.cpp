@@ -19,6 +19,8 @@
 CComPtr<ID3DUserDefinedAnnotation> pPerfMarker;
 D3D11PerformanceMarker* g_theD3D11PerfMarker = nullptr;
 
+constexpr int MARKER_NAME_MAX_LENGTH = 256;
+
 
 //--------------------------------------------------------------------------------------------------------------------------------------------
 D3D11PerformanceMarker::D3D11PerformanceMarker( Renderer* renderContext )
@@ -54,10 +56,19 @@ void D3D11PerformanceMarker::EndPerformanceMarker()
 
 
 //--------------------------------------------------------------------------------------------------------------------------------------------
+// Widens into a stack buffer; markers are opened per pass every frame and shouldn't touch the heap
+//
 ZoneScopedD3D11Marker::ZoneScopedD3D11Marker( const char* name )
 {
-	std::string nameAsString = name;
-	g_theD3D11PerfMarker->BeginPerformanceMarker( StringToWideString( nameAsString ).c_str() );
+	wchar_t wideName[ MARKER_NAME_MAX_LENGTH ];
+	int     charNum = 0;
+	for ( ; charNum < MARKER_NAME_MAX_LENGTH - 1 && name[ charNum ] != '\0'; charNum++ )
+	{
+		wideName[ charNum ] = static_cast< wchar_t >( static_cast< unsigned char >( name[ charNum ] ) );
+	}
+	wideName[ charNum ] = L'\0';
+
+	g_theD3D11PerfMarker->BeginPerformanceMarker( wideName );
 }
 
 
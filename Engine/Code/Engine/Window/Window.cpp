@@ -18,6 +18,12 @@ Window* g_theWindow = nullptr;
 Window* Window::s_theWindow = nullptr;
 
 
+//-----------------------------------------------------------------------------------------------
+static constexpr EventID QUIT_EVENT                  = HashEventName( "Quit" );
+static constexpr EventID HANDLE_CHAR_INPUT_EVENT     = HashEventName( "HandleCharInput" );
+static constexpr EventID HANDLE_KEY_DOWN_INPUT_EVENT = HashEventName( "HandleKeyDownInput" );
+
+
 //-----------------------------------------------------------------------------------------------
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler( HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam );
 
@@ -47,7 +53,7 @@ LRESULT CALLBACK WindowsMessageHandlingProcedure( HWND windowHandle, UINT wmMess
 
 		case WM_CLOSE:
 		{
-			FireEvent( "Quit" );
+			FireEvent( QUIT_EVENT );
 			return 0;
 		}
 
@@ -56,9 +62,9 @@ LRESULT CALLBACK WindowsMessageHandlingProcedure( HWND windowHandle, UINT wmMess
 			int asKey = static_cast< int >( wParam );
 
 			EventArgs keyArg;
-			keyArg.SetValue( "KeyValue", Stringf( "%d", asKey ) );
+			keyArg.SetValue( "KeyValue", asKey );
 
-			FireEvent( "HandleCharInput", keyArg );
+			FireEvent( HANDLE_CHAR_INPUT_EVENT, keyArg );
 
 			break;
 		}
@@ -163,9 +169,9 @@ LRESULT CALLBACK WindowsMessageHandlingProcedure( HWND windowHandle, UINT wmMess
 			bool wasConsumed = false;
 
 			EventArgs keyArg;
-			keyArg.SetValue( "KeyValue", Stringf( "%u", asKey ) );
+			keyArg.SetValue( "KeyValue", static_cast< int >( asKey ) );
 
-			FireEvent( "HandleKeyDownInput", keyArg );
+			FireEvent( HANDLE_KEY_DOWN_INPUT_EVENT, keyArg );
 
 			if ( input )
 			{
@@ -0,0 +1,13 @@
+#include "TestFramework.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Build in Release; Debug timings say nothing about the optimized paths being measured
+//
+int main( int argc, char** argv )
+{
+	(void) argc;
+	(void) argv;
+
+	return RunAllBenchmarks();
+}
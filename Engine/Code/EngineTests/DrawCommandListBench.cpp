@@ -0,0 +1,48 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Renderer/DrawCommandList.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+static Shader*             const FAKE_SHADER = reinterpret_cast< Shader* >( 0x10 );
+static VertexBuffer const* const FAKE_VBO    = reinterpret_cast< VertexBuffer const* >( 0x30 );
+static IndexBuffer const*  const FAKE_IBO    = reinterpret_cast< IndexBuffer const* >( 0x50 );
+
+
+//-----------------------------------------------------------------------------------------------
+static void RecordShadowLikeView( DrawCommandList& commandList, int numDraws )
+{
+	ModelTransformationData data;
+	commandList.BindShader( FAKE_SHADER );
+	for ( int drawNum = 0; drawNum < numDraws; drawNum++ )
+	{
+		data.tint[ 0 ] = static_cast< float >( drawNum );
+		commandList.SetModelBuffer( data );
+		commandList.DrawIndexedVertexBuffer( FAKE_VBO, FAKE_IBO, 36, drawNum * 36 );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// One frame of shadow recording: reusing a list keeps its capacity, a fresh list grows from empty
+//
+ENGINE_BENCHMARK( DrawCommandList_RecordShadowView )
+{
+	constexpr int NUM_DRAWS  = 4096;
+	constexpr int NUM_FRAMES = 500;
+
+	DrawCommandList reused;
+	bench.Measure( "Record 4096 draws, reused list", NUM_FRAMES, [&]()
+	{
+		reused.Reset();
+		RecordShadowLikeView( reused, NUM_DRAWS );
+		DoNotOptimizeAway( &reused );
+	} );
+
+	bench.Measure( "Record 4096 draws, new list", NUM_FRAMES, [&]()
+	{
+		DrawCommandList fresh;
+		RecordShadowLikeView( fresh, NUM_DRAWS );
+		DoNotOptimizeAway( &fresh );
+	} );
+}
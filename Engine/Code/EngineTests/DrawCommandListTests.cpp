@@ -0,0 +1,103 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Renderer/DrawCommandList.hpp"
+
+#include <utility>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+// Only the pointers are recorded, so tags stand in for real GPU objects
+//
+static Shader*             const FAKE_SHADER_A = reinterpret_cast< Shader* >( 0x10 );
+static Shader*             const FAKE_SHADER_B = reinterpret_cast< Shader* >( 0x20 );
+static VertexBuffer const* const FAKE_VBO      = reinterpret_cast< VertexBuffer const* >( 0x30 );
+static VertexBuffer const* const FAKE_ATTR_VBO = reinterpret_cast< VertexBuffer const* >( 0x40 );
+static IndexBuffer const*  const FAKE_IBO      = reinterpret_cast< IndexBuffer const* >( 0x50 );
+
+
+//-----------------------------------------------------------------------------------------------
+static ModelTransformationData MakeModelData( float tag )
+{
+	ModelTransformationData data;
+	data.tint[ 0 ] = tag;
+	return data;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void RecordShadowLikeView( DrawCommandList& commandList, int numDraws )
+{
+	commandList.BindShader( FAKE_SHADER_A );
+	for ( int drawNum = 0; drawNum < numDraws; drawNum++ )
+	{
+		commandList.SetModelBuffer( MakeModelData( static_cast< float >( drawNum ) ) );
+		commandList.DrawIndexedVertexBuffer( FAKE_VBO, FAKE_IBO, 36, drawNum * 36 );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( DrawCommandList_RecordsCommandsInOrder )
+{
+	DrawCommandList commandList;
+	TEST_CHECK( commandList.IsEmpty() );
+
+	commandList.BindShader( FAKE_SHADER_A );
+	commandList.SetModelBuffer( MakeModelData( 1.0f ) );
+	commandList.DrawIndexedVertexBuffer( FAKE_VBO, FAKE_IBO, 36, 12 );
+	commandList.BindShader( FAKE_SHADER_B );
+	commandList.SetModelBuffer( MakeModelData( 2.0f ) );
+	commandList.DrawIndexedVertexStreams( FAKE_VBO, FAKE_ATTR_VBO, FAKE_IBO, 6, 0 );
+
+	std::vector<DrawCommand> const& commands = commandList.GetCommands();
+	TEST_CHECK( commands.size() == 6 );
+	TEST_CHECK( commandList.GetNumDraws() == 2 );
+	if ( commands.size() != 6 )
+		return;
+
+	TEST_CHECK( commands[ 0 ].m_type == DrawCommandType::BIND_SHADER && commands[ 0 ].m_shader == FAKE_SHADER_A );
+	TEST_CHECK( commands[ 1 ].m_type == DrawCommandType::SET_MODEL_BUFFER );
+	TEST_CHECK( commands[ 2 ].m_type == DrawCommandType::DRAW_INDEXED_VERTEX_BUFFER );
+	TEST_CHECK( commands[ 2 ].m_vbo == FAKE_VBO && commands[ 2 ].m_ibo == FAKE_IBO && commands[ 2 ].m_count == 36 && commands[ 2 ].m_offset == 12 );
+	TEST_CHECK( commands[ 3 ].m_type == DrawCommandType::BIND_SHADER && commands[ 3 ].m_shader == FAKE_SHADER_B );
+	TEST_CHECK( commands[ 5 ].m_type == DrawCommandType::DRAW_INDEXED_VERTEX_STREAMS && commands[ 5 ].m_attributeVBO == FAKE_ATTR_VBO );
+
+	// Each model buffer command points at its own packed copy of the constants
+	TEST_CHECK( commandList.GetModelData( commands[ 1 ].m_modelDataIndex ).tint[ 0 ] == 1.0f );
+	TEST_CHECK( commandList.GetModelData( commands[ 4 ].m_modelDataIndex ).tint[ 0 ] == 2.0f );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( DrawCommandList_ResetClearsForReuse )
+{
+	DrawCommandList commandList;
+	RecordShadowLikeView( commandList, 100 );
+	TEST_CHECK( commandList.GetNumDraws() == 100 );
+
+	commandList.Reset();
+	TEST_CHECK( commandList.IsEmpty() );
+	TEST_CHECK( commandList.GetNumDraws() == 0 );
+
+	RecordShadowLikeView( commandList, 3 );
+	std::vector<DrawCommand> const& commands = commandList.GetCommands();
+	TEST_CHECK( commands.size() == 7 );
+	TEST_CHECK( commandList.GetNumDraws() == 3 );
+	TEST_CHECK( commandList.GetModelData( commands[ 5 ].m_modelDataIndex ).tint[ 0 ] == 2.0f );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Lists are recorded on job workers into separate objects; swapping hands one to the frame packet
+//
+ENGINE_TEST( DrawCommandList_SwapMovesRecording )
+{
+	DrawCommandList recorded;
+	DrawCommandList packet;
+	RecordShadowLikeView( recorded, 5 );
+
+	std::swap( recorded, packet );
+	TEST_CHECK( recorded.IsEmpty() );
+	TEST_CHECK( packet.GetNumDraws() == 5 );
+}
@@ -0,0 +1,241 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+
+#include <thread>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr int     NUM_FIRING_THREADS     = 4;
+constexpr int     NUM_FIRES_PER_THREAD   = 500;
+constexpr EventID TEST_RESUBSCRIBE_EVENT = HashEventName( "EngineTests_Resubscribe" );
+constexpr EventID TEST_QUEUED_EVENT      = HashEventName( "EngineTests_Queued" );
+
+
+//-----------------------------------------------------------------------------------------------
+struct ReceivedEvent
+{
+	int  m_threadNum    = 0;
+	int  m_sequenceNum  = 0;
+	bool m_onMainThread = false;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static EventSystem*               s_testEventSystem = nullptr;
+static std::thread::id            s_mainThreadID;
+static int                        s_numFirstCalls   = 0;
+static int                        s_numLaterCalls   = 0;
+static int                        s_numLastCalls    = 0;
+static std::vector<ReceivedEvent> s_receivedEvents;
+
+
+//-----------------------------------------------------------------------------------------------
+static bool OnResubscribeLater( EventArgs& args )
+{
+	UNUSED( args );
+	s_numLaterCalls++;
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool OnResubscribeLast( EventArgs& args )
+{
+	UNUSED( args );
+	s_numLastCalls++;
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Swaps itself and the last subscriber out for a new one, in the middle of its own dispatch
+//
+static bool OnResubscribeFirst( EventArgs& args )
+{
+	UNUSED( args );
+	s_numFirstCalls++;
+	s_testEventSystem->UnsubscribeEventCallbackFunction( "EngineTests_Resubscribe", &OnResubscribeFirst );
+	s_testEventSystem->UnsubscribeEventCallbackFunction( "EngineTests_Resubscribe", &OnResubscribeLast );
+	s_testEventSystem->SubscribeEventCallbackFunction( "EngineTests_Resubscribe", &OnResubscribeLater );
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool OnQueuedEvent( EventArgs& args )
+{
+	ReceivedEvent received;
+	received.m_threadNum    = args.GetValue( "Thread", -1 );
+	received.m_sequenceNum  = args.GetValue( "Sequence", -1 );
+	received.m_onMainThread = std::this_thread::get_id() == s_mainThreadID;
+	s_receivedEvents.push_back( received );
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void FireQueuedEvents( EventSystem* eventSystem, int threadNum )
+{
+	for ( int sequenceNum = 0; sequenceNum < NUM_FIRES_PER_THREAD; sequenceNum++ )
+	{
+		EventArgs args;
+		args.SetValue( "Thread", threadNum );
+		args.SetValue( "Sequence", sequenceNum );
+		eventSystem->FireEvent( TEST_QUEUED_EVENT, args );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static int CountEventsOffMainThread()
+{
+	int numOffMainThread = 0;
+	for ( ReceivedEvent const& received : s_receivedEvents )
+	{
+		numOffMainThread += received.m_onMainThread ? 0 : 1;
+	}
+	return numOffMainThread;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Dispatch walks the table that was current when it started: changes made by a callback show up
+// from the next fire on, and a subscriber removed mid dispatch still gets this one call
+//
+ENGINE_TEST( EventSystem_SubscribeChangesInsideCallback )
+{
+	EventSystemConfig config;
+	EventSystem eventSystem( config );
+	eventSystem.Startup();
+	s_testEventSystem = &eventSystem;
+	s_numFirstCalls   = 0;
+	s_numLaterCalls   = 0;
+	s_numLastCalls    = 0;
+
+	eventSystem.SubscribeEventCallbackFunction( "EngineTests_Resubscribe", &OnResubscribeFirst );
+	eventSystem.SubscribeEventCallbackFunction( "EngineTests_Resubscribe", &OnResubscribeLast );
+
+	eventSystem.FireEvent( TEST_RESUBSCRIBE_EVENT );
+	TEST_CHECK( s_numFirstCalls == 1 );
+	TEST_CHECK( s_numLastCalls == 1 );
+	TEST_CHECK( s_numLaterCalls == 0 );
+
+	eventSystem.FireEvent( TEST_RESUBSCRIBE_EVENT );
+	TEST_CHECK( s_numFirstCalls == 1 );
+	TEST_CHECK( s_numLastCalls == 1 );
+	TEST_CHECK( s_numLaterCalls == 1 );
+	TEST_CHECK( eventSystem.IsValidEvent( "EngineTests_Resubscribe" ) );
+
+	eventSystem.UnsubscribeEventCallbackFunction( "EngineTests_Resubscribe", &OnResubscribeLater );
+	TEST_CHECK( !eventSystem.IsValidEvent( "EngineTests_Resubscribe" ) );
+
+	s_testEventSystem = nullptr;
+	eventSystem.Shutdown();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Workers take turns, so fire order is known across threads; then they fire at once, where only
+// each thread's own order is defined
+//
+ENGINE_TEST( EventSystem_QueuedFiresDrainInFireOrder )
+{
+	EventSystemConfig config;
+	EventSystem eventSystem( config );
+	eventSystem.Startup();
+	eventSystem.SubscribeEventCallbackFunction( "EngineTests_Queued", &OnQueuedEvent );
+	s_mainThreadID = std::this_thread::get_id();
+	s_receivedEvents.clear();
+
+	for ( int threadNum = 0; threadNum < NUM_FIRING_THREADS; threadNum++ )
+	{
+		std::thread worker( &FireQueuedEvents, &eventSystem, threadNum );
+		worker.join();
+	}
+	eventSystem.BeginFrame();
+
+	int numOutOfOrder = 0;
+	TEST_CHECK( s_receivedEvents.size() == NUM_FIRING_THREADS * NUM_FIRES_PER_THREAD );
+	for ( size_t receivedNum = 0; receivedNum < s_receivedEvents.size(); receivedNum++ )
+	{
+		ReceivedEvent const& received = s_receivedEvents[ receivedNum ];
+		bool isInOrder = received.m_threadNum == static_cast< int >( receivedNum ) / NUM_FIRES_PER_THREAD &&
+						 received.m_sequenceNum == static_cast< int >( receivedNum ) % NUM_FIRES_PER_THREAD;
+		numOutOfOrder += isInOrder ? 0 : 1;
+	}
+	TEST_CHECK( numOutOfOrder == 0 );
+	TEST_CHECK( CountEventsOffMainThread() == 0 );
+
+	s_receivedEvents.clear();
+	std::vector<std::thread> workers;
+	for ( int threadNum = 0; threadNum < NUM_FIRING_THREADS; threadNum++ )
+	{
+		workers.emplace_back( &FireQueuedEvents, &eventSystem, threadNum );
+	}
+	for ( std::thread& worker : workers )
+	{
+		worker.join();
+	}
+	eventSystem.BeginFrame();
+
+	int nextSequenceNums[ NUM_FIRING_THREADS ] = {};
+	numOutOfOrder = 0;
+	TEST_CHECK( s_receivedEvents.size() == NUM_FIRING_THREADS * NUM_FIRES_PER_THREAD );
+	for ( ReceivedEvent const& received : s_receivedEvents )
+	{
+		if ( received.m_threadNum < 0 || received.m_threadNum >= NUM_FIRING_THREADS )
+		{
+			numOutOfOrder++;
+			continue;
+		}
+
+		int& nextSequenceNum = nextSequenceNums[ received.m_threadNum ];
+		numOutOfOrder += received.m_sequenceNum == nextSequenceNum ? 0 : 1;
+		nextSequenceNum = received.m_sequenceNum + 1;
+	}
+	TEST_CHECK( numOutOfOrder == 0 );
+	TEST_CHECK( CountEventsOffMainThread() == 0 );
+
+	eventSystem.Shutdown();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( EventSystem_WorkerFireRunsAtMainThreadDrain )
+{
+	EventSystemConfig config;
+	EventSystem eventSystem( config );
+	eventSystem.Startup();
+	eventSystem.SubscribeEventCallbackFunction( "EngineTests_Queued", &OnQueuedEvent );
+	s_mainThreadID = std::this_thread::get_id();
+	s_receivedEvents.clear();
+
+	// The main thread dispatches at once
+	EventArgs mainArgs;
+	mainArgs.SetValue( "Thread", NUM_FIRING_THREADS );
+	eventSystem.FireEvent( TEST_QUEUED_EVENT, mainArgs );
+	TEST_CHECK( s_receivedEvents.size() == 1 );
+
+	// A worker's fire waits, even after the worker is gone, until the main thread drains
+	std::thread worker( []( EventSystem* workerEventSystem )
+	{
+		EventArgs args;
+		args.SetValue( "Thread", 0 );
+		workerEventSystem->FireEvent( TEST_QUEUED_EVENT, args );
+	}, &eventSystem );
+	worker.join();
+	TEST_CHECK( s_receivedEvents.size() == 1 );
+
+	eventSystem.BeginFrame();
+	TEST_CHECK( s_receivedEvents.size() == 2 );
+	TEST_CHECK( s_receivedEvents.back().m_threadNum == 0 );
+	TEST_CHECK( CountEventsOffMainThread() == 0 );
+
+	eventSystem.BeginFrame();
+	TEST_CHECK( s_receivedEvents.size() == 2 );
+
+	eventSystem.Shutdown();
+}
@@ -0,0 +1,137 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr int NUM_BATCH_FILES = 8;
+
+
+//-----------------------------------------------------------------------------------------------
+static std::string GetBatchFilePath( int fileNum )
+{
+	return std::string( "EngineTests_Batch" ) + std::to_string( fileNum ) + ".txt";
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// File n holds n + 1 copies of its own line, so a request filled from the wrong file shows up
+//
+static std::string GetBatchFileContents( int fileNum )
+{
+	std::string contents;
+	for ( int lineNum = 0; lineNum <= fileNum; lineNum++ )
+	{
+		contents += "batch file " + std::to_string( fileNum ) + "\n";
+	}
+	return contents;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void WriteBatchFiles()
+{
+	for ( int fileNum = 0; fileNum < NUM_BATCH_FILES; fileNum++ )
+	{
+		std::string contents = GetBatchFileContents( fileNum );
+		StringWriteToFile( contents, GetBatchFilePath( fileNum ) );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void DeleteBatchFiles()
+{
+	for ( int fileNum = 0; fileNum < NUM_BATCH_FILES; fileNum++ )
+	{
+		remove( GetBatchFilePath( fileNum ).c_str() );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// The last request names a file that does not exist and must fail on its own
+//
+static void MakeBatchRequests( std::vector<FileReadRequest>& out_requests )
+{
+	out_requests.clear();
+	out_requests.resize( NUM_BATCH_FILES + 1 );
+	for ( int fileNum = 0; fileNum < NUM_BATCH_FILES; fileNum++ )
+	{
+		out_requests[ fileNum ].m_filename = GetBatchFilePath( fileNum );
+	}
+	out_requests[ NUM_BATCH_FILES ].m_filename = "EngineTests_BatchMissing.txt";
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static int CountWrongResults( std::vector<FileReadRequest> const& requests )
+{
+	int numWrong = 0;
+	for ( int fileNum = 0; fileNum < NUM_BATCH_FILES; fileNum++ )
+	{
+		FileReadRequest const& request  = requests[ fileNum ];
+		std::string            expected = GetBatchFileContents( fileNum );
+
+		bool isRight = request.m_succeeded && request.m_buffer.size() == expected.size() + 1 && request.m_buffer.back() == 0 &&
+					   memcmp( request.m_buffer.data(), expected.data(), expected.size() ) == 0;
+		numWrong += isRight ? 0 : 1;
+	}
+
+	numWrong += requests[ NUM_BATCH_FILES ].m_succeeded ? 1 : 0;
+	return numWrong;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( FileUtils_BatchReadWithoutJobSystem )
+{
+	WriteBatchFiles();
+	JobSystem* previousJobSystem = g_theJobSystem;
+	g_theJobSystem = nullptr;
+
+	std::vector<FileReadRequest> requests;
+	MakeBatchRequests( requests );
+	FileReadBatch( requests.data(), static_cast< int >( requests.size() ) );
+	TEST_CHECK( CountWrongResults( requests ) == 0 );
+
+	g_theJobSystem = previousJobSystem;
+	DeleteBatchFiles();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Waits inside FileReadBatch, then again through a caller owned counter that lets work overlap the reads
+//
+ENGINE_TEST( FileUtils_BatchReadOnJobSystem )
+{
+	WriteBatchFiles();
+	JobSystemConfig config;
+	config.m_numWorkerThreads = 3;
+	JobSystem jobSystem( config );
+	jobSystem.Startup();
+	JobSystem* previousJobSystem = g_theJobSystem;
+	g_theJobSystem = &jobSystem;
+
+	std::vector<FileReadRequest> requests;
+	MakeBatchRequests( requests );
+	FileReadBatch( requests.data(), static_cast< int >( requests.size() ) );
+	TEST_CHECK( CountWrongResults( requests ) == 0 );
+
+	std::vector<FileReadRequest> asyncRequests;
+	MakeBatchRequests( asyncRequests );
+	JobCounter counter;
+	FileReadBatch( asyncRequests.data(), static_cast< int >( asyncRequests.size() ), &counter );
+	jobSystem.WaitForCounter( counter );
+	TEST_CHECK( CountWrongResults( asyncRequests ) == 0 );
+
+	g_theJobSystem = previousJobSystem;
+	jobSystem.Shutdown();
+	DeleteBatchFiles();
+}
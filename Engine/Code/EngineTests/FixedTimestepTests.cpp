@@ -0,0 +1,128 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Core/FixedTimestep.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// 64 ticks per second and frame times in 1/256ths of a second are exact in binary, so tick counts
+// and alphas can be checked for equality rather than within an epsilon
+//
+constexpr double TEST_TICKS_PER_SECOND = 64.0;
+constexpr double TEST_TIME_UNIT        = 1.0 / 256.0;
+constexpr int    TEST_MAX_TICKS        = 8;
+
+
+//-----------------------------------------------------------------------------------------------
+static FixedTimestepConfig MakeTestTimestepConfig()
+{
+	FixedTimestepConfig config;
+	config.m_ticksPerSecond   = TEST_TICKS_PER_SECOND;
+	config.m_maxTicksPerFrame = TEST_MAX_TICKS;
+	return config;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Uneven frame times add up to the same ticks a steady frame rate would give over the same time
+//
+ENGINE_TEST( FixedTimestep_TicksFollowAccumulatedTime )
+{
+	FixedTimestep timestep( MakeTestTimestepConfig() );
+
+	TEST_CHECK( timestep.Advance( 4.0 * TEST_TIME_UNIT ) == 1 );
+	TEST_CHECK( timestep.Advance( 8.0 * TEST_TIME_UNIT ) == 2 );
+	TEST_CHECK( timestep.Advance( 2.0 * TEST_TIME_UNIT ) == 0 );
+	TEST_CHECK( timestep.Advance( 2.0 * TEST_TIME_UNIT ) == 1 );
+	TEST_CHECK( timestep.GetTicksThisFrame() == 1 );
+
+	int frameUnits[] = { 3, 5, 1, 7, 4, 6, 2, 9, 11, 3 };
+	int numTicksSum  = 0;
+	int totalUnits   = 0;
+	for ( int units : frameUnits )
+	{
+		numTicksSum += timestep.Advance( static_cast< double >( units ) * TEST_TIME_UNIT );
+		totalUnits  += units;
+	}
+	TEST_CHECK( numTicksSum == totalUnits / 4 );
+	TEST_CHECK( timestep.GetTotalTicks() == static_cast< uint64_t >( 4 + numTicksSum ) );
+
+	// Negative frame times never take ticks back
+	uint64_t totalTicks = timestep.GetTotalTicks();
+	TEST_CHECK( timestep.Advance( -1.0 ) == 0 );
+	TEST_CHECK( timestep.GetTotalTicks() == totalTicks );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( FixedTimestep_AlphaIsTheLeftoverFractionOfATick )
+{
+	FixedTimestep timestep( MakeTestTimestepConfig() );
+
+	TEST_CHECK( timestep.Advance( 1.0 * TEST_TIME_UNIT ) == 0 );
+	TEST_CHECK( timestep.GetInterpolationAlpha() == 0.25f );
+	TEST_CHECK( timestep.Advance( 1.0 * TEST_TIME_UNIT ) == 0 );
+	TEST_CHECK( timestep.GetInterpolationAlpha() == 0.5f );
+	TEST_CHECK( timestep.Advance( 2.0 * TEST_TIME_UNIT ) == 1 );
+	TEST_CHECK( timestep.GetInterpolationAlpha() == 0.0f );
+	TEST_CHECK( timestep.Advance( 7.0 * TEST_TIME_UNIT ) == 1 );
+	TEST_CHECK( timestep.GetInterpolationAlpha() == 0.75f );
+
+	// Alpha always stays inside [0,1) over arbitrary frame times
+	int numAlphasOutOfRange = 0;
+	for ( int frameNum = 0; frameNum < 1000; frameNum++ )
+	{
+		timestep.Advance( 0.001 + 0.0137 * static_cast< double >( frameNum % 7 ) );
+		float alpha = timestep.GetInterpolationAlpha();
+		numAlphasOutOfRange += ( alpha >= 0.0f && alpha < 1.0f ) ? 0 : 1;
+	}
+	TEST_CHECK( numAlphasOutOfRange == 0 );
+
+	timestep.Reset();
+	TEST_CHECK( timestep.GetInterpolationAlpha() == 1.0f );
+	TEST_CHECK( timestep.GetTotalTicks() == 0 );
+	TEST_CHECK( timestep.Advance( 2.0 * TEST_TIME_UNIT ) == 0 );
+	TEST_CHECK( timestep.GetInterpolationAlpha() == 0.5f );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// A hitch runs at most m_maxTicksPerFrame ticks and drops the rest, but keeps the fraction of a tick
+// so alpha carries on smoothly; nothing is caught up on the frames after it
+//
+ENGINE_TEST( FixedTimestep_HitchIsClampedWithoutCatchUp )
+{
+	FixedTimestep timestep( MakeTestTimestepConfig() );
+
+	TEST_CHECK( timestep.Advance( 1.0 + 3.0 * TEST_TIME_UNIT ) == TEST_MAX_TICKS );
+	TEST_CHECK( timestep.GetInterpolationAlpha() == 0.75f );
+	TEST_CHECK( timestep.GetDroppedSeconds() == static_cast< double >( 64 - TEST_MAX_TICKS ) / TEST_TICKS_PER_SECOND );
+
+	TEST_CHECK( timestep.Advance( 0.0 ) == 0 );
+	TEST_CHECK( timestep.Advance( 1.0 * TEST_TIME_UNIT ) == 1 );
+	TEST_CHECK( timestep.GetInterpolationAlpha() == 0.0f );
+	TEST_CHECK( timestep.GetTotalTicks() == static_cast< uint64_t >( TEST_MAX_TICKS + 1 ) );
+
+	// Exactly the limit is not a hitch
+	TEST_CHECK( timestep.Advance( static_cast< double >( TEST_MAX_TICKS ) / TEST_TICKS_PER_SECOND ) == TEST_MAX_TICKS );
+	TEST_CHECK( timestep.GetDroppedSeconds() == static_cast< double >( 64 - TEST_MAX_TICKS ) / TEST_TICKS_PER_SECOND );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( FixedTimestep_DeterministicRunsOneTickPerFrame )
+{
+	FixedTimestep timestep( MakeTestTimestepConfig() );
+	timestep.Advance( 3.0 * TEST_TIME_UNIT );
+
+	timestep.SetDeterministic( true );
+	TEST_CHECK( timestep.Advance( 0.0 ) == 1 );
+	TEST_CHECK( timestep.Advance( 5.0 ) == 1 );
+	TEST_CHECK( timestep.GetInterpolationAlpha() == 1.0f );
+	TEST_CHECK( timestep.GetDroppedSeconds() == 0.0 );
+
+	// Leaving deterministic mode starts from an empty accumulator, not the time it ignored
+	timestep.SetDeterministic( false );
+	TEST_CHECK( timestep.Advance( 2.0 * TEST_TIME_UNIT ) == 0 );
+	TEST_CHECK( timestep.GetInterpolationAlpha() == 0.5f );
+	TEST_CHECK( timestep.GetTotalTicks() == 2 );
+}
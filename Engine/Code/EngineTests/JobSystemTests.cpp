@@ -0,0 +1,202 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Core/JobSystem.hpp"
+
+#include <atomic>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr double NESTED_JOB_SECONDS = 0.02;
+
+
+//-----------------------------------------------------------------------------------------------
+// Spins rather than sleeps so the time is spent inside the job the way real work would be
+//
+static void SpinForSeconds( double seconds )
+{
+	double endSeconds = GetCurrentTimeSeconds() + seconds;
+	while ( GetCurrentTimeSeconds() < endSeconds )
+	{
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static int GetTotalJobsExecuted( JobSystem const& jobSystem )
+{
+	int numJobs = 0;
+	std::vector<JobWorkerStats> const& stats = jobSystem.GetWorkerStats();
+	for ( int workerNum = 0; workerNum < static_cast< int >( stats.size() ); workerNum++ )
+	{
+		numJobs += stats[ workerNum ].m_numJobsExecuted;
+	}
+	return numJobs;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( JobSystem_CountsEveryJob )
+{
+	JobSystemConfig config;
+	config.m_numWorkerThreads = 3;
+	JobSystem jobSystem( config );
+	jobSystem.Startup();
+
+	constexpr int NUM_JOBS = 1000;
+	std::atomic<int> numRuns = { 0 };
+
+	std::vector<JobDecl> jobDecls( NUM_JOBS );
+	for ( int jobNum = 0; jobNum < NUM_JOBS; jobNum++ )
+	{
+		jobDecls[ jobNum ].m_jobData  = &numRuns;
+		jobDecls[ jobNum ].m_function = []( void* jobData )
+		{
+			static_cast< std::atomic<int>* >( jobData )->fetch_add( 1 );
+		};
+	}
+
+	jobSystem.BeginFrame();
+	JobCounter counter;
+	jobSystem.KickJobs( jobDecls.data(), NUM_JOBS, &counter );
+	jobSystem.WaitForCounter( counter );
+	jobSystem.BeginFrame();
+
+	TEST_CHECK( counter.IsDone() );
+	TEST_CHECK( numRuns.load() == NUM_JOBS );
+	TEST_CHECK( GetTotalJobsExecuted( jobSystem ) == NUM_JOBS );
+
+	jobSystem.Shutdown();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( JobSystem_ContinuationsRunAfterDependency )
+{
+	JobSystemConfig config;
+	config.m_numWorkerThreads = 2;
+	JobSystem jobSystem( config );
+	jobSystem.Startup();
+
+	struct OrderData
+	{
+		std::atomic<int>  m_numFirstDone          = { 0 };
+		std::atomic<bool> m_isContinuationInOrder = { false };
+	};
+	OrderData data;
+
+	JobDecl first;
+	first.m_jobData  = &data;
+	first.m_function = []( void* jobData )
+	{
+		SpinForSeconds( 0.005 );
+		static_cast< OrderData* >( jobData )->m_numFirstDone.fetch_add( 1 );
+	};
+
+	JobDecl continuation;
+	continuation.m_jobData  = &data;
+	continuation.m_function = []( void* jobData )
+	{
+		OrderData* orderData = static_cast< OrderData* >( jobData );
+		orderData->m_isContinuationInOrder = orderData->m_numFirstDone.load() == 4;
+	};
+
+	JobDecl firstJobs[ 4 ] = { first, first, first, first };
+	JobCounter firstCounter;
+	JobCounter allCounter;
+	jobSystem.KickJobs( firstJobs, 4, &firstCounter );
+	jobSystem.KickJobsAfter( firstCounter, &continuation, 1, &allCounter );
+	jobSystem.WaitForCounter( allCounter );
+
+	TEST_CHECK( data.m_isContinuationInOrder.load() );
+
+	jobSystem.Shutdown();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// With no worker threads every nested job runs inline on the main thread inside its parent. Busy
+// time must come out as the wall time of the parent, not parent plus children
+//
+ENGINE_TEST( JobSystem_NestedJobsAreNotDoubleCounted )
+{
+	JobSystemConfig config;
+	config.m_numWorkerThreads = 0;
+	JobSystem jobSystem( config );
+	jobSystem.Startup();
+
+	struct NestedData
+	{
+		JobSystem* m_jobSystem = nullptr;
+	};
+	NestedData data;
+	data.m_jobSystem = &jobSystem;
+
+	JobDecl outer;
+	outer.m_jobData  = &data;
+	outer.m_function = []( void* jobData )
+	{
+		JobSystem* nestedJobSystem = static_cast< NestedData* >( jobData )->m_jobSystem;
+		SpinForSeconds( NESTED_JOB_SECONDS );
+
+		JobDecl inner;
+		inner.m_function = []( void* )
+		{
+			SpinForSeconds( NESTED_JOB_SECONDS );
+		};
+		JobDecl innerJobs[ 2 ] = { inner, inner };
+
+		JobCounter innerCounter;
+		nestedJobSystem->KickJobs( innerJobs, 2, &innerCounter );
+		nestedJobSystem->WaitForCounter( innerCounter );
+	};
+
+	jobSystem.BeginFrame();
+	double startSeconds = GetCurrentTimeSeconds();
+
+	JobCounter counter;
+	jobSystem.KickJob( outer, &counter );
+	jobSystem.WaitForCounter( counter );
+
+	double wallSeconds = GetCurrentTimeSeconds() - startSeconds;
+	jobSystem.BeginFrame();
+
+	JobWorkerStats const& mainStats = jobSystem.GetWorkerStats()[ MAIN_THREAD_WORKER ];
+	TEST_CHECK( mainStats.m_numJobsExecuted == 3 );
+	TEST_CHECK( mainStats.m_busySeconds >= 3.0 * NESTED_JOB_SECONDS * 0.95 );
+	TEST_CHECK( mainStats.m_busySeconds <= wallSeconds + 0.001 );
+	TEST_CHECK( mainStats.m_utilization <= 1.0f );
+
+	jobSystem.Shutdown();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( JobSystem_ParallelForVisitsEachIndexOnce )
+{
+	JobSystemConfig config;
+	config.m_numWorkerThreads = 3;
+	JobSystem jobSystem( config );
+	jobSystem.Startup();
+
+	constexpr int NUM_INDICES = 10007;
+	std::vector< std::atomic<int> > visits( NUM_INDICES );
+	for ( int index = 0; index < NUM_INDICES; index++ )
+	{
+		visits[ index ] = 0;
+	}
+
+	jobSystem.ParallelFor( NUM_INDICES, 64, [ &visits ]( int index )
+	{
+		visits[ index ].fetch_add( 1 );
+	} );
+
+	int numWrongVisits = 0;
+	for ( int index = 0; index < NUM_INDICES; index++ )
+	{
+		numWrongVisits += visits[ index ].load() == 1 ? 0 : 1;
+	}
+	TEST_CHECK( numWrongVisits == 0 );
+
+	jobSystem.Shutdown();
+}
@@ -0,0 +1,165 @@
+#include "TestFramework.hpp"
+#include "Mat44ScalarReference.hpp"
+
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr int NUM_BENCH_MATRICES  = 1024;
+constexpr int NUM_BENCH_POSITIONS = 16384;
+constexpr int NUM_BENCH_PASSES    = 200;
+
+
+//-----------------------------------------------------------------------------------------------
+static std::vector< Mat44 > MakeBenchMatrices()
+{
+	srand( 7 );
+	RandomNumberGenerator rng;
+
+	std::vector< Mat44 > matrices( NUM_BENCH_MATRICES );
+	for ( int matrixNum = 0; matrixNum < NUM_BENCH_MATRICES; matrixNum++ )
+	{
+		matrices[ matrixNum ] = Mat44::CreateTranslation3D( Vec3( rng.GetRandomFloatInRange( -50.0f, 50.0f ), rng.GetRandomFloatInRange( -50.0f, 50.0f ), rng.GetRandomFloatInRange( -50.0f, 50.0f ) ) );
+		matrices[ matrixNum ].AppendZRotation( rng.GetRandomFloatInRange( -180.0f, 180.0f ) );
+		matrices[ matrixNum ].AppendXRotation( rng.GetRandomFloatInRange( -180.0f, 180.0f ) );
+		matrices[ matrixNum ].AppendScaleUniform3D( rng.GetRandomFloatInRange( 0.5f, 2.0f ) );
+	}
+	return matrices;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static std::vector< Vec3 > MakeBenchPositions()
+{
+	srand( 8 );
+	RandomNumberGenerator rng;
+
+	std::vector< Vec3 > positions( NUM_BENCH_POSITIONS );
+	for ( int positionNum = 0; positionNum < NUM_BENCH_POSITIONS; positionNum++ )
+	{
+		positions[ positionNum ] = Vec3( rng.GetRandomFloatInRange( -100.0f, 100.0f ), rng.GetRandomFloatInRange( -100.0f, 100.0f ), rng.GetRandomFloatInRange( -100.0f, 100.0f ) );
+	}
+	return positions;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Each "call" below is one pass over NUM_BENCH_MATRICES matrices or NUM_BENCH_POSITIONS positions. The
+// scalar calls also copy each matrix into and out of the reference wrapper, which favours SSE slightly
+//
+ENGINE_BENCHMARK( Mat44_SimdVersusScalar )
+{
+	std::vector< Mat44 > matrices  = MakeBenchMatrices();
+	std::vector< Vec3 >  positions = MakeBenchPositions();
+	std::vector< Mat44 > results( NUM_BENCH_MATRICES );
+
+	std::vector< float > matrixValues( NUM_BENCH_MATRICES * 16 );
+	for ( int matrixNum = 0; matrixNum < NUM_BENCH_MATRICES; matrixNum++ )
+	{
+		for ( int index = 0; index < 16; index++ )
+		{
+			matrixValues[ matrixNum * 16 + index ] = matrices[ matrixNum ].m_values[ index ];
+		}
+	}
+	std::vector< float > resultValues( NUM_BENCH_MATRICES * 16 );
+	Mat44 const parent = matrices[ 0 ];
+
+	bench.Measure( "Append x1024 (SSE)", NUM_BENCH_PASSES, [&]()
+	{
+		for ( int matrixNum = 0; matrixNum < NUM_BENCH_MATRICES; matrixNum++ )
+		{
+			results[ matrixNum ] = parent;
+			results[ matrixNum ].Append( matrices[ matrixNum ] );
+		}
+		DoNotOptimizeAway( results.data() );
+	} );
+	bench.Measure( "Append x1024 (scalar)", NUM_BENCH_PASSES, [&]()
+	{
+		for ( int matrixNum = 0; matrixNum < NUM_BENCH_MATRICES; matrixNum++ )
+		{
+			Mat44ScalarReference::Append( parent.m_values, matrixValues.data() + ( matrixNum * 16 ), resultValues.data() + ( matrixNum * 16 ) );
+		}
+		DoNotOptimizeAway( resultValues.data() );
+	} );
+
+	bench.Measure( "AppendArray x1024 (SSE)", NUM_BENCH_PASSES, [&]()
+	{
+		Mat44::AppendArray( parent, NUM_BENCH_MATRICES, matrices.data(), results.data() );
+		DoNotOptimizeAway( results.data() );
+	} );
+	bench.Measure( "AppendArray x1024 (scalar)", NUM_BENCH_PASSES, [&]()
+	{
+		Mat44ScalarReference::AppendArray( parent.m_values, NUM_BENCH_MATRICES, matrixValues.data(), resultValues.data() );
+		DoNotOptimizeAway( resultValues.data() );
+	} );
+
+	std::vector< Vec3 > transformed = positions;
+	bench.Measure( "TransformPosition3D x16384 (SSE)", NUM_BENCH_PASSES, [&]()
+	{
+		for ( int positionNum = 0; positionNum < NUM_BENCH_POSITIONS; positionNum++ )
+		{
+			transformed[ positionNum ] = parent.TransformPosition3D( positions[ positionNum ] );
+		}
+		DoNotOptimizeAway( transformed.data() );
+	} );
+	bench.Measure( "TransformPosition3D x16384 (scalar)", NUM_BENCH_PASSES, [&]()
+	{
+		for ( int positionNum = 0; positionNum < NUM_BENCH_POSITIONS; positionNum++ )
+		{
+			transformed[ positionNum ] = Mat44ScalarReference::TransformPosition3D( parent.m_values, positions[ positionNum ] );
+		}
+		DoNotOptimizeAway( transformed.data() );
+	} );
+
+	bench.Measure( "TransformPositionArray3D x16384 (SSE)", NUM_BENCH_PASSES, [&]()
+	{
+		transformed = positions;
+		parent.TransformPositionArray3D( NUM_BENCH_POSITIONS, transformed.data() );
+		DoNotOptimizeAway( transformed.data() );
+	} );
+	bench.Measure( "TransformPositionArray3D x16384 (scalar)", NUM_BENCH_PASSES, [&]()
+	{
+		transformed = positions;
+		Mat44ScalarReference::TransformPositionArray3D( parent.m_values, NUM_BENCH_POSITIONS, transformed.data() );
+		DoNotOptimizeAway( transformed.data() );
+	} );
+
+	bench.Measure( "GetOrthonormalInverse x1024 (SSE)", NUM_BENCH_PASSES, [&]()
+	{
+		for ( int matrixNum = 0; matrixNum < NUM_BENCH_MATRICES; matrixNum++ )
+		{
+			results[ matrixNum ] = matrices[ matrixNum ].GetOrthonormalInverse();
+		}
+		DoNotOptimizeAway( results.data() );
+	} );
+	bench.Measure( "GetOrthonormalInverse x1024 (scalar)", NUM_BENCH_PASSES, [&]()
+	{
+		for ( int matrixNum = 0; matrixNum < NUM_BENCH_MATRICES; matrixNum++ )
+		{
+			Mat44ScalarReference::GetOrthonormalInverse( matrixValues.data() + ( matrixNum * 16 ), resultValues.data() + ( matrixNum * 16 ) );
+		}
+		DoNotOptimizeAway( resultValues.data() );
+	} );
+
+	bench.Measure( "GetInverse x1024 (SSE)", NUM_BENCH_PASSES, [&]()
+	{
+		for ( int matrixNum = 0; matrixNum < NUM_BENCH_MATRICES; matrixNum++ )
+		{
+			results[ matrixNum ] = matrices[ matrixNum ].GetInverse();
+		}
+		DoNotOptimizeAway( results.data() );
+	} );
+	bench.Measure( "GetInverse x1024 (scalar)", NUM_BENCH_PASSES, [&]()
+	{
+		for ( int matrixNum = 0; matrixNum < NUM_BENCH_MATRICES; matrixNum++ )
+		{
+			Mat44ScalarReference::GetInverse( matrixValues.data() + ( matrixNum * 16 ), resultValues.data() + ( matrixNum * 16 ) );
+		}
+		DoNotOptimizeAway( resultValues.data() );
+	} );
+}
@@ -0,0 +1,91 @@
+//-----------------------------------------------------------------------------------------------
+// Compiles Engine/Math/Mat44.cpp a second time with SIMD disabled and the class renamed, so this
+// translation unit holds the scalar path while the engine library holds the SSE one
+//
+#define ENGINE_DISABLE_SIMD
+#define Mat44 Mat44Scalar
+#include "Engine/Math/Mat44.cpp"
+#undef Mat44
+
+#include "Mat44ScalarReference.hpp"
+
+#include <cstring>
+
+
+//-----------------------------------------------------------------------------------------------
+static void CopyValues( Mat44Scalar const& matrix, float* out_values )
+{
+	memcpy( out_values, matrix.m_values, sizeof( matrix.m_values ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Mat44ScalarReference::Append( float const* lhsValues, float const* rhsValues, float* out_values )
+{
+	Mat44Scalar result( lhsValues );
+	result.Append( Mat44Scalar( rhsValues ) );
+	CopyValues( result, out_values );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Mat44ScalarReference::AppendArray( float const* lhsValues, int numMatrices, float const* rhsValues, float* out_values )
+{
+	Mat44Scalar lhs( lhsValues );
+	for ( int matrixNum = 0; matrixNum < numMatrices; matrixNum++ )
+	{
+		Mat44Scalar rhs( rhsValues + ( matrixNum * 16 ) );
+		Mat44Scalar result;
+		Mat44Scalar::AppendArray( lhs, 1, &rhs, &result );
+		CopyValues( result, out_values + ( matrixNum * 16 ) );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec3 Mat44ScalarReference::TransformPosition3D( float const* values, Vec3 const& position )
+{
+	return Mat44Scalar( values ).TransformPosition3D( position );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec3 Mat44ScalarReference::TransformVectorQuantity3D( float const* values, Vec3 const& vectorQuantity )
+{
+	return Mat44Scalar( values ).TransformVectorQuantity3D( vectorQuantity );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec4 Mat44ScalarReference::TransformHomogeneous3D( float const* values, Vec4 const& homogeneousPoint )
+{
+	return Mat44Scalar( values ).TransformHomogeneous3D( homogeneousPoint );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Mat44ScalarReference::TransformPositionArray3D( float const* values, int numPositions, Vec3* positions )
+{
+	Mat44Scalar( values ).TransformPositionArray3D( numPositions, positions );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Mat44ScalarReference::TransformVectorQuantityArray3D( float const* values, int numVectors, Vec3* vectors )
+{
+	Mat44Scalar( values ).TransformVectorQuantityArray3D( numVectors, vectors );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Mat44ScalarReference::GetOrthonormalInverse( float const* values, float* out_values )
+{
+	CopyValues( Mat44Scalar( values ).GetOrthonormalInverse(), out_values );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Mat44ScalarReference::GetInverse( float const* values, float* out_values )
+{
+	CopyValues( Mat44Scalar( values ).GetInverse(), out_values );
+}
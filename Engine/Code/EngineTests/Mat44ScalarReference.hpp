@@ -0,0 +1,25 @@
+#pragma once
+//-----------------------------------------------------------------------------------------------
+// Mat44ScalarReference.hpp
+//
+// The ENGINE_DISABLE_SIMD build of Mat44.cpp, compiled into the test and bench executables beside the
+// engine's own (SSE) Mat44 so both paths can be run on the same input. Matrices are passed as their
+// sixteen basis major floats ( Mat44::m_values ) because the two classes cannot share a name.
+//
+struct Vec3;
+struct Vec4;
+
+
+//-----------------------------------------------------------------------------------------------
+namespace Mat44ScalarReference
+{
+	void Append( float const* lhsValues, float const* rhsValues, float* out_values );
+	void AppendArray( float const* lhsValues, int numMatrices, float const* rhsValues, float* out_values );
+	Vec3 TransformPosition3D( float const* values, Vec3 const& position );
+	Vec3 TransformVectorQuantity3D( float const* values, Vec3 const& vectorQuantity );
+	Vec4 TransformHomogeneous3D( float const* values, Vec4 const& homogeneousPoint );
+	void TransformPositionArray3D( float const* values, int numPositions, Vec3* positions );
+	void TransformVectorQuantityArray3D( float const* values, int numVectors, Vec3* vectors );
+	void GetOrthonormalInverse( float const* values, float* out_values );
+	void GetInverse( float const* values, float* out_values );
+}
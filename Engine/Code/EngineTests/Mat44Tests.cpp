@@ -0,0 +1,395 @@
+#include "TestFramework.hpp"
+#include "Mat44ScalarReference.hpp"
+
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/Vec4.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+// Both paths sum the same products in the same order, so they normally agree exactly; the epsilon
+// only leaves room for the compiler contracting or reordering the scalar path
+//
+constexpr float MAT44_RELATIVE_EPSILON = 1.0e-5f;
+constexpr int   NUM_RANDOM_MATRICES    = 500;
+constexpr int   NUM_RANDOM_VECTORS     = 64;
+
+
+//-----------------------------------------------------------------------------------------------
+static bool IsNearlyEqual( float actual, float expected )
+{
+	float tolerance = MAT44_RELATIVE_EPSILON * ( 1.0f + fabsf( expected ) );
+	return fabsf( actual - expected ) <= tolerance;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool AreNearlyEqual( float const* actualValues, float const* expectedValues, int numValues )
+{
+	for ( int index = 0; index < numValues; index++ )
+	{
+		if ( !IsNearlyEqual( actualValues[ index ], expectedValues[ index ] ) )
+			return false;
+	}
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool AreNearlyEqual( Vec3 const& actual, Vec3 const& expected )
+{
+	return IsNearlyEqual( actual.x, expected.x ) && IsNearlyEqual( actual.y, expected.y ) && IsNearlyEqual( actual.z, expected.z );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool AreNearlyEqual( Vec4 const& actual, Vec4 const& expected )
+{
+	return IsNearlyEqual( actual.x, expected.x ) && IsNearlyEqual( actual.y, expected.y ) && IsNearlyEqual( actual.z, expected.z ) && IsNearlyEqual( actual.w, expected.w );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static Mat44 MakeRandomMatrix( RandomNumberGenerator& rng, float range )
+{
+	Mat44 matrix;
+	for ( int index = 0; index < 16; index++ )
+	{
+		matrix.m_values[ index ] = rng.GetRandomFloatInRange( -range, range );
+	}
+	return matrix;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static Mat44 MakeRandomRigidTransform( RandomNumberGenerator& rng )
+{
+	Mat44 matrix = Mat44::CreateTranslation3D( Vec3( rng.GetRandomFloatInRange( -500.0f, 500.0f ), rng.GetRandomFloatInRange( -500.0f, 500.0f ), rng.GetRandomFloatInRange( -500.0f, 500.0f ) ) );
+	matrix.AppendZRotation( rng.GetRandomFloatInRange( -180.0f, 180.0f ) );
+	matrix.AppendYRotation( rng.GetRandomFloatInRange( -180.0f, 180.0f ) );
+	matrix.AppendXRotation( rng.GetRandomFloatInRange( -180.0f, 180.0f ) );
+	return matrix;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Zero, rank deficient, projective and badly scaled matrices; every one is a valid Append/transform input
+//
+static std::vector< Mat44 > MakeDegenerateMatrices()
+{
+	std::vector< Mat44 > matrices;
+
+	matrices.push_back( Mat44() );
+
+	Mat44 zero;
+	for ( int index = 0; index < 16; index++ )
+	{
+		zero.m_values[ index ] = 0.0f;
+	}
+	matrices.push_back( zero );
+
+	Mat44 flattened = Mat44::CreateNonUniformScale3D( Vec3( 1.0f, 1.0f, 0.0f ) );
+	matrices.push_back( flattened );
+
+	Mat44 duplicateColumns;
+	duplicateColumns.m_values[ Mat44::Jx ] = 1.0f;
+	duplicateColumns.m_values[ Mat44::Jy ] = 0.0f;
+	matrices.push_back( duplicateColumns );
+
+	matrices.push_back( Mat44::CreatePerspectiveProjection( 60.0f, 16.0f / 9.0f, 0.01f, 10000.0f ) );
+	matrices.push_back( Mat44::CreateOrthoProjection( -1000.0f, 1000.0f, -1000.0f, 1000.0f, 0.0f, 5000.0f ) );
+	matrices.push_back( Mat44::CreateNonUniformScale3D( Vec3( 1.0e6f, 1.0e-6f, 1.0f ) ) );
+	matrices.push_back( Mat44::CreateTranslation3D( Vec3( 1.0e7f, -1.0e7f, 1.0e7f ) ) );
+
+	return matrices;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Invertible, but with determinants far from 1 so rounding in the cofactor scale step shows up
+//
+static std::vector< Mat44 > MakeIllConditionedInvertibleMatrices()
+{
+	std::vector< Mat44 > matrices;
+
+	matrices.push_back( Mat44() );
+	matrices.push_back( Mat44::CreatePerspectiveProjection( 60.0f, 16.0f / 9.0f, 0.01f, 10000.0f ) );
+	matrices.push_back( Mat44::CreateOrthoProjection( -1000.0f, 1000.0f, -1000.0f, 1000.0f, 0.0f, 5000.0f ) );
+	matrices.push_back( Mat44::CreateUniformScale3D( 1.0e-3f ) );
+	matrices.push_back( Mat44::CreateNonUniformScale3D( Vec3( 1.0e3f, 1.0e-3f, 1.0f ) ) );
+
+	Mat44 nearlySingular;
+	nearlySingular.m_values[ Mat44::Jx ] = 1.0f;
+	nearlySingular.m_values[ Mat44::Jy ] = 1.0e-4f;
+	matrices.push_back( nearlySingular );
+
+	return matrices;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static std::vector< Mat44 > MakeTestMatrices( RandomNumberGenerator& rng )
+{
+	std::vector< Mat44 > matrices = MakeDegenerateMatrices();
+	for ( int matrixNum = 0; matrixNum < NUM_RANDOM_MATRICES; matrixNum++ )
+	{
+		matrices.push_back( MakeRandomMatrix( rng, 10.0f ) );
+		matrices.push_back( MakeRandomRigidTransform( rng ) );
+	}
+	return matrices;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static std::vector< float > FlattenMatrices( std::vector< Mat44 > const& matrices )
+{
+	std::vector< float > values;
+	values.reserve( matrices.size() * 16 );
+	for ( int matrixNum = 0; matrixNum < static_cast< int >( matrices.size() ); matrixNum++ )
+	{
+		values.insert( values.end(), matrices[ matrixNum ].m_values, matrices[ matrixNum ].m_values + 16 );
+	}
+	return values;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( Mat44_Append_MatchesScalarPath )
+{
+	srand( 1 );
+	RandomNumberGenerator rng;
+	std::vector< Mat44 > matrices = MakeTestMatrices( rng );
+
+	int numMismatches = 0;
+	for ( int lhsNum = 0; lhsNum < static_cast< int >( matrices.size() ); lhsNum++ )
+	{
+		Mat44 const& rhs = matrices[ ( lhsNum * 7 + 3 ) % static_cast< int >( matrices.size() ) ];
+
+		Mat44 simdResult = matrices[ lhsNum ];
+		simdResult.Append( rhs );
+
+		float scalarResult[ 16 ];
+		Mat44ScalarReference::Append( matrices[ lhsNum ].m_values, rhs.m_values, scalarResult );
+
+		if ( !AreNearlyEqual( simdResult.m_values, scalarResult, 16 ) )
+		{
+			numMismatches++;
+		}
+	}
+	TEST_CHECK( numMismatches == 0 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( Mat44_AppendArray_MatchesScalarPath )
+{
+	srand( 2 );
+	RandomNumberGenerator rng;
+	std::vector< Mat44 > matrices = MakeTestMatrices( rng );
+	std::vector< float > matrixValues = FlattenMatrices( matrices );
+	int numMatrices = static_cast< int >( matrices.size() );
+
+	std::vector< Mat44 > degenerateParents = MakeDegenerateMatrices();
+	degenerateParents.push_back( MakeRandomRigidTransform( rng ) );
+
+	for ( int parentNum = 0; parentNum < static_cast< int >( degenerateParents.size() ); parentNum++ )
+	{
+		Mat44 const& parent = degenerateParents[ parentNum ];
+
+		std::vector< Mat44 > simdResults( numMatrices );
+		Mat44::AppendArray( parent, numMatrices, matrices.data(), simdResults.data() );
+
+		std::vector< float > scalarResults( numMatrices * 16 );
+		Mat44ScalarReference::AppendArray( parent.m_values, numMatrices, matrixValues.data(), scalarResults.data() );
+
+		int numMismatches = 0;
+		for ( int matrixNum = 0; matrixNum < numMatrices; matrixNum++ )
+		{
+			if ( !AreNearlyEqual( simdResults[ matrixNum ].m_values, scalarResults.data() + ( matrixNum * 16 ), 16 ) )
+			{
+				numMismatches++;
+			}
+		}
+		TEST_CHECK( numMismatches == 0 );
+	}
+
+	// out aliasing rhs is documented as allowed
+	std::vector< Mat44 > inPlace = matrices;
+	Mat44::AppendArray( degenerateParents.back(), numMatrices, inPlace.data(), inPlace.data() );
+	std::vector< float > scalarResults( numMatrices * 16 );
+	Mat44ScalarReference::AppendArray( degenerateParents.back().m_values, numMatrices, matrixValues.data(), scalarResults.data() );
+	TEST_CHECK( AreNearlyEqual( FlattenMatrices( inPlace ).data(), scalarResults.data(), numMatrices * 16 ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( Mat44_Transform_MatchesScalarPath )
+{
+	srand( 3 );
+	RandomNumberGenerator rng;
+	std::vector< Mat44 > matrices = MakeTestMatrices( rng );
+
+	std::vector< Vec3 > inputs;
+	inputs.push_back( Vec3( 0.0f, 0.0f, 0.0f ) );
+	inputs.push_back( Vec3( 1.0e6f, -1.0e6f, 1.0e-6f ) );
+	for ( int vectorNum = 0; vectorNum < NUM_RANDOM_VECTORS; vectorNum++ )
+	{
+		inputs.push_back( Vec3( rng.GetRandomFloatInRange( -100.0f, 100.0f ), rng.GetRandomFloatInRange( -100.0f, 100.0f ), rng.GetRandomFloatInRange( -100.0f, 100.0f ) ) );
+	}
+	int numInputs = static_cast< int >( inputs.size() );
+
+	int numPositionMismatches    = 0;
+	int numVectorMismatches      = 0;
+	int numHomogeneousMismatches = 0;
+	int numArrayMismatches       = 0;
+
+	for ( int matrixNum = 0; matrixNum < static_cast< int >( matrices.size() ); matrixNum++ )
+	{
+		Mat44 const& matrix = matrices[ matrixNum ];
+
+		for ( int inputNum = 0; inputNum < numInputs; inputNum++ )
+		{
+			Vec3 const& input = inputs[ inputNum ];
+			Vec4 homogeneous( input.x, input.y, input.z, rng.GetRandomFloatInRange( -2.0f, 2.0f ) );
+
+			numPositionMismatches    += AreNearlyEqual( matrix.TransformPosition3D( input ), Mat44ScalarReference::TransformPosition3D( matrix.m_values, input ) ) ? 0 : 1;
+			numVectorMismatches      += AreNearlyEqual( matrix.TransformVectorQuantity3D( input ), Mat44ScalarReference::TransformVectorQuantity3D( matrix.m_values, input ) ) ? 0 : 1;
+			numHomogeneousMismatches += AreNearlyEqual( matrix.TransformHomogeneous3D( homogeneous ), Mat44ScalarReference::TransformHomogeneous3D( matrix.m_values, homogeneous ) ) ? 0 : 1;
+		}
+
+		std::vector< Vec3 > simdPositions   = inputs;
+		std::vector< Vec3 > scalarPositions = inputs;
+		matrix.TransformPositionArray3D( numInputs, simdPositions.data() );
+		Mat44ScalarReference::TransformPositionArray3D( matrix.m_values, numInputs, scalarPositions.data() );
+
+		std::vector< Vec3 > simdVectors   = inputs;
+		std::vector< Vec3 > scalarVectors = inputs;
+		matrix.TransformVectorQuantityArray3D( numInputs, simdVectors.data() );
+		Mat44ScalarReference::TransformVectorQuantityArray3D( matrix.m_values, numInputs, scalarVectors.data() );
+
+		for ( int inputNum = 0; inputNum < numInputs; inputNum++ )
+		{
+			numArrayMismatches += AreNearlyEqual( simdPositions[ inputNum ], scalarPositions[ inputNum ] ) ? 0 : 1;
+			numArrayMismatches += AreNearlyEqual( simdVectors[ inputNum ], scalarVectors[ inputNum ] ) ? 0 : 1;
+		}
+	}
+
+	TEST_CHECK( numPositionMismatches == 0 );
+	TEST_CHECK( numVectorMismatches == 0 );
+	TEST_CHECK( numHomogeneousMismatches == 0 );
+	TEST_CHECK( numArrayMismatches == 0 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( Mat44_TransformArray_HonorsStride )
+{
+	struct StridedVertex
+	{
+		Vec3  m_position;
+		float m_padding = 42.0f;
+	};
+
+	srand( 4 );
+	RandomNumberGenerator rng;
+	Mat44 matrix = MakeRandomRigidTransform( rng );
+
+	StridedVertex vertices[ 16 ];
+	for ( int vertexNum = 0; vertexNum < 16; vertexNum++ )
+	{
+		vertices[ vertexNum ].m_position = Vec3( rng.GetRandomFloatInRange( -10.0f, 10.0f ), rng.GetRandomFloatInRange( -10.0f, 10.0f ), rng.GetRandomFloatInRange( -10.0f, 10.0f ) );
+	}
+
+	StridedVertex transformed[ 16 ];
+	for ( int vertexNum = 0; vertexNum < 16; vertexNum++ )
+	{
+		transformed[ vertexNum ] = vertices[ vertexNum ];
+	}
+	matrix.TransformPositionArray3D( 16, &transformed[ 0 ].m_position, sizeof( StridedVertex ) );
+
+	for ( int vertexNum = 0; vertexNum < 16; vertexNum++ )
+	{
+		Vec3 expected = Mat44ScalarReference::TransformPosition3D( matrix.m_values, vertices[ vertexNum ].m_position );
+		TEST_CHECK( AreNearlyEqual( transformed[ vertexNum ].m_position, expected ) );
+		TEST_CHECK( transformed[ vertexNum ].m_padding == 42.0f );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( Mat44_OrthonormalInverse_MatchesScalarPath )
+{
+	srand( 5 );
+	RandomNumberGenerator rng;
+
+	// The orthonormal inverse is a transpose plus translation; it is defined for any input, degenerate or not
+	std::vector< Mat44 > matrices = MakeTestMatrices( rng );
+
+	int numMismatches = 0;
+	for ( int matrixNum = 0; matrixNum < static_cast< int >( matrices.size() ); matrixNum++ )
+	{
+		Mat44 simdInverse = matrices[ matrixNum ].GetOrthonormalInverse();
+
+		float scalarInverse[ 16 ];
+		Mat44ScalarReference::GetOrthonormalInverse( matrices[ matrixNum ].m_values, scalarInverse );
+
+		if ( !AreNearlyEqual( simdInverse.m_values, scalarInverse, 16 ) )
+		{
+			numMismatches++;
+		}
+	}
+	TEST_CHECK( numMismatches == 0 );
+
+	// And for rigid transforms it really is the inverse
+	Mat44 rigid = MakeRandomRigidTransform( rng );
+	Mat44 product = rigid;
+	product.Append( rigid.GetOrthonormalInverse() );
+	Mat44 identity;
+	for ( int index = 0; index < 16; index++ )
+	{
+		TEST_CHECK_NEAR( product.m_values[ index ], identity.m_values[ index ], 1.0e-3f );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Singular matrices are not covered: GetInverse dies on them by design in both paths
+//
+ENGINE_TEST( Mat44_Inverse_MatchesScalarPath )
+{
+	srand( 6 );
+	RandomNumberGenerator rng;
+
+	std::vector< Mat44 > matrices = MakeIllConditionedInvertibleMatrices();
+	for ( int matrixNum = 0; matrixNum < NUM_RANDOM_MATRICES; matrixNum++ )
+	{
+		// Keep the random set away from singular; the ill conditioned cases above cover that end
+		Mat44 random = MakeRandomMatrix( rng, 10.0f );
+		random.m_values[ Mat44::Ix ] += 40.0f;
+		random.m_values[ Mat44::Jy ] += 40.0f;
+		random.m_values[ Mat44::Kz ] += 40.0f;
+		random.m_values[ Mat44::Tw ] += 40.0f;
+		matrices.push_back( random );
+		matrices.push_back( MakeRandomRigidTransform( rng ) );
+	}
+
+	int numMismatches = 0;
+	for ( int matrixNum = 0; matrixNum < static_cast< int >( matrices.size() ); matrixNum++ )
+	{
+		Mat44 simdInverse = matrices[ matrixNum ].GetInverse();
+
+		float scalarInverse[ 16 ];
+		Mat44ScalarReference::GetInverse( matrices[ matrixNum ].m_values, scalarInverse );
+
+		if ( !AreNearlyEqual( simdInverse.m_values, scalarInverse, 16 ) )
+		{
+			numMismatches++;
+		}
+	}
+	TEST_CHECK( numMismatches == 0 );
+}
@@ -0,0 +1,94 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr int     NUM_BENCH_CALLS = 1000000;
+constexpr int     NUM_BENCH_FIRES = 200000;
+constexpr EventID BENCH_KEY_EVENT = HashEventName( "EngineBench_KeyPressed" );
+
+
+//-----------------------------------------------------------------------------------------------
+static int s_benchKeyValueSum = 0;
+
+
+//-----------------------------------------------------------------------------------------------
+static bool OnBenchKeyPressed( EventArgs& args )
+{
+	s_benchKeyValueSum += args.GetValue( "KeyValue", 0 );
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Typed values, console style text read back as a number, and the event hot path that builds four
+// typed args per fire
+//
+ENGINE_BENCHMARK( NamedStrings_GetSetAndEventFire )
+{
+	NamedStrings values;
+	values.SetValue( "count", 7 );
+	values.SetValue( "scale", 0.5f );
+	values.SetValue( "position", Vec3( 1.0f, 2.0f, 3.0f ) );
+	values.SetValue( "rate", "120" );
+	values.SetValue( "offset", "1.5,2,-3" );
+	values.SetValue( "tint", "255,128,0,255" );
+
+	int intSum = 0;
+	bench.Measure( "SetValue( int ) + GetValue( int )", NUM_BENCH_CALLS, [&]()
+	{
+		values.SetValue( "count", intSum & 0xff );
+		intSum += values.GetValue( "count", 0 );
+	} );
+	DoNotOptimizeAway( &intSum );
+
+	Vec3 vec3Sum;
+	bench.Measure( "GetValue( Vec3 ) from a typed value", NUM_BENCH_CALLS, [&]()
+	{
+		vec3Sum += values.GetValue( "position", Vec3() );
+	} );
+	DoNotOptimizeAway( &vec3Sum );
+
+	bench.Measure( "GetValue( int ) from text", NUM_BENCH_CALLS, [&]()
+	{
+		intSum += values.GetValue( "rate", 0 );
+	} );
+	DoNotOptimizeAway( &intSum );
+
+	bench.Measure( "GetValue( Vec3 ) from text", NUM_BENCH_CALLS, [&]()
+	{
+		vec3Sum += values.GetValue( "offset", Vec3() );
+	} );
+	DoNotOptimizeAway( &vec3Sum );
+
+	unsigned int alphaSum = 0;
+	bench.Measure( "GetValue( Rgba8 ) from text", NUM_BENCH_CALLS, [&]()
+	{
+		alphaSum += values.GetValue( "tint", Rgba8() ).a;
+	} );
+	DoNotOptimizeAway( &alphaSum );
+
+	EventSystemConfig config;
+	EventSystem eventSystem( config );
+	eventSystem.Startup();
+	eventSystem.SubscribeEventCallbackFunction( "EngineBench_KeyPressed", &OnBenchKeyPressed );
+
+	s_benchKeyValueSum = 0;
+	int fireNum = 0;
+	bench.Measure( "Build four typed args + FireEvent by id", NUM_BENCH_FIRES, [&]()
+	{
+		EventArgs args;
+		args.SetValue( "KeyValue", fireNum++ );
+		args.SetValue( "IsRepeat", false );
+		args.SetValue( "Scale", 1.5f );
+		args.SetValue( "Position", Vec3( 1.0f, 2.0f, 3.0f ) );
+		eventSystem.FireEvent( BENCH_KEY_EVENT, args );
+	} );
+	DoNotOptimizeAway( &s_benchKeyValueSum );
+
+	eventSystem.Shutdown();
+}
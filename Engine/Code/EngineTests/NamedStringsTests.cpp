@@ -0,0 +1,142 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/FrameArena.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <cstdio>
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr int     NUM_HOT_PATH_FIRES = 1000;
+constexpr EventID TEST_KEY_EVENT     = HashEventName( "EngineTests_KeyPressed" );
+
+
+//-----------------------------------------------------------------------------------------------
+static int s_keyValueSum = 0;
+
+
+//-----------------------------------------------------------------------------------------------
+static bool OnTestKeyPressed( EventArgs& args )
+{
+	s_keyValueSum += args.GetValue( "KeyValue", 0 );
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( NamedStrings_TypedValuesRoundTrip )
+{
+	NamedStrings values;
+	values.SetValue( "count", 7 );
+	values.SetValue( "scale", 0.5f );
+	values.SetValue( "visible", true );
+	values.SetValue( "position", Vec3( 1.0f, 2.0f, 3.0f ) );
+	values.SetValue( "tint", Rgba8( 10, 20, 30, 40 ) );
+	values.SetValue( "name", "lamp" );
+
+	TEST_CHECK( values.GetNumValues() == 6 );
+	TEST_CHECK( values.GetValue( "count", 0 ) == 7 );
+	TEST_CHECK( values.GetValue( "scale", 0.0f ) == 0.5f );
+	TEST_CHECK( values.GetValue( "visible", false ) );
+	TEST_CHECK( values.GetValue( "position", Vec3() ) == Vec3( 1.0f, 2.0f, 3.0f ) );
+	TEST_CHECK( values.GetValue( "tint", Rgba8() ) == Rgba8( 10, 20, 30, 40 ) );
+	TEST_CHECK( values.GetValue( "name", "" ) == "lamp" );
+	TEST_CHECK( values.GetValue( "missing", 3 ) == 3 );
+
+	// Numeric types convert directly, and setting a key again replaces its value
+	TEST_CHECK( values.GetValue( "count", 0.0f ) == 7.0f );
+	values.SetValue( "count", 9 );
+	TEST_CHECK( values.GetValue( "count", 0 ) == 9 );
+	TEST_CHECK( values.GetNumValues() == 6 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Text only gets parsed when read as another type, which is the dev console path
+//
+ENGINE_TEST( NamedStrings_TextIsParsedOnTypedRead )
+{
+	NamedStrings values;
+	values.SetValue( "rate", std::string( "120" ) );
+	values.SetValue( "enabled", std::string( "true" ) );
+
+	TEST_CHECK( values.GetValue( "rate", 0 ) == 120 );
+	TEST_CHECK( values.GetValue( "rate", 0.0f ) == 120.0f );
+	TEST_CHECK( values.GetValue( "enabled", false ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Text keeps its last parse, so alternating reads, rereads and sets must never return a stale value
+//
+ENGINE_TEST( NamedStrings_ParsedTextFollowsTheText )
+{
+	NamedStrings values;
+	values.SetValue( "rate", "120" );
+	values.SetValue( "offset", "1.5,2,-3" );
+
+	TEST_CHECK( values.GetValue( "rate", 0 ) == 120 );
+	TEST_CHECK( values.GetValue( "rate", 0 ) == 120 );
+	TEST_CHECK( values.GetValue( "rate", 0.0f ) == 120.0f );
+	TEST_CHECK( values.GetValue( "rate", 0 ) == 120 );
+	TEST_CHECK( values.GetValue( "rate", "" ) == "120" );
+	TEST_CHECK( values.GetValue( "offset", Vec3() ) == Vec3( 1.5f, 2.0f, -3.0f ) );
+	TEST_CHECK( values.GetValue( "offset", Vec3() ) == Vec3( 1.5f, 2.0f, -3.0f ) );
+
+	values.SetValue( "rate", std::string( "60" ) );
+	TEST_CHECK( values.GetValue( "rate", 0 ) == 60 );
+	values.SetValue( "rate", 30 );
+	TEST_CHECK( values.GetValue( "rate", 0 ) == 30 );
+	values.SetValue( "rate", "15" );
+	TEST_CHECK( values.GetValue( "rate", 0 ) == 15 );
+	TEST_CHECK( values.GetValue( "rate", "" ) == "15" );
+
+	// Copies carry the parse along with the text
+	NamedStrings copy = values;
+	TEST_CHECK( copy.GetValue( "rate", 0 ) == 15 );
+	TEST_CHECK( copy.GetValue( "offset", Vec3() ) == Vec3( 1.5f, 2.0f, -3.0f ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// The event hot path: build args with a few typed values, fire by id, read them in the callback.
+// Only meaningful where ENGINE_TRACK_HEAP_ALLOCATIONS counts operator new ( debug builds )
+//
+ENGINE_TEST( NamedStrings_EventFireDoesNotAllocate )
+{
+	EventSystemConfig config;
+	EventSystem eventSystem( config );
+	eventSystem.Startup();
+	eventSystem.SubscribeEventCallbackFunction( "EngineTests_KeyPressed", &OnTestKeyPressed );
+
+	s_keyValueSum = 0;
+	int expectedSum = 0;
+
+	HeapAllocationScope fireScope;
+	for ( int fireNum = 0; fireNum < NUM_HOT_PATH_FIRES; fireNum++ )
+	{
+		EventArgs args;
+		args.SetValue( "KeyValue", fireNum );
+		args.SetValue( "IsRepeat", false );
+		args.SetValue( "Scale", 1.5f );
+		args.SetValue( "Position", Vec3( 1.0f, 2.0f, 3.0f ) );
+		eventSystem.FireEvent( TEST_KEY_EVENT, args );
+		expectedSum += fireNum;
+	}
+	int numAllocations = fireScope.GetNumAllocations();
+
+	TEST_CHECK( s_keyValueSum == expectedSum );
+
+#if defined(ENGINE_TRACK_HEAP_ALLOCATIONS)
+	printf( "    %d heap allocations over %d fires\n", numAllocations, NUM_HOT_PATH_FIRES );
+	TEST_CHECK( numAllocations == 0 );
+#else
+	UNUSED( numAllocations );
+	printf( "    skipped the allocation count: ENGINE_TRACK_HEAP_ALLOCATIONS is off in this build\n" );
+#endif
+
+	eventSystem.Shutdown();
+}
@@ -0,0 +1,264 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Renderer/VertexData/Vertex_PackedPUTBN.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+
+//-----------------------------------------------------------------------------------------------
+// Half floats keep 11 significant bits, so rounding to nearest is off by at most 2^-11 relative.
+// Octahedral snorm16 vectors land within a few thousandths of a degree; the bound leaves headroom
+//
+constexpr float HALF_RELATIVE_EPSILON      = 1.0f / 2048.0f;
+constexpr float MAX_OCTAHEDRAL_ERROR_DEG   = 0.01f;
+constexpr float MAX_UNQUANTIZED_ERROR_DEG  = 0.001f;
+constexpr int   NUM_RANDOM_VECTORS         = 5000;
+
+
+//-----------------------------------------------------------------------------------------------
+// acos of a float dot product can't resolve angles under about 0.03 degrees; atan2 of the cross and dot can
+//
+static float GetAngleBetweenDegrees( Vec3 const& a, Vec3 const& b )
+{
+	Vec3 unitA = a.GetNormalized();
+	Vec3 unitB = b.GetNormalized();
+	return ConvertRadiansToDegrees( atan2f( CrossProduct3D( unitA, unitB ).GetLength(), DotProduct3D( unitA, unitB ) ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static Vec3 MakeRandomUnitVector( RandomNumberGenerator& rng )
+{
+	for ( ;; )
+	{
+		Vec3 candidate( rng.GetRandomFloatInRange( -1.0f, 1.0f ), rng.GetRandomFloatInRange( -1.0f, 1.0f ), rng.GetRandomFloatInRange( -1.0f, 1.0f ) );
+		float lengthSquared = candidate.GetLengthSquared();
+		if ( lengthSquared > 0.01f && lengthSquared <= 1.0f )
+			return candidate.GetNormalized();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static Vertex_PCUTBN MakeVertex( Vec3 const& position, Vec2 const& uv, Vec3 const& tangent, Vec3 const& normal, float bitangentSign )
+{
+	Vec3 binormal = CrossProduct3D( normal, tangent ) * bitangentSign;
+	return Vertex_PCUTBN( position, Rgba8::WHITE, uv, tangent, binormal, normal );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( HalfFloat_ExactValuesRoundTrip )
+{
+	float const exactValues[] = { 0.0f, 1.0f, -2.0f, 0.5f, 0.333984375f, 1024.0f, 65504.0f, -65504.0f, ldexpf( 1.0f, -14 ) };
+	for ( float value : exactValues )
+	{
+		TEST_CHECK( HalfToFloat( FloatToHalf( value ) ) == value );
+	}
+
+	TEST_CHECK( FloatToHalf( 1.0f ) == 0x3C00 );
+	TEST_CHECK( FloatToHalf( -2.0f ) == 0xC000 );
+	TEST_CHECK( FloatToHalf( 65504.0f ) == 0x7BFF );
+	TEST_CHECK( FloatToHalf( -0.0f ) == 0x8000 );
+	TEST_CHECK( std::signbit( HalfToFloat( 0x8000 ) ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Below 2^-14 halves lose precision one bit at a time down to the smallest denormal, 2^-24
+//
+ENGINE_TEST( HalfFloat_Denormals )
+{
+	float smallestDenormal = ldexpf( 1.0f, -24 );
+	float largestDenormal  = ldexpf( 1023.0f, -24 );
+
+	TEST_CHECK( FloatToHalf( smallestDenormal ) == 0x0001 );
+	TEST_CHECK( FloatToHalf( largestDenormal ) == 0x03FF );
+	TEST_CHECK( FloatToHalf( -smallestDenormal ) == 0x8001 );
+	TEST_CHECK( HalfToFloat( 0x0001 ) == smallestDenormal );
+	TEST_CHECK( HalfToFloat( 0x03FF ) == largestDenormal );
+	TEST_CHECK( HalfToFloat( 0x0200 ) == ldexpf( 1.0f, -15 ) );
+
+	for ( int mantissa = 1; mantissa < 1024; mantissa++ )
+	{
+		float value = ldexpf( static_cast< float >( mantissa ), -24 );
+		TEST_CHECK( FloatToHalf( value ) == mantissa );
+	}
+
+	// Half of the smallest denormal rounds away from zero, anything well under it flushes to zero
+	TEST_CHECK( FloatToHalf( ldexpf( 1.0f, -25 ) * 1.5f ) == 0x0001 );
+	TEST_CHECK( FloatToHalf( 1.0e-10f ) == 0x0000 );
+	TEST_CHECK( FloatToHalf( -1.0e-10f ) == 0x8000 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( HalfFloat_InfinityAndNaN )
+{
+	float infinity = std::numeric_limits<float>::infinity();
+
+	TEST_CHECK( FloatToHalf( infinity ) == 0x7C00 );
+	TEST_CHECK( FloatToHalf( -infinity ) == 0xFC00 );
+	TEST_CHECK( HalfToFloat( 0x7C00 ) == infinity );
+	TEST_CHECK( HalfToFloat( 0xFC00 ) == -infinity );
+
+	// Past the largest half the value overflows to infinity rather than wrapping
+	TEST_CHECK( FloatToHalf( 65536.0f ) == 0x7C00 );
+	TEST_CHECK( FloatToHalf( -1.0e9f ) == 0xFC00 );
+
+	float nan = HalfToFloat( FloatToHalf( std::numeric_limits<float>::quiet_NaN() ) );
+	TEST_CHECK( nan != nan );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( HalfFloat_RoundingStaysWithinHalfAnUlp )
+{
+	RandomNumberGenerator rng;
+	int numOutOfBounds = 0;
+	for ( int valueNum = 0; valueNum < NUM_RANDOM_VECTORS; valueNum++ )
+	{
+		float value = rng.GetRandomFloatInRange( -4000.0f, 4000.0f );
+		if ( fabsf( value ) < ldexpf( 1.0f, -14 ) )
+			continue;
+
+		float roundTrip = HalfToFloat( FloatToHalf( value ) );
+		if ( fabsf( roundTrip - value ) > fabsf( value ) * HALF_RELATIVE_EPSILON )
+		{
+			numOutOfBounds++;
+		}
+	}
+	TEST_CHECK( numOutOfBounds == 0 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( Octahedral_RoundTripKeepsDirection )
+{
+	Vec3 const axes[] = { Vec3( 1.0f, 0.0f, 0.0f ), Vec3( -1.0f, 0.0f, 0.0f ), Vec3( 0.0f, 1.0f, 0.0f ), Vec3( 0.0f, -1.0f, 0.0f ), Vec3( 0.0f, 0.0f, 1.0f ), Vec3( 0.0f, 0.0f, -1.0f ) };
+	for ( Vec3 const& axis : axes )
+	{
+		TEST_CHECK( GetAngleBetweenDegrees( DecodeOctahedral( EncodeOctahedral( axis ) ), axis ) <= MAX_UNQUANTIZED_ERROR_DEG );
+	}
+
+	RandomNumberGenerator rng;
+	float maxErrorDegrees = 0.0f;
+	bool  encodedInSquare = true;
+	for ( int vectorNum = 0; vectorNum < NUM_RANDOM_VECTORS; vectorNum++ )
+	{
+		Vec3 direction = MakeRandomUnitVector( rng );
+		Vec2 encoded   = EncodeOctahedral( direction );
+		encodedInSquare = encodedInSquare && fabsf( encoded.x ) <= 1.0f && fabsf( encoded.y ) <= 1.0f;
+
+		maxErrorDegrees = std::max( maxErrorDegrees, GetAngleBetweenDegrees( DecodeOctahedral( encoded ), direction ) );
+	}
+	printf( "    max error %.6f degrees\n", maxErrorDegrees );
+	TEST_CHECK( encodedInSquare );
+	TEST_CHECK( maxErrorDegrees <= MAX_UNQUANTIZED_ERROR_DEG );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Position within half a unorm16 step of the bounds, uvs as exact as a half allows, tangent frame
+// within the octahedral bound, and the handedness carried through the position's w
+//
+ENGINE_TEST( PackedVertex_RoundTripWithinQuantizationError )
+{
+	AABB3 bounds( Vec3( -12.0f, -3.0f, 0.0f ), Vec3( 20.0f, 5.0f, 40.0f ) );
+	Vec3  extent = bounds.m_maxs - bounds.m_mins;
+	Vec3  maxPositionError = extent * ( 0.5f / 65535.0f ) + Vec3( 1.0e-5f, 1.0e-5f, 1.0e-5f );
+
+	RandomNumberGenerator rng;
+	int   numBadPositions  = 0;
+	int   numBadUVs        = 0;
+	int   numBadSigns      = 0;
+	float maxFrameErrorDeg = 0.0f;
+
+	for ( int vertNum = 0; vertNum < NUM_RANDOM_VECTORS; vertNum++ )
+	{
+		Vec3 position( rng.GetRandomFloatInRange( bounds.m_mins.x, bounds.m_maxs.x ), rng.GetRandomFloatInRange( bounds.m_mins.y, bounds.m_maxs.y ), rng.GetRandomFloatInRange( bounds.m_mins.z, bounds.m_maxs.z ) );
+		Vec2 uv( rng.GetRandomFloatInRange( -4.0f, 8.0f ), rng.GetRandomFloatInRange( -4.0f, 8.0f ) );
+
+		Vec3 normal  = MakeRandomUnitVector( rng );
+		Vec3 tangent = CrossProduct3D( normal, MakeRandomUnitVector( rng ) ).GetNormalized();
+		float bitangentSign = ( vertNum & 1 ) != 0 ? 1.0f : -1.0f;
+
+		Vertex_PCUTBN original = MakeVertex( position, uv, tangent, normal, bitangentSign );
+		Vertex_PCUTBN decoded  = Vertex_PackedPUTBN::Encode( original, bounds ).Decode( bounds );
+
+		Vec3 positionError = decoded.m_position - original.m_position;
+		if ( fabsf( positionError.x ) > maxPositionError.x || fabsf( positionError.y ) > maxPositionError.y || fabsf( positionError.z ) > maxPositionError.z )
+		{
+			numBadPositions++;
+		}
+
+		if ( fabsf( decoded.m_uvTexCoords.x - uv.x ) > fabsf( uv.x ) * HALF_RELATIVE_EPSILON + 1.0e-6f ||
+			 fabsf( decoded.m_uvTexCoords.y - uv.y ) > fabsf( uv.y ) * HALF_RELATIVE_EPSILON + 1.0e-6f )
+		{
+			numBadUVs++;
+		}
+
+		if ( DotProduct3D( decoded.m_binormal, original.m_binormal ) <= 0.0f )
+		{
+			numBadSigns++;
+		}
+
+		maxFrameErrorDeg = std::max( maxFrameErrorDeg, GetAngleBetweenDegrees( decoded.m_normal, normal ) );
+		maxFrameErrorDeg = std::max( maxFrameErrorDeg, GetAngleBetweenDegrees( decoded.m_tangent, tangent ) );
+		maxFrameErrorDeg = std::max( maxFrameErrorDeg, GetAngleBetweenDegrees( decoded.m_binormal, original.m_binormal ) );
+	}
+
+	printf( "    max tangent frame error %.6f degrees\n", maxFrameErrorDeg );
+	TEST_CHECK( numBadPositions == 0 );
+	TEST_CHECK( numBadUVs == 0 );
+	TEST_CHECK( numBadSigns == 0 );
+	TEST_CHECK( maxFrameErrorDeg <= MAX_OCTAHEDRAL_ERROR_DEG );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Mirrored uv islands flip the bitangent; the sign has to survive even though the packed binormal
+// itself is rebuilt from the normal and tangent
+//
+ENGINE_TEST( PackedVertex_KeepsTangentHandedness )
+{
+	AABB3 bounds( Vec3( 0.0f, 0.0f, 0.0f ), Vec3( 1.0f, 1.0f, 1.0f ) );
+	Vec3  normal( 0.0f, 0.0f, 1.0f );
+	Vec3  tangent( 1.0f, 0.0f, 0.0f );
+
+	Vertex_PCUTBN rightHanded = MakeVertex( Vec3( 0.5f, 0.5f, 0.5f ), Vec2( 0.25f, 0.75f ), tangent, normal, 1.0f );
+	Vertex_PCUTBN leftHanded  = MakeVertex( Vec3( 0.5f, 0.5f, 0.5f ), Vec2( 0.25f, 0.75f ), tangent, normal, -1.0f );
+
+	Vertex_PackedPUTBN packedRight = Vertex_PackedPUTBN::Encode( rightHanded, bounds );
+	Vertex_PackedPUTBN packedLeft  = Vertex_PackedPUTBN::Encode( leftHanded, bounds );
+	TEST_CHECK( packedRight.m_position.m_position[ 3 ] == 0xFFFF );
+	TEST_CHECK( packedLeft.m_position.m_position[ 3 ] == 0 );
+
+	Vec3 decodedRight = packedRight.Decode( bounds ).m_binormal;
+	Vec3 decodedLeft  = packedLeft.Decode( bounds ).m_binormal;
+	TEST_CHECK_NEAR( decodedRight.y, 1.0, 1.0e-4 );
+	TEST_CHECK_NEAR( decodedLeft.y, -1.0, 1.0e-4 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Tiling and offset uvs routinely leave [0,1]; halves hold them exactly when they are representable
+//
+ENGINE_TEST( PackedVertex_KeepsUVsOutsideUnitRange )
+{
+	AABB3 bounds( Vec3( 0.0f, 0.0f, 0.0f ), Vec3( 1.0f, 1.0f, 1.0f ) );
+	Vec2 const uvs[] = { Vec2( -1.25f, 3.5f ), Vec2( 16.0f, -0.0625f ), Vec2( 1.0f, 0.0f ), Vec2( -2048.0f, 1000.5f ) };
+
+	for ( Vec2 const& uv : uvs )
+	{
+		Vertex_PCUTBN vertex  = MakeVertex( Vec3( 0.0f, 0.0f, 0.0f ), uv, Vec3( 1.0f, 0.0f, 0.0f ), Vec3( 0.0f, 0.0f, 1.0f ), 1.0f );
+		Vertex_PCUTBN decoded = Vertex_PackedPUTBN::Encode( vertex, bounds ).Decode( bounds );
+		TEST_CHECK( decoded.m_uvTexCoords.x == uv.x && decoded.m_uvTexCoords.y == uv.y );
+	}
+}
@@ -0,0 +1,88 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Renderer/RenderQueue.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr int NUM_BENCH_ITEMS     = 4096;
+constexpr int NUM_BENCH_SHADERS   = 4;
+constexpr int NUM_BENCH_MATERIALS = 32;
+constexpr int NUM_BENCH_MESHES    = 256;
+constexpr int NUM_BENCH_FRAMES    = 500;
+
+
+//-----------------------------------------------------------------------------------------------
+// Roughly the main view of a large scene: a few shaders, tens of materials and hundreds of meshes in
+// random submission order. Only pointers are compared, so tags stand in for GPU objects
+//
+static std::vector< RenderQueueItem > MakeBenchItems()
+{
+	srand( 11 );
+
+	std::vector< RenderQueueItem > items( NUM_BENCH_ITEMS );
+	for ( int itemNum = 0; itemNum < NUM_BENCH_ITEMS; itemNum++ )
+	{
+		RenderQueueItem& item = items[ itemNum ];
+		item.m_shader         = reinterpret_cast< Shader* >( static_cast< uintptr_t >( 0x1000 + ( rand() % NUM_BENCH_SHADERS ) * 0x10 ) );
+		item.m_diffuseTexture = reinterpret_cast< Texture const* >( static_cast< uintptr_t >( 0x2000 + ( rand() % NUM_BENCH_MATERIALS ) * 0x10 ) );
+		item.m_vbo            = reinterpret_cast< VertexBuffer const* >( static_cast< uintptr_t >( 0x10000 + ( rand() % NUM_BENCH_MESHES ) * 0x10 ) );
+		item.m_depth          = static_cast< float >( rand() ) / static_cast< float >( RAND_MAX );
+	}
+	return items;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Every call refills the queue the way a frame does, so the sort never sees already sorted input. The
+// std::stable_sort call also copies the keys out first, which favours the radix sort slightly
+//
+ENGINE_BENCHMARK( RenderQueue_RadixVersusStableSort )
+{
+	std::vector< RenderQueueItem > items = MakeBenchItems();
+	RenderQueue queue;
+
+	bench.Measure( "Add 4096 items", NUM_BENCH_FRAMES, [&]()
+	{
+		queue.Reset();
+		for ( RenderQueueItem const& item : items )
+		{
+			queue.AddItem( item );
+		}
+		DoNotOptimizeAway( &queue );
+	} );
+
+	bench.Measure( "Add 4096 items, radix sort", NUM_BENCH_FRAMES, [&]()
+	{
+		queue.Reset();
+		for ( RenderQueueItem const& item : items )
+		{
+			queue.AddItem( item );
+		}
+		queue.SortItems();
+		DoNotOptimizeAway( &queue );
+	} );
+
+	std::vector< std::pair< uint64_t, int > > keys( NUM_BENCH_ITEMS );
+	bench.Measure( "Add 4096 items, std::stable_sort", NUM_BENCH_FRAMES, [&]()
+	{
+		queue.Reset();
+		for ( RenderQueueItem const& item : items )
+		{
+			queue.AddItem( item );
+		}
+		for ( int itemNum = 0; itemNum < NUM_BENCH_ITEMS; itemNum++ )
+		{
+			keys[ itemNum ] = std::make_pair( queue.GetSortedKey( itemNum ), itemNum );
+		}
+		std::stable_sort( keys.begin(), keys.end(), []( std::pair< uint64_t, int > const& a, std::pair< uint64_t, int > const& b )
+		{
+			return a.first < b.first;
+		} );
+		DoNotOptimizeAway( keys.data() );
+	} );
+}
@@ -0,0 +1,173 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Renderer/RenderQueue.hpp"
+
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+// Items are only sorted here, never submitted, so tags stand in for real GPU objects
+//
+static Shader*             const FAKE_SHADER_A = reinterpret_cast< Shader* >( 0x10 );
+static Shader*             const FAKE_SHADER_B = reinterpret_cast< Shader* >( 0x20 );
+static Texture const*      const FAKE_TEXTURE  = reinterpret_cast< Texture const* >( 0x30 );
+static VertexBuffer const* const FAKE_VBO_A    = reinterpret_cast< VertexBuffer const* >( 0x40 );
+static VertexBuffer const* const FAKE_VBO_B    = reinterpret_cast< VertexBuffer const* >( 0x50 );
+
+
+//-----------------------------------------------------------------------------------------------
+static RenderQueueItem MakeItem( Shader* shader, VertexBuffer const* vbo, uint8_t layer, float depth, int tag )
+{
+	RenderQueueItem item;
+	item.m_shader         = shader;
+	item.m_diffuseTexture = FAKE_TEXTURE;
+	item.m_vbo            = vbo;
+	item.m_layer          = layer;
+	item.m_depth          = depth;
+	item.m_count          = tag;
+	return item;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool AreKeysSorted( RenderQueue const& queue )
+{
+	for ( int itemNum = 1; itemNum < queue.GetNumItems(); itemNum++ )
+	{
+		if ( queue.GetSortedKey( itemNum - 1 ) > queue.GetSortedKey( itemNum ) )
+			return false;
+	}
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( RenderQueue_LayerOutranksState )
+{
+	RenderQueue queue;
+	queue.AddItem( MakeItem( FAKE_SHADER_A, FAKE_VBO_A, 1, 0.0f, 0 ) );
+	queue.AddItem( MakeItem( FAKE_SHADER_B, FAKE_VBO_B, 0, 0.9f, 1 ) );
+	queue.SortItems();
+
+	TEST_CHECK( AreKeysSorted( queue ) );
+	TEST_CHECK( queue.GetSortedItem( 0 ).m_count == 1 );
+	TEST_CHECK( queue.GetSortedItem( 1 ).m_count == 0 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( RenderQueue_GroupsByShaderThenMesh )
+{
+	RenderQueue queue;
+	queue.AddItem( MakeItem( FAKE_SHADER_A, FAKE_VBO_A, 0, 0.5f, 0 ) );
+	queue.AddItem( MakeItem( FAKE_SHADER_B, FAKE_VBO_A, 0, 0.5f, 1 ) );
+	queue.AddItem( MakeItem( FAKE_SHADER_A, FAKE_VBO_B, 0, 0.5f, 2 ) );
+	queue.AddItem( MakeItem( FAKE_SHADER_B, FAKE_VBO_B, 0, 0.5f, 3 ) );
+	queue.AddItem( MakeItem( FAKE_SHADER_A, FAKE_VBO_A, 0, 0.5f, 4 ) );
+	queue.SortItems();
+
+	TEST_CHECK( AreKeysSorted( queue ) );
+
+	int shaderChanges = 0;
+	int meshChanges   = 0;
+	for ( int itemNum = 1; itemNum < queue.GetNumItems(); itemNum++ )
+	{
+		RenderQueueItem const& previous = queue.GetSortedItem( itemNum - 1 );
+		RenderQueueItem const& current  = queue.GetSortedItem( itemNum );
+		shaderChanges += previous.m_shader != current.m_shader ? 1 : 0;
+		meshChanges   += previous.m_shader != current.m_shader || previous.m_vbo != current.m_vbo ? 1 : 0;
+	}
+	TEST_CHECK( shaderChanges == 1 );
+	TEST_CHECK( meshChanges == 3 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( RenderQueue_FrontToBackWithinGroup )
+{
+	RenderQueue queue;
+	queue.AddItem( MakeItem( FAKE_SHADER_A, FAKE_VBO_A, 0, 0.75f, 0 ) );
+	queue.AddItem( MakeItem( FAKE_SHADER_A, FAKE_VBO_A, 0, 0.25f, 1 ) );
+	queue.AddItem( MakeItem( FAKE_SHADER_A, FAKE_VBO_A, 0, 0.50f, 2 ) );
+	queue.SortItems();
+
+	TEST_CHECK( queue.GetSortedItem( 0 ).m_count == 1 );
+	TEST_CHECK( queue.GetSortedItem( 1 ).m_count == 2 );
+	TEST_CHECK( queue.GetSortedItem( 2 ).m_count == 0 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( RenderQueue_EqualKeysKeepSubmissionOrder )
+{
+	constexpr int NUM_ITEMS = 300;
+
+	RenderQueue queue;
+	for ( int itemNum = 0; itemNum < NUM_ITEMS; itemNum++ )
+	{
+		Shader* shader = ( itemNum % 3 ) == 0 ? FAKE_SHADER_B : FAKE_SHADER_A;
+		queue.AddItem( MakeItem( shader, FAKE_VBO_A, 0, 0.5f, itemNum ) );
+	}
+	queue.SortItems();
+
+	TEST_CHECK( AreKeysSorted( queue ) );
+
+	int numOutOfOrder = 0;
+	for ( int itemNum = 1; itemNum < NUM_ITEMS; itemNum++ )
+	{
+		bool sameKey = queue.GetSortedKey( itemNum - 1 ) == queue.GetSortedKey( itemNum );
+		if ( sameKey && queue.GetSortedItem( itemNum - 1 ).m_count > queue.GetSortedItem( itemNum ).m_count )
+		{
+			numOutOfOrder++;
+		}
+	}
+	TEST_CHECK( numOutOfOrder == 0 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Ids are assigned on first sight, so after a reset the first shader seen sorts first again
+//
+ENGINE_TEST( RenderQueue_ResetStateIDsForgetsOldAddresses )
+{
+	RenderQueue queue;
+	queue.AddItem( MakeItem( FAKE_SHADER_A, FAKE_VBO_A, 0, 0.5f, 0 ) );
+	queue.AddItem( MakeItem( FAKE_SHADER_B, FAKE_VBO_A, 0, 0.5f, 1 ) );
+	queue.SortItems();
+	TEST_CHECK( queue.GetSortedItem( 0 ).m_shader == FAKE_SHADER_A );
+
+	queue.Reset();
+	queue.AddItem( MakeItem( FAKE_SHADER_B, FAKE_VBO_A, 0, 0.5f, 0 ) );
+	queue.AddItem( MakeItem( FAKE_SHADER_A, FAKE_VBO_A, 0, 0.5f, 1 ) );
+	queue.SortItems();
+	TEST_CHECK( queue.GetSortedItem( 0 ).m_shader == FAKE_SHADER_A );
+
+	queue.Reset();
+	queue.ResetStateIDs();
+	queue.AddItem( MakeItem( FAKE_SHADER_B, FAKE_VBO_A, 0, 0.5f, 0 ) );
+	queue.AddItem( MakeItem( FAKE_SHADER_A, FAKE_VBO_A, 0, 0.5f, 1 ) );
+	queue.SortItems();
+	TEST_CHECK( queue.GetSortedItem( 0 ).m_shader == FAKE_SHADER_B );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// A table that ran out of ids would lump every new shader onto the last one; Reset starts it over
+//
+ENGINE_TEST( RenderQueue_ResetRecyclesFullIDTable )
+{
+	constexpr int NUM_SHADER_IDS = ( 1 << SORT_KEY_SHADER_BITS ) - 1;
+
+	RenderQueue queue;
+	for ( int shaderNum = 0; shaderNum < NUM_SHADER_IDS; shaderNum++ )
+	{
+		Shader* shader = reinterpret_cast< Shader* >( static_cast< uintptr_t >( 0x1000 + shaderNum * 0x10 ) );
+		queue.AddItem( MakeItem( shader, FAKE_VBO_A, 0, 0.5f, shaderNum ) );
+	}
+
+	queue.Reset();
+	queue.AddItem( MakeItem( FAKE_SHADER_B, FAKE_VBO_A, 0, 0.5f, 0 ) );
+	queue.AddItem( MakeItem( reinterpret_cast< Shader* >( 0x1000 ), FAKE_VBO_A, 0, 0.5f, 1 ) );
+	queue.SortItems();
+	TEST_CHECK( queue.GetSortedItem( 0 ).m_shader == FAKE_SHADER_B );
+}
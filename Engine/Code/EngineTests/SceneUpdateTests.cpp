@@ -0,0 +1,201 @@
+#include "TestFramework.hpp"
+
+#include "Engine/3D/ModelNode.hpp"
+#include "Engine/3D/VisualDatabase.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+// Same shape as the game's scene update: each object composes its model matrix, then walks its own
+// node instances. The serial and parallel runs must agree bit for bit, not just within an epsilon
+//
+constexpr int          NUM_SCENE_OBJECTS       = 300;
+constexpr int          NUM_NODES_PER_OBJECT    = 6;
+constexpr int          NUM_TEST_MESHES         = 4;
+constexpr int          SCENE_UPDATE_BATCH_SIZE = 8;
+constexpr unsigned int TEST_SCENE_SEED         = 12345;
+
+
+//-----------------------------------------------------------------------------------------------
+struct TestSceneObject
+{
+	Vec3        m_position;
+	EulerAngles m_orientation;
+	Mat44       m_modelMatrix;
+	ModelNode*  m_rootNode  = nullptr;
+	AABB3       m_worldBounds;
+	bool        m_hasBounds = false;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Owns every node; ModelNode's destructor neither frees children nor is virtual
+//
+struct TestScene
+{
+	std::vector<TestSceneObject>               m_objects;
+	std::vector<std::unique_ptr<ModelNode>>    m_baseNodes;
+	std::vector<std::unique_ptr<GeometryNode>> m_geometryNodes;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static Mat44 MakeRandomLocalTransform( RandomNumberGenerator& rng )
+{
+	Mat44 transform = Mat44::CreateTranslation3D( Vec3( rng.GetRandomFloatInRange( -5.0f, 5.0f ), rng.GetRandomFloatInRange( -5.0f, 5.0f ), rng.GetRandomFloatInRange( -5.0f, 5.0f ) ) );
+	transform.AppendZRotation( rng.GetRandomFloatInRange( -180.0f, 180.0f ) );
+	transform.AppendXRotation( rng.GetRandomFloatInRange( -180.0f, 180.0f ) );
+	transform.AppendScaleUniform3D( rng.GetRandomFloatInRange( 0.5f, 2.0f ) );
+	return transform;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// RandomNumberGenerator draws from rand(), so reseeding it makes every call build the same scene
+//
+static void BuildTestScene( TestScene& scene )
+{
+	srand( TEST_SCENE_SEED );
+	RandomNumberGenerator rng;
+
+	scene.m_objects.resize( NUM_SCENE_OBJECTS );
+	for ( TestSceneObject& object : scene.m_objects )
+	{
+		object.m_position    = Vec3( rng.GetRandomFloatInRange( -200.0f, 200.0f ), rng.GetRandomFloatInRange( -200.0f, 200.0f ), rng.GetRandomFloatInRange( 0.0f, 20.0f ) );
+		object.m_orientation = EulerAngles( rng.GetRandomFloatInRange( -180.0f, 180.0f ), rng.GetRandomFloatInRange( -90.0f, 90.0f ), rng.GetRandomFloatInRange( -180.0f, 180.0f ) );
+
+		scene.m_baseNodes.emplace_back( new ModelNode() );
+		object.m_rootNode = scene.m_baseNodes.back().get();
+		object.m_rootNode->SetLocalToParentTransform( MakeRandomLocalTransform( rng ) );
+
+		ModelNode* parent = object.m_rootNode;
+		for ( int nodeNum = 1; nodeNum < NUM_NODES_PER_OBJECT; nodeNum++ )
+		{
+			ModelNode* node = nullptr;
+			if ( rng.GetRandomRollGivenChance( 0.7f ) )
+			{
+				scene.m_geometryNodes.emplace_back( new GeometryNode( static_cast< uint >( rng.GetRandomIntLessThan( NUM_TEST_MESHES ) ) ) );
+				node = scene.m_geometryNodes.back().get();
+			}
+			else
+			{
+				scene.m_baseNodes.emplace_back( new ModelNode() );
+				node = scene.m_baseNodes.back().get();
+			}
+
+			node->SetLocalToParentTransform( MakeRandomLocalTransform( rng ) );
+			parent->AddChild( node );
+
+			// Mix of deep chains and siblings
+			if ( rng.GetRandomRollGivenChance( 0.5f ) )
+			{
+				parent = node;
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Mirrors FBXSceneObject::Update
+//
+static void UpdateTestSceneObject( TestSceneObject& object )
+{
+	object.m_modelMatrix = Mat44();
+	object.m_modelMatrix.AppendTranslation3D( object.m_position );
+	object.m_modelMatrix.AppendZRotation( object.m_orientation.m_yawDegrees );
+	object.m_modelMatrix.AppendYRotation( object.m_orientation.m_pitchDegrees );
+	object.m_modelMatrix.AppendXRotation( object.m_orientation.m_rollDegrees );
+
+	object.m_hasBounds = false;
+	object.m_rootNode->UpdateWorldTransforms( object.m_modelMatrix, object.m_worldBounds, object.m_hasBounds );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool AreBitIdentical( ModelNode* nodeA, ModelNode* nodeB )
+{
+	Mat44 worldA = nodeA->GetLocalToWorldTransform();
+	Mat44 worldB = nodeB->GetLocalToWorldTransform();
+	if ( memcmp( &worldA, &worldB, sizeof( Mat44 ) ) != 0 )
+		return false;
+
+	std::vector<ModelNode*> const& childrenA = nodeA->GetChildren();
+	std::vector<ModelNode*> const& childrenB = nodeB->GetChildren();
+	if ( childrenA.size() != childrenB.size() )
+		return false;
+
+	for ( size_t childNum = 0; childNum < childrenA.size(); childNum++ )
+	{
+		if ( !AreBitIdentical( childrenA[ childNum ], childrenB[ childNum ] ) )
+			return false;
+	}
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( SceneUpdate_ParallelMatchesSerialBitForBit )
+{
+	// Geometry nodes read their local bounds from the visual database by mesh id
+	VisualDatabaseConfig databaseConfig;
+	VisualDatabase database( databaseConfig );
+	database.m_meshData.resize( NUM_TEST_MESHES );
+	for ( int meshNum = 0; meshNum < NUM_TEST_MESHES; meshNum++ )
+	{
+		float size = static_cast< float >( meshNum + 1 );
+		database.m_meshData[ meshNum ].m_bounds = AABB3( Vec3( -size, -0.5f * size, 0.0f ), Vec3( size, 0.5f * size, 2.0f * size ) );
+	}
+	VisualDatabase* previousDatabase = g_theVisualDatabase;
+	g_theVisualDatabase = &database;
+
+	TestScene serialScene;
+	TestScene parallelScene;
+	BuildTestScene( serialScene );
+	BuildTestScene( parallelScene );
+
+	for ( TestSceneObject& object : serialScene.m_objects )
+	{
+		UpdateTestSceneObject( object );
+	}
+
+	JobSystemConfig jobConfig;
+	jobConfig.m_numWorkerThreads = 4;
+	JobSystem jobSystem( jobConfig );
+	jobSystem.Startup();
+	jobSystem.BeginFrame();
+
+	std::vector<TestSceneObject>& parallelObjects = parallelScene.m_objects;
+	jobSystem.ParallelFor( NUM_SCENE_OBJECTS, SCENE_UPDATE_BATCH_SIZE, [ &parallelObjects ]( int objNum )
+	{
+		UpdateTestSceneObject( parallelObjects[ objNum ] );
+	} );
+	jobSystem.Shutdown();
+
+	int numMismatchedObjects = 0;
+	int numObjectsWithBounds = 0;
+	for ( int objNum = 0; objNum < NUM_SCENE_OBJECTS; objNum++ )
+	{
+		TestSceneObject const& serial   = serialScene.m_objects[ objNum ];
+		TestSceneObject const& parallel = parallelObjects[ objNum ];
+
+		bool matches = memcmp( &serial.m_modelMatrix, &parallel.m_modelMatrix, sizeof( Mat44 ) ) == 0;
+		matches = matches && serial.m_hasBounds == parallel.m_hasBounds;
+		matches = matches && ( !serial.m_hasBounds || memcmp( &serial.m_worldBounds, &parallel.m_worldBounds, sizeof( AABB3 ) ) == 0 );
+		matches = matches && AreBitIdentical( serial.m_rootNode, parallel.m_rootNode );
+		numMismatchedObjects += matches ? 0 : 1;
+		numObjectsWithBounds += serial.m_hasBounds ? 1 : 0;
+	}
+
+	TEST_CHECK( numMismatchedObjects == 0 );
+	TEST_CHECK( numObjectsWithBounds > NUM_SCENE_OBJECTS / 2 );
+
+	g_theVisualDatabase = previousDatabase;
+}
@@ -0,0 +1,131 @@
+#include "TestFramework.hpp"
+
+#include <cmath>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+struct RegisteredTest
+{
+	char const*       m_name     = nullptr;
+	TestFunction      m_function = nullptr;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct RegisteredBenchmark
+{
+	char const*       m_name     = nullptr;
+	BenchmarkFunction m_function = nullptr;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Function local so registration from other translation units never runs before construction
+//
+static std::vector< RegisteredTest >& GetRegisteredTests()
+{
+	static std::vector< RegisteredTest > s_tests;
+	return s_tests;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static std::vector< RegisteredBenchmark >& GetRegisteredBenchmarks()
+{
+	static std::vector< RegisteredBenchmark > s_benchmarks;
+	return s_benchmarks;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+TestRegistrar::TestRegistrar( char const* name, TestFunction function )
+{
+	RegisteredTest test;
+	test.m_name     = name;
+	test.m_function = function;
+	GetRegisteredTests().push_back( test );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+BenchmarkRegistrar::BenchmarkRegistrar( char const* name, BenchmarkFunction function )
+{
+	RegisteredBenchmark benchmark;
+	benchmark.m_name     = name;
+	benchmark.m_function = function;
+	GetRegisteredBenchmarks().push_back( benchmark );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TestContext::Check( bool condition, char const* conditionText, char const* file, int line )
+{
+	if ( condition )
+		return;
+
+	m_numFailures++;
+	printf( "    FAILED %s(%d): %s\n", file, line, conditionText );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TestContext::CheckNear( double actual, double expected, double epsilon, char const* actualText, char const* expectedText, char const* file, int line )
+{
+	if ( fabs( actual - expected ) <= epsilon )
+		return;
+
+	m_numFailures++;
+	printf( "    FAILED %s(%d): %s = %.9g, %s = %.9g, epsilon %.3g\n", file, line, actualText, actual, expectedText, expected, epsilon );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int RunAllTests()
+{
+	int numFailedTests = 0;
+	std::vector< RegisteredTest > const& tests = GetRegisteredTests();
+
+	for ( int testNum = 0; testNum < static_cast< int >( tests.size() ); testNum++ )
+	{
+		TestContext context;
+		tests[ testNum ].m_function( context );
+
+		bool passed = context.GetNumFailures() == 0;
+		printf( "[%s] %s\n", passed ? "PASS" : "FAIL", tests[ testNum ].m_name );
+		if ( !passed )
+		{
+			numFailedTests++;
+		}
+	}
+
+	printf( "%d of %d tests passed\n", static_cast< int >( tests.size() ) - numFailedTests, static_cast< int >( tests.size() ) );
+	return numFailedTests;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int RunAllBenchmarks()
+{
+	std::vector< RegisteredBenchmark > const& benchmarks = GetRegisteredBenchmarks();
+
+	for ( int benchmarkNum = 0; benchmarkNum < static_cast< int >( benchmarks.size() ); benchmarkNum++ )
+	{
+		printf( "%s\n", benchmarks[ benchmarkNum ].m_name );
+		BenchmarkContext bench;
+		benchmarks[ benchmarkNum ].m_function( bench );
+	}
+
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void const* volatile s_doNotOptimizeSink = nullptr;
+
+
+//-----------------------------------------------------------------------------------------------
+void DoNotOptimizeAway( void const* pointer )
+{
+	s_doNotOptimizeSink = pointer;
+}
@@ -0,0 +1,101 @@
+#pragma once
+//-----------------------------------------------------------------------------------------------
+// TestFramework.hpp
+//
+// Minimal self registering tests and benchmarks for the engine. EngineTests runs every ENGINE_TEST
+// and returns the number of failed tests; EngineBench runs every ENGINE_BENCHMARK and prints timings.
+//
+//	ENGINE_TEST( name ) { TEST_CHECK( condition ); TEST_CHECK_NEAR( actual, expected, epsilon ); }
+//	ENGINE_BENCHMARK( name ) { bench.Measure( "label", iterations, [&]() { ... } ); }
+//
+#include "Engine/Core/Time.hpp"
+
+#include <cstdio>
+
+
+//-----------------------------------------------------------------------------------------------
+class TestContext
+{
+public:
+	void  Check( bool condition, char const* conditionText, char const* file, int line );
+	void  CheckNear( double actual, double expected, double epsilon, char const* actualText, char const* expectedText, char const* file, int line );
+
+	int   GetNumFailures() const { return m_numFailures; }
+
+private:
+	int   m_numFailures = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+class BenchmarkContext
+{
+public:
+	// Runs function numIterations times after one warm up call and prints the average time per call
+	template< typename FunctionType >
+	double Measure( char const* label, int numIterations, FunctionType function );
+};
+
+
+//-----------------------------------------------------------------------------------------------
+typedef void ( *TestFunction )( TestContext& context );
+typedef void ( *BenchmarkFunction )( BenchmarkContext& bench );
+
+
+//-----------------------------------------------------------------------------------------------
+struct TestRegistrar
+{
+	TestRegistrar( char const* name, TestFunction function );
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct BenchmarkRegistrar
+{
+	BenchmarkRegistrar( char const* name, BenchmarkFunction function );
+};
+
+
+//-----------------------------------------------------------------------------------------------
+int RunAllTests();
+int RunAllBenchmarks();
+
+// Keeps the optimizer from discarding work whose result a benchmark never reads
+void DoNotOptimizeAway( void const* pointer );
+
+
+//-----------------------------------------------------------------------------------------------
+#define ENGINE_TEST( testName )																	\
+	static void testName( TestContext& context );												\
+	static TestRegistrar s_testRegistrar_##testName( #testName, testName );						\
+	static void testName( TestContext& context )
+
+#define ENGINE_BENCHMARK( benchName )															\
+	static void benchName( BenchmarkContext& bench );											\
+	static BenchmarkRegistrar s_benchmarkRegistrar_##benchName( #benchName, benchName );		\
+	static void benchName( BenchmarkContext& bench )
+
+#define TEST_CHECK( condition )																	\
+	context.Check( ( condition ), #condition, __FILE__, __LINE__ )
+
+#define TEST_CHECK_NEAR( actual, expected, epsilon )												\
+	context.CheckNear( ( actual ), ( expected ), ( epsilon ), #actual, #expected, __FILE__, __LINE__ )
+
+
+//-----------------------------------------------------------------------------------------------
+template< typename FunctionType >
+double BenchmarkContext::Measure( char const* label, int numIterations, FunctionType function )
+{
+	function();
+
+	double startTime = GetCurrentTimeSeconds();
+	for ( int iteration = 0; iteration < numIterations; iteration++ )
+	{
+		function();
+	}
+	double totalSeconds = GetCurrentTimeSeconds() - startTime;
+
+	double nanosecondsPerCall = ( totalSeconds * 1.0e9 ) / static_cast< double >( numIterations );
+	printf( "  %-48s %12.2f ns/call  (%d calls, %.3f ms)\n", label, nanosecondsPerCall, numIterations, totalSeconds * 1000.0 );
+	return nanosecondsPerCall;
+}
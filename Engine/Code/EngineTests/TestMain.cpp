@@ -0,0 +1,13 @@
+#include "TestFramework.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Exit code is the number of failed tests, so a build step can fail on it
+//
+int main( int argc, char** argv )
+{
+	(void) argc;
+	(void) argv;
+
+	return RunAllTests();
+}
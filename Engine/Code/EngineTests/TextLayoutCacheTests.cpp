@@ -0,0 +1,174 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Renderer/BitmapFont.hpp"
+#include "Engine/Renderer/Texture.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr int NUM_VERTS_PER_GLYPH = 6;
+
+
+//-----------------------------------------------------------------------------------------------
+// Fonts and textures are normally made only by the Renderer; the layout code just needs a 16x16
+// glyph grid over a texture of known size
+//
+struct TextLayoutTestAccess
+{
+	static Texture* CreateFontTexture()
+	{
+		Texture* texture = new Texture();
+		texture->m_dimensions = IntVec2( 256, 256 );
+		return texture;
+	}
+
+	static void DestroyFontTexture( Texture* texture )
+	{
+		delete texture;
+	}
+
+	static BitmapFont* CreateFont( Texture const& texture )
+	{
+		return new BitmapFont( "EngineTests/TestFont", texture );
+	}
+
+	static int GetNumCachedLayouts( BitmapFont const& font )
+	{
+		return static_cast< int >( font.m_cachedTextLayouts.size() );
+	}
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct TextLayoutArgs
+{
+	AABB2       m_box        = AABB2( Vec2( 10.0f, 20.0f ), Vec2( 410.0f, 60.0f ) );
+	float       m_cellHeight = 16.0f;
+	Rgba8       m_tint       = Rgba8::WHITE;
+	float       m_cellAspect = 0.7f;
+	Vec2        m_alignment  = Vec2( 0.0f, 0.5f );
+	TextBoxMode m_mode       = TextBoxMode::SHRINK;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static std::vector<Vertex_PCU> LayOutCached( BitmapFont& font, std::string const& text, TextLayoutArgs const& args = TextLayoutArgs() )
+{
+	std::vector<Vertex_PCU> verts;
+	font.AddCachedVertsForTextInBox2D( verts, args.m_box, args.m_cellHeight, text, args.m_tint, args.m_cellAspect, args.m_alignment, args.m_mode );
+	return verts;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static std::vector<Vertex_PCU> LayOutFresh( BitmapFont& font, std::string const& text, TextLayoutArgs const& args = TextLayoutArgs() )
+{
+	std::vector<Vertex_PCU> verts;
+	font.AddVertsForTextInBox2D( verts, args.m_box, args.m_cellHeight, text, args.m_tint, args.m_cellAspect, args.m_alignment, args.m_mode );
+	return verts;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool AreBitIdentical( std::vector<Vertex_PCU> const& vertsA, std::vector<Vertex_PCU> const& vertsB )
+{
+	return vertsA.size() == vertsB.size() && memcmp( vertsA.data(), vertsB.data(), vertsA.size() * sizeof( Vertex_PCU ) ) == 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Every quad covers one glyph cell of the same width and uses one glyph's UV rect on its corners
+//
+static int CountBadGlyphQuads( std::vector<Vertex_PCU> const& verts, std::string const& text )
+{
+	if ( verts.size() != text.length() * NUM_VERTS_PER_GLYPH )
+		return static_cast< int >( text.length() ) + 1;
+
+	int   numBadQuads = 0;
+	float glyphWidth  = verts[ 1 ].m_position.x - verts[ 0 ].m_position.x;
+	for ( size_t charNum = 0; charNum < text.length(); charNum++ )
+	{
+		Vertex_PCU const* quad = &verts[ charNum * NUM_VERTS_PER_GLYPH ];
+		AABB2 uvBounds( quad[ 0 ].m_uvTexCoords, quad[ 2 ].m_uvTexCoords );
+
+		float expectedMinU = static_cast< float >( static_cast< unsigned char >( text[ charNum ] ) % 16 ) / 16.0f;
+		bool  isGoodQuad   = fabsf( ( quad[ 1 ].m_position.x - quad[ 0 ].m_position.x ) - glyphWidth ) < 0.0001f;
+		isGoodQuad = isGoodQuad && fabsf( uvBounds.m_mins.x - expectedMinU ) < 0.01f;
+		isGoodQuad = isGoodQuad && uvBounds.m_mins.x < uvBounds.m_maxs.x && uvBounds.m_mins.y < uvBounds.m_maxs.y;
+		isGoodQuad = isGoodQuad && quad[ 3 ].m_uvTexCoords == uvBounds.m_mins && quad[ 4 ].m_uvTexCoords == uvBounds.m_maxs;
+		isGoodQuad = isGoodQuad && quad[ 1 ].m_uvTexCoords == Vec2( uvBounds.m_maxs.x, uvBounds.m_mins.y );
+		isGoodQuad = isGoodQuad && quad[ 5 ].m_uvTexCoords == Vec2( uvBounds.m_mins.x, uvBounds.m_maxs.y );
+		numBadQuads += isGoodQuad ? 0 : 1;
+	}
+	return numBadQuads;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// A counter that changes a few digits each frame is patched in place, and must come out exactly as
+// a fresh layout of the new text would
+//
+ENGINE_TEST( TextLayoutCache_PatchedTextMatchesFreshLayout )
+{
+	Texture*    texture = TextLayoutTestAccess::CreateFontTexture();
+	BitmapFont* font    = TextLayoutTestAccess::CreateFont( *texture );
+
+	std::vector<std::string> frames = { "FPS: 59.94 ( 16.68 ms )", "FPS: 60.02 ( 16.66 ms )", "FPS: 61.37 ( 16.29 ms )", "FPS: 59.94 ( 16.68 ms )" };
+	int numMismatchedFrames = 0;
+	int numBadQuads         = 0;
+	for ( std::string const& text : frames )
+	{
+		std::vector<Vertex_PCU> cachedVerts = LayOutCached( *font, text );
+		numMismatchedFrames += AreBitIdentical( cachedVerts, LayOutFresh( *font, text ) ) ? 0 : 1;
+		numBadQuads         += CountBadGlyphQuads( cachedVerts, text );
+	}
+
+	TEST_CHECK( numMismatchedFrames == 0 );
+	TEST_CHECK( numBadQuads == 0 );
+	TEST_CHECK( TextLayoutTestAccess::GetNumCachedLayouts( *font ) == 1 );
+
+	delete font;
+	TextLayoutTestAccess::DestroyFontTexture( texture );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Another length, another line count or another layout argument gets its own layout
+//
+ENGINE_TEST( TextLayoutCache_OnlySameLayoutSingleLinesArePatched )
+{
+	Texture*    texture = TextLayoutTestAccess::CreateFontTexture();
+	BitmapFont* font    = TextLayoutTestAccess::CreateFont( *texture );
+
+	TextLayoutArgs tintedArgs;
+	tintedArgs.m_tint = Rgba8( 255, 0, 0, 255 );
+
+	TextLayoutArgs overrunArgs;
+	overrunArgs.m_mode = TextBoxMode::OVERRUN;
+
+	LayOutCached( *font, "Pos: 1.5, 2.5" );
+	TEST_CHECK( AreBitIdentical( LayOutCached( *font, "Pos: 10.5, 2.5" ), LayOutFresh( *font, "Pos: 10.5, 2.5" ) ) );
+	TEST_CHECK( TextLayoutTestAccess::GetNumCachedLayouts( *font ) == 2 );
+
+	TEST_CHECK( AreBitIdentical( LayOutCached( *font, "Pos: 3.5, 4.5", tintedArgs ), LayOutFresh( *font, "Pos: 3.5, 4.5", tintedArgs ) ) );
+	TEST_CHECK( AreBitIdentical( LayOutCached( *font, "Pos: 3.5, 4.5", overrunArgs ), LayOutFresh( *font, "Pos: 3.5, 4.5", overrunArgs ) ) );
+	TEST_CHECK( TextLayoutTestAccess::GetNumCachedLayouts( *font ) == 4 );
+
+	LayOutCached( *font, "ab\ncd" );
+	TEST_CHECK( AreBitIdentical( LayOutCached( *font, "ef\ngh" ), LayOutFresh( *font, "ef\ngh" ) ) );
+	TEST_CHECK( TextLayoutTestAccess::GetNumCachedLayouts( *font ) == 6 );
+
+	// Repeats copy the stored layout without adding or patching
+	TEST_CHECK( AreBitIdentical( LayOutCached( *font, "Pos: 1.5, 2.5" ), LayOutFresh( *font, "Pos: 1.5, 2.5" ) ) );
+	TEST_CHECK( TextLayoutTestAccess::GetNumCachedLayouts( *font ) == 6 );
+
+	font->ClearTextLayoutCache();
+	TEST_CHECK( TextLayoutTestAccess::GetNumCachedLayouts( *font ) == 0 );
+
+	delete font;
+	TextLayoutTestAccess::DestroyFontTexture( texture );
+}
@@ -0,0 +1,259 @@
+#include "TestFramework.hpp"
+
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Renderer/TextureCooker.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+// Smooth content with a little texel noise, roughly what photographic albedo looks like to a block
+// encoder. Hard edges would lower every format's score without telling us anything new
+//
+constexpr int   TEST_TEXTURE_SIZE = 64;
+constexpr float MIN_BC1_PSNR      = 34.0f;		// about 3 dB under what the encoder reaches today
+constexpr float MIN_BC3_PSNR      = 35.0f;		// over all four channels
+constexpr float MIN_BC5_PSNR      = 45.0f;		// over x and y only, each with its own eight value palette
+
+
+//-----------------------------------------------------------------------------------------------
+static unsigned char GetTestNoise( int x, int y )
+{
+	unsigned int hash = static_cast< unsigned int >( x ) * 73856093u ^ static_cast< unsigned int >( y ) * 19349663u;
+	return static_cast< unsigned char >( ( hash >> 7 ) & 3u );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static Image MakeColorTestImage( bool isTranslucent )
+{
+	Image image;
+	image.SetupAsSolidColor( TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE, Rgba8::WHITE );
+	Rgba8* texels = image.GetRawData();
+
+	for ( int y = 0; y < TEST_TEXTURE_SIZE; y++ )
+	{
+		for ( int x = 0; x < TEST_TEXTURE_SIZE; x++ )
+		{
+			Rgba8& texel = texels[ y * TEST_TEXTURE_SIZE + x ];
+			texel.r = static_cast< unsigned char >( x * 4 ) + GetTestNoise( x, y );
+			texel.g = static_cast< unsigned char >( y * 3 ) + GetTestNoise( y, x );
+			texel.b = static_cast< unsigned char >( 128 + 100.0f * sinf( static_cast< float >( x + y ) * 0.1f ) );
+			texel.a = isTranslucent ? static_cast< unsigned char >( 255 - ( x + y ) * 2 ) : 255;
+		}
+	}
+	return image;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Tangent space normals of a gentle height field, encoded the way normal map images store them
+//
+static Image MakeNormalTestImage()
+{
+	Image image;
+	image.SetupAsSolidColor( TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE, Rgba8::WHITE );
+	Rgba8* texels = image.GetRawData();
+
+	for ( int y = 0; y < TEST_TEXTURE_SIZE; y++ )
+	{
+		for ( int x = 0; x < TEST_TEXTURE_SIZE; x++ )
+		{
+			float normalX = 0.4f * cosf( static_cast< float >( x ) * 0.15f );
+			float normalY = 0.4f * sinf( static_cast< float >( y ) * 0.2f );
+			float normalZ = sqrtf( 1.0f - normalX * normalX - normalY * normalY );
+
+			Rgba8& texel = texels[ y * TEST_TEXTURE_SIZE + x ];
+			texel.r = static_cast< unsigned char >( ( normalX * 0.5f + 0.5f ) * 255.0f + 0.5f );
+			texel.g = static_cast< unsigned char >( ( normalY * 0.5f + 0.5f ) * 255.0f + 0.5f );
+			texel.b = static_cast< unsigned char >( ( normalZ * 0.5f + 0.5f ) * 255.0f + 0.5f );
+		}
+	}
+	return image;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static float CookAndMeasureTopMip( Image const& source, TextureUsage usage, CookedTextureFormat expectedFormat, int numChannels, TestContext& context )
+{
+	CookedTexture cookedTexture;
+	CookTexture( source, usage, cookedTexture );
+	TEST_CHECK( cookedTexture.m_format == expectedFormat );
+
+	Image decoded;
+	DecodeCookedTextureMip( cookedTexture, 0, decoded );
+	float psnr = ComputeImagePSNR( source, decoded, numChannels );
+	printf( "    PSNR %.2f dB\n", psnr );
+	return psnr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static std::string GetTestCookedFilePath( char const* name )
+{
+	return std::string( "EngineTests_" ) + name + ".ctex";
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( TextureCooker_BC1RoundTripKeepsQuality )
+{
+	float psnr = CookAndMeasureTopMip( MakeColorTestImage( false ), TextureUsage::COLOR, CookedTextureFormat::BC1, 3, context );
+	TEST_CHECK( psnr >= MIN_BC1_PSNR );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( TextureCooker_BC3RoundTripKeepsQuality )
+{
+	float psnr = CookAndMeasureTopMip( MakeColorTestImage( true ), TextureUsage::COLOR, CookedTextureFormat::BC3, 4, context );
+	TEST_CHECK( psnr >= MIN_BC3_PSNR );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( TextureCooker_BC5RoundTripKeepsQuality )
+{
+	float psnr = CookAndMeasureTopMip( MakeNormalTestImage(), TextureUsage::NORMAL_MAP, CookedTextureFormat::BC5, 2, context );
+	TEST_CHECK( psnr >= MIN_BC5_PSNR );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( TextureCooker_FileRoundTripIsExact )
+{
+	CookedTexture written;
+	CookTexture( MakeColorTestImage( true ), TextureUsage::COLOR, written );
+
+	std::string filePath = GetTestCookedFilePath( "RoundTrip" );
+	TEST_CHECK( WriteCookedTextureFile( written, filePath ) );
+
+	CookedTexture read;
+	TEST_CHECK( ReadCookedTextureFile( read, filePath ) );
+	TEST_CHECK( read.m_format == written.m_format && read.m_usage == written.m_usage );
+	TEST_CHECK( read.m_mips.size() == written.m_mips.size() );
+	TEST_CHECK( read.m_data == written.m_data );
+
+	remove( filePath.c_str() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Each file is written from a cooked texture with one field broken; all of them must be rejected so
+// LoadOrCookTexture falls back to cooking from the source image
+//
+ENGINE_TEST( TextureCooker_RejectsInconsistentFiles )
+{
+	CookedTexture valid;
+	CookTexture( MakeColorTestImage( false ), TextureUsage::COLOR, valid );
+	std::string filePath = GetTestCookedFilePath( "Corrupt" );
+	CookedTexture read;
+
+	CookedTexture badFormat = valid;
+	badFormat.m_format = static_cast< CookedTextureFormat >( 7 );
+	WriteCookedTextureFile( badFormat, filePath );
+	TEST_CHECK( !ReadCookedTextureFile( read, filePath ) );
+
+	CookedTexture badUsage = valid;
+	badUsage.m_usage = static_cast< TextureUsage >( 9 );
+	WriteCookedTextureFile( badUsage, filePath );
+	TEST_CHECK( !ReadCookedTextureFile( read, filePath ) );
+
+	CookedTexture badMipSize = valid;
+	badMipSize.m_mips[ 1 ].m_byteSize += 8;
+	WriteCookedTextureFile( badMipSize, filePath );
+	TEST_CHECK( !ReadCookedTextureFile( read, filePath ) );
+
+	CookedTexture badMipDimensions = valid;
+	badMipDimensions.m_mips[ 2 ].m_dimensions = IntVec2( 64, 64 );
+	WriteCookedTextureFile( badMipDimensions, filePath );
+	TEST_CHECK( !ReadCookedTextureFile( read, filePath ) );
+
+	CookedTexture wrongFormatForData = valid;
+	wrongFormatForData.m_format = CookedTextureFormat::BC3;
+	WriteCookedTextureFile( wrongFormatForData, filePath );
+	TEST_CHECK( !ReadCookedTextureFile( read, filePath ) );
+
+	CookedTexture truncated = valid;
+	truncated.m_mips.pop_back();
+	WriteCookedTextureFile( truncated, filePath );
+	TEST_CHECK( !ReadCookedTextureFile( read, filePath ) );
+
+	remove( filePath.c_str() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Alpha is filtered linearly, so it shows exactly how much each source texel contributes. A 5 wide
+// level has no pairs to average; the last column must still reach mip 1, and the mean must survive
+//
+ENGINE_TEST( TextureCooker_OddSizedMipsKeepEdgeTexels )
+{
+	constexpr int ODD_SIZE = 5;
+
+	Image columnImage;
+	Image rowImage;
+	columnImage.SetupAsSolidColor( ODD_SIZE, ODD_SIZE, Rgba8( 255, 255, 255, 0 ) );
+	rowImage.SetupAsSolidColor( ODD_SIZE, ODD_SIZE, Rgba8( 255, 255, 255, 0 ) );
+	for ( int index = 0; index < ODD_SIZE; index++ )
+	{
+		columnImage.GetRawData()[ index * ODD_SIZE + ( ODD_SIZE - 1 ) ].a = 255;
+		rowImage.GetRawData()[ ( ODD_SIZE - 1 ) * ODD_SIZE + index ].a    = 255;
+	}
+
+	std::vector<Image> columnMips;
+	std::vector<Image> rowMips;
+	GenerateMipChain( columnImage, TextureUsage::COLOR, columnMips );
+	GenerateMipChain( rowImage, TextureUsage::COLOR, rowMips );
+
+	TEST_CHECK( columnMips.size() == 3 );
+	TEST_CHECK( rowMips.size() == 3 );
+	if ( columnMips.size() != 3 || rowMips.size() != 3 )
+		return;
+
+	TEST_CHECK( columnMips[ 1 ].GetDimensions() == IntVec2( 2, 2 ) );
+	TEST_CHECK( columnMips[ 2 ].GetDimensions() == IntVec2( 1, 1 ) );
+
+	// The destination texel next to the edge covers 2/5 of the white column; the other covers none of it
+	Rgba8 const* columnMip = columnMips[ 1 ].GetRawData();
+	Rgba8 const* rowMip    = rowMips[ 1 ].GetRawData();
+	for ( int index = 0; index < 2; index++ )
+	{
+		TEST_CHECK( columnMip[ index * 2 + 0 ].a == 0 );
+		TEST_CHECK( columnMip[ index * 2 + 1 ].a == 102 );
+		TEST_CHECK( rowMip[ 0 * 2 + index ].a == 0 );
+		TEST_CHECK( rowMip[ 1 * 2 + index ].a == 102 );
+	}
+
+	// One white column out of five averages to 51 all the way down
+	TEST_CHECK( columnMips[ 2 ].GetRawData()[ 0 ].a == 51 );
+	TEST_CHECK( rowMips[ 2 ].GetRawData()[ 0 ].a == 51 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ENGINE_TEST( TextureCooker_NonPowerOfTwoChainIsFlatForFlatInput )
+{
+	Image source;
+	source.SetupAsSolidColor( 13, 7, Rgba8( 200, 90, 30, 180 ) );
+
+	std::vector<Image> mips;
+	GenerateMipChain( source, TextureUsage::COLOR, mips );
+	TEST_CHECK( mips.size() == 4 );
+
+	int numChangedTexels = 0;
+	for ( Image const& mip : mips )
+	{
+		IntVec2      dimensions = mip.GetDimensions();
+		Rgba8 const* texels     = mip.GetRawData();
+		for ( int texelNum = 0; texelNum < dimensions.x * dimensions.y; texelNum++ )
+		{
+			numChangedTexels += texels[ texelNum ] == Rgba8( 200, 90, 30, 180 ) ? 0 : 1;
+		}
+	}
+	TEST_CHECK( numChangedTexels == 0 );
+}
@@ -8,11 +8,14 @@
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/FrameArena.hpp"
+#include "Engine/Core/JobSystem.hpp"
 #include "Engine/Core/Time.hpp"
 #include "Engine/Debug/UI/DebugUISystem.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Window/Window.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/RenderThread.hpp"
 #include "Engine/Renderer/VertexData/Vertex_PCU.hpp"
 #include "Engine/Telemetry/D3D11PerformanceMarker.hpp"
 
@@ -36,10 +39,18 @@ App::~App()
 //----------------------------------------------------------------------------------------------- 
 void App::Startup()
 {
+	FrameArenaConfig frameArenaConfig;
+	g_theFrameArena = new FrameArena( frameArenaConfig );
+	g_theFrameArena->Startup();
+
 	EventSystemConfig eventConfig;
 	g_theEventSystem = new EventSystem( eventConfig );
 	g_theEventSystem->Startup();
 
+	JobSystemConfig jobConfig;
+	g_theJobSystem = new JobSystem( jobConfig );
+	g_theJobSystem->Startup();
+
 	InputConfig inputConfig;
 	g_theInput = new InputSystem( inputConfig );
 	g_theInput->Startup();
@@ -56,6 +67,10 @@ void App::Startup()
 	g_theRenderer = new Renderer( renderConfig );
 	g_theRenderer->Startup();
 
+	RenderThreadConfig renderThreadConfig;
+	g_theRenderThread = new RenderThread( renderThreadConfig );
+	g_theRenderThread->Startup();
+
 	g_theD3D11PerfMarker = new D3D11PerformanceMarker( g_theRenderer );
 
 	AudioConfig audioConfig;
@@ -82,6 +97,7 @@ void App::Startup()
 	g_theFBXLoader->Startup();
 
 	VisualDatabaseConfig config;
+	config.m_usePackedVertices = true;
 	g_theVisualDatabase = new VisualDatabase( config );
 	g_theVisualDatabase->Startup();
 
@@ -89,18 +105,25 @@ void App::Startup()
 	m_theGame->Startup();
 
 	SubscribeEventCallbackFunction( "Quit", App::QuitApp );
+	SubscribeEventCallbackFunction( "SimulationMode", App::SetSimulationMode );
+	SubscribeEventCallbackFunction( "RenderThread", App::SetRenderThreadMode );
 }
 
 
 //----------------------------------------------------------------------------------------------- 
+// The renderer begins its frame in EndFrame instead, once the render thread is idle and before the
+// next packet goes out
+//
 void App::BeginFrame()
 {
 	Clock::SystemBeginFrame();
 
+	g_theFrameArena->BeginFrame();
 	g_theEventSystem->BeginFrame();
+	g_theJobSystem->BeginFrame();
 	g_theInput->BeginFrame();
 	g_theWindow->BeginFrame();
-	g_theRenderer->BeginFrame();
+	g_theRenderThread->BeginFrame();
 	g_theAudio->BeginFrame();
 	g_theConsole->BeginFrame();
 	g_theDebugUISystem->BeginFrame();
@@ -110,6 +133,8 @@ void App::BeginFrame()
 //----------------------------------------------------------------------------------------------- 
 void App::ResetGame()
 {
+	g_theRenderThread->WaitUntilIdle();
+
 	m_theGame->Shutdown();
 	delete m_theGame;
 	m_theGame = nullptr;
@@ -133,13 +158,17 @@ void App::RunFrame()
 {
 	constexpr float MIN_FRAMES_PER_SECOND = 10.f;
 	constexpr float MAX_DELTA_SECONDS = 1.f / MIN_FRAMES_PER_SECOND;
+
+	BeginFrame();
+
 	float deltaSeconds = static_cast< float >( Clock::GetSystemClock().GetFrameDeltaSeconds() );
 
 	if ( deltaSeconds > MAX_DELTA_SECONDS )
 		deltaSeconds = MAX_DELTA_SECONDS;
 
-	BeginFrame();
-	Update( deltaSeconds );
+	int numSimulationTicks = m_simulationTimestep.Advance( deltaSeconds );
+
+	Update( numSimulationTicks );
 	Render();
 	EndFrame();
 
@@ -147,14 +176,24 @@ void App::RunFrame()
 
 
 //----------------------------------------------------------------------------------------------- 
-void App::Update( float deltaSeconds )
+// Input and UI run once per frame, the simulation once per fixed tick, and whatever gets rendered is
+// built afterwards from the last two ticks' states
+//
+void App::Update( int numSimulationTicks )
 {
 	g_theConsole->Update();
 	g_theDebugUISystem->Update();
 	UpdateDevKeys();
-	UNUSED( deltaSeconds );
+
 	m_theGame->Update();
 
+	float tickSeconds = static_cast< float >( m_simulationTimestep.GetTickSeconds() );
+	for ( int tickNum = 0; tickNum < numSimulationTicks; tickNum++ )
+	{
+		m_theGame->Simulate( tickSeconds );
+	}
+
+	m_theGame->UpdateForRender( m_simulationTimestep.GetInterpolationAlpha() );
 }
 
 //----------------------------------------------------------------------------------------------- 
@@ -170,6 +209,27 @@ void App::UpdateDevKeys()
 		g_theConsole->SetMode( DevConsoleMode::VISIBLE );
 	}
 
+	// Handled before the frame packet is built, so the packet never references anything these release
+	if ( g_theInput->WasKeyJustPressed( KEYCODE_F1 ) )
+	{
+		g_theRenderThread->WaitUntilIdle();
+		g_theRenderer->RecompileAllShaders();
+	}
+
+	if ( g_theInput->WasKeyJustPressed( KEYCODE_F2 ) )
+	{
+		m_theGame->ReloadXMLData();
+	}
+
+	if ( g_theInput->WasKeyJustPressed( KEYCODE_SQUARE_OPEN_BRACKET ) )
+	{
+		m_theGame->LoadPreviousScene();
+	}
+
+	if ( g_theInput->WasKeyJustPressed( KEYCODE_SQUARE_CLOSE_BRACKET ) )
+	{
+		m_theGame->LoadNextScene();
+	}
 }
 
 
@@ -190,9 +250,50 @@ bool App::QuitApp( EventArgs& args )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// SimulationMode deterministic=true|false rate=<ticks per second>
+// With no arguments it toggles deterministic mode, which runs exactly one tick per frame so benchmark
+// runs simulate the same states regardless of frame times. Giving only a rate keeps the current mode
+//
+bool App::SetSimulationMode( EventArgs& args )
+{
+	FixedTimestep& timestep = g_theApp->m_simulationTimestep;
+
+	bool toggleDefault   = args.GetNumValues() == 0 ? !timestep.IsDeterministic() : timestep.IsDeterministic();
+	bool isDeterministic = args.GetValue( "deterministic", toggleDefault );
+	timestep.SetDeterministic( isDeterministic );
+
+	float ticksPerSecond = args.GetValue( "rate", static_cast< float >( timestep.GetTicksPerSecond() ) );
+	timestep.SetTicksPerSecond( ticksPerSecond );
+
+	g_theConsole->AddLine( DevConsole::INFO_MAJOR, Stringf( "Simulation: %.1f ticks per second, %s", timestep.GetTicksPerSecond(), isDeterministic ? "deterministic" : "real time" ) );
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// RenderThread threaded=true|false
+// With no arguments it toggles; single threaded runs each frame packet inline when it is submitted,
+// for comparing against the threaded path
+//
+bool App::SetRenderThreadMode( EventArgs& args )
+{
+	bool isThreaded = args.GetValue( "threaded", !g_theRenderThread->IsThreaded() );
+	g_theRenderThread->SetThreaded( isThreaded );
+
+	g_theConsole->AddLine( DevConsole::INFO_MAJOR, Stringf( "Render thread: %s", isThreaded ? "threaded" : "inline" ) );
+	return true;
+}
+
+
 //----------------------------------------------------------------------------------------------- 
+// The scene packet submitted last frame is still drawing; overlays go on top of it once it finishes,
+// so the scene on screen is one frame behind the overlays
+//
 void App::Render() const
 {
+	g_theRenderThread->WaitUntilIdle();
+
 	m_theGame->Render();
 	g_theDebugUISystem->Render();
 }
@@ -201,33 +302,21 @@ void App::Render() const
 //----------------------------------------------------------------------------------------------- 
 void App::EndFrame()
 {
-	if ( g_theInput->WasKeyJustPressed( KEYCODE_F1 ) )
-	{
-		g_theRenderer->RecompileAllShaders();
-	}
-
-	if ( g_theInput->WasKeyJustPressed( KEYCODE_F2 ) )
-	{
-		m_theGame->ReloadXMLData();
-	}
-
-	if ( g_theInput->WasKeyJustPressed( KEYCODE_SQUARE_OPEN_BRACKET ) )
-	{
-		m_theGame->LoadPreviousScene();
-	}
-
-	if ( g_theInput->WasKeyJustPressed( KEYCODE_SQUARE_CLOSE_BRACKET ) )
-	{
-		m_theGame->LoadNextScene();
-	}
-
 	g_theDebugUISystem->EndFrame();
 	g_theConsole->EndFrame();
 	g_theAudio->EndFrame();
+
+	// Present, then start the next renderer frame ( streamed texture uploads ) while the context is still
+	// free, and only then hand this frame's scene to the render thread
 	g_theRenderer->EndFrame();
+	g_theRenderer->BeginFrame();
+	m_theGame->SubmitFramePacket();
+
 	g_theWindow->EndFrame();
 	g_theInput->EndFrame();
+	g_theJobSystem->EndFrame();
 	g_theEventSystem->EndFrame();
+	g_theFrameArena->EndFrame();
 }
 
 
@@ -236,6 +325,11 @@ void App::Shutdown()
 {
 	g_theInput->PopMouseConfig( m_defaultConfig );
 
+	// Finishes the last submitted frame before the game releases anything it references
+	g_theRenderThread->Shutdown();
+	delete g_theRenderThread;
+	g_theRenderThread = nullptr;
+
 	m_theGame->Shutdown();
 	delete m_theGame;
 	m_theGame = nullptr;
@@ -271,10 +365,18 @@ void App::Shutdown()
 	g_theInput->Shutdown();
 	delete g_theInput;
 	g_theInput = nullptr;
+
+	g_theJobSystem->Shutdown();
+	delete g_theJobSystem;
+	g_theJobSystem = nullptr;
 	
 	g_theEventSystem->Shutdown();
 	delete g_theEventSystem;
 	g_theEventSystem = nullptr;
 
+	g_theFrameArena->Shutdown();
+	delete g_theFrameArena;
+	g_theFrameArena = nullptr;
+
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/FixedTimestep.hpp"
 #include "Game/EngineBuildPreferences.hpp"
 
 
@@ -22,10 +23,14 @@ public:
 
 	bool HandleQuitRequested();
 	static bool QuitApp( EventArgs& args );
+	static bool SetSimulationMode( EventArgs& args );
+	static bool SetRenderThreadMode( EventArgs& args );
+
+	FixedTimestep const& GetSimulationTimestep() const { return m_simulationTimestep; }
 
 private:
 	void BeginFrame();
-	void Update( float deltaSeconds );
+	void Update( int numSimulationTicks );
 	void Render() const;
 	void EndFrame();
 	void ResetGame();
@@ -33,8 +38,9 @@ private:
 
 
 private:
-	bool         m_isQuitting = false;
-	Game*        m_theGame    = nullptr;
+	bool          m_isQuitting = false;
+	Game*         m_theGame    = nullptr;
+	FixedTimestep m_simulationTimestep;		// game simulation ticks; rendering interpolates between the last two
 
-	MouseConfig* m_defaultConfig;
+	MouseConfig*  m_defaultConfig;
 };
\ No newline at end of file
@@ -0,0 +1,392 @@
+#include "CompiledDefinitions.hpp"
+
+#include "Game/Definitions/LightConfigurations.hpp"
+#include "Game/Definitions/SceneSetting.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/XMLUtils.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+
+//------------------------------------------------------------------------------------------------
+constexpr uint32_t COMPILED_DEFINITIONS_FOURCC  = 'G' | ( 'D' << 8 ) | ( 'E' << 16 ) | ( 'F' << 24 );
+constexpr uint32_t COMPILED_DEFINITIONS_VERSION = 1;
+
+
+//------------------------------------------------------------------------------------------------
+// The shader data size guards against a blob compiled before ShaderLightData changed layout
+//
+struct CompiledDefinitionsHeader
+{
+	uint32_t m_fourCC                = COMPILED_DEFINITIONS_FOURCC;
+	uint32_t m_version               = COMPILED_DEFINITIONS_VERSION;
+	uint32_t m_shaderLightDataSize   = static_cast< uint32_t >( sizeof( ShaderLightData ) );
+	uint32_t m_numLightConfigs       = 0;
+	uint32_t m_numScenes             = 0;
+};
+
+
+//------------------------------------------------------------------------------------------------
+void DefinitionBlobReader::Read( std::string& out_value )
+{
+	uint32_t length = 0;
+	Read( length );
+	if ( !m_isValid || m_offset + length > m_size )
+	{
+		out_value.clear();
+		m_isValid = false;
+		return;
+	}
+
+	out_value.assign( reinterpret_cast< char const* >( m_data + m_offset ), length );
+	m_offset += length;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void AppendToDefinitionBlob( std::vector<uint8_t>& blob, std::string const& value )
+{
+	AppendToDefinitionBlob( blob, static_cast< uint32_t >( value.size() ) );
+	blob.insert( blob.end(), value.begin(), value.end() );
+}
+
+
+//------------------------------------------------------------------------------------------------
+static void DeleteDefinitions()
+{
+	for ( SceneSetting* scene : SceneSetting::s_sceneDefs )
+	{
+		delete scene;
+	}
+	SceneSetting::s_sceneDefs.clear();
+
+	for ( LightConfiguration* config : LightConfiguration::s_lightDefs )
+	{
+		delete config;
+	}
+	LightConfiguration::s_lightDefs.clear();
+}
+
+
+//------------------------------------------------------------------------------------------------
+static tinyxml2::XMLElement* ParseXmlFromRequest( tinyxml2::XMLDocument& doc, FileReadRequest const& request )
+{
+	if ( !request.m_succeeded )
+		return nullptr;
+
+	doc.Parse( reinterpret_cast< char const* >( request.m_buffer.data() ), request.m_buffer.size() - 1 );
+	return doc.ErrorID() == tinyxml2::XML_SUCCESS ? doc.RootElement() : nullptr;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Both files are read as one batch so the scene settings read overlaps the light configurations read
+//
+bool LoadDefinitionsFromXml( char const* lightConfigXmlPath, char const* sceneSettingXmlPath )
+{
+	FileReadRequest xmlReads[ 2 ];
+	xmlReads[ 0 ].m_filename = lightConfigXmlPath;
+	xmlReads[ 1 ].m_filename = sceneSettingXmlPath;
+	FileReadBatch( xmlReads, 2 );
+
+	tinyxml2::XMLDocument doc;
+	tinyxml2::XMLElement* root = ParseXmlFromRequest( doc, xmlReads[ 0 ] );
+	if ( root == nullptr || _strcmpi( root->Name(), "LightConfigurations" ) != 0 )
+	{
+		DebuggerPrintf( "Error Opening the Light Config XML Document \"%s\"\n", lightConfigXmlPath );
+		return false;
+	}
+
+	tinyxml2::XMLElement* childOfRoot = root->FirstChildElement();
+
+	LightConfiguration::s_lightDefs.clear();
+	while ( childOfRoot )
+	{
+		LightConfiguration* config = new LightConfiguration();
+		if ( !config->LoadFromXmlElement( *childOfRoot ) )
+		{
+			DebuggerPrintf( "Invalid light configuration in \"%s\"\n", lightConfigXmlPath );
+			delete config;
+			DeleteDefinitions();
+			return false;
+		}
+
+		childOfRoot = childOfRoot->NextSiblingElement();
+	}
+
+	root = ParseXmlFromRequest( doc, xmlReads[ 1 ] );
+	if ( root == nullptr || _strcmpi( root->Name(), "SceneSettings" ) != 0 )
+	{
+		DebuggerPrintf( "Error Opening the Scene Setting XML Document \"%s\"\n", sceneSettingXmlPath );
+		DeleteDefinitions();
+		return false;
+	}
+
+	childOfRoot = root->FirstChildElement();
+
+	SceneSetting::s_sceneDefs.clear();
+	while ( childOfRoot )
+	{
+		SceneSetting* config = new SceneSetting();
+		if ( !config->LoadFromXmlElement( *childOfRoot ) )
+		{
+			DebuggerPrintf( "Invalid scene setting in \"%s\"\n", sceneSettingXmlPath );
+			delete config;
+			DeleteDefinitions();
+			return false;
+		}
+
+		childOfRoot = childOfRoot->NextSiblingElement();
+	}
+
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool WriteCompiledDefinitions( char const* blobPath )
+{
+	CompiledDefinitionsHeader header;
+	header.m_numLightConfigs = static_cast< uint32_t >( LightConfiguration::s_lightDefs.size() );
+	header.m_numScenes       = static_cast< uint32_t >( SceneSetting::s_sceneDefs.size() );
+
+	std::vector<uint8_t> blob;
+	AppendToDefinitionBlob( blob, header );
+
+	for ( LightConfiguration const* config : LightConfiguration::s_lightDefs )
+	{
+		config->AppendToBlob( blob );
+	}
+
+	for ( SceneSetting const* scene : SceneSetting::s_sceneDefs )
+	{
+		scene->AppendToBlob( blob );
+	}
+
+	return BufferWriteToFile( blob, blobPath );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Light configurations come first in the blob since scenes look theirs up by id
+//
+bool LoadCompiledDefinitions( char const* blobPath )
+{
+	MappedFile file;
+	if ( !file.Open( blobPath ) )
+		return false;
+
+	DefinitionBlobReader reader;
+	reader.m_data = file.GetData();
+	reader.m_size = file.GetSize();
+
+	CompiledDefinitionsHeader header;
+	reader.Read( header );
+	if ( !reader.m_isValid || header.m_fourCC != COMPILED_DEFINITIONS_FOURCC || header.m_version != COMPILED_DEFINITIONS_VERSION ||
+		 header.m_shaderLightDataSize != sizeof( ShaderLightData ) )
+		return false;
+
+	LightConfiguration::s_lightDefs.clear();
+	SceneSetting::s_sceneDefs.clear();
+
+	for ( uint32_t configNum = 0; configNum < header.m_numLightConfigs; configNum++ )
+	{
+		LightConfiguration* config = new LightConfiguration();
+		if ( !config->LoadFromBlob( reader ) )
+		{
+			delete config;
+			DeleteDefinitions();
+			return false;
+		}
+	}
+
+	for ( uint32_t sceneNum = 0; sceneNum < header.m_numScenes; sceneNum++ )
+	{
+		SceneSetting* scene = new SceneSetting();
+		if ( !scene->LoadFromBlob( reader ) )
+		{
+			delete scene;
+			DeleteDefinitions();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Same policy as cooked textures: a blob without its XML is still usable, so shipped data can
+// leave the XML out, and a stale or unreadable blob is recompiled from the XML
+//
+bool LoadOrCompileDefinitions()
+{
+	std::error_code lightXmlError;
+	std::error_code sceneXmlError;
+	std::error_code blobError;
+	std::filesystem::file_time_type lightXmlTime = std::filesystem::last_write_time( LIGHT_CONFIGURATIONS_XML_PATH, lightXmlError );
+	std::filesystem::file_time_type sceneXmlTime = std::filesystem::last_write_time( SCENE_SETTINGS_XML_PATH, sceneXmlError );
+	std::filesystem::file_time_type blobTime     = std::filesystem::last_write_time( COMPILED_DEFINITIONS_PATH, blobError );
+
+	bool isBlobCurrent = !blobError && ( lightXmlError || blobTime >= lightXmlTime ) && ( sceneXmlError || blobTime >= sceneXmlTime );
+	if ( isBlobCurrent && LoadCompiledDefinitions( COMPILED_DEFINITIONS_PATH ) )
+		return true;
+
+	if ( !LoadDefinitionsFromXml( LIGHT_CONFIGURATIONS_XML_PATH, SCENE_SETTINGS_XML_PATH ) )
+		return false;
+
+	if ( !WriteCompiledDefinitions( COMPILED_DEFINITIONS_PATH ) )
+	{
+		DebuggerPrintf( "Failed to write compiled definitions \"%s\"\n", COMPILED_DEFINITIONS_PATH );
+	}
+
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+template <typename T>
+static T* FindDefinitionByID( std::vector<T*> const& defs, int id )
+{
+	for ( T* def : defs )
+	{
+		if ( def && def->m_id == id )
+			return def;
+	}
+
+	return nullptr;
+}
+
+
+//------------------------------------------------------------------------------------------------
+template <typename T>
+static bool AreDefinitionsEqual( T const& a, T const& b )
+{
+	std::vector<uint8_t> blobA;
+	std::vector<uint8_t> blobB;
+	a.AppendToBlob( blobA );
+	b.AppendToBlob( blobB );
+	return blobA == blobB;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Live definitions are matched to the freshly loaded ones by id and compared as compiled records.
+// A changed definition is copied into the live object so pointers held elsewhere stay valid, and a
+// changed scene keeps the objects whose FBX didn't change
+//
+bool ReloadDefinitions( DefinitionReloadResult& out_result )
+{
+	std::vector<LightConfiguration*> liveLightDefs;
+	std::vector<SceneSetting*>       liveSceneDefs;
+	liveLightDefs.swap( LightConfiguration::s_lightDefs );
+	liveSceneDefs.swap( SceneSetting::s_sceneDefs );
+
+	if ( !LoadOrCompileDefinitions() )
+	{
+		DeleteDefinitions();
+		LightConfiguration::s_lightDefs.swap( liveLightDefs );
+		SceneSetting::s_sceneDefs.swap( liveSceneDefs );
+		return false;
+	}
+
+	std::vector<LightConfiguration*> loadedLightDefs;
+	std::vector<SceneSetting*>       loadedSceneDefs;
+	loadedLightDefs.swap( LightConfiguration::s_lightDefs );
+	loadedSceneDefs.swap( SceneSetting::s_sceneDefs );
+
+	// Loaded scenes point at loaded light configs, so those are only deleted once the scenes are merged
+	std::vector<LightConfiguration*> lightDefsToDelete;
+	for ( LightConfiguration* loadedConfig : loadedLightDefs )
+	{
+		LightConfiguration* liveConfig = FindDefinitionByID( liveLightDefs, loadedConfig->m_id );
+		if ( liveConfig == nullptr )
+		{
+			LightConfiguration::s_lightDefs.push_back( loadedConfig );
+			out_result.m_changedLightConfigIDs.push_back( loadedConfig->m_id );
+			continue;
+		}
+
+		if ( !AreDefinitionsEqual( *liveConfig, *loadedConfig ) )
+		{
+			*liveConfig = *loadedConfig;
+			out_result.m_changedLightConfigIDs.push_back( liveConfig->m_id );
+		}
+
+		LightConfiguration::s_lightDefs.push_back( liveConfig );
+		lightDefsToDelete.push_back( loadedConfig );
+		std::replace( liveLightDefs.begin(), liveLightDefs.end(), liveConfig, static_cast< LightConfiguration* >( nullptr ) );
+	}
+
+	for ( SceneSetting* loadedScene : loadedSceneDefs )
+	{
+		SceneSetting* liveScene = FindDefinitionByID( liveSceneDefs, loadedScene->m_id );
+		bool isSceneChanged = liveScene == nullptr || !AreDefinitionsEqual( *liveScene, *loadedScene );
+		loadedScene->m_lightConfig = LightConfiguration::GetLightConfigurationByID( loadedScene->m_lightConfig->m_id );
+
+		if ( liveScene == nullptr )
+		{
+			loadedScene->CreateSceneObjects();
+			SceneSetting::s_sceneDefs.push_back( loadedScene );
+		}
+		else
+		{
+			if ( isSceneChanged )
+			{
+				liveScene->ApplyDefinition( *loadedScene );
+			}
+
+			SceneSetting::s_sceneDefs.push_back( liveScene );
+			std::replace( liveSceneDefs.begin(), liveSceneDefs.end(), liveScene, static_cast< SceneSetting* >( nullptr ) );
+			delete loadedScene;
+		}
+
+		if ( isSceneChanged )
+		{
+			out_result.m_changedSceneIDs.push_back( SceneSetting::s_sceneDefs.back()->m_id );
+		}
+	}
+
+	for ( SceneSetting* removedScene : liveSceneDefs )
+	{
+		if ( removedScene )
+		{
+			removedScene->DestroySceneObjects();
+			delete removedScene;
+			out_result.m_numRemovedDefinitions++;
+		}
+	}
+
+	for ( LightConfiguration* removedConfig : liveLightDefs )
+	{
+		if ( removedConfig )
+		{
+			delete removedConfig;
+			out_result.m_numRemovedDefinitions++;
+		}
+	}
+
+	for ( LightConfiguration* config : lightDefsToDelete )
+	{
+		delete config;
+	}
+
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool DefinitionReloadResult::IsLightConfigChanged( int id ) const
+{
+	return std::find( m_changedLightConfigIDs.begin(), m_changedLightConfigIDs.end(), id ) != m_changedLightConfigIDs.end();
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool DefinitionReloadResult::IsSceneChanged( int id ) const
+{
+	return std::find( m_changedSceneIDs.begin(), m_changedSceneIDs.end(), id ) != m_changedSceneIDs.end();
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "Game/GameCommon.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+//------------------------------------------------------------------------------------------------
+constexpr char const* LIGHT_CONFIGURATIONS_XML_PATH = "Data/XML/LightConfigurations.xml";
+constexpr char const* SCENE_SETTINGS_XML_PATH       = "Data/XML/SceneSetting.xml";
+constexpr char const* COMPILED_DEFINITIONS_PATH     = "Data/XML/Definitions.gdef";
+
+
+//------------------------------------------------------------------------------------------------
+// Bounds checked cursor over a compiled definitions blob; a short read zeroes the value and
+// marks the whole reader invalid instead of reading past the end
+//
+struct DefinitionBlobReader
+{
+	uint8_t const* m_data    = nullptr;
+	size_t         m_size    = 0;
+	size_t         m_offset  = 0;
+	bool           m_isValid = true;
+
+	template <typename T>
+	void Read( T& out_value )
+	{
+		if ( !m_isValid || m_offset + sizeof( T ) > m_size )
+		{
+			memset( static_cast< void* >( &out_value ), 0, sizeof( T ) );
+			m_isValid = false;
+			return;
+		}
+
+		memcpy( static_cast< void* >( &out_value ), m_data + m_offset, sizeof( T ) );
+		m_offset += sizeof( T );
+	}
+
+	void Read( std::string& out_value );
+};
+
+
+//------------------------------------------------------------------------------------------------
+template <typename T>
+void AppendToDefinitionBlob( std::vector<uint8_t>& blob, T const& value )
+{
+	uint8_t const* bytes = reinterpret_cast< uint8_t const* >( &value );
+	blob.insert( blob.end(), bytes, bytes + sizeof( T ) );
+}
+
+void AppendToDefinitionBlob( std::vector<uint8_t>& blob, std::string const& value );
+
+
+//------------------------------------------------------------------------------------------------
+struct DefinitionReloadResult
+{
+	std::vector<int> m_changedLightConfigIDs;		// includes added ones
+	std::vector<int> m_changedSceneIDs;
+	int              m_numRemovedDefinitions = 0;
+
+	bool IsLightConfigChanged( int id ) const;
+	bool IsSceneChanged( int id ) const;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// The XML is validated and compiled once into fixed layout records; later runs load those with no
+// string parsing until either XML file is newer than the blob. The XML stays the authoring path
+//
+bool LoadDefinitionsFromXml( char const* lightConfigXmlPath, char const* sceneSettingXmlPath );
+bool WriteCompiledDefinitions( char const* blobPath );
+bool LoadCompiledDefinitions( char const* blobPath );
+bool LoadOrCompileDefinitions();	// fills LightConfiguration::s_lightDefs and SceneSetting::s_sceneDefs
+bool ReloadDefinitions( DefinitionReloadResult& out_result );	// keeps the live definitions when loading fails
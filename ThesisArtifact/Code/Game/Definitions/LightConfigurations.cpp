@@ -1,5 +1,7 @@
 #include "LightConfigurations.hpp"
 
+#include "Game/Definitions/CompiledDefinitions.hpp"
+
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Math/Vec3.hpp"
 
@@ -11,12 +13,20 @@ std::vector<LightConfiguration*> LightConfiguration::s_lightDefs;
 //------------------------------------------------------------------------------------------------
 bool LightConfiguration::LoadFromXmlElement( XmlElement const& elem )
 {
-	GUARANTEE_OR_DIE( _strcmpi( elem.Name(), "LightConfiguration" ) == 0, "Error In XML Format" );
+	if ( _strcmpi( elem.Name(), "LightConfiguration" ) != 0 )
+	{
+		DebuggerPrintf( "Error In XML Format: expected LightConfiguration, found %s\n", elem.Name() );
+		return false;
+	}
 
 	tinyxml2::XMLElement const* element = &elem;
 	m_id = ParseXmlAttribute( *element, "id", 9999 );
 
-	ASSERT_OR_DIE( GetLightConfigurationByID( m_id ) == nullptr, "Duplicate Data Found In LightConfiguration" );
+	if ( GetLightConfigurationByID( m_id ) != nullptr )
+	{
+		DebuggerPrintf( "Duplicate Data Found In LightConfiguration: id %d is used twice\n", m_id );
+		return false;
+	}
 
 	LightDataC data;
 	
@@ -49,9 +59,15 @@ bool LightConfiguration::LoadFromXmlElement( XmlElement const& elem )
 	data.m_color.z = colorAsFloats[2];
 
 	//Cascade values
-	m_numCascades = ParseXmlAttribute( *element, "numCascades", 1 );
+	int numCascades = ParseXmlAttribute( *element, "numCascades", 1 );
+	if ( numCascades < 1 || numCascades > static_cast< int >( NUM_CASCADES ) )
+	{
+		DebuggerPrintf( "LightConfiguration %d: numCascades %d is outside 1 to %u; clamping\n", m_id, numCascades, NUM_CASCADES );
+		numCascades = numCascades < 1 ? 1 : static_cast< int >( NUM_CASCADES );
+	}
+	m_numCascades = static_cast< uint >( numCascades );
 	
-	for ( uint cascadeNum = 0; cascadeNum < m_numCascades && cascadeNum < NUM_CASCADES; cascadeNum++ )
+	for ( uint cascadeNum = 0; cascadeNum < m_numCascades; cascadeNum++ )
 	{
 		m_cascadePercentages[cascadeNum] = ParseXmlAttribute( *element, Stringf( "cascade%d", cascadeNum ).c_str(), 10 );
 		if ( cascadeNum != 0 && m_cascadePercentages[cascadeNum] < m_cascadePercentages[cascadeNum - 1] )
@@ -207,6 +223,51 @@ bool LightConfiguration::LoadFromXmlElement( XmlElement const& elem )
 	}
 
 	m_numLights = index;
+	m_shaderData.m_numLights = index;
+
+	s_lightDefs.push_back( this );
+
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Every member is plain data, so the record is the members back to back in declaration order
+//
+void LightConfiguration::AppendToBlob( std::vector<uint8_t>& blob ) const
+{
+	AppendToDefinitionBlob( blob, m_id );
+	AppendToDefinitionBlob( blob, m_numLights );
+	AppendToDefinitionBlob( blob, m_shaderData );
+	AppendToDefinitionBlob( blob, m_numCascades );
+	AppendToDefinitionBlob( blob, m_cascadePercentages );
+	AppendToDefinitionBlob( blob, m_lightRotating );
+	AppendToDefinitionBlob( blob, m_lightRotatingAxis );
+	AppendToDefinitionBlob( blob, m_lightMoving );
+	AppendToDefinitionBlob( blob, m_lightMoveSpeed );
+	AppendToDefinitionBlob( blob, m_lightStartPosition );
+	AppendToDefinitionBlob( blob, m_lightEndPosition );
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool LightConfiguration::LoadFromBlob( DefinitionBlobReader& reader )
+{
+	reader.Read( m_id );
+	reader.Read( m_numLights );
+	reader.Read( m_shaderData );
+	reader.Read( m_numCascades );
+	reader.Read( m_cascadePercentages );
+	reader.Read( m_lightRotating );
+	reader.Read( m_lightRotatingAxis );
+	reader.Read( m_lightMoving );
+	reader.Read( m_lightMoveSpeed );
+	reader.Read( m_lightStartPosition );
+	reader.Read( m_lightEndPosition );
+
+	// Cascade counts size the per view bit masks and cascade loops, so a bad one means a bad blob
+	if ( !reader.m_isValid || m_numLights > MAXLIGHTS || m_numCascades == 0 || m_numCascades > NUM_CASCADES || GetLightConfigurationByID( m_id ) != nullptr )
+		return false;
 
 	s_lightDefs.push_back( this );
 
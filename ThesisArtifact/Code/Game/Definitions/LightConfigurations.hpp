@@ -4,15 +4,22 @@
 #include "Engine/Core/XMLUtils.hpp"
 #include "Engine/Renderer/LightStructure.hpp"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 
+//------------------------------------------------------------------------------------------------
+struct DefinitionBlobReader;
+
+
 //------------------------------------------------------------------------------------------------
 class LightConfiguration
 {
 public:
 	bool                             LoadFromXmlElement( XmlElement const& elem );
+	void                             AppendToBlob( std::vector<uint8_t>& blob ) const;
+	bool                             LoadFromBlob( DefinitionBlobReader& reader );
 	static LightConfiguration const* GetLightConfigurationByID( int id );
 
 public:
@@ -1,8 +1,10 @@
 #include "SceneSetting.hpp"
 
+#include "Game/Definitions/CompiledDefinitions.hpp"
 #include "Game/Definitions/LightConfigurations.hpp"
 #include "Game/FBXSceneObject.hpp"
 
+#include "Engine/3D/Model.hpp"
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 
@@ -13,17 +15,29 @@ std::vector<SceneSetting*> SceneSetting::s_sceneDefs;
 //------------------------------------------------------------------------------------------------
 bool SceneSetting::LoadFromXmlElement( XmlElement const& elem )
 {
-	GUARANTEE_OR_DIE( _strcmpi( elem.Name(), "Scene" ) == 0, "Error In XML Format" );
+	if ( _strcmpi( elem.Name(), "Scene" ) != 0 )
+	{
+		DebuggerPrintf( "Error In XML Format: expected Scene, found %s\n", elem.Name() );
+		return false;
+	}
 
 	tinyxml2::XMLElement const* element = &elem;
 	m_id = ParseXmlAttribute( *element, "id", 9999 );
 
-	ASSERT_OR_DIE( GetSceneSettingByID( m_id ) == nullptr, "Duplicate Data Found In Scene Settings" );
+	if ( GetSceneSettingByID( m_id ) != nullptr )
+	{
+		DebuggerPrintf( "Duplicate Data Found In Scene Settings: id %d is used twice\n", m_id );
+		return false;
+	}
 
-	uint lightConfig = ParseXmlAttribute( *element, "lightConfig", 9999 );
+	int lightConfig = ParseXmlAttribute( *element, "lightConfig", 9999 );
 	LightConfiguration const* config = LightConfiguration::GetLightConfigurationByID( lightConfig );
 	m_lightConfig = config;
-	ASSERT_OR_DIE( config != nullptr, "LightConfig not found" );
+	if ( config == nullptr )
+	{
+		DebuggerPrintf( "LightConfig %d not found for scene %d\n", lightConfig, m_id );
+		return false;
+	}
 
 	m_name = ParseXmlAttribute( *element, "name", "" );
 
@@ -62,28 +76,17 @@ bool SceneSetting::LoadFromXmlElement( XmlElement const& elem )
 
 	while ( firstFBXChild )
 	{
-		Vec3 position    = ParseXmlAttribute( *firstFBXChild, "position", Vec3(777.0f, 777.0f, 777.0f) );
-		EulerAngles fbxOrientation;
-		Vec3 orientation = ParseXmlAttribute( *firstFBXChild, "orientation", Vec3::ZERO );
-		fbxOrientation.m_yawDegrees   = orientation.x;
-		fbxOrientation.m_pitchDegrees = orientation.y;
-		fbxOrientation.m_rollDegrees  = orientation.z;
-
-		std::string fbxPath           = ParseXmlAttribute( *firstFBXChild, "path", "" );
-		std::string texturePath       = ParseXmlAttribute( *firstFBXChild, "texturePath", "" );
-		std::string normalTexturePath = ParseXmlAttribute( *firstFBXChild, "normalTexturePath", "" );
-
-		FBXSceneObject* object = new FBXSceneObject( g_theGame, position, fbxOrientation, fbxPath );
-		m_sceneObjects.push_back( object );
+		SceneModelDefinition modelDef;
+		modelDef.m_position = ParseXmlAttribute( *firstFBXChild, "position", Vec3(777.0f, 777.0f, 777.0f) );
+		Vec3 orientation    = ParseXmlAttribute( *firstFBXChild, "orientation", Vec3::ZERO );
+		modelDef.m_orientation.m_yawDegrees   = orientation.x;
+		modelDef.m_orientation.m_pitchDegrees = orientation.y;
+		modelDef.m_orientation.m_rollDegrees  = orientation.z;
 
-		if ( texturePath.length() > 1 )
-		{
-			object->m_texture       = g_theRenderer->CreateOrGetTextureFromFile( texturePath.c_str() );
-		}
-		if ( normalTexturePath.length() > 1 )
-		{
-			object->m_normalTexture = g_theRenderer->CreateOrGetTextureFromFile( texturePath.c_str() );
-		}		
+		modelDef.m_fbxPath           = ParseXmlAttribute( *firstFBXChild, "path", "" );
+		modelDef.m_texturePath       = ParseXmlAttribute( *firstFBXChild, "texturePath", "" );
+		modelDef.m_normalTexturePath = ParseXmlAttribute( *firstFBXChild, "normalTexturePath", "" );
+		m_modelDefs.push_back( modelDef );
 		
 		firstFBXChild = firstFBXChild->NextSiblingElement("FBXModel");
 	}
@@ -94,6 +97,173 @@ bool SceneSetting::LoadFromXmlElement( XmlElement const& elem )
 }
 
 
+//------------------------------------------------------------------------------------------------
+void SceneSetting::AppendToBlob( std::vector<uint8_t>& blob ) const
+{
+	AppendToDefinitionBlob( blob, m_id );
+	AppendToDefinitionBlob( blob, m_name );
+	AppendToDefinitionBlob( blob, m_lightConfig->m_id );
+
+	AppendToDefinitionBlob( blob, m_cam1Position );
+	AppendToDefinitionBlob( blob, m_cam1Orientation );
+	AppendToDefinitionBlob( blob, m_cam2Position );
+	AppendToDefinitionBlob( blob, m_cam2Orientation );
+	AppendToDefinitionBlob( blob, m_useCamera1 );
+
+	AppendToDefinitionBlob( blob, m_debugSpecificLight );
+	AppendToDefinitionBlob( blob, m_debugFrustum );
+	AppendToDefinitionBlob( blob, m_debugCascades );
+	AppendToDefinitionBlob( blob, m_debugSpecCascades );
+	AppendToDefinitionBlob( blob, m_debugDepthBuffer );
+	AppendToDefinitionBlob( blob, m_debugAllDepthBuffers );
+	AppendToDefinitionBlob( blob, m_debugCascadeNum );
+	AppendToDefinitionBlob( blob, m_specCascadeNum );
+
+	AppendToDefinitionBlob( blob, m_nearPlane );
+	AppendToDefinitionBlob( blob, m_farPlane );
+	AppendToDefinitionBlob( blob, m_numSamples );
+	AppendToDefinitionBlob( blob, m_enablePCF );
+	AppendToDefinitionBlob( blob, m_hideDefaultGeometry );
+
+	AppendToDefinitionBlob( blob, static_cast< uint32_t >( m_modelDefs.size() ) );
+	for ( SceneModelDefinition const& modelDef : m_modelDefs )
+	{
+		AppendToDefinitionBlob( blob, modelDef.m_position );
+		AppendToDefinitionBlob( blob, modelDef.m_orientation );
+		AppendToDefinitionBlob( blob, modelDef.m_fbxPath );
+		AppendToDefinitionBlob( blob, modelDef.m_texturePath );
+		AppendToDefinitionBlob( blob, modelDef.m_normalTexturePath );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+bool SceneSetting::LoadFromBlob( DefinitionBlobReader& reader )
+{
+	int lightConfigID = 0;
+	reader.Read( m_id );
+	reader.Read( m_name );
+	reader.Read( lightConfigID );
+
+	reader.Read( m_cam1Position );
+	reader.Read( m_cam1Orientation );
+	reader.Read( m_cam2Position );
+	reader.Read( m_cam2Orientation );
+	reader.Read( m_useCamera1 );
+
+	reader.Read( m_debugSpecificLight );
+	reader.Read( m_debugFrustum );
+	reader.Read( m_debugCascades );
+	reader.Read( m_debugSpecCascades );
+	reader.Read( m_debugDepthBuffer );
+	reader.Read( m_debugAllDepthBuffers );
+	reader.Read( m_debugCascadeNum );
+	reader.Read( m_specCascadeNum );
+
+	reader.Read( m_nearPlane );
+	reader.Read( m_farPlane );
+	reader.Read( m_numSamples );
+	reader.Read( m_enablePCF );
+	reader.Read( m_hideDefaultGeometry );
+
+	uint32_t numModels = 0;
+	reader.Read( numModels );
+	for ( uint32_t modelNum = 0; modelNum < numModels && reader.m_isValid; modelNum++ )
+	{
+		SceneModelDefinition modelDef;
+		reader.Read( modelDef.m_position );
+		reader.Read( modelDef.m_orientation );
+		reader.Read( modelDef.m_fbxPath );
+		reader.Read( modelDef.m_texturePath );
+		reader.Read( modelDef.m_normalTexturePath );
+		m_modelDefs.push_back( modelDef );
+	}
+
+	m_lightConfig = LightConfiguration::GetLightConfigurationByID( lightConfigID );
+	if ( !reader.m_isValid || m_lightConfig == nullptr || GetSceneSettingByID( m_id ) != nullptr )
+		return false;
+
+	s_sceneDefs.push_back( this );
+
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// An object is reused when it was built from the same FBX, which skips copying the model's node tree
+//
+void SceneSetting::CreateSceneObjects( std::vector<FBXSceneObject*>* objectsToReuse )
+{
+	for ( SceneModelDefinition const& modelDef : m_modelDefs )
+	{
+		FBXSceneObject* object = nullptr;
+		if ( objectsToReuse )
+		{
+			for ( size_t objectNum = 0; objectNum < objectsToReuse->size(); objectNum++ )
+			{
+				FBXSceneObject* candidate = ( *objectsToReuse )[ objectNum ];
+				if ( _strcmpi( candidate->m_fbxModel->m_filePath.c_str(), modelDef.m_fbxPath.c_str() ) == 0 )
+				{
+					object = candidate;
+					objectsToReuse->erase( objectsToReuse->begin() + objectNum );
+					break;
+				}
+			}
+		}
+
+		if ( object )
+		{
+			object->m_position      = modelDef.m_position;
+			object->m_orientation   = modelDef.m_orientation;
+			object->m_texture       = nullptr;
+			object->m_normalTexture = nullptr;
+		}
+		else
+		{
+			object = new FBXSceneObject( g_theGame, modelDef.m_position, modelDef.m_orientation, modelDef.m_fbxPath );
+		}
+		m_sceneObjects.push_back( object );
+
+		if ( modelDef.m_texturePath.length() > 1 )
+		{
+			object->m_texture       = g_theRenderer->CreateOrGetTextureFromFile( modelDef.m_texturePath.c_str() );
+		}
+		if ( modelDef.m_normalTexturePath.length() > 1 )
+		{
+			object->m_normalTexture = g_theRenderer->CreateOrGetTextureFromFile( modelDef.m_normalTexturePath.c_str(), TextureUsage::NORMAL_MAP );
+		}
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+void SceneSetting::DestroySceneObjects()
+{
+	for ( FBXSceneObject* object : m_sceneObjects )
+	{
+		delete object;
+	}
+	m_sceneObjects.clear();
+}
+
+
+//------------------------------------------------------------------------------------------------
+void SceneSetting::ApplyDefinition( SceneSetting const& definition )
+{
+	std::vector<FBXSceneObject*> previousObjects;
+	previousObjects.swap( m_sceneObjects );
+
+	*this = definition;
+	m_sceneObjects.clear();
+	CreateSceneObjects( &previousObjects );
+
+	for ( FBXSceneObject* object : previousObjects )
+	{
+		delete object;
+	}
+}
+
+
 //------------------------------------------------------------------------------------------------
 SceneSetting const* SceneSetting::GetSceneSettingByID( int id )
 {
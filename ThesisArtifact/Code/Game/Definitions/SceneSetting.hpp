@@ -5,6 +5,7 @@
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/EulerAngles.hpp"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -12,13 +13,33 @@
 //------------------------------------------------------------------------------------------------
 class LightConfiguration;
 class FBXSceneObject;
+struct DefinitionBlobReader;
 
 
 //------------------------------------------------------------------------------------------------
+struct SceneModelDefinition
+{
+	Vec3        m_position;
+	EulerAngles m_orientation;
+	std::string m_fbxPath;
+	std::string m_texturePath;
+	std::string m_normalTexturePath;
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Loading only fills the definition; CreateSceneObjects builds the models and textures it names.
+// ApplyDefinition updates a live scene in place and keeps the objects whose model didn't change
+//
 class SceneSetting
 {
 public:
 	bool                       LoadFromXmlElement( XmlElement const& elem );
+	void                       AppendToBlob( std::vector<uint8_t>& blob ) const;
+	bool                       LoadFromBlob( DefinitionBlobReader& reader );
+	void                       CreateSceneObjects( std::vector<FBXSceneObject*>* objectsToReuse = nullptr );	// reused objects are taken out of the list
+	void                       DestroySceneObjects();
+	void                       ApplyDefinition( SceneSetting const& definition );
 	static SceneSetting const* GetSceneSettingByID( int id );
 	static SceneSetting const* GetSceneSettingByName( std::string sceneName );
 
@@ -26,6 +47,7 @@ public:
 	int                               m_id;
 	std::string                       m_name;
 	LightConfiguration const*         m_lightConfig = nullptr;
+	std::vector<SceneModelDefinition> m_modelDefs;
 	std::vector<FBXSceneObject*>   	  m_sceneObjects;
 
 	Vec3                              m_cam1Position;
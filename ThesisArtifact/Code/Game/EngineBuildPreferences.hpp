@@ -10,9 +10,11 @@
 
 //#define ENGINE_DISABLE_AUDIO	// (If uncommented) Disables AudioSystem code and fmod linkage.
 //#define _OPENGL1
+//#define ENGINE_DISABLE_SIMD	// (If uncommented) Forces the scalar Mat44 math path instead of SSE.
 
 #if defined(_DEBUG)
 #define ENGINE_DEBUG_RENDERER
+#define ENGINE_TRACK_HEAP_ALLOCATIONS	// Replaces global operator new to count general heap allocations per thread ( see HeapAllocationScope ).
 #endif
 
 
@@ -3,15 +3,39 @@
 #include "Game/Game.hpp"
 
 #include "Engine/3D/Material.hpp"
+#include "Engine/3D/MeshLOD.hpp"
 #include "Engine/3D/Model.hpp"
 #include "Engine/3D/ModelNode.hpp"
 #include "Engine/3D/FBXLoader.hpp"
 #include "Engine/3D/VisualDatabase.hpp"
+#include "Engine/Renderer/DrawCommandList.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/RenderQueue.hpp"
 
 #include "fbxsdk/include/fbxsdk.h"
 
 
+//------------------------------------------------------------------------------------------------
+static ModelTransformationData GetGeometryModelData( GeometryNode const* geoNode )
+{
+	ModelTransformationData data;
+	data.modelMatrix = geoNode->GetLocalToWorldTransform();
+	if ( geoNode->HasPackedVertices() )
+	{
+		AABB3 const& bounds = geoNode->GetLocalBounds();
+		Vec3 extent = bounds.m_maxs - bounds.m_mins;
+		data.packedPositionOffset[ 0 ] = bounds.m_mins.x;
+		data.packedPositionOffset[ 1 ] = bounds.m_mins.y;
+		data.packedPositionOffset[ 2 ] = bounds.m_mins.z;
+		data.packedPositionScale[ 0 ] = extent.x;
+		data.packedPositionScale[ 1 ] = extent.y;
+		data.packedPositionScale[ 2 ] = extent.z;
+	}
+
+	return data;
+}
+
+
 //------------------------------------------------------------------------------------------------
 FBXSceneObject::FBXSceneObject( Game* Owner, Vec3 const& startPosition, EulerAngles const& orientation, std::string objectPath ) :
 	Object( Owner, startPosition, orientation )
@@ -38,7 +62,8 @@ void FBXSceneObject::Update( float deltaseconds )
 	m_modelMatrix.AppendYRotation( m_orientation.m_pitchDegrees );
 	m_modelMatrix.AppendXRotation( m_orientation.m_rollDegrees );
 
-	UpdateTraverse( m_fbxModel->m_node );
+	m_hasBounds = false;
+	m_fbxModel->m_node->UpdateWorldTransforms( m_modelMatrix, m_worldBounds, m_hasBounds );
 }
 
 
@@ -47,7 +72,32 @@ void FBXSceneObject::Render() const
 {
 	g_theRenderer->BindTexture( m_texture );
 	g_theRenderer->BindTexture( m_normalTexture, 1 );
-	RenderTraverse( m_fbxModel->m_node );
+	RenderTraverse( m_fbxModel->m_node, m_cameraLOD );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Records rather than draws so shadow views can be built on job workers. The caller binds the shader
+//
+void FBXSceneObject::RecordDepthOnly( DrawCommandList& commandList, int lightNum, int viewNum ) const
+{
+	RecordDepthOnlyTraverse( m_fbxModel->m_node, m_shadowLODs[ lightNum ][ viewNum ], commandList );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Queues one item per geometry node at the camera LOD; the queue sorts them and filters redundant binds
+//
+void FBXSceneObject::AddToRenderQueue( RenderQueue& queue, Shader* shader, RasterState const& rasterState, float depth ) const
+{
+	RenderQueueItem item;
+	item.m_shader         = shader;
+	item.m_rasterState    = rasterState;
+	item.m_diffuseTexture = m_texture;
+	item.m_normalTexture  = m_normalTexture;
+	item.m_depth          = depth;
+
+	AddToRenderQueueTraverse( m_fbxModel->m_node, queue, item );
 }
 
 
@@ -59,47 +109,98 @@ void FBXSceneObject::DebugRender() const
 
 
 //------------------------------------------------------------------------------------------------
-void FBXSceneObject::UpdateTraverse( ModelNode* node )
+void FBXSceneObject::RenderTraverse( ModelNode* node, uint lodNum ) const
 {
-	if ( node->GetParent() )
+	if ( node->m_nodeType == NodeType::Geometry )
 	{
-		Mat44 mat( node->GetParent()->GetLocalToWorldTransform() );
-		mat.Append( node->GetLocalToParentTransform() );
-		node->SetLocalToWorldTransform( mat );
+		GeometryNode* geoNode = node->AsGeometryNode();
+		//Material* material = geoNode->GetMaterial();
+		//material->SetRendererState();
+
+		MeshLOD const& lod = geoNode->GetLOD( lodNum );
+		CountGeometryDrawn( geoNode, lodNum, false );
+
+		g_theRenderer->SetModelBuffer( GetGeometryModelData( geoNode ) );
+
+		if ( !geoNode->HasPackedVertices() )
+		{
+			g_theRenderer->DrawIndexedVertexBuffer( geoNode->GetVertexBuffer(), geoNode->GetIndexBuffer(), lod.m_indexCount, lod.m_indexOffset );
+		}
+		else
+		{
+			g_theRenderer->DrawIndexedVertexStreams( geoNode->GetPositionVertexBuffer(), geoNode->GetAttributeVertexBuffer(), geoNode->GetIndexBuffer(), lod.m_indexCount, lod.m_indexOffset );
+		}
 	}
-	else
+
+	for ( ModelNode* childNode : node->GetChildren() )
 	{
-		Mat44 toWorldMatrix( m_modelMatrix );
-		toWorldMatrix.Append( node->GetLocalToParentTransform() );
-		node->SetLocalToWorldTransform( toWorldMatrix );
+		RenderTraverse( childNode, lodNum );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Shadow passes only need positions, so packed meshes bind just their position stream
+//
+void FBXSceneObject::RecordDepthOnlyTraverse( ModelNode* node, uint lodNum, DrawCommandList& commandList ) const
+{
+	if ( node->m_nodeType == NodeType::Geometry )
+	{
+		GeometryNode* geoNode = node->AsGeometryNode();
+
+		MeshLOD const& lod = geoNode->GetLOD( lodNum );
+		CountGeometryDrawn( geoNode, lodNum, true );
+
+		commandList.SetModelBuffer( GetGeometryModelData( geoNode ) );
+
+		VertexBuffer* vbo = geoNode->HasPackedVertices() ? geoNode->GetPositionVertexBuffer() : geoNode->GetVertexBuffer();
+		commandList.DrawIndexedVertexBuffer( vbo, geoNode->GetIndexBuffer(), lod.m_indexCount, lod.m_indexOffset );
 	}
 
 	for ( ModelNode* childNode : node->GetChildren() )
 	{
-		UpdateTraverse( childNode );
+		RecordDepthOnlyTraverse( childNode, lodNum, commandList );
 	}
 }
 
 
 //------------------------------------------------------------------------------------------------
-void FBXSceneObject::RenderTraverse( ModelNode* node ) const
+void FBXSceneObject::AddToRenderQueueTraverse( ModelNode* node, RenderQueue& queue, RenderQueueItem& item ) const
 {
 	if ( node->m_nodeType == NodeType::Geometry )
 	{
 		GeometryNode* geoNode = node->AsGeometryNode();
-		//Material* material = geoNode->GetMaterial();
-		//material->SetRendererState();
-
-		m_game->AddVertsRendered( static_cast< uint32_t >( geoNode->GetVertexCount() ) );
 
-		ModelTransformationData data;
-		data.modelMatrix = geoNode->GetLocalToWorldTransform();
-		g_theRenderer->SetModelBuffer( data );
-		g_theRenderer->DrawVertexBuffer( geoNode->GetVertexBuffer(), geoNode->GetVertexCount() );
+		MeshLOD const& lod = geoNode->GetLOD( m_cameraLOD );
+		CountGeometryDrawn( geoNode, m_cameraLOD, false );
+
+		item.m_modelData   = GetGeometryModelData( geoNode );
+		item.m_ibo         = geoNode->GetIndexBuffer();
+		item.m_count       = static_cast< int >( lod.m_indexCount );
+		item.m_indexOffset = static_cast< int >( lod.m_indexOffset );
+		if ( geoNode->HasPackedVertices() )
+		{
+			item.m_vbo          = geoNode->GetPositionVertexBuffer();
+			item.m_attributeVBO = geoNode->GetAttributeVertexBuffer();
+		}
+		else
+		{
+			item.m_vbo          = geoNode->GetVertexBuffer();
+			item.m_attributeVBO = nullptr;
+		}
+		queue.AddItem( item );
 	}
 
 	for ( ModelNode* childNode : node->GetChildren() )
 	{
-		RenderTraverse( childNode );
+		AddToRenderQueueTraverse( childNode, queue, item );
 	}
 }
+
+
+//------------------------------------------------------------------------------------------------
+void FBXSceneObject::CountGeometryDrawn( GeometryNode const* geoNode, uint lodNum, bool depthOnly ) const
+{
+	m_game->AddVertsRendered( static_cast< uint32_t >( geoNode->GetLOD( lodNum ).m_indexCount ) );
+	m_game->AddLODDrawn( lodNum < geoNode->GetNumLODs() ? lodNum : geoNode->GetNumLODs() - 1, depthOnly );
+}
@@ -1,14 +1,24 @@
 #pragma once
 #include "Game/Object.hpp"
 
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Renderer/LightStructure.hpp"
+
 #include <string>
 
 
 //------------------------------------------------------------------------------------------------
+class DrawCommandList;
+class GeometryNode;
 class Model;
 class ModelNode;
+class RenderQueue;
+class Shader;
 class Texture;
 
+struct RasterState;
+struct RenderQueueItem;
+
 
 //------------------------------------------------------------------------------------------------
 class FBXSceneObject : public Object
@@ -20,14 +30,25 @@ public:
 	virtual void Update( float deltaseconds ) override;
 	virtual void Render() const override;
 	virtual void DebugRender() const override;
+	void         RecordDepthOnly( DrawCommandList& commandList, int lightNum, int viewNum ) const;
+	void         AddToRenderQueue( RenderQueue& queue, Shader* shader, RasterState const& rasterState, float depth ) const;
 
 protected:
-	virtual void UpdateTraverse( ModelNode* node );
-	virtual void RenderTraverse( ModelNode* node ) const;
+	virtual void RenderTraverse( ModelNode* node, uint lodNum ) const;
+	virtual void RecordDepthOnlyTraverse( ModelNode* node, uint lodNum, DrawCommandList& commandList ) const;
+	virtual void AddToRenderQueueTraverse( ModelNode* node, RenderQueue& queue, RenderQueueItem& item ) const;
+	void         CountGeometryDrawn( GeometryNode const* geoNode, uint lodNum, bool depthOnly ) const;
 
 public:
 	Model* m_fbxModel = nullptr;
 
 	Texture* m_texture       = nullptr;
 	Texture* m_normalTexture = nullptr;
+
+	AABB3    m_worldBounds   = AABB3( Vec3::ZERO, Vec3::ZERO );
+	bool     m_hasBounds     = false;
+
+	// Selected per view by Game each frame; kept between frames for LOD hysteresis
+	uint8_t  m_cameraLOD                                = 0;
+	uint8_t  m_shadowLODs[ MAXLIGHTS ][ NUM_CASCADES ]  = {};
 };
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+#include "Game/GameCommon.hpp"
+
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/DebugRender.hpp"
+#include "Engine/Renderer/DrawCommandList.hpp"
+#include "Engine/Renderer/LightStructure.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/RenderQueue.hpp"
+
+#include <cstdint>
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------
+constexpr int NUM_FRAME_PACKETS = 2;		// one being built while the other renders
+
+
+//----------------------------------------------------------------------------------------------------
+struct CameraConstantsForCamera1
+{
+	Mat44 m_viewMatrix;
+	Mat44 m_projectionMatrix;
+};
+
+
+//----------------------------------------------------------------------------------------------------
+// Everything the render thread needs to draw one frame's scene, built by Game::BuildFramePacket without
+// any renderer calls and never modified once submitted. Pointers are to data that only changes after
+// the render thread has been drained: scene meshes, depth textures and Game's static geometry
+//
+struct FramePacket
+{
+	uint64_t                     m_frameNumber = 0;
+
+	// Main view. The camera is copied after its matrices were built, so the render thread only reads caches
+	Camera                       m_sceneCamera;
+	CameraConstantsForCamera1    m_cam1Constants;
+	bool                         m_hideDefaultGeometry = false;
+
+	// Lighting
+	ShaderLightData              m_shaderLightData;
+	ShaderShadowMatrixData       m_shadowMatrixData;
+	uint                         m_numShadowMatrices = 0;
+	CascadeConstantsData         m_cascadeData;
+	Texture*                     m_lightDepthTextures[ MAXLIGHTS ] = {};
+
+	// Light depth passes in submission order, each with the draws recorded for it
+	std::vector<DepthPassView>   m_shadowViews;
+	std::vector<DrawCommandList> m_shadowDrawLists;		// parallel to m_shadowViews
+
+	// Lit geometry for the main view; Submit sorts it and records stats on the render thread
+	mutable RenderQueue          m_sceneRenderQueue;
+
+#if defined(ENGINE_DEBUG_RENDERING)
+
+	DebugVertexStream            m_debugWorldStream;
+
+#endif
+};
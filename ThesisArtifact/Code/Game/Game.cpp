@@ -1,6 +1,7 @@
 #include "Game.hpp"
 
 #include "Game/App.hpp"
+#include "Game/Definitions/CompiledDefinitions.hpp"
 #include "Game/Definitions/LightConfigurations.hpp"
 #include "Game/Definitions/SceneSetting.hpp"
 #include "Game/FBXSceneObject.hpp"
@@ -8,12 +9,16 @@
 
 #include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/3D/FBXLoader.hpp"
+#include "Engine/3D/VisualDatabase.hpp"
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/FrameArena.hpp"
+#include "Engine/Core/JobSystem.hpp"
 #include "Engine/Core/Stopwatch.hpp"
+#include "Engine/Core/Time.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Math/AABB3.hpp"
@@ -25,7 +30,9 @@
 #include "Engine/Renderer/ConstantBuffer.hpp"
 #include "Engine/Renderer/Lighting/LightCamera.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/RenderThread.hpp"
 #include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/TextureStreamer.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/VertexData/VertexUtils.hpp"
 #include "Engine/Telemetry/D3D11PerformanceMarker.hpp"
@@ -33,6 +40,8 @@
 
 #include "ThirdParty/imgui/imgui.h"
 
+#include <cstdio>
+
 
 //----------------------------------------------------------------------------------------------------
 Game* g_theGame = nullptr;
@@ -53,27 +62,75 @@ Game::~Game()
 
 
 //----------------------------------------------------------------------------------------------------
+// Once per frame, before this frame's simulation ticks
+//
 void Game::Update()
 {
 	float deltaSeconds = static_cast< float >( Clock::GetSystemClock().GetFrameDeltaSeconds() );
-	m_vertsRendered = 0;
+	RestoreSimulatedLightStates();
+	ResetRenderStats();
+
+	if ( m_definitionWatcher.PollChangedFiles() > 0 )
+	{
+		ReloadXMLData();
+	}
 
 	UpdateDebug();
 	UpdateShaderLightDataUsingUI();
-	UpdateLightRotation( deltaSeconds );
+	m_player->UpdateMouseLook( deltaSeconds );
+}
+
+
+//----------------------------------------------------------------------------------------------------
+void Game::Simulate( float tickSeconds )
+{
+	for ( int lightNum = 0; lightNum < MAXLIGHTS; lightNum++ )
+	{
+		m_lightInterpolation[ lightNum ].m_previousPosition  = m_shaderLightData.m_lights[ lightNum ].m_worldPosition;
+		m_lightInterpolation[ lightNum ].m_previousDirection = m_shaderLightData.m_lights[ lightNum ].m_direction;
+	}
+
+	m_player->Update( tickSeconds );
+	UpdateLightRotation( tickSeconds );
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// Once per frame, after the simulation ticks: everything derived from the simulated state for rendering
+//
+void Game::UpdateForRender( float interpolationAlpha )
+{
+	float deltaSeconds = static_cast< float >( Clock::GetSystemClock().GetFrameDeltaSeconds() );
+
 	UpdateEntities( deltaSeconds );
-	UpdateCamera( deltaSeconds );
+	ApplyInterpolatedLightStates( interpolationAlpha );
+	UpdateCamera( interpolationAlpha );
 
 #if defined(ENGINE_DEBUG_RENDERING)
 
+	HeapAllocationScope overlayScope;
+
 	//DebugAddWorldBasis( Mat44(), Rgba8::WHITE, Rgba8::WHITE, 0.f, DebugRenderMode::USE_DEPTH );
-	DebugAddScreenText( Stringf( "Player Position: (%.2f, %.2f, %.2f)", m_player->m_position.x, m_player->m_position.y, m_player->m_position.z ), Vec2( 400.0f, 168.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
-	DebugAddScreenText( Stringf( "Active Scene name: %s", m_sceneSetting->m_name.c_str() ), Vec2( 400.0f, 200.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
-	DebugAddScreenText( Stringf( "Active Camera: %s", m_useCamera1 ? "Main camera" : "Debug Camera" ), Vec2( 400.0f, 192.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
-	DebugAddScreenText( Stringf( "FPS: %.3f", 1.0f / deltaSeconds ), Vec2( 400.0f, 184.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
+	DebugAddScreenText( FrameStringf( "Player Position: (%.2f, %.2f, %.2f)", m_player->m_position.x, m_player->m_position.y, m_player->m_position.z ), Vec2( 400.0f, 168.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
+	DebugAddScreenText( FrameStringf( "Active Scene name: %s", m_sceneSetting->m_name.c_str() ), Vec2( 400.0f, 200.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
+	DebugAddScreenText( FrameStringf( "Active Camera: %s", m_useCamera1 ? "Main camera" : "Debug Camera" ), Vec2( 400.0f, 192.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
+	DebugAddScreenText( FrameStringf( "FPS: %.3f", 1.0f / deltaSeconds ), Vec2( 400.0f, 184.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
+
+	FixedTimestep const& simulationTimestep = m_App->GetSimulationTimestep();
+	DebugAddScreenText( FrameStringf( "Simulation: %d ticks this frame at %.0f Hz, alpha %.2f%s", simulationTimestep.GetTicksThisFrame(), simulationTimestep.GetTicksPerSecond(),
+		simulationTimestep.GetInterpolationAlpha(), simulationTimestep.IsDeterministic() ? ", deterministic" : "" ), Vec2( 400.0f, 152.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
+
+	Rgba8 heapTextColor = m_lastTransientHeapAllocations > 0 ? Rgba8::RED : Rgba8::WHITE;
+	DebugAddScreenText( FrameStringf( "Heap Allocations: %d last frame, %d on transient paths", m_lastFrameHeapAllocations, m_lastTransientHeapAllocations ), Vec2( 400.0f, 80.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f, heapTextColor );
+
+	FrameArenaStats const& arenaStats = g_theFrameArena->GetLastFrameStats();
+	DebugAddScreenText( FrameStringf( "Frame Arena: %d KB used, %d KB peak, %d overflows", static_cast< int >( arenaStats.m_bytesUsed / 1024 ), static_cast< int >( arenaStats.m_peakBytesUsed / 1024 ), arenaStats.m_numOverflowAllocations ), Vec2( 400.0f, 64.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
+
+	m_transientHeapAllocations += overlayScope.GetNumAllocations();
 
 #endif
 
+	BuildFramePacket( m_framePackets[ m_buildPacketIndex ] );
 }
 
 
@@ -117,6 +174,7 @@ void Game::UpdateDebug()
 			m_player->m_position    = m_worldCamera2.GetPosition();
 			m_player->m_orientation = m_worldCamera2.GetOrientation();
 		}
+		m_player->SnapInterpolation();
 	}
 }
 
@@ -333,29 +391,94 @@ void Game::UpdateLightRotation( float deltaSeconds )
 //----------------------------------------------------------------------------------------------------
 void Game::UpdateEntities( float deltaSeconds )
 {
-	m_player->Update( deltaSeconds );
-
-	for ( FBXSceneObject* obj : m_sceneSetting->m_sceneObjects )
+	// Every object only writes its own matrix, bounds and instanced node hierarchy, so the per object math
+	// is exactly the serial path's and the result does not depend on which worker ran it
+	std::vector<FBXSceneObject*> const& sceneObjects = m_sceneSetting->m_sceneObjects;
+	g_theJobSystem->ParallelFor( static_cast< int >( sceneObjects.size() ), SCENE_UPDATE_BATCH_SIZE, [ &sceneObjects, deltaSeconds ]( int objNum )
 	{
+		FBXSceneObject* obj = sceneObjects[ objNum ];
 		if ( obj != nullptr )
 		{
-			obj->Update(deltaSeconds);
+			obj->Update( deltaSeconds );
 		}
-	}
+	} );
 
 	if ( !m_hideDefaultGeometry )
 	{
-		m_vertsRendered += static_cast< uint32_t >( m_floor.size() );
-		m_vertsRendered += static_cast< uint32_t >( m_wall.size() );
-		m_vertsRendered += static_cast< uint32_t >( m_cubeVerts1.size() ) * 2;
+		AddVertsRendered( static_cast< uint32_t >( m_floor.size() ) );
+		AddVertsRendered( static_cast< uint32_t >( m_wall.size() ) );
+		AddVertsRendered( static_cast< uint32_t >( m_cubeVerts1.size() ) * 2 );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// Lights that follow the camera are set from the already interpolated camera, so they are left alone
+//
+void Game::ApplyInterpolatedLightStates( float interpolationAlpha )
+{
+	for ( int lightNum = 0; lightNum < MAXLIGHTS; lightNum++ )
+	{
+		bool isSimulated = ( m_lightMoving[ lightNum ] || m_lightRotating[ lightNum ] ) && !m_lightCamFollow[ lightNum ] && !m_lightCamDir[ lightNum ];
+		if ( !isSimulated )
+			continue;
+
+		LightInterpolationState& state = m_lightInterpolation[ lightNum ];
+		LightDataC& light = m_shaderLightData.m_lights[ lightNum ];
+
+		state.m_simulatedPosition     = light.m_worldPosition;
+		state.m_simulatedDirection    = light.m_direction;
+		state.m_isShowingInterpolated = true;
+
+		light.m_worldPosition = state.m_previousPosition + ( state.m_simulatedPosition - state.m_previousPosition ) * interpolationAlpha;
+
+		Vec3 direction = state.m_previousDirection + ( state.m_simulatedDirection - state.m_previousDirection ) * interpolationAlpha;
+		if ( direction.GetLengthSquared() > 0.0f )
+		{
+			light.m_direction = direction.GetNormalized();
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------
+void Game::RestoreSimulatedLightStates()
+{
+	for ( int lightNum = 0; lightNum < MAXLIGHTS; lightNum++ )
+	{
+		LightInterpolationState& state = m_lightInterpolation[ lightNum ];
+		if ( !state.m_isShowingInterpolated )
+			continue;
+
+		m_shaderLightData.m_lights[ lightNum ].m_worldPosition = state.m_simulatedPosition;
+		m_shaderLightData.m_lights[ lightNum ].m_direction     = state.m_simulatedDirection;
+		state.m_isShowingInterpolated = false;
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// For state that was just set rather than simulated: the next frame shows it as is instead of
+// blending in from whatever came before
+//
+void Game::SnapInterpolation()
+{
+	for ( int lightNum = 0; lightNum < MAXLIGHTS; lightNum++ )
+	{
+		LightInterpolationState& state = m_lightInterpolation[ lightNum ];
+		state.m_previousPosition      = m_shaderLightData.m_lights[ lightNum ].m_worldPosition;
+		state.m_previousDirection     = m_shaderLightData.m_lights[ lightNum ].m_direction;
+		state.m_isShowingInterpolated = false;
 	}
+
+	m_player->SnapInterpolation();
 }
 
 
 //----------------------------------------------------------------------------------------------------
-void Game::UpdateCamera( float deltaSeconds )
+void Game::UpdateCamera( float interpolationAlpha )
 {
-	UNUSED( deltaSeconds );
+	Vec3 playerPosition = m_player->GetInterpolatedPosition( interpolationAlpha );
 
 	for ( int cascadeNum = 0; cascadeNum < NUM_CASCADES; cascadeNum++ )
 	{
@@ -363,15 +486,14 @@ void Game::UpdateCamera( float deltaSeconds )
 	}
 	m_cascadeData.numCascades = m_numCascades;
 	m_cascadeData.enablePCF = m_enablePCF ? 1 : 0;
-	m_cascadeDepthConstantBuffer->SetData( m_cascadeData );
 
 	if ( m_useCamera1 )
 	{
-		m_worldCamera.SetCameraPositionAndOrientation( m_player->m_position, m_player->m_orientation );
+		m_worldCamera.SetCameraPositionAndOrientation( playerPosition, m_player->m_orientation );
 	}
 	else
 	{
-		m_worldCamera2.SetCameraPositionAndOrientation( m_player->m_position, m_player->m_orientation );
+		m_worldCamera2.SetCameraPositionAndOrientation( playerPosition, m_player->m_orientation );
 	}
 
 	for ( int lightNum = 0; lightNum < m_numLights; lightNum++ )
@@ -386,33 +508,40 @@ void Game::UpdateCamera( float deltaSeconds )
 		}
 	}
 
+	UpdateShadowCasters();
+
 	for ( int lightNum = 0; lightNum < MAXLIGHTS; lightNum++ )
 	{
 		m_lightCameraArray[lightNum]->SetLightValues( m_shaderLightData.m_lights[lightNum] );
 
 		if ( m_shaderLightData.m_lights[lightNum].m_lightType == INVALID_LIGHT )
 		{
-			m_lightCameraArray[lightNum]->CreateDepthTextures( 1 );
+			UpdateLightDepthTextures( lightNum, 0 );
 			continue;
 	    }
 		else if ( m_shaderLightData.m_lights[lightNum].m_lightType == DIRECTIONAL_LIGHT )
 		{
-			m_lightCameraArray[lightNum]->CreateDepthTextures( m_numCascades );
 			m_lightCameraArray[lightNum]->SetCameraType( CameraType::ORTHOGRAPHIC );
 			m_lightCameraArray[lightNum]->SetGameSpace( Vec3( 0.0f, 1.0f, 0.0f ), Vec3( 0.0f, 0.0f, 1.0f ), Vec3( 1.0f, 0.0f, 0.0f ) );
 			UpdateLightCameraProjection( lightNum );
+
+			uint8_t cascadeMask = static_cast< uint8_t >( ( 1u << m_numCascades ) - 1u );
+			for ( int cascadeNum = 0; cascadeNum < m_numCascades; cascadeNum++ )
+			{
+				m_lightCameraArray[lightNum]->SetShadowResolution( DEPTH_TEXTURE_SIZE, cascadeNum );
+			}
+			UpdateLightDepthTextures( lightNum, static_cast< uint >( m_numCascades ) );
+			for ( ShadowCaster& caster : m_shadowCasters )
+			{
+				caster.m_viewMask[ lightNum ] = cascadeMask;
+			}
 		}
 		else if ( m_shaderLightData.m_lights[lightNum].m_lightType == SPOT_LIGHT )
 		{
-			m_lightCameraArray[lightNum]->CreateDepthTextures( 1 );
 			m_lightCameraArray[lightNum]->SetCameraType( CameraType::PERSPECTIVE );
 			m_lightCameraArray[lightNum]->SetGameSpace( Vec3( 0.0f, -1.0f, 0.0f ), Vec3( 0.0f, 0.0f, 1.0f ), Vec3( 1.0f, 0.0f, 0.0f ) );
-			m_lightCameraArray[lightNum]->SetFieldOfView( 2.0f * ConvertRadiansToDegrees( acosf( m_shaderLightData.m_lights[lightNum].m_dotOuterAngle ) ) );
-			m_lightCameraArray[lightNum]->SetZNearZFar( 0.1f, 20.0f );
-			m_lightCameraArray[lightNum]->SetAspect( 2.0f );
-
-			Mat44 projMatrix = Mat44::CreatePerspectiveProjection( m_lightCameraArray[lightNum]->GetFOV(), m_lightCameraArray[lightNum]->GetAspect(), m_lightCameraArray[lightNum]->GetZNear(), m_lightCameraArray[lightNum]->GetZFar() );
-			m_lightCameraArray[lightNum]->SetProjectionMatrix( projMatrix, 0 );
+			UpdateSpotLightCameraProjection( lightNum );
+			UpdateLightDepthTextures( lightNum, 1 );
 			
 			Vec3 lightStart = m_shaderLightData.m_lights[lightNum].m_worldPosition;
 			Vec3 lightEndArrow = m_shaderLightData.m_lights[lightNum].m_worldPosition + m_shaderLightData.m_lights[lightNum].m_direction * 0.25f;
@@ -420,27 +549,401 @@ void Game::UpdateCamera( float deltaSeconds )
 		}
 		else if ( m_shaderLightData.m_lights[lightNum].m_lightType == POINT_LIGHT )
 		{
-			m_lightCameraArray[lightNum]->CreateDepthTextures( 1 );
+			m_lightCameraArray[lightNum]->SetCameraType( CameraType::PERSPECTIVE );
+			m_lightCameraArray[lightNum]->SetGameSpace( Vec3( 0.0f, -1.0f, 0.0f ), Vec3( 0.0f, 0.0f, 1.0f ), Vec3( 1.0f, 0.0f, 0.0f ) );
+			UpdatePointLightCameraProjection( lightNum );
+			UpdateLightDepthTextures( lightNum, NUM_CUBE_FACES );
+
 			DebugAddWorldSphere( m_shaderLightData.m_lights[lightNum].m_worldPosition, 0.1f, 0.0f, Rgba8::WHITE );
 		}
+	}
+
+	UpdateShadowMatrices();
+	UpdateSceneObjectLODs();
+	BuildShadowDrawLists();
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Only shadow casting lights own a depth texture, sized to the largest view resolution picked this frame.
+// It grows as soon as a view needs more, but only shrinks once it is 4x too big, so a light sitting on a
+// resolution boundary does not reallocate every frame. Recreating or releasing a texture frees the old
+// one, which the frame on the render thread may still be drawing into, so that frame finishes first
+//
+void Game::UpdateLightDepthTextures( int lightNum, uint numDepthSlices )
+{
+	LightCamera* lightCamera = m_lightCameraArray[ lightNum ];
+	if ( numDepthSlices == 0 || !lightCamera->IsShadowCasting() )
+	{
+		if ( lightCamera->GetDepthTexture() != nullptr )
+		{
+			g_theRenderThread->WaitUntilIdle();
+			lightCamera->ReleaseDepthTextures();
+		}
+		return;
+	}
+
+	uint resolution = 0;
+	for ( uint sliceNum = 0; sliceNum < numDepthSlices; sliceNum++ )
+	{
+		resolution = std::max( resolution, lightCamera->GetShadowResolution( static_cast< int >( sliceNum ) ) );
+	}
+
+	uint textureSize = lightCamera->GetDepthTextureSize();
+	if ( lightCamera->GetDepthTexture() != nullptr && lightCamera->GetNumDepthSlices() == numDepthSlices &&
+		 resolution <= textureSize && resolution * 4 > textureSize )
+		return;
+
+	g_theRenderThread->WaitUntilIdle();
+	lightCamera->CreateDepthTextures( numDepthSlices, resolution );
+}
+
+
+//------------------------------------------------------------------------------------------------
+void Game::UpdateShadowMatrices()
+{
+	m_shaderLightData.m_numLights = static_cast< uint >( m_numLights );
+	m_numShadowMatrices = 0;
+
+	for ( int lightNum = 0; lightNum < m_numLights; lightNum++ )
+	{
+		LightDataC& light = m_shaderLightData.m_lights[ lightNum ];
+		light.m_shadowMatrixIndex   = NO_SHADOW_MATRIX;
+		light.m_shadowViewportScale = 1.0f;
+
+		uint numMatrices = 0;
+		if ( light.m_lightType == DIRECTIONAL_LIGHT )
+		{
+			numMatrices = static_cast< uint >( m_numCascades );
+		}
+		else if ( light.m_lightType == SPOT_LIGHT )
+		{
+			numMatrices = 1;
+		}
+		else if ( light.m_lightType == POINT_LIGHT )
+		{
+			numMatrices = NUM_CUBE_FACES;
+		}
+
+		if ( light.m_isShadowCasting == 0 || numMatrices == 0 )
+		{
+			continue;
+		}
+
+		light.m_shadowMatrixIndex = m_numShadowMatrices;
+		for ( uint projNum = 0; projNum < numMatrices; projNum++ )
+		{
+			// Remap clip space into the top left resolution x resolution region the depth pass rendered to
+			float viewportScale = static_cast< float >( m_lightCameraArray[ lightNum ]->GetShadowResolution( projNum ) ) / static_cast< float >( m_lightCameraArray[ lightNum ]->GetDepthTextureSize() );
+			light.m_shadowViewportScale = viewportScale;
+			Mat44 viewportRemap;
+			viewportRemap.m_values[ Mat44::Ix ] = viewportScale;
+			viewportRemap.m_values[ Mat44::Jy ] = viewportScale;
+			viewportRemap.m_values[ Mat44::Tx ] = viewportScale - 1.0f;
+			viewportRemap.m_values[ Mat44::Ty ] = 1.0f - viewportScale;
+
+			Mat44 lightViewProjection = viewportRemap;
+			lightViewProjection.Append( m_lightCameraArray[ lightNum ]->GetViewProjectionMatrix( projNum ) );
+			m_shadowMatrixData.m_lightViewProjection[ m_numShadowMatrices ] = lightViewProjection;
+			m_numShadowMatrices++;
+		}
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Picks each scene object's LOD for the main view from its projected size. Shadow view LODs are picked
+// per view while building the shadow draw lists
+//
+void Game::UpdateSceneObjectLODs()
+{
+	Camera const& camera       = m_useCamera1 ? m_worldCamera : m_worldCamera2;
+	float         screenHeight = static_cast< float >( g_theWindow->GetClientHeight() );
+
+	for ( FBXSceneObject* obj : m_sceneSetting->m_sceneObjects )
+	{
+		if ( obj == nullptr || !obj->m_hasBounds )
+			continue;
+
+		Vec3  center = obj->m_worldBounds.GetCenter();
+		float radius = obj->m_worldBounds.GetDimensions().GetLength() * 0.5f;
+
+		float cameraSize = GetProjectedDiameterPixels( center, radius, camera.GetViewProjectionMatrix(), screenHeight );
+		obj->m_cameraLOD = static_cast< uint8_t >( SelectMeshLOD( cameraSize, obj->m_cameraLOD ) );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Lists every depth pass in submission order, then records each view's draws on the job workers
+//
+void Game::BuildShadowDrawLists()
+{
+	m_shadowViews.clear();
+	for ( int lightNum = 0; lightNum < MAXLIGHTS; lightNum++ )
+	{
+		LightDataC const& light = m_shaderLightData.m_lights[ lightNum ];
+		if ( light.m_lightType == INVALID_LIGHT || light.m_isShadowCasting == 0 )
+			continue;
+
+		int numViews = m_numCascades;
+		if ( light.m_lightType == SPOT_LIGHT )
+		{
+			numViews = 1;
+		}
+		else if ( light.m_lightType == POINT_LIGHT )
+		{
+			numViews = NUM_CUBE_FACES;
+		}
+
+		for ( int viewNum = 0; viewNum < numViews; viewNum++ )
+		{
+			ShadowView view;
+			view.m_lightNum = lightNum;
+			view.m_viewNum  = viewNum;
+			m_shadowViews.push_back( view );
+		}
+	}
+
+	m_shadowDrawLists.resize( m_shadowViews.size() );
+
+	Shader* shader            = m_depthShader;
+	Shader* sceneObjectShader = m_sceneObjectDepthShader;
+	g_theJobSystem->ParallelFor( static_cast< int >( m_shadowViews.size() ), 1, [ this, shader, sceneObjectShader ]( int shadowViewNum )
+	{
+		BuildShadowDrawList( shadowViewNum, shader, sceneObjectShader );
+	} );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Runs on a job worker. Only writes this view's draw list and this view's slot of each object's shadow
+// LODs, so views can be built in any order. Shadow matrices already include the remap into this view's
+// viewport, so scaling by the light's own depth texture size ( spot and point lights get smaller ones
+// than the sun ) gives the caster's size in shadow map texels.
+// Unlike the scene queue these lists are deliberately left unsorted: depth only passes bind no textures
+// and one raster state, casters are already recorded grouped by shader, and each scene object draws from
+// its own buffers, so a sort would cost more than the few binds it could merge
+//
+void Game::BuildShadowDrawList( int shadowViewNum, Shader* shader, Shader* sceneObjectShader )
+{
+	ShadowView const& view        = m_shadowViews[ shadowViewNum ];
+	DrawCommandList&  commandList = m_shadowDrawLists[ shadowViewNum ];
+	LightDataC const& light       = m_shaderLightData.m_lights[ view.m_lightNum ];
+	uint8_t           viewBit     = static_cast< uint8_t >( 1u << view.m_viewNum );
+
+	commandList.Reset();
+
+	float lodBias = m_shadowLODBias;
+	if ( light.m_lightType == DIRECTIONAL_LIGHT )
+	{
+		for ( int cascadeNum = 0; cascadeNum < view.m_viewNum; cascadeNum++ )
+		{
+			lodBias *= m_cascadeLODBiasFalloff;
+		}
+	}
+
+	float        depthTextureSize    = static_cast< float >( m_lightCameraArray[ view.m_lightNum ]->GetDepthTextureSize() );
+	Mat44 const* lightViewProjection = nullptr;
+	if ( light.m_shadowMatrixIndex != NO_SHADOW_MATRIX )
+	{
+		lightViewProjection = &m_shadowMatrixData.m_lightViewProjection[ light.m_shadowMatrixIndex + view.m_viewNum ];
+	}
+
+	Shader* boundShader = nullptr;
+	for ( ShadowCaster const& caster : m_shadowCasters )
+	{
+		if ( ( caster.m_viewMask[ view.m_lightNum ] & viewBit ) == 0 )
+			continue;
+
+		Shader* casterShader = caster.m_sceneObject != nullptr ? sceneObjectShader : shader;
+		if ( casterShader != boundShader )
+		{
+			commandList.BindShader( casterShader );
+			boundShader = casterShader;
+		}
+
+		if ( caster.m_sceneObject != nullptr )
+		{
+			FBXSceneObject* obj = caster.m_sceneObject;
+			if ( lightViewProjection != nullptr )
+			{
+				Vec3  center     = obj->m_worldBounds.GetCenter();
+				float radius     = obj->m_worldBounds.GetDimensions().GetLength() * 0.5f;
+				float shadowSize = GetProjectedDiameterPixels( center, radius, *lightViewProjection, depthTextureSize );
+
+				uint8_t& lod = obj->m_shadowLODs[ view.m_lightNum ][ view.m_viewNum ];
+				lod = static_cast< uint8_t >( SelectMeshLOD( shadowSize, lod, lodBias ) );
+			}
+
+			obj->RecordDepthOnly( commandList, view.m_lightNum, view.m_viewNum );
+			continue;
+		}
+
+		ModelTransformationData data;
+		data.modelMatrix = caster.m_modelMatrix;
+		Rgba8::WHITE.GetAsFloats( data.tint );
+		commandList.SetModelBuffer( data );
+		commandList.DrawVertexArray( static_cast< int >( caster.m_verts->size() ), caster.m_verts->data() );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+void Game::UpdateShadowCasters()
+{
+	m_shadowCasters.clear();
+
+	if ( !m_hideDefaultGeometry )
+	{
+		AABB3 cubeBounds( -0.50f, -0.5f, -0.50f, 0.50f, 0.5f, 0.50f );
+
+		ShadowCaster cube;
+		cube.m_modelMatrix = m_cube1transform;
+		cube.m_worldBounds = cubeBounds.GetTransformed( m_cube1transform );
+		cube.m_verts       = &m_cubeVerts1;
+		m_shadowCasters.push_back( cube );
+
+		for ( int cubeNum = 0; cubeNum < 1; cubeNum++ )
+		{
+			ShadowCaster rotatedCube;
+			rotatedCube.m_modelMatrix = m_cubeTransforms[ cubeNum ];
+			rotatedCube.m_worldBounds = cubeBounds.GetTransformed( m_cubeTransforms[ cubeNum ] );
+			rotatedCube.m_verts       = &m_cubeVerts1;
+			m_shadowCasters.push_back( rotatedCube );
+		}
+
+		ShadowCaster floor;
+		floor.m_worldBounds = AABB3( -25.0f, -25.0f, -0.750f, 25.0f, 25.0f, -0.7f );
+		floor.m_verts       = &m_floor;
+		m_shadowCasters.push_back( floor );
+
+		ShadowCaster wall;
+		wall.m_worldBounds = AABB3( 5.0f, -5.0f, -5.0f, 6.0f, 5.0f, 5.0f );
+		wall.m_verts       = &m_wall;
+		m_shadowCasters.push_back( wall );
+	}
+
+	for ( FBXSceneObject* obj : m_sceneSetting->m_sceneObjects )
+	{
+		if ( obj == nullptr || !obj->m_hasBounds )
+			continue;
+
+		ShadowCaster sceneCaster;
+		sceneCaster.m_worldBounds = obj->m_worldBounds;
+		sceneCaster.m_sceneObject = obj;
+		m_shadowCasters.push_back( sceneCaster );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+void Game::UpdateSpotLightCameraProjection( int lightNum )
+{
+	LightCamera* lightCamera = m_lightCameraArray[ lightNum ];
+	LightDataC const& light  = m_shaderLightData.m_lights[ lightNum ];
+
+	float coneHalfAngle   = ConvertRadiansToDegrees( acosf( Clamp( light.m_dotOuterAngle, -1.0f, 1.0f ) ) );
+	float fieldOfView     = Clamp( 2.0f * coneHalfAngle, 1.0f, 170.0f );
+	float attenuationDist = lightCamera->GetAttenuationRadius( SHADOW_ATTENUATION_CUTOFF, m_farPlane );
+	Vec3  coneAxis        = light.m_direction.GetNormalized();
+
+	//Cull casters against the spot volume and fit near/far to what is left
+	float zNear = attenuationDist;
+	float zFar  = 0.0f;
+	for ( ShadowCaster& caster : m_shadowCasters )
+	{
+		Vec3  center = caster.m_worldBounds.GetCenter();
+		float radius = caster.m_worldBounds.GetDimensions().GetLength() * 0.5f;
 		
-		for ( int projNum = 0; projNum < NUM_CASCADES; projNum++ )
+		if ( !lightCamera->IsSphereInsideSpotCone( center, radius, attenuationDist ) )
+			continue;
+
+		caster.m_viewMask[ lightNum ] = 1;
+
+		float distanceAlongAxis = DotProduct3D( center - light.m_worldPosition, coneAxis );
+		if ( distanceAlongAxis - radius < zNear )
+		{
+			zNear = distanceAlongAxis - radius;
+		}
+		if ( distanceAlongAxis + radius > zFar )
+		{
+			zFar = distanceAlongAxis + radius;
+		}
+	}
+
+	zNear = Clamp( zNear, 0.05f, attenuationDist );
+	zFar  = Clamp( zFar, zNear + 0.01f, attenuationDist + 0.01f );
+
+	lightCamera->SetFieldOfView( fieldOfView );
+	lightCamera->SetAspect( 1.0f );
+	lightCamera->SetZNearZFar( zNear, zFar );
+	lightCamera->SetShadowResolution( GetShadowResolutionForCoverage( light.m_worldPosition, attenuationDist ), 0 );
+
+	Mat44 projMatrix = Mat44::CreatePerspectiveProjection( lightCamera->GetFOV(), lightCamera->GetAspect(), lightCamera->GetZNear(), lightCamera->GetZFar() );
+	lightCamera->SetProjectionMatrix( projMatrix, 0 );
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Point lights render one 90 degree view per cube face into the slices of their depth texture array
+void Game::UpdatePointLightCameraProjection( int lightNum )
+{
+	LightCamera* lightCamera = m_lightCameraArray[ lightNum ];
+	LightDataC const& light  = m_shaderLightData.m_lights[ lightNum ];
+
+	float attenuationDist = lightCamera->GetAttenuationRadius( SHADOW_ATTENUATION_CUTOFF, m_farPlane );
+	uint  resolution      = GetShadowResolutionForCoverage( light.m_worldPosition, attenuationDist );
+
+	lightCamera->SetFieldOfView( 90.0f );
+	lightCamera->SetAspect( 1.0f );
+	lightCamera->SetZNearZFar( 0.05f, attenuationDist + 0.01f );
+
+	Mat44 projMatrix = Mat44::CreatePerspectiveProjection( lightCamera->GetFOV(), lightCamera->GetAspect(), lightCamera->GetZNear(), lightCamera->GetZFar() );
+
+	for ( int faceNum = 0; faceNum < NUM_CUBE_FACES; faceNum++ )
+	{
+		uint8_t faceBit = static_cast< uint8_t >( 1u << faceNum );
+		for ( ShadowCaster& caster : m_shadowCasters )
 		{
-			m_shaderLightData.m_lights[ lightNum ].m_projectionMat[projNum] = m_lightCameraArray[ lightNum ]->GetProjectionMatrix( projNum );
+			Vec3  center = caster.m_worldBounds.GetCenter();
+			float radius = caster.m_worldBounds.GetDimensions().GetLength() * 0.5f;
+
+			if ( lightCamera->IsSphereInsideCubeFace( center, radius, attenuationDist, faceNum ) )
+			{
+				caster.m_viewMask[ lightNum ] |= faceBit;
+			}
 		}
-		Mat44 lightSpaceViewMatrix = m_lightCameraArray[ lightNum ]->GetRenderMatrix();
-		lightSpaceViewMatrix.Append( m_lightCameraArray[ lightNum ]->GetViewMatrix() );
 
-		m_shaderLightData.m_lights[ lightNum ].m_viewMat = lightSpaceViewMatrix;
-		m_lightCameraArray[ lightNum ]->SetLightValues( m_shaderLightData.m_lights[ lightNum ] );
+		Mat44 faceProjection = projMatrix;
+		faceProjection.Append( LightCamera::GetCubeFaceRotation( faceNum ) );
+		lightCamera->SetProjectionMatrix( faceProjection, faceNum );
+		lightCamera->SetShadowResolution( resolution, faceNum );
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Picks a power of two shadow resolution from how much of the screen the light's influence sphere covers
+uint Game::GetShadowResolutionForCoverage( Vec3 const& lightPosition, float lightRadius ) const
+{
+	Camera const& viewCamera = m_useCamera1 ? m_worldCamera : m_worldCamera2;
+
+	float distanceToLight = ( lightPosition - viewCamera.GetPosition() ).GetLength();
+	if ( distanceToLight <= lightRadius )
+		return DEPTH_TEXTURE_SIZE;
+
+	float tanHalfFov     = SinDegrees( viewCamera.GetFOV() * 0.5f ) / CosDegrees( viewCamera.GetFOV() * 0.5f );
+	float screenCoverage = Clamp( lightRadius / ( distanceToLight * tanHalfFov ), 0.0f, 1.0f );
+	float idealTexels    = screenCoverage * static_cast< float >( DEPTH_TEXTURE_SIZE );
+
+	uint resolution = DEPTH_TEXTURE_SIZE;
+	while ( resolution > MIN_SHADOW_RESOLUTION && static_cast< float >( resolution / 2 ) >= idealTexels )
+	{
+		resolution /= 2;
 	}
 
-	CameraConstantsForCamera1 data;
-	Mat44 renderMat = m_worldCamera.GetRenderMatrix();
-	renderMat.Append( m_worldCamera.GetViewMatrix() );
-	data.m_projectionMatrix = m_worldCamera.GetProjectionMatrix();
-	data.m_viewMatrix = renderMat;
-	m_cam1ConstantBuffer->SetData( data );
+	return resolution;
 }
 
 
@@ -611,7 +1114,6 @@ void Game::UpdateLightCameraProjection( int lightNum )
 	    Mat44 projMatrix = Mat44::CreateOrthoProjection(light_aabb.m_maxs.y, light_aabb.m_mins.y, light_aabb.m_maxs.z, light_aabb.m_mins.z, light_aabb.m_mins.x, light_aabb.m_maxs.x );
 		
 		m_lightCameraArray[ lightNum ]->SetProjectionMatrix( projMatrix, projNum );
-		g_theRenderer->ClearDepthBuffer( m_lightCameraArray[ lightNum ]->GetDepthTexture(), 1.0f, projNum );
 	}
 }
 
@@ -619,138 +1121,318 @@ void Game::UpdateLightCameraProjection( int lightNum )
 //------------------------------------------------------------------------------------------------
 void Game::AddVertsRendered( uint32_t vertsAdded )
 {
-	m_vertsRendered += vertsAdded;
+	GetRenderStatsForCurrentThread().m_vertsRendered += vertsAdded;
 }
 
 
-//----------------------------------------------------------------------------------------------------
-void Game::Render() const
+//------------------------------------------------------------------------------------------------
+void Game::AddLODDrawn( uint lodNum, bool isShadowPass )
 {
-	g_theRenderer->ClearScreen( Rgba8( 0, 0, 0, 255 ) );
+	RenderStatCounters& stats = GetRenderStatsForCurrentThread();
+	if ( isShadowPass )
+	{
+		stats.m_shadowLODDraws[ lodNum ]++;
+	}
+	else
+	{
+		stats.m_cameraLODDraws[ lodNum ]++;
+	}
+}
 
-	RenderForDepthBuffers();
 
-	g_theRenderer->ClearScreen( Rgba8( 0, 0, 0, 255 ) );
+//------------------------------------------------------------------------------------------------
+// Non worker threads all land in the last slot, so only job workers may count concurrently
+//
+RenderStatCounters& Game::GetRenderStatsForCurrentThread()
+{
+	int workerIndex = g_theJobSystem->GetCurrentWorkerIndex();
+	if ( workerIndex < 0 )
+	{
+		return m_renderStats.back();
+	}
 
-	if ( m_useCamera1 )
+	return m_renderStats[ workerIndex ];
+}
+
+
+//------------------------------------------------------------------------------------------------
+RenderStatCounters Game::GetTotalRenderStats() const
+{
+	RenderStatCounters total;
+	for ( RenderStatCounters const& stats : m_renderStats )
 	{
-		g_theRenderer->BeginCamera( m_worldCamera );
+		total.m_vertsRendered += stats.m_vertsRendered;
+		for ( uint lodNum = 0; lodNum < MAX_MESH_LODS; lodNum++ )
 		{
-			RenderEntities();
-			DebugRenderWorldToCamera( m_worldCamera );
+			total.m_cameraLODDraws[ lodNum ] += stats.m_cameraLODDraws[ lodNum ];
+			total.m_shadowLODDraws[ lodNum ] += stats.m_shadowLODDraws[ lodNum ];
 		}
-		g_theRenderer->EndCamera( m_worldCamera );
 	}
-	else
+
+	return total;
+}
+
+
+//------------------------------------------------------------------------------------------------
+void Game::ResetRenderStats()
+{
+	size_t numSlots = static_cast< size_t >( g_theJobSystem->GetNumWorkers() ) + 1;
+	m_renderStats.assign( numSlots, RenderStatCounters() );
+
+	uint64_t totalHeapAllocations = GetTotalHeapAllocations();
+	m_lastFrameHeapAllocations     = static_cast< int >( totalHeapAllocations - m_lastTotalHeapAllocations );
+	m_lastTotalHeapAllocations     = totalHeapAllocations;
+	m_lastTransientHeapAllocations = m_transientHeapAllocations;
+	m_transientHeapAllocations     = 0;
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// Captures this frame's scene for the render thread. Runs at the end of UpdateForRender, after every
+// light, shadow view and debug primitive is final, and never calls into the renderer
+//
+void Game::BuildFramePacket( FramePacket& out_packet )
+{
+	out_packet.m_frameNumber         = m_numFramePacketsBuilt++;
+	out_packet.m_hideDefaultGeometry = m_hideDefaultGeometry;
+
+	// Building the matrices here means the render thread only ever reads the camera's caches
+	Camera const& camera = m_useCamera1 ? m_worldCamera : m_worldCamera2;
+	camera.GetViewProjectionMatrix();
+	out_packet.m_sceneCamera = camera;
+
+	out_packet.m_cam1Constants.m_projectionMatrix = m_worldCamera.GetProjectionMatrix();
+	out_packet.m_cam1Constants.m_viewMatrix       = m_worldCamera.GetRenderViewMatrix();
+
+	out_packet.m_shaderLightData   = m_shaderLightData;
+	out_packet.m_shadowMatrixData  = m_shadowMatrixData;
+	out_packet.m_numShadowMatrices = m_numShadowMatrices;
+	out_packet.m_cascadeData       = m_cascadeData;
+	for ( int lightNum = 0; lightNum < MAXLIGHTS; lightNum++ )
+	{
+		out_packet.m_lightDepthTextures[ lightNum ] = m_lightCameraArray[ lightNum ]->GetDepthTexture();
+	}
+
+	out_packet.m_shadowViews.clear();
+	for ( ShadowView const& view : m_shadowViews )
+	{
+		out_packet.m_shadowViews.push_back( m_lightCameraArray[ view.m_lightNum ]->GetDepthPassView( view.m_viewNum ) );
+	}
+
+	// The packet's old lists were already executed, so they come back as next frame's recording buffers
+	out_packet.m_shadowDrawLists.swap( m_shadowDrawLists );
+
+	BuildSceneRenderQueue( out_packet.m_sceneRenderQueue );
+
+#if defined(ENGINE_DEBUG_RENDERING)
+
+	DebugRenderBuildWorldStream( camera, out_packet.m_debugWorldStream );
+
+#endif
+}
+
+
+//----------------------------------------------------------------------------------------------------
+void Game::BuildSceneRenderQueue( RenderQueue& out_queue ) const
+{
+	Camera const& camera     = m_useCamera1 ? m_worldCamera : m_worldCamera2;
+	Vec3          cameraPos  = camera.GetPosition();
+	float         depthScale = 1.0f / m_farPlane;
+
+	out_queue.Reset();
+
+	if ( !m_hideDefaultGeometry )
 	{
-		g_theRenderer->BeginCamera( m_worldCamera2 );
+		RasterState state;
+		state.m_cullmode = CullMode::BACK;
+		state.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
+
+		RenderQueueItem cubeItem;
+		cubeItem.m_shader         = m_litShader;
+		cubeItem.m_rasterState    = state;
+		cubeItem.m_diffuseTexture = m_boxTexture;
+		cubeItem.m_normalTexture  = m_boxNormalTexture;
+		cubeItem.m_vbo            = m_cubeBuffer;
+		cubeItem.m_count          = static_cast< int >( m_cubeVerts1.size() );
+
+		cubeItem.m_modelData.modelMatrix = m_cube1transform;
+		Rgba8::WHITE.GetAsFloats( cubeItem.m_modelData.tint );
+		cubeItem.m_depth = ( m_cube1transform.GetTranslation3D() - cameraPos ).GetLength() * depthScale;
+		out_queue.AddItem( cubeItem );
+
+		for ( int cubeNum = 0; cubeNum < 1; cubeNum++ )
 		{
-			RenderEntities();
-			DebugRenderWorldToCamera( m_worldCamera2 );
+			cubeItem.m_modelData.modelMatrix = m_cubeTransforms[cubeNum];
+			cubeItem.m_depth = ( m_cubeTransforms[cubeNum].GetTranslation3D() - cameraPos ).GetLength() * depthScale;
+			out_queue.AddItem( cubeItem );
 		}
-		g_theRenderer->EndCamera( m_worldCamera2 );
 	}
 
-	DebugAddScreenText( Stringf( "Vertices Rendered: %d", m_vertsRendered ), Vec2( 400.0f, 176.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
+	RasterState modelState;
+	modelState.m_cullmode = CullMode::NONE;
+	modelState.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
 
-	g_theRenderer->BeginCamera( m_screenCamera );
+	for ( FBXSceneObject const* obj : m_sceneSetting->m_sceneObjects )
 	{
-		RenderUI();
+		if ( obj == nullptr )
+			continue;
+
+		float depth = ( obj->m_worldBounds.GetCenter() - cameraPos ).GetLength() * depthScale;
+		obj->AddToRenderQueue( out_queue, m_modelShader, modelState, depth );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// Hands the packet built this frame to the render thread and moves building on to the other one
+//
+void Game::SubmitFramePacket()
+{
+	g_theRenderThread->SubmitFrame( &Game::ExecuteFramePacket, &m_framePackets[ m_buildPacketIndex ] );
+
+	m_submittedPacketIndex = m_buildPacketIndex;
+	m_buildPacketIndex     = ( m_buildPacketIndex + 1 ) % NUM_FRAME_PACKETS;
+}
+
+
+//----------------------------------------------------------------------------------------------------
+void Game::ExecuteFramePacket( void const* framePacket )
+{
+	g_theGame->RenderScene( *static_cast< FramePacket const* >( framePacket ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// Runs on the render thread, so everything it draws comes from the packet or from data that only
+// changes once the render thread has been drained
+//
+void Game::RenderScene( FramePacket const& packet ) const
+{
+	g_theRenderer->ClearScreen( Rgba8( 0, 0, 0, 255 ) );
+
+	RenderForDepthBuffers( packet );
+
+	g_theRenderer->ClearScreen( Rgba8( 0, 0, 0, 255 ) );
+
+	g_theRenderer->BeginCamera( packet.m_sceneCamera );
+	{
+		RenderEntities( packet );
 
 #if defined(ENGINE_DEBUG_RENDERING)
 
-		DebugRenderScreenToCamera( m_screenCamera );
+		DebugRenderWorldStream( packet.m_debugWorldStream );
 
 #endif
 	}
-	g_theRenderer->EndCamera( m_screenCamera );
+	g_theRenderer->EndCamera( packet.m_sceneCamera );
 }
 
 
 //----------------------------------------------------------------------------------------------------
-void Game::RenderForDepthBuffers() const
+// Appends to a fixed buffer in place, so building a line of N numbers is linear rather than re-printing
+// the growing line N times. Text past the end of the buffer is dropped
+//
+static void AppendStatText( char* buffer, size_t bufferSize, size_t& inout_length, char const* format, int value )
 {
-	RasterState state;
-	state.m_cullmode = CullMode::NONE;
-	state.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
-	g_theRenderer->SetRasterState( state );
+	if ( inout_length + 1 >= bufferSize )
+		return;
 
-	for ( int lightCamNum = 0; lightCamNum < MAXLIGHTS; lightCamNum++ )
+	int numWritten = snprintf( buffer + inout_length, bufferSize - inout_length, format, value );
+	if ( numWritten > 0 )
 	{
-		ZoneScopedD3D11Marker d3dzone( Stringf( "Light Pass - %d", lightCamNum ).c_str() );
+		inout_length = std::min( inout_length + static_cast< size_t >( numWritten ), bufferSize - 1 );
+	}
+}
 
-		int numCascades = m_numCascades;
 
-		if ( m_shaderLightData.m_lights[lightCamNum].m_lightType == INVALID_LIGHT )
-			continue;
+//----------------------------------------------------------------------------------------------------
+// Overlays only; the scene for this frame is drawn by the render thread once the packet is submitted
+//
+void Game::Render() const
+{
+	// Overlay text, UI and console all build into the frame arena; the scope checks that stays true
+	HeapAllocationScope overlayScope;
+
+	RenderStatCounters renderStats = GetTotalRenderStats();
+	DebugAddScreenText( FrameStringf( "Vertices Rendered: %d", renderStats.m_vertsRendered ), Vec2( 400.0f, 176.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
+	DebugAddScreenText( FrameStringf( "Camera Matrix Rebuilds: %d", Camera::GetNumMatrixRebuilds() ), Vec2( 400.0f, 160.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
+
+	char   cameraLODText[ 256 ] = "Camera LOD Draws:";
+	char   shadowLODText[ 256 ] = "Shadow LOD Draws:";
+	size_t cameraLODLength      = strlen( cameraLODText );
+	size_t shadowLODLength      = strlen( shadowLODText );
+	for ( uint lodNum = 0; lodNum < MAX_MESH_LODS; lodNum++ )
+	{
+		AppendStatText( cameraLODText, sizeof( cameraLODText ), cameraLODLength, " %d", renderStats.m_cameraLODDraws[ lodNum ] );
+		AppendStatText( shadowLODText, sizeof( shadowLODText ), shadowLODLength, " %d", renderStats.m_shadowLODDraws[ lodNum ] );
+	}
+	DebugAddScreenText( std::string_view( cameraLODText, cameraLODLength ), Vec2( 400.0f, 144.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
+	DebugAddScreenText( std::string_view( shadowLODText, shadowLODLength ), Vec2( 400.0f, 128.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
 
-		if ( m_shaderLightData.m_lights[lightCamNum].m_isShadowCasting == 0 )
-			continue;
+	RenderThreadStats renderThreadStats = g_theRenderThread->GetStats();
+	DebugAddScreenText( FrameStringf( "Render Thread: %.2f ms frame, %.2f ms waited%s", renderThreadStats.m_lastFrameSeconds * 1000.0f, renderThreadStats.m_lastWaitSeconds * 1000.0f, g_theRenderThread->IsThreaded() ? "" : " (inline)" ), Vec2( 400.0f, 120.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
 
-		if ( m_shaderLightData.m_lights[lightCamNum].m_lightType != DIRECTIONAL_LIGHT )
-			numCascades = 1;
+	char   workerText[ 512 ] = "Job Worker Utilization:";
+	size_t workerLength      = strlen( workerText );
+	for ( JobWorkerStats const& stats : g_theJobSystem->GetWorkerStats() )
+	{
+		AppendStatText( workerText, sizeof( workerText ), workerLength, " %d%%", static_cast< int >( stats.m_utilization * 100.0f ) );
+	}
+	DebugAddScreenText( std::string_view( workerText, workerLength ), Vec2( 400.0f, 112.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
 
-		for ( int cascadeNum = 0; cascadeNum < numCascades; cascadeNum++ )
-		{ 
-			ZoneScopedD3D11Marker* d3dCascadeZone = nullptr;
-			if ( m_shaderLightData.m_lights[lightCamNum].m_lightType == DIRECTIONAL_LIGHT )
-				d3dCascadeZone = new ZoneScopedD3D11Marker( Stringf( "Cascade - %d", cascadeNum ).c_str() );
+	// The last submitted packet has finished by now, so its queue stats are stable
+	if ( m_submittedPacketIndex >= 0 )
+	{
+		RenderQueueStats const& queueStats = m_framePackets[ m_submittedPacketIndex ].m_sceneRenderQueue.GetStats();
+		DebugAddScreenText( FrameStringf( "Render Queue: %d draws, %d binds issued, %d binds skipped", queueStats.m_numDraws, queueStats.m_bindsIssued, queueStats.m_bindsSkipped ), Vec2( 400.0f, 96.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
+	}
 
-			g_theRenderer->BeginCamera( *m_lightCameraArray[ lightCamNum ], cascadeNum );
-			{
-				g_theRenderer->SetDepthOptions( DepthTest::LESS_EQUAL, true );
+	TextureStreamingStats const& streamingStats = g_theRenderer->GetTextureStreamingStats();
+	DebugAddScreenText( FrameStringf( "Texture Streaming: %.1f MB resident, %d pending, %.1f MB uploaded, %d evicted", static_cast< float >( streamingStats.m_residentBytes ) / ( 1024.0f * 1024.0f ), streamingStats.m_numPendingRequests, static_cast< float >( streamingStats.m_uploadedBytesThisFrame ) / ( 1024.0f * 1024.0f ), streamingStats.m_numEvictions ), Vec2( 400.0f, 104.0f ), 0.0f, Vec2( 1.0f, 1.0f ), 8.0f );
 
-				Shader* shader = g_theRenderer->CreateOrGetShaderFromFile( "Data/Shaders/LightDepthBuffer" );
-				g_theRenderer->BindShader( shader );
+	g_theRenderer->BeginCamera( m_screenCamera );
+	{
+		RenderUI();
 
-				if ( !m_hideDefaultGeometry )
-				{
-					ModelTransformationData data;
-					data.modelMatrix = m_cube1transform;
-					Rgba8::WHITE.GetAsFloats( data.tint );
-					g_theRenderer->SetModelBuffer( data );
-					g_theRenderer->DrawVertexArray( static_cast< int >( m_cubeVerts1.size() ), m_cubeVerts1.data() );
+#if defined(ENGINE_DEBUG_RENDERING)
 
-					for ( int cubeNum = 0; cubeNum < 1; cubeNum++ )
-					{
-						ModelTransformationData cubeTransformData;
-						cubeTransformData.modelMatrix = m_cubeTransforms[cubeNum];
-						Rgba8::WHITE.GetAsFloats( cubeTransformData.tint );
-						g_theRenderer->SetModelBuffer( cubeTransformData );
-						g_theRenderer->DrawVertexArray( static_cast< int >( m_cubeVerts1.size() ), m_cubeVerts1.data() );
-					}
-				}
+		DebugRenderScreenToCamera( m_screenCamera );
 
-				for ( FBXSceneObject const* obj : m_sceneSetting->m_sceneObjects )
-				{
-					if ( obj != nullptr )
-					{
-						obj->Render();
-					}
-				}
+#endif
+	}
+	g_theRenderer->EndCamera( m_screenCamera );
 
-				ModelTransformationData data1;
-				Rgba8::WHITE.GetAsFloats( data1.tint );
-				g_theRenderer->SetModelBuffer( data1 );
-				if ( !m_hideDefaultGeometry )
-				{
-					g_theRenderer->DrawVertexArray( static_cast< int >( m_floor.size() ), m_floor.data() );
-					g_theRenderer->DrawVertexArray( static_cast< int >( m_wall.size() ), m_wall.data() );
-				}
-				if ( d3dCascadeZone != nullptr )
-				{
-					delete d3dCascadeZone;
-					d3dCascadeZone = nullptr;
-				}
-			}
-			g_theRenderer->EndCamera( *m_lightCameraArray[ lightCamNum ] );
+	m_transientHeapAllocations += overlayScope.GetNumAllocations();
+}
+
+
+//----------------------------------------------------------------------------------------------------
+void Game::RenderForDepthBuffers( FramePacket const& packet ) const
+{
+	RasterState state;
+	state.m_cullmode = CullMode::NONE;
+	state.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
+	g_theRenderer->SetRasterState( state );
+
+	// Draw lists were built in submission order during Update, so this only replays them
+	for ( size_t shadowViewNum = 0; shadowViewNum < packet.m_shadowViews.size(); shadowViewNum++ )
+	{
+		// Fixed name: the frame arena rewinds on the main thread, so the render thread does not allocate from it
+		DepthPassView const& view = packet.m_shadowViews[ shadowViewNum ];
+		ZoneScopedD3D11Marker d3dzone( "Light depth pass" );
+
+		g_theRenderer->BeginDepthPass( view );
+		{
+			g_theRenderer->SetDepthOptions( DepthTest::LESS_EQUAL, true );
+			g_theRenderer->ExecuteDrawCommandList( packet.m_shadowDrawLists[ shadowViewNum ] );
 		}
+		g_theRenderer->EndDepthPass();
 	}
 }
 
 
 //----------------------------------------------------------------------------------------------------
-void Game::RenderEntities() const
+void Game::RenderEntities( FramePacket const& packet ) const
 {
 	ZoneScopedD3D11Marker mark( __FUNCTION__ );
 	{
@@ -763,8 +1445,7 @@ void Game::RenderEntities() const
 		g_theRenderer->SetRasterState( skyBoxState );
 		g_theRenderer->SetDepthOptions( DepthTest::ALWAYS, false );
 
-		Shader* skyBoxShader = g_theRenderer->CreateOrGetShaderFromFile( "Data/Shaders/Skybox" );
-		g_theRenderer->BindShader( skyBoxShader );
+		g_theRenderer->BindShader( m_skyBoxShader );
 		g_theRenderer->BindCubeTexture( m_skybox );
 		g_theRenderer->DrawVertexArray( static_cast< int >( m_skyBoxVerts.size() ), m_skyBoxVerts.data() );
 	}
@@ -775,68 +1456,41 @@ void Game::RenderEntities() const
 	g_theRenderer->SetRasterState( state );
 	g_theRenderer->SetDepthOptions( DepthTest::LESS_EQUAL, true );
 
-	Shader* shader = g_theRenderer->CreateOrGetShaderFromFile( "Data/Shaders/BlinnPhong" );
-	Texture* boxTexture = g_theRenderer->CreateOrGetTextureFromFile( "Data/Textures/tile_diffuse.png" );
-	Texture* boxNormalTexture = g_theRenderer->CreateOrGetTextureFromFile( "Data/Textures/tile_normal.png" );
-	g_theRenderer->BindShader( shader );
-	g_theRenderer->BindTexture( boxTexture );
-	g_theRenderer->BindTexture( boxNormalTexture, 1 );
+	g_theRenderer->BindShader( m_litShader );
 
+	// Lights without shadows have no depth texture; their slot stays empty and is never sampled
 	for ( int lightCamNum = 0; lightCamNum < MAXLIGHTS; lightCamNum++ )
 	{
-		g_theRenderer->BindDepthTexture( m_lightCameraArray[ lightCamNum ]->GetDepthTexture(), 8 + lightCamNum );
+		if ( packet.m_lightDepthTextures[ lightCamNum ] != nullptr )
+		{
+			g_theRenderer->BindDepthTexture( packet.m_lightDepthTextures[ lightCamNum ], 8 + lightCamNum );
+		}
 	}
 
-	g_theRenderer->SetLightBuffer( m_shaderLightData );
+	g_theRenderer->SetLightBuffer( packet.m_shaderLightData );
+	g_theRenderer->SetShadowMatrixBuffer( packet.m_shadowMatrixData, packet.m_numShadowMatrices );
+	m_cascadeDepthConstantBuffer->SetData( packet.m_cascadeData );
+	m_cam1ConstantBuffer->SetData( packet.m_cam1Constants );
 	g_theRenderer->BindConstantBuffer( 5, m_cascadeDepthConstantBuffer );
 	g_theRenderer->BindConstantBuffer( 6, m_cam1ConstantBuffer );
 
-	if ( !m_hideDefaultGeometry )
+	// Floor and wall stream through the immediate buffer, so they are drawn directly rather than queued
+	if ( !packet.m_hideDefaultGeometry )
 	{
-		ModelTransformationData data;
-		data.modelMatrix = m_cube1transform;
-		Rgba8::WHITE.GetAsFloats( data.tint );
-		g_theRenderer->SetModelBuffer( data );
-		g_theRenderer->DrawVertexBuffer( m_cubeBuffer, static_cast< int >( m_cubeVerts1.size() ) );
-
-		for ( int cubeNum = 0; cubeNum < 1; cubeNum++ )
-		{
-			ModelTransformationData cubeTransformData;
-			cubeTransformData.modelMatrix = m_cubeTransforms[cubeNum];
-			Rgba8::WHITE.GetAsFloats( cubeTransformData.tint );
-			g_theRenderer->SetModelBuffer( cubeTransformData );
-			g_theRenderer->DrawVertexBuffer( m_cubeBuffer, static_cast< int >( m_cubeVerts1.size() ) );
-		}
-	}
-	g_theRenderer->BindTexture( nullptr );
-	g_theRenderer->BindTexture( nullptr, 1 );
+		g_theRenderer->BindTexture( nullptr );
+		g_theRenderer->BindTexture( nullptr, 1 );
 
-	ModelTransformationData data1;
-	Rgba8::WHITE.GetAsFloats( data1.tint );
-	g_theRenderer->SetModelBuffer( data1 );
+		ModelTransformationData data1;
+		Rgba8::WHITE.GetAsFloats( data1.tint );
+		g_theRenderer->SetModelBuffer( data1 );
 
-	if ( !m_hideDefaultGeometry )
-	{
 		g_theRenderer->DrawVertexArray( static_cast< int >( m_floor.size() ), m_floor.data() );
 		g_theRenderer->DrawVertexArray( static_cast< int >( m_wall.size() ), m_wall.data() );
 	}
 
-	state.m_cullmode = CullMode::NONE;
-	state.m_windingOrder = WindingOrder::COUNTER_CLOCKWISE;
-	g_theRenderer->SetRasterState( state );
-
-	Shader* modelShader = g_theRenderer->CreateOrGetShaderFromFile( "Data/Shaders/BlinnPhongModels" );
-	g_theRenderer->BindShader( modelShader );
-	
 	{
-		ZoneScopedD3D11Marker fbxObjectMark( "FBX render pass" );
-		for ( FBXSceneObject const* obj : m_sceneSetting->m_sceneObjects )
-		{
-			if ( obj != nullptr )
-			{
-				obj->Render();
-			}
-		}
+		ZoneScopedD3D11Marker fbxObjectMark( "Scene render queue" );
+		packet.m_sceneRenderQueue.Submit( g_theRenderer );
 	}
 
 	for ( int lightCamNum = 0; lightCamNum < MAXLIGHTS; lightCamNum++ )
@@ -849,7 +1503,7 @@ void Game::RenderEntities() const
 //----------------------------------------------------------------------------------------------------
 void Game::RenderUI() const
 {
-	if ( m_debugDepthBuffer )
+	if ( m_debugDepthBuffer && m_lightCameraArray[ m_debugLightNumber ]->GetDepthTexture() != nullptr )
 	{
 		RasterState state;
 		state.m_cullmode = CullMode::BACK;
@@ -870,7 +1524,7 @@ void Game::RenderUI() const
 				m_debugPrintConstantBuffer->SetData( data );
 				g_theRenderer->BindConstantBuffer( 4, m_debugPrintConstantBuffer );
 
-				std::vector<Vertex_PCU> verts;
+				FrameVector<Vertex_PCU> verts = MakeFrameVector<Vertex_PCU>( 6 );
 				AddVertsForAABB2D( verts, AABB2( -400.0f + ( cascadeNum * 100.0f ), -200.0f, -300.0f + ( ( cascadeNum ) * 100.0f ), -100.0f), Rgba8::WHITE );
 				g_theRenderer->BindDepthTexture( m_lightCameraArray[m_debugLightNumber]->GetDepthTexture(), 0 );
 				g_theRenderer->DrawVertexArray( static_cast< int >( verts.size() ), verts.data() );
@@ -884,7 +1538,7 @@ void Game::RenderUI() const
 			m_debugPrintConstantBuffer->SetData( data );
 			g_theRenderer->BindConstantBuffer( 4, m_debugPrintConstantBuffer );
 
-			std::vector<Vertex_PCU> verts;
+			FrameVector<Vertex_PCU> verts = MakeFrameVector<Vertex_PCU>( 6 );
 			AddVertsForAABB2D( verts, AABB2( -400.0f, -200.0, -300.0f, -100.0f ), Rgba8::WHITE );
 			g_theRenderer->BindDepthTexture( m_lightCameraArray[ m_debugLightNumber ]->GetDepthTexture(), 0 );
 			g_theRenderer->DrawVertexArray( static_cast< int >(verts.size()), verts.data() );
@@ -905,44 +1559,51 @@ void Game::ResetEntities()
 //------------------------------------------------------------------------------------------------
 void Game::ReloadXMLData()
 {
-	tinyxml2::XMLDocument doc;
-	doc.LoadFile( "Data/XML/LightConfigurations.xml" );
-	GUARANTEE_OR_DIE( doc.ErrorID() == tinyxml2::XML_SUCCESS, "Error Opening the Light Config XML Document" );
+	// Reloaded scenes release meshes the frame on the render thread may still be drawing
+	g_theRenderThread->WaitUntilIdle();
 
-	tinyxml2::XMLElement* root = doc.RootElement();
-	GUARANTEE_OR_DIE( _strcmpi( root->Name(), "LightConfigurations" ) == 0, "Root name different from LightConfigurations" );
+	int    previousSceneID = m_sceneSetting ? m_sceneSetting->m_id : -1;
+	double reloadStartTime = GetCurrentTimeSeconds();
 
-	tinyxml2::XMLElement* childOfRoot = root->FirstChildElement();
-
-	LightConfiguration::s_lightDefs.clear();
-	while ( childOfRoot )
+	DefinitionReloadResult result;
+	if ( !ReloadDefinitions( result ) )
 	{
-		LightConfiguration* config = new LightConfiguration();
-		config->LoadFromXmlElement( *childOfRoot );
+		// At startup there is nothing to fall back on
+		if ( m_sceneSetting == nullptr )
+		{
+			ERROR_AND_DIE( "Failed to load the light configuration and scene setting definitions" );
+		}
 
-		childOfRoot = childOfRoot->NextSiblingElement();
+		DebuggerPrintf( "Definition reload failed; keeping the current scenes and light configurations\n" );
+		return;
 	}
 
-	doc.LoadFile( "Data/XML/SceneSEtting.xml" );
-	GUARANTEE_OR_DIE( doc.ErrorID() == tinyxml2::XML_SUCCESS, "Error Opening the Scene Setting XML Document" );
-
-	root = doc.RootElement();
-	GUARANTEE_OR_DIE( _strcmpi( root->Name(), "SceneSettings" ) == 0, "Root name different from SceneSettings" );
+	// Changed scenes freed their meshes, and new ones may land at the same addresses
+	for ( int packetNum = 0; packetNum < NUM_FRAME_PACKETS; packetNum++ )
+	{
+		m_framePackets[ packetNum ].m_sceneRenderQueue.ResetStateIDs();
+	}
 
-	childOfRoot = root->FirstChildElement();
+	ASSERT_OR_DIE( SceneSetting::s_sceneDefs.size() > 0, "NO SCENE CONFIGS FOUND!!!" );
 
-	SceneSetting::s_sceneDefs.clear();
-	while ( childOfRoot )
+	if ( m_activeGameScene >= static_cast< int >( SceneSetting::s_sceneDefs.size() ) )
 	{
-		SceneSetting* config = new SceneSetting();
-		config->LoadFromXmlElement( *childOfRoot );
-
-		childOfRoot = childOfRoot->NextSiblingElement();
+		m_activeGameScene = 0;
 	}
 
-	ASSERT_OR_DIE( SceneSetting::s_sceneDefs.size() > 0, "NO SCENE CONFIGS FOUND!!!" );
+	// Only a changed active scene is reloaded; a changed light setup keeps the cameras where they are
+	SceneSetting const* activeScene = SceneSetting::s_sceneDefs[ m_activeGameScene ];
+	if ( activeScene->m_id != previousSceneID || result.IsSceneChanged( activeScene->m_id ) )
+	{
+		LoadScene( m_activeGameScene );
+	}
+	else if ( result.IsLightConfigChanged( activeScene->m_lightConfig->m_id ) )
+	{
+		ApplyLightConfiguration( *activeScene->m_lightConfig );
+	}
 
-	LoadScene( m_activeGameScene );
+	DebuggerPrintf( "Reloaded definitions in %.2f ms: %d light configurations and %d scenes changed, %d removed\n", ( GetCurrentTimeSeconds() - reloadStartTime ) * 1000.0,
+					static_cast< int >( result.m_changedLightConfigIDs.size() ), static_cast< int >( result.m_changedSceneIDs.size() ), result.m_numRemovedDefinitions );
 }
 
 //------------------------------------------------------------------------------------------------
@@ -987,27 +1648,8 @@ void Game::LoadScene( uint sceneNum )
 	}
 
 	SceneSetting* setting = SceneSetting::s_sceneDefs[ sceneNum ];
-	m_shaderLightData = setting->m_lightConfig->m_shaderData;
-	m_numLights = setting->m_lightConfig->m_numLights;
 	m_sceneSetting = setting;
-
-	m_numCascades = setting->m_lightConfig->m_numCascades;
-	
-	for ( int cascadeNum = 0; cascadeNum < NUM_CASCADES; cascadeNum++ )
-	{
-		m_cascadeDepthPercent[cascadeNum] = setting->m_lightConfig->m_cascadePercentages[cascadeNum];
-	}
-
-	for ( int lightNum = 0; lightNum < MAXLIGHTS; lightNum++ )
-	{
-		m_lightRotating[lightNum] = ( setting->m_lightConfig->m_lightRotating[lightNum] == 1 );
-		m_lightRotationAxes[lightNum] = ( setting->m_lightConfig->m_lightRotatingAxis[lightNum] );
-
-		m_lightMoving[lightNum] = setting->m_lightConfig->m_lightMoving[lightNum];
-		m_lightMoveSpeed[lightNum] = setting->m_lightConfig->m_lightMoveSpeed[lightNum];
-		m_lightStartPosition[lightNum] = setting->m_lightConfig->m_lightStartPosition[lightNum];
-		m_lightEndPosition[lightNum] = setting->m_lightConfig->m_lightEndPosition[lightNum];
-	}
+	ApplyLightConfiguration( *setting->m_lightConfig );
 
 	m_debugSpecificLight   = setting->m_debugSpecificLight;  
 	m_debugFrustum         = setting->m_debugFrustum;        
@@ -1032,6 +1674,7 @@ void Game::LoadScene( uint sceneNum )
 		m_player->m_orientation = setting->m_cam2Orientation;
 		m_player->m_position = setting->m_cam2Position;
 	}
+	m_player->SnapInterpolation();
 
 	m_nearPlane = setting->m_nearPlane;
 	m_farPlane = setting->m_farPlane;
@@ -1042,3 +1685,31 @@ void Game::LoadScene( uint sceneNum )
 	m_worldCamera.SetCameraPositionAndOrientation( setting->m_cam1Position, setting->m_cam1Orientation );
 	m_worldCamera2.SetCameraPositionAndOrientation( setting->m_cam2Position, setting->m_cam2Orientation );
 }
+
+
+//------------------------------------------------------------------------------------------------
+void Game::ApplyLightConfiguration( LightConfiguration const& config )
+{
+	m_shaderLightData = config.m_shaderData;
+	m_numLights = config.m_numLights;
+
+	m_numCascades = config.m_numCascades;
+	
+	for ( int cascadeNum = 0; cascadeNum < NUM_CASCADES; cascadeNum++ )
+	{
+		m_cascadeDepthPercent[cascadeNum] = config.m_cascadePercentages[cascadeNum];
+	}
+
+	for ( int lightNum = 0; lightNum < MAXLIGHTS; lightNum++ )
+	{
+		m_lightRotating[lightNum] = ( config.m_lightRotating[lightNum] == 1 );
+		m_lightRotationAxes[lightNum] = ( config.m_lightRotatingAxis[lightNum] );
+
+		m_lightMoving[lightNum] = config.m_lightMoving[lightNum];
+		m_lightMoveSpeed[lightNum] = config.m_lightMoveSpeed[lightNum];
+		m_lightStartPosition[lightNum] = config.m_lightStartPosition[lightNum];
+		m_lightEndPosition[lightNum] = config.m_lightEndPosition[lightNum];
+	}
+
+	SnapInterpolation();
+}
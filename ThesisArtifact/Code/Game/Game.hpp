@@ -1,8 +1,13 @@
 #pragma once
 #include "GameCommon.hpp"
+#include "Game/FramePacket.hpp"
 
+#include "Engine/3D/MeshLOD.hpp"
+#include "Engine/Core/FileWatcher.hpp"
 #include "Engine/Input/InputSystem.hpp"
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/DrawCommandList.hpp"
 #include "Engine/Renderer/LightStructure.hpp"
 #include "Engine/Renderer/VertexData/Vertex_PCU.hpp"
 #include "Engine/Renderer/VertexData/Vertex_PCUTBN.hpp"
@@ -13,10 +18,13 @@ class App;
 class BitmapFont;
 class Clock;
 class ConstantBuffer;
+class FBXSceneObject;
+class LightConfiguration;
 class Object;
 class Prop;
 class Player;
 class SceneSetting;
+class Shader;
 class Stopwatch;
 class Texture;
 class VertexBuffer;
@@ -27,18 +35,54 @@ struct ShaderLightData;
 
 
 //----------------------------------------------------------------------------------------------------
-struct CameraConstantsForCamera1
+struct DebugCascadePrint
 {
-	Mat44 m_viewMatrix;
-	Mat44 m_projectionMatrix;
+	float debugCascadeLayer = 0.0f;
+	Vec3  padding;
 };
 
 
 //----------------------------------------------------------------------------------------------------
-struct DebugCascadePrint
+// Anything drawn into the light depth passes. m_viewMask holds one bit per (light, cascade/face) view.
+struct ShadowCaster
 {
-	float debugCascadeLayer = 0.0f;
-	Vec3  padding;
+	AABB3                             m_worldBounds;
+	Mat44                             m_modelMatrix;
+	std::vector<Vertex_PCUTBN> const* m_verts                 = nullptr;
+	FBXSceneObject*                   m_sceneObject           = nullptr;
+	uint8_t                           m_viewMask[ MAXLIGHTS ] = {};
+};
+
+
+//----------------------------------------------------------------------------------------------------
+// One depth pass: a cascade of a directional light, a spot light, or one cube face of a point light
+struct ShadowView
+{
+	int m_lightNum = 0;
+	int m_viewNum  = 0;
+};
+
+
+//----------------------------------------------------------------------------------------------------
+// Draw statistics for one thread. Padded to a cache line so workers counting side by side never share one
+struct alignas( 64 ) RenderStatCounters
+{
+	uint32_t m_vertsRendered                   = 0;
+	uint32_t m_cameraLODDraws[ MAX_MESH_LODS ] = {};
+	uint32_t m_shadowLODDraws[ MAX_MESH_LODS ] = {};
+};
+
+
+//----------------------------------------------------------------------------------------------------
+// Moving and rotating lights are simulated on fixed ticks. While a frame renders, m_shaderLightData holds
+// a blend of the last two ticks, and the simulated values go back in before anything else reads or edits it
+struct LightInterpolationState
+{
+	Vec3 m_previousPosition;
+	Vec3 m_previousDirection;
+	Vec3 m_simulatedPosition;
+	Vec3 m_simulatedDirection;
+	bool m_isShowingInterpolated = false;
 };
 
 
@@ -55,19 +99,44 @@ public:
 		void CreateOrigin();
 		void CreateEntities();
 		void CreateLightConfigs();
+		void LoadRenderResources();
 
 	void Update();
 		void UpdateDebug();
 		void UpdateShaderLightDataUsingUI();
+	void Simulate( float tickSeconds );
 		void UpdateLightRotation( float deltaSeconds );
+	void UpdateForRender( float interpolationAlpha );
 		void UpdateEntities( float deltaSeconds );
-		void UpdateCamera( float deltaSeconds );
+		void ApplyInterpolatedLightStates( float interpolationAlpha );
+		void RestoreSimulatedLightStates();
+		void SnapInterpolation();
+		void UpdateCamera( float interpolationAlpha );
+		     void UpdateShadowCasters();
+		     void UpdateLightDepthTextures( int lightNum, uint numDepthSlices );
 		     void UpdateLightCameraProjection( int lightNum );
+		     void UpdateSpotLightCameraProjection( int lightNum );
+		     void UpdatePointLightCameraProjection( int lightNum );
+		     uint GetShadowResolutionForCoverage( Vec3 const& lightPosition, float lightRadius ) const;
+		     void UpdateShadowMatrices();
+		     void UpdateSceneObjectLODs();
+		     void BuildShadowDrawLists();
+		     void BuildShadowDrawList( int shadowViewNum, Shader* shader, Shader* sceneObjectShader );
+		void BuildFramePacket( FramePacket& out_packet );
+		     void BuildSceneRenderQueue( RenderQueue& out_queue ) const;
 		void AddVertsRendered( uint32_t vertsAdded );
+		void AddLODDrawn( uint lodNum, bool isShadowPass );
+		RenderStatCounters& GetRenderStatsForCurrentThread();
+		RenderStatCounters  GetTotalRenderStats() const;
+		void                ResetRenderStats();
+
+	void SubmitFramePacket();
+	static void ExecuteFramePacket( void const* framePacket );		// render thread
+	void RenderScene( FramePacket const& packet ) const;
+		void RenderForDepthBuffers( FramePacket const& packet ) const;
+		void RenderEntities( FramePacket const& packet ) const;
 
 	void Render() const;
-		void RenderForDepthBuffers() const;
-		void RenderEntities() const;
 		void RenderUI() const;
 	
 	void Shutdown();
@@ -78,6 +147,7 @@ public:
 	void LoadNextScene();
 	void LoadPreviousScene();
 	    void LoadScene( uint sceneNum );
+	    void ApplyLightConfiguration( LightConfiguration const& config );
 	
 private:
 	App*                       m_App;
@@ -107,9 +177,14 @@ private:
 //--------------------------------------------------------------------------------------------------------------------------------------------
 	
 	ShaderLightData            m_shaderLightData;
+	ShaderShadowMatrixData     m_shadowMatrixData;
+	uint                       m_numShadowMatrices = 0;
 	LightDataC                 m_lightPresets[ 4 ];
 	
 	LightCamera**              m_lightCameraArray;
+	std::vector<ShadowCaster>  m_shadowCasters;
+	std::vector<ShadowView>      m_shadowViews;
+	std::vector<DrawCommandList> m_shadowDrawLists;		// parallel to m_shadowViews, rebuilt every frame and swapped into the frame packet
 
 	ConstantBuffer*            m_cascadeDepthConstantBuffer = nullptr;
 	ConstantBuffer*            m_cam1ConstantBuffer         = nullptr;
@@ -135,6 +210,25 @@ private:
 	std::vector<Vertex_PCU>    m_skyBoxVerts;
 
 
+//--------------------------------------------------------------------------------------------------------------------------------------------
+//			RENDERING
+//--------------------------------------------------------------------------------------------------------------------------------------------
+
+	FramePacket                m_framePackets[ NUM_FRAME_PACKETS ];
+	int                        m_buildPacketIndex     = 0;		// the packet the render thread is done with
+	int                        m_submittedPacketIndex = -1;
+	uint64_t                   m_numFramePacketsBuilt = 0;
+
+	// Looked up once at Startup; the shader and texture caches are not safe to touch while a frame renders
+	Shader*                    m_skyBoxShader           = nullptr;
+	Shader*                    m_litShader              = nullptr;
+	Shader*                    m_modelShader            = nullptr;
+	Shader*                    m_depthShader            = nullptr;
+	Shader*                    m_sceneObjectDepthShader = nullptr;
+	Texture*                   m_boxTexture             = nullptr;
+	Texture*                   m_boxNormalTexture       = nullptr;
+
+
 //--------------------------------------------------------------------------------------------------------------------------------------------
 //		    IMGUI DATA
 //--------------------------------------------------------------------------------------------------------------------------------------------	
@@ -171,11 +265,20 @@ private:
 	float                      m_lightMoveSpeed[MAXLIGHTS];
 	Vec3                       m_lightStartPosition[MAXLIGHTS];
 	Vec3                       m_lightEndPosition[MAXLIGHTS];
+	LightInterpolationState    m_lightInterpolation[MAXLIGHTS];
 	
 	int                        m_activeGameScene    = 0;
 	SceneSetting*              m_sceneSetting       = nullptr;
+	FileWatcher                m_definitionWatcher;	// light and scene XML; changes reload only the definitions that differ
+
+	std::vector<RenderStatCounters> m_renderStats;		// one per job worker, last slot shared by non worker threads
+	mutable int                m_transientHeapAllocations     = 0;	// debug overlay, console and UI work; should stay zero once warmed up
+	int                        m_lastTransientHeapAllocations = 0;
+	int                        m_lastFrameHeapAllocations     = 0;
+	uint64_t                   m_lastTotalHeapAllocations     = 0;
 
-	uint32_t                   m_vertsRendered = 0;
+	float                      m_shadowLODBias         = 0.5f;	// shadow maps tolerate coarser silhouettes than the main view
+	float                      m_cascadeLODBiasFalloff = 0.7f;	// further bias multiplied in per cascade step outwards
 
 	Player*                    m_player;
 };
@@ -28,6 +28,10 @@ constexpr float SCREEN_CENTER_X = SCREEN_SIZE_X * 0.5f;
 constexpr float WORLD_CENTER_X = WORLD_SIZE_X / 2.f;
 constexpr float WORLD_CENTER_Y = WORLD_SIZE_Y / 2.f;
 
+constexpr float SHADOW_ATTENUATION_CUTOFF = 0.01f;
+constexpr uint  MIN_SHADOW_RESOLUTION     = 256;
+constexpr int   SCENE_UPDATE_BATCH_SIZE   = 32;		// scene objects per job worker batch
+
 
 //-----------------------------------------------------------------------------------------------
 extern App*                    g_theApp;
@@ -1,9 +1,12 @@
 #include "Game.hpp"
 
 #include "Game/App.hpp"
+#include "Game/Definitions/CompiledDefinitions.hpp"
 #include "Game/Player.hpp"
 
+#include "Engine/3D/VisualDatabase.hpp"
 #include "Engine/Core/Clock.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/MathUtils.hpp"
@@ -12,6 +15,7 @@
 #include "Engine/Renderer/ConstantBuffer.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/RenderThread.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
 #include "Engine/Renderer/VertexData/VertexUtils.hpp"
@@ -22,9 +26,12 @@ void Game::Startup()
 {
 	g_theGame = this;
 
+	LoadRenderResources();
 	CreateMouseConfigs();
 	CreateEntities();
 	CreateLightConfigs();
+	m_definitionWatcher.WatchFile( LIGHT_CONFIGURATIONS_XML_PATH );
+	m_definitionWatcher.WatchFile( SCENE_SETTINGS_XML_PATH );
 	ReloadXMLData();
 
 	m_worldCamera.SetCameraType( CameraType::PERSPECTIVE );
@@ -57,6 +64,26 @@ void Game::Startup()
 }
 
 
+//----------------------------------------------------------------------------------------------------
+// Frame packets are built without touching the renderer, so everything they reference is looked up once here
+//
+void Game::LoadRenderResources()
+{
+	ASSERT_OR_DIE( g_theRenderThread->GetMaxFramesInFlight() < NUM_FRAME_PACKETS, "Game needs a free frame packet to build into while the others are in flight" );
+
+	bool usePackedVertices = g_theVisualDatabase->m_config.m_usePackedVertices;
+
+	m_skyBoxShader           = g_theRenderer->CreateOrGetShaderFromFile( "Data/Shaders/Skybox" );
+	m_litShader              = g_theRenderer->CreateOrGetShaderFromFile( "Data/Shaders/BlinnPhong" );
+	m_modelShader            = g_theRenderer->CreateOrGetShaderFromFile( usePackedVertices ? "Data/Shaders/BlinnPhongModelsPacked" : "Data/Shaders/BlinnPhongModels" );
+	m_depthShader            = g_theRenderer->CreateOrGetShaderFromFile( "Data/Shaders/LightDepthBuffer" );
+	m_sceneObjectDepthShader = usePackedVertices ? g_theRenderer->CreateOrGetShaderFromFile( "Data/Shaders/LightDepthBufferPacked" ) : m_depthShader;
+
+	m_boxTexture       = g_theRenderer->CreateOrGetTextureFromFile( "Data/Textures/tile_diffuse.png" );
+	m_boxNormalTexture = g_theRenderer->CreateOrGetTextureFromFile( "Data/Textures/tile_normal.png", TextureUsage::NORMAL_MAP );
+}
+
+
 //----------------------------------------------------------------------------------------------------
 void Game::CreateEntities()
 {
@@ -196,12 +196,12 @@ void Game::UpdateShaderLightDataUsingUI()
 					{
 						ImGui::Combo( "Rotation Axis", reinterpret_cast<int*>(&m_lightRotationAxes[lightNum]), "+X\0-X\0+Y\0-Y\0+Z\0-Z" );
 					}
-
-					bool shadowCasting = m_shaderLightData.m_lights[lightNum].m_isShadowCasting ? true : false;
-					ImGui::Checkbox( "Shadow Casting?", &shadowCasting );
-					m_shaderLightData.m_lights[lightNum].m_isShadowCasting = shadowCasting ? 1 : 0;
 				}
 
+				bool shadowCasting = m_shaderLightData.m_lights[lightNum].m_isShadowCasting ? true : false;
+				ImGui::Checkbox( "Shadow Casting?", &shadowCasting );
+				m_shaderLightData.m_lights[lightNum].m_isShadowCasting = shadowCasting ? 1 : 0;
+
 				ImGui::TreePop();
 			}
 		}
@@ -10,7 +10,8 @@
 
 //----------------------------------------------------------------------------------------------------
 Player::Player( Game* owner, Vec3 const& startPosition, EulerAngles const& orientation ):
-	Object( owner, startPosition, orientation )
+	Object( owner, startPosition, orientation ),
+	m_previousPosition( startPosition )
 {
 	
 }
@@ -40,22 +41,14 @@ void Player::DebugRender() const
 //----------------------------------------------------------------------------------------------------
 void Player::Update( float deltaSeconds )
 {
+	m_previousPosition = m_position;
 	UpdateUsingKeyboard( deltaSeconds );
 }
 
 
 //----------------------------------------------------------------------------------------------------
-Vec3 Player::GetForward() const
+void Player::UpdateMouseLook( float deltaSeconds )
 {
-	return m_forwardVector;
-}
-
-
-//----------------------------------------------------------------------------------------------------
-void Player::UpdateUsingKeyboard( float deltaSeconds )
-{
-	Mat44 orientMat = m_orientation.GetAsMatrix_XFwd_YLeft_ZUp();
-
 	IntVec2 mouseRelativeMovement = g_theInput->GetMouseRelativeMovement();
 	float mouseSenstivity = 0.02f;
 	
@@ -69,7 +62,34 @@ void Player::UpdateUsingKeyboard( float deltaSeconds )
 	m_orientation.m_pitchDegrees = Clamp( m_orientation.m_pitchDegrees, -85.f, 85.f );
 
 	GenerateDirectionVectors();
-	
+}
+
+
+//----------------------------------------------------------------------------------------------------
+Vec3 Player::GetForward() const
+{
+	return m_forwardVector;
+}
+
+
+//----------------------------------------------------------------------------------------------------
+Vec3 Player::GetInterpolatedPosition( float interpolationAlpha ) const
+{
+	return m_previousPosition + ( m_position - m_previousPosition ) * interpolationAlpha;
+}
+
+
+//----------------------------------------------------------------------------------------------------
+void Player::SnapInterpolation()
+{
+	m_previousPosition = m_position;
+	GenerateDirectionVectors();
+}
+
+
+//----------------------------------------------------------------------------------------------------
+void Player::UpdateUsingKeyboard( float deltaSeconds )
+{
 	float multiplier = 1.f;
 
 	if ( g_theInput->IsKeyDown( KEYCODE_SHIFT ) )
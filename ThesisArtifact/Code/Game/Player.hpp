@@ -11,16 +11,20 @@ public:
 
 	void Render() const override;
 	void DebugRender() const override;
-	void Update( float deltaSeconds ) override;
+	void Update( float deltaSeconds ) override;		// one simulation tick of movement
+	void UpdateMouseLook( float deltaSeconds );		// once per frame, so look input is never dropped or repeated by the tick count
 
 	Vec3 GetForward() const;
+	Vec3 GetInterpolatedPosition( float interpolationAlpha ) const;
+	void SnapInterpolation();						// after teleporting, so the next frame doesn't blend in from the old position
 
 protected:
 	void UpdateUsingKeyboard( float deltaSeconds );
 	void GenerateDirectionVectors();
 
 protected:
-	Vec3 m_forwardVector = Vec3( 1.0f, 0.0f, 0.0f);
-	Vec3 m_leftVector    = Vec3( 0.0f, 1.0f, 0.0f );
-	Vec3 m_upVector      = Vec3( 0.0f, 0.0f, 1.0f );
+	Vec3 m_forwardVector    = Vec3( 1.0f, 0.0f, 0.0f);
+	Vec3 m_leftVector       = Vec3( 0.0f, 1.0f, 0.0f );
+	Vec3 m_upVector         = Vec3( 0.0f, 0.0f, 1.0f );
+	Vec3 m_previousPosition;						// m_position before the last simulation tick
 };
\ No newline at end of file
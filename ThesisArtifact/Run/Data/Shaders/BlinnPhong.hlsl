@@ -92,7 +92,7 @@ float4 PixelMain( v2p_t input ) : SV_Target0
 	
 	float3   bitangent         = normalize( cross( normal, tangent ) );
 	float3x3 TBN               = float3x3( tangent, bitangent, normal );
-	float3   surfaceNormal     = ColorToFloat3( normalColor.xyz );
+	float3   surfaceNormal     = NormalColorToFloat3( normalColor.xy );
 	float3   worldNormal       = mul( surfaceNormal, TBN );
 	
     //float4 lightProjectedPositions[ MAX_CASCADES * MAXLIGHTS ];
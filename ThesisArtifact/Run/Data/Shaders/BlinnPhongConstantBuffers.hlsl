@@ -2,6 +2,8 @@
 static const uint MAXLIGHTS        = 8;
 static const uint NUM_SAMPLES      = 32;
 static const uint NUM_CASCADES     = 8;
+static const uint NUM_CUBE_FACES   = 6;
+static const uint MAX_SHADOW_MATRICES = MAXLIGHTS * NUM_CASCADES;
 static const uint INVALIDLIGHT     = 0;
 static const uint DIRECTIONALLIGHT = 1;
 static const uint SPOTLIGHT        = 2;
@@ -21,6 +23,8 @@ cbuffer ObjectConstants : register(b3)
 {
 	float4x4 modelMatrix;
     float4   tint;
+    float4   packedPositionOffset;
+    float4   packedPositionScale;
 };
 
 
@@ -42,27 +46,32 @@ struct lightDataG // Light Data for GPU
 	float3          specularAttenuation;                     
 	float           dotOuterAngle;                    
 	
-    float4x4        viewMatrix;
-    float4x4        projMatrix[ NUM_CASCADES ];
-	
     uint            isShadowCasting;
     float           shadowBias;
-
-    float           padding0;
-    float           padding1;
+    uint            shadowMatrixIndex;
+    float           shadowViewportScale;
 };
 
 
 //------------------------------------------------------------------------------------------------
+// Only the first numLights entries of lights[] are uploaded
 cbuffer LightConstantsG : register( b4 )
 {
 	float4		ambientLight;						
-	lightDataG	lights[ MAXLIGHTS ];
-	
 	float		diffuseFactor;					
 	float		specularFactor;				
 	float		specularPower;				
-	float		padding00;
+	uint		numLights;
+
+	lightDataG	lights[ MAXLIGHTS ];
+};
+
+
+//------------------------------------------------------------------------------------------------
+// Packed light view-projections, indexed by lights[ i ].shadowMatrixIndex + cascade
+cbuffer ShadowMatrixConstantsG : register( b7 )
+{
+    float4x4    shadowMatrices[ MAX_SHADOW_MATRICES ];
 };
 
 
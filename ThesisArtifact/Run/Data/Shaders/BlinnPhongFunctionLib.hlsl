@@ -101,6 +101,31 @@ float CalculateDepthValue( float2 texCoord, uint lightNum, float pixelDepth, flo
 }
 
 
+//------------------------------------------------------------------------------------------------
+// Each light's depth texture is sized to its own shadow resolution, so PCF offsets are in its texels
+//------------------------------------------------------------------------------------------------
+float GetDepthTextureSize( uint lightNum )
+{
+    uint width  = 1;
+    uint height = 1;
+    uint slices = 1;
+    
+    switch ( lightNum )
+    {
+        case 0: DepthTexture[ 0 ].GetDimensions( width, height, slices ); break;
+        case 1: DepthTexture[ 1 ].GetDimensions( width, height, slices ); break;
+        case 2: DepthTexture[ 2 ].GetDimensions( width, height, slices ); break;
+        case 3: DepthTexture[ 3 ].GetDimensions( width, height, slices ); break;
+        case 4: DepthTexture[ 4 ].GetDimensions( width, height, slices ); break;
+        case 5: DepthTexture[ 5 ].GetDimensions( width, height, slices ); break;
+        case 6: DepthTexture[ 6 ].GetDimensions( width, height, slices ); break;
+        case 7: DepthTexture[ 7 ].GetDimensions( width, height, slices ); break;
+    }
+    
+    return ( float ) width;
+}
+
+
 //------------------------------------------------------------------------------------------------
 float CalculateShadowFactor( float4 lightSpacePos, uint lightNum, float bias, float cascadeNum = 0.0f )
 {
@@ -131,13 +156,14 @@ float CalculateShadowFactor( float4 lightSpacePos, uint lightNum, float bias, fl
     }
     else
     {
-        uint numComparisons = 0;
+        uint  numComparisons   = 0;
+        float depthTextureSize = GetDepthTextureSize( lightNum );
     
         for ( uint sampleNum = 0; sampleNum < numSamples; sampleNum++ )
         {        
             float2 randomRotation = float2( 1.0f, 1.0f );
             uint index = uint( 16.0f * random( float4( shadowUVTexCoords.xyy, sampleNum ) ) ) % 16;
-            sampleCoords = shadowUVTexCoords + ( poissonDisk[ index ] * randomRotation / ( 0.85f * dimensionOfDepthTexture ) );
+            sampleCoords = shadowUVTexCoords + ( poissonDisk[ index ] * randomRotation / ( 0.85f * depthTextureSize ) );
        
             if ( ( saturate( sampleCoords.x ) == sampleCoords.x ) &&
 		        ( saturate( sampleCoords.y ) == sampleCoords.y ) )
@@ -165,6 +191,16 @@ float3 ColorToFloat3( float3 color )
 }
 
 
+//------------------------------------------------------------------------------------------------
+// Cooked normal maps are BC5 and only keep x and y, so z is rebuilt from the unit length
+//
+float3 NormalColorToFloat3( float2 color )
+{
+    float2 xy = color * 2.0f - 1.0f;
+    return normalize( float3( xy, sqrt( saturate( 1.0f - dot( xy, xy ) ) ) ) );
+}
+
+
 //------------------------------------------------------------------------------------------------
 float2 ComputeLightFactor( lightDataG light, float3 worldPosition, float3 worldNormal, float3 directionToCam )
 {
@@ -209,7 +245,7 @@ float3 ComputeLighting( float3 worldPos, float3 worldNormal, float3 surfaceColor
     float3 specular = float3( 0.0f.xxx );
     
    // add up contribution of all lights
-    for ( uint index = 0; index < MAXLIGHTS; index++ )
+    for ( uint index = 0; index < numLights; index++ )
     {
         if ( lights[index].lightType == INVALIDLIGHT)
             continue;
@@ -219,7 +255,7 @@ float3 ComputeLighting( float3 worldPos, float3 worldNormal, float3 surfaceColor
         
         float visibility = 1.0f;
 
-        if ( lights[index].isShadowCasting == 1)
+        if ( lights[index].isShadowCasting == 1 && lights[ index ].shadowMatrixIndex < MAX_SHADOW_MATRICES )
         {
             float cosTheta = clamp( dot( worldNormal, -lights[ index ].direction ), 0, 1 );
             float theta = acos( cosTheta );
@@ -230,7 +266,7 @@ float3 ComputeLighting( float3 worldPos, float3 worldNormal, float3 surfaceColor
             //bias = clamp( bias, lights[ index ].shadowBias, lights[ index ].shadowBias * 10.0f );
             //float bias = lights[ index ].shadowBias;
             
-            float4 lightViewSpacePos = mul( lights[ index ].viewMatrix, worldPosition );
+            uint   shadowMatrixIndex = lights[ index ].shadowMatrixIndex;
             float4 lightProjSpacePos;
             
             if ( lights[ index ].lightType == DIRECTIONALLIGHT )
@@ -247,16 +283,36 @@ float3 ComputeLighting( float3 worldPos, float3 worldNormal, float3 surfaceColor
         
                 if ( cascade != -1 )
                 {
-                    lightProjSpacePos = mul( lights[ index ].projMatrix[ cascade ], lightViewSpacePos );
+                    lightProjSpacePos = mul( shadowMatrices[ shadowMatrixIndex + cascade ], worldPosition );
                     visibility *= CalculateShadowFactor( lightProjSpacePos, index, bias, ( float ) cascade );
                 }
             }
             else if ( lights[ index ].lightType == SPOTLIGHT )
             {
                 bias = lights[ index ].shadowBias;
-                lightProjSpacePos = mul( lights[ index ].projMatrix[ 0 ], lightViewSpacePos );
+                lightProjSpacePos = mul( shadowMatrices[ shadowMatrixIndex ], worldPosition );
                 visibility *= CalculateShadowFactor( lightProjSpacePos, index, bias, 0 );
             }
+            else if ( lights[ index ].lightType == POINTLIGHT )
+            {
+                bias = lights[ index ].shadowBias;
+                
+                // Each face is remapped into the top left viewport region, so the face bounds are [-1, 2s - 1] x [1 - 2s, 1]
+                float faceExtent = ( 2.0f * lights[ index ].shadowViewportScale ) - 1.0f;
+                for ( uint faceNum = 0; faceNum < NUM_CUBE_FACES; faceNum++ )
+                {
+                    lightProjSpacePos = mul( shadowMatrices[ shadowMatrixIndex + faceNum ], worldPosition );
+                    float2 faceNDC = lightProjSpacePos.xy / lightProjSpacePos.w;
+                    
+                    if ( lightProjSpacePos.w > 0.0f && 
+                         faceNDC.x >= -1.0f && faceNDC.x <= faceExtent && 
+                         faceNDC.y >= -faceExtent && faceNDC.y <= 1.0f )
+                    {
+                        visibility *= CalculateShadowFactor( lightProjSpacePos, index, bias, ( float ) faceNum );
+                        break;
+                    }
+                }
+            }
         }
                 
         if ( visibility > 0.0f )
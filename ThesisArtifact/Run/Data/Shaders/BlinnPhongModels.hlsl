@@ -12,6 +12,10 @@ struct vs_input_t
 	float3 normal   : NORMAL;
 };
 
+#if defined( PACKED_VERTEX )
+#include "PackedVertex.hlsl"
+#endif
+
 
 //------------------------------------------------------------------------------------------------
 struct v2p_t 
@@ -36,8 +40,14 @@ float3 Projection( float3 vecU, float3 vecV )
 
 
 //------------------------------------------------------------------------------------------------
+#if defined( PACKED_VERTEX )
+v2p_t VertexMain( packed_vs_input_t packedInput )
+{
+	vs_input_t input = UnpackVertex( packedInput, packedPositionOffset.xyz, packedPositionScale.xyz );
+#else
 v2p_t VertexMain( vs_input_t input )
 {
+#endif
 	v2p_t v2p;
 
 	float4 localPosition = float4( input.position, 1 );
@@ -98,7 +108,7 @@ float4 PixelMain( v2p_t input ) : SV_Target0
     binormal = normalize( binormal - ( Projection( normal, binormal ) ) - ( Projection( tangent, binormal ) ) );
 	
 	float3x3 TBN            = float3x3( tangent, binormal, normal );
-	float3   surfaceNormal  = ColorToFloat3( normalColor.xyz );
+	float3   surfaceNormal  = NormalColorToFloat3( normalColor.xy );
 	float3   worldNormal    = mul( surfaceNormal, TBN );
 	
     //worldNormal *= 0.5f;
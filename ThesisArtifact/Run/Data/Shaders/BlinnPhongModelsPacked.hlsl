@@ -0,0 +1,3 @@
+// BlinnPhongModels for meshes uploaded as Vertex_PackedPUTBN
+#define PACKED_VERTEX
+#include "BlinnPhongModels.hlsl"
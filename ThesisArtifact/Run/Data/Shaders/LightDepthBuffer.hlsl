@@ -11,6 +11,10 @@ struct vs_input_t
 	float3 normal   : NORMAL;
 };
 
+#if defined( PACKED_VERTEX )
+#include "PackedVertex.hlsl"
+#endif
+
 
 //------------------------------------------------------------------------------------------------
 struct v2f_t
@@ -35,12 +39,20 @@ cbuffer ObjectConstants : register( b3 )
 {
 	float4x4 modelMatrix;
 	float4   tint;
+	float4   packedPositionOffset;
+	float4   packedPositionScale;
 };
 
 
 //------------------------------------------------------------------------------------------------
+#if defined( PACKED_VERTEX )
+v2f_t VertexMain( packed_position_vs_input_t packedInput )
+{
+	vs_input_t input = UnpackPosition( packedInput, packedPositionOffset.xyz, packedPositionScale.xyz );
+#else
 v2f_t VertexMain( vs_input_t input )
 {
+#endif
     v2f_t v2f;
 
 	float4 localPosition = float4( input.position, 1 );
@@ -0,0 +1,3 @@
+// LightDepthBuffer for meshes uploaded as Vertex_PackedPUTBN - reads only the Vertex_PackedPosition stream
+#define PACKED_VERTEX
+#include "LightDepthBuffer.hlsl"
@@ -0,0 +1,61 @@
+// Decode for Vertex_PackedPUTBN - include after vs_input_t is declared and keep in sync with Vertex_PackedPUTBN::Decode
+
+
+//------------------------------------------------------------------------------------------------
+struct packed_vs_input_t
+{
+	float4 position : POSITION;		// slot 0 - unorm16 xyz inside the mesh bounds, w = bitangent sign
+	float2 uv       : TEXCOORD;		// slot 1 - half
+	float2 tangent  : TANGENT;		// slot 1 - octahedral snorm16
+	float2 normal   : NORMAL;		// slot 1 - octahedral snorm16
+};
+
+
+//------------------------------------------------------------------------------------------------
+struct packed_position_vs_input_t
+{
+	float4 position : POSITION;
+};
+
+
+//------------------------------------------------------------------------------------------------
+float3 DecodeOctahedral( float2 encoded )
+{
+    float3 decoded = float3( encoded.x, encoded.y, 1.0f - abs( encoded.x ) - abs( encoded.y ) );
+    if ( decoded.z < 0.0f )
+    {
+        float2 signs = float2( encoded.x >= 0.0f ? 1.0f : -1.0f, encoded.y >= 0.0f ? 1.0f : -1.0f );
+        decoded.xy = ( 1.0f - abs( encoded.yx ) ) * signs;
+    }
+    return normalize( decoded );
+}
+
+
+//------------------------------------------------------------------------------------------------
+vs_input_t UnpackVertex( packed_vs_input_t packedInput, float3 positionOffset, float3 positionScale )
+{
+    vs_input_t input;
+    
+    float bitangentSign = packedInput.position.w > 0.5f ? 1.0f : -1.0f;
+    
+    input.position = positionOffset + packedInput.position.xyz * positionScale;
+    input.color    = float4( 1.0f, 1.0f, 1.0f, 1.0f );
+    input.uv       = packedInput.uv;
+    input.tangent  = DecodeOctahedral( packedInput.tangent );
+    input.normal   = DecodeOctahedral( packedInput.normal );
+    input.binormal = cross( input.normal, input.tangent ) * bitangentSign;
+    
+    return input;
+}
+
+
+//------------------------------------------------------------------------------------------------
+vs_input_t UnpackPosition( packed_position_vs_input_t packedInput, float3 positionOffset, float3 positionScale )
+{
+    vs_input_t input = ( vs_input_t ) 0;
+    
+    input.position = positionOffset + packedInput.position.xyz * positionScale;
+    input.color    = float4( 1.0f, 1.0f, 1.0f, 1.0f );
+    
+    return input;
+}